@@ -38,7 +38,7 @@ project "LunariaCore"
         removefiles { "src/RHI/Linux/**.cpp", "include/LunariaCore/RHI/Linux/**.hpp" }
 
 	filter "system:linux"
-	    links { "GL" }
+	    links { "GL", "pthread" }
         removefiles { "src/RHI/Windows/**.cpp", "include/LunariaCore/RHI/Windows/**.hpp" }
 
 	filter "configurations:Debug"
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace Lunaria {
+
+	// Read only view of a whole file mapped into memory, pages are loaded by the OS on first touch.
+	// The data is page aligned and stays valid until the object is destroyed.
+	class LUNARIA_API MappedFile
+	{
+	public:
+		MappedFile() = default;
+		MappedFile(const std::string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const std::string& path);
+		void Close();
+
+		bool IsOpen() const { return m_Data != nullptr; }
+		const uint8_t* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+
+	#ifdef LU_PLATFORM_WINDOWS
+		void* m_File = nullptr;
+		void* m_Mapping = nullptr;
+	#endif
+	};
+
+}
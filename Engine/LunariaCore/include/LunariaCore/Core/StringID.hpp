@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string_view>
+
+namespace Lunaria {
+
+	// Index of a string in the global string table. Strings are interned once into an arena and
+	// never freed, an ID copies and compares like an integer and resolves without locking. IDs are
+	// only valid for the current run, files have to store the strings.
+	class LUNARIA_API StringID
+	{
+	public:
+		StringID() = default; // The empty string
+		explicit StringID(std::string_view string);
+
+		std::string_view GetString() const;
+		const char* CStr() const; // Null terminated
+		uint32_t GetValue() const { return m_ID; }
+		bool IsEmpty() const { return m_ID == 0; }
+
+		bool operator==(const StringID& other) const { return m_ID == other.m_ID; }
+		bool operator!=(const StringID& other) const { return m_ID != other.m_ID; }
+
+		// Of the whole table, every string interned so far
+		static uint32_t GetStringCount();
+		static size_t GetArenaSize();
+	private:
+		uint32_t m_ID = 0;
+	};
+
+}
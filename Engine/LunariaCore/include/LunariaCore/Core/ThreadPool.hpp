@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Lunaria {
+
+	// Fixed set of worker threads for data parallel loops, the calling thread helps out.
+	// One loop runs at a time, ParallelFor must not be called from inside a task.
+	class LUNARIA_API ThreadPool
+	{
+	public:
+		ThreadPool(uint32_t workerCount);
+		~ThreadPool();
+
+		// Calls task(i) for every i in [0, count), returns once all are done
+		void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& task);
+
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+	private:
+		void WorkerLoop();
+	private:
+		std::vector<std::thread> m_Workers;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_WorkAvailable, m_WorkDone;
+		bool m_Running = true;
+
+		const std::function<void(uint32_t)>* m_Task = nullptr;
+		uint32_t m_TaskCount = 0;
+		std::atomic<uint32_t> m_NextTask = 0;
+		uint32_t m_ActiveWorkers = 0;
+		uint64_t m_Generation = 0;
+	};
+
+}
@@ -7,6 +7,8 @@
 
 namespace Lunaria {
 
+	class GraphicsContext;
+
 	enum class LUNARIA_API WindowBorder
 	{
 		Left = 0,
@@ -42,8 +44,13 @@ namespace Lunaria {
 		virtual ~Window() = default;
 		Window(const Window&) = delete;
 
+		// Polls events and presents
 		virtual void OnUpdate() = 0;
 
+		// Only the event half of OnUpdate, the render thread presents on its own
+		virtual void PollEvents() = 0;
+		virtual GraphicsContext& GetGraphicsContext() const = 0;
+
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
 
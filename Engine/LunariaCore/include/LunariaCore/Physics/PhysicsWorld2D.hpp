@@ -0,0 +1,194 @@
+#pragma once
+
+#include "LunariaCore/Core/Timestep.hpp"
+
+#include <entt/entt.hpp>
+
+#include <glm/glm.hpp>
+
+namespace Lunaria {
+
+	class ThreadPool;
+	struct TransformComponent;
+	struct Rigidbody2DComponent;
+
+	// Rigid bodies of a registry in 2D, stepped at a fixed rate. Every step sweeps the bounds along
+	// the axis they are spread the most on, collides the overlapping pairs, groups the touching
+	// bodies into islands and solves the islands on the worker threads. Islands at rest fall asleep
+	// and cost nothing until something touches them.
+	// The body list follows the registry through AddBody/RemoveBody/RefreshBody, see Scene.
+	class LUNARIA_API PhysicsWorld2D
+	{
+	public:
+		// Reads transforms and velocities changed since the last update, takes as many fixed steps
+		// as fit into the time and writes the moved bodies back. Without workers everything is serial.
+		void Update(entt::registry& registry, Timestep timestep, ThreadPool* workers);
+
+		// Applied at the start of the next update
+		void AddBody(entt::entity entity);
+		void RemoveBody(entt::entity entity);
+		void RefreshBody(entt::entity entity); // Colliders changed
+		// Builds everything from the registry again, for changes that bypassed the signals
+		void Invalidate() { m_Invalid = true; }
+
+		const glm::vec2& GetGravity() const { return m_Gravity; }
+		void SetGravity(const glm::vec2& gravity) { m_Gravity = gravity; }
+
+		float GetFixedTimestep() const { return m_FixedTimestep; }
+		void SetFixedTimestep(float timestep);
+
+		uint32_t GetVelocityIterations() const { return m_VelocityIterations; }
+		void SetVelocityIterations(uint32_t iterations) { m_VelocityIterations = std::max(iterations, 1u); }
+
+		uint32_t GetBodyCount() const { return static_cast<uint32_t>(m_Bodies.size()); }
+		// As of the last step
+		uint32_t GetAwakeBodyCount() const { return m_AwakeCount; }
+		uint32_t GetContactCount() const { return static_cast<uint32_t>(m_Contacts.size()); }
+		uint32_t GetIslandCount() const { return static_cast<uint32_t>(m_IslandOffsets.empty() ? 0 : m_IslandOffsets.size() - 1); }
+	private:
+		// Same values as Rigidbody2DComponent::BodyType, Components.hpp can't be included here
+		enum class BodyType : uint8_t { Static = 0, Dynamic, Kinematic };
+		enum class ShapeType : uint8_t { None = 0, Box, Circle };
+
+		struct Body
+		{
+			glm::vec2 Position = { 0.0f, 0.0f };
+			float Angle = 0.0f;
+			glm::vec2 Velocity = { 0.0f, 0.0f };
+			float AngularVelocity = 0.0f;
+			// Pushes bodies apart within a step without the push staying in their velocity
+			glm::vec2 BiasVelocity = { 0.0f, 0.0f };
+			float BiasAngularVelocity = 0.0f;
+
+			float InverseMass = 0.0f, InverseInertia = 0.0f;
+			float GravityScale = 1.0f;
+			float SleepTime = 0.0f;
+
+			// World space size, the offset rotates with the body
+			ShapeType Shape = ShapeType::None;
+			glm::vec2 Offset = { 0.0f, 0.0f };
+			glm::vec2 HalfExtents = { 0.0f, 0.0f }; // Radius in x for circles
+			float Friction = 0.0f, Restitution = 0.0f;
+
+			// Placed by PlaceShape whenever the body moves or changes
+			glm::mat2 Rotation{ 1.0f };
+			glm::vec2 Center = { 0.0f, 0.0f };
+
+			BodyType Type = BodyType::Static;
+			bool FixedRotation = false;
+			bool Awake = true;
+			bool Moved = false; // Since the last write back
+
+			entt::entity Entity = entt::null;
+		};
+
+		struct Bounds
+		{
+			glm::vec2 Min, Max;
+		};
+
+		// Sorted by band, then by Min along the sweep axis. Other is the perpendicular axis the bands
+		// slice, a body is listed once in every band it overlaps.
+		struct SweepEntry
+		{
+			float Min, Max;
+			float OtherMin, OtherMax;
+			uint32_t Body;
+			int32_t Band, FirstBand;
+		};
+
+		struct ContactPoint
+		{
+			glm::vec2 AnchorA, AnchorB; // From the body origins
+			float Separation;
+			float NormalImpulse, TangentImpulse;
+			float NormalMass, TangentMass;
+			float Bias; // Velocity the solver aims for, closes gaps and bounces
+			float PositionBias, BiasImpulse; // Penetration recovery, solved on the bias velocities
+			uint32_t ID; // Features the point came from, matches it with the last step
+		};
+
+		struct Contact
+		{
+			uint32_t BodyA, BodyB;
+			glm::vec2 Normal; // From A to B
+			ContactPoint Points[2];
+			uint32_t PointCount;
+			float Friction, Restitution;
+			// Two points are solved together, one at a time lets stacks sway
+			glm::mat2 BlockMass, InverseBlockMass;
+			bool BlockSolve;
+		};
+
+		// Impulses of the last step, warm starting the solver keeps stacks at rest
+		struct CachedContact
+		{
+			uint64_t Key;
+			uint32_t IDs[2];
+			float NormalImpulses[2], TangentImpulses[2];
+			uint32_t PointCount;
+		};
+
+		void Rebuild(entt::registry& registry);
+		void ApplyChanges(entt::registry& registry);
+		void InsertBody(entt::registry& registry, entt::entity entity);
+		void EraseBody(entt::entity entity);
+		uint32_t FindBody(entt::entity entity) const;
+
+		void ReadBodies(entt::registry& registry, ThreadPool* workers);
+		void WriteBodies(entt::registry& registry, ThreadPool* workers);
+		void BuildBody(Body& body, const entt::registry& registry, const TransformComponent& transform, const Rigidbody2DComponent& rigidbody);
+		void PlaceShape(uint32_t index);
+
+		void Step(float timestep, ThreadPool* workers);
+		void IntegrateVelocities(float timestep, ThreadPool* workers);
+		void FindPairs(ThreadPool* workers);
+		void Collide(ThreadPool* workers);
+		void BuildIslands();
+		void SolveIslands(float timestep, ThreadPool* workers);
+		void PrepareContact(Contact& contact, float inverseTimestep);
+		void SolveContact(Contact& contact);
+		void IntegratePositions(float timestep, ThreadPool* workers);
+		void UpdateSleep(float timestep);
+		void CacheImpulses();
+
+		uint32_t FindRoot(uint32_t body);
+		uint64_t GetContactKey(uint32_t bodyA, uint32_t bodyB) const;
+	private:
+		glm::vec2 m_Gravity = { 0.0f, -9.81f };
+		float m_FixedTimestep = 1.0f / 60.0f;
+		uint32_t m_VelocityIterations = 8;
+		float m_Accumulator = 0.0f;
+
+		std::vector<Body> m_Bodies;
+		std::vector<Bounds> m_Bounds;
+		std::vector<uint32_t> m_BodyIndices; // By entity index
+		uint32_t m_AwakeCount = 0;
+
+		bool m_Invalid = true;
+		std::vector<entt::entity> m_Added, m_Removed, m_Refreshed;
+
+		// Persistent between steps, mostly sorted already so insertion sort is cheap
+		std::vector<SweepEntry> m_Sweep, m_SweepScratch;
+		std::vector<glm::ivec2> m_BodyBands; // First and last band of every body
+		std::vector<uint32_t> m_LargeBodies; // Span too many bands, tested against every body instead
+		std::vector<uint32_t> m_BandOffsets;
+		float m_BandSize = 1.0f;
+		int m_SweepAxis = 0;
+		bool m_SweepDirty = true;
+
+		std::vector<std::vector<std::pair<uint32_t, uint32_t>>> m_ChunkPairs;
+		std::vector<std::pair<uint32_t, uint32_t>> m_Pairs;
+		std::vector<Contact> m_Contacts;
+		std::vector<CachedContact> m_Cache; // Sorted by key
+
+		// Touching dynamic bodies share a root, islands are runs of m_IslandContacts solved independently
+		std::vector<uint32_t> m_Parents;
+		std::vector<uint8_t> m_RootAwake;
+		std::vector<uint32_t> m_RootIslands;
+		std::vector<float> m_RootSleepTimes;
+		std::vector<uint32_t> m_IslandContacts;
+		std::vector<uint32_t> m_IslandOffsets;
+	};
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Buffer.hpp"
+
+namespace Lunaria {
+
+	class NullVertexBuffer final : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer(uint32_t size, BufferUsage usage);
+		~NullVertexBuffer() override;
+
+		void Bind() const override {}
+		void Unbind() const override {}
+
+		const BufferLayout& GetLayout() const override { return m_Layout; }
+		void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+		void SetData(const void* data, uint32_t size) override;
+
+		uint32_t GetSize() const { return m_Size; }
+		BufferUsage GetUsage() const { return m_Usage; }
+	private:
+		uint32_t m_ResourceID;
+		uint32_t m_Size;
+		BufferUsage m_Usage;
+		BufferLayout m_Layout;
+	};
+
+	class NullIndexBuffer final : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(const void* indices, uint32_t count, IndexType type);
+		~NullIndexBuffer() override;
+
+		void Bind() const override {}
+		void Unbind() const override {}
+
+		uint32_t GetCount() const override { return m_Count; }
+		IndexType GetIndexType() const override { return m_Type; }
+	private:
+		uint32_t m_ResourceID;
+		uint32_t m_Count;
+		IndexType m_Type;
+	};
+
+	class NullStorageBuffer final : public StorageBuffer
+	{
+	public:
+		NullStorageBuffer(uint32_t size);
+		~NullStorageBuffer() override;
+
+		void Bind(uint32_t /*binding*/) const override {}
+
+		void SetData(const void* data, uint32_t size, uint32_t offset) override;
+		void GetData(void* data, uint32_t size, uint32_t offset) const override; // Reads zeros
+
+		uint32_t GetSize() const override { return m_Size; }
+	private:
+		uint32_t m_ResourceID;
+		uint32_t m_Size;
+	};
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "LunariaCore/Renderer/GraphicsContext.hpp"
+
+namespace Lunaria {
+
+	class NullContext : public GraphicsContext
+	{
+	public:
+		void Init() override {}
+		void SwapBuffers() override {}
+	};
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+namespace Lunaria {
+
+	enum class NullResourceType
+	{
+		VertexBuffer = 0,
+		IndexBuffer,
+		VertexArray,
+		Texture,
+		Shader,
+		FrameBuffer,
+		StorageBuffer,
+		Count
+	};
+
+	struct NullCommand
+	{
+		enum class Type
+		{
+			Clear = 0,
+			SetViewport,
+			SetClearColor,
+			DrawIndexed,
+			MultiDrawIndexedIndirect,
+			PushDebugGroup,
+			PopDebugGroup,
+			Dispatch,
+			Barrier
+		};
+
+		Type CommandType = Type::Clear;
+
+		// State the command ran with, resource IDs as handed out by NullDevice
+		uint32_t Shader = 0;
+		uint32_t VertexArray = 0;
+		uint32_t FrameBuffer = 0;
+
+		uint32_t Count = 0; // Indices of a draw, draws of a multi-draw, work groups of a dispatch, barrier flags
+		uint32_t InstanceCount = 1;
+	};
+
+	// Stand-in for the GPU of the null backend (RendererAPI::API::None).
+	// Resources only exist as IDs with a byte size, draws are validated against the bound
+	// state and appended to a command log, so the engine's CPU side can run and be measured
+	// without a graphics driver.
+	class LUNARIA_API NullDevice
+	{
+	public:
+		struct MemoryStatistics
+		{
+			std::array<uint32_t, static_cast<size_t>(NullResourceType::Count)> Resources{};
+			std::array<size_t, static_cast<size_t>(NullResourceType::Count)> Bytes{};
+
+			size_t GetTotalBytes() const;
+		};
+
+		static uint32_t CreateResource(NullResourceType type, size_t bytes = 0);
+		static void ResizeResource(uint32_t id, size_t bytes);
+		static void DestroyResource(uint32_t id);
+		static bool IsAlive(uint32_t id, NullResourceType type);
+
+		static void BindShader(uint32_t shader);
+		static void BindVertexArray(uint32_t vertexArray);
+		static void BindFrameBuffer(uint32_t frameBuffer);
+
+		static uint32_t GetBoundShader();
+		static uint32_t GetBoundVertexArray();
+
+		// Fills in the bound state, then appends to the log
+		static void Record(NullCommand command);
+
+		// Logged and counted, tests can fail on a non zero count
+		static void ValidationError(const std::string& message);
+
+		static void SetCommandLogEnabled(bool enabled);
+		static const std::vector<NullCommand>& GetCommands();
+		static void ClearCommands();
+
+		static MemoryStatistics GetMemoryStats();
+		static uint32_t GetValidationErrorCount();
+	};
+
+}
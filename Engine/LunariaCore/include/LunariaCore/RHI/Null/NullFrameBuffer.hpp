@@ -0,0 +1,29 @@
+#pragma once
+
+#include "LunariaCore/Renderer/FrameBuffer.hpp"
+
+namespace Lunaria {
+
+	class NullFrameBuffer final : public FrameBuffer
+	{
+	public:
+		NullFrameBuffer(const FrameBufferSpecification& specification);
+		~NullFrameBuffer() override;
+
+		void Bind() override;
+		void Unbind() override;
+
+		void Resize(uint32_t width, uint32_t height) override;
+
+		void SetRenderSize(uint32_t width, uint32_t height) override;
+		glm::uvec2 GetRenderSize() const override { return m_RenderSize; }
+
+		const FrameBufferSpecification& GetSpecification() const override { return m_Specification; }
+		uint32_t GetColorAttachmentRendererID() const override { return m_ResourceID; }
+	private:
+		uint32_t m_ResourceID;
+		FrameBufferSpecification m_Specification;
+		glm::uvec2 m_RenderSize;
+	};
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "LunariaCore/Renderer/MeshBatch.hpp"
+#include "LunariaCore/Renderer/OffsetAllocator.hpp"
+
+namespace Lunaria {
+
+	// Same packing rules as the OpenGL batch, Flush records one multi-draw
+	class NullMeshBatch final : public MeshBatch
+	{
+	public:
+		NullMeshBatch(const MeshBatchSpecification& specification);
+		~NullMeshBatch() override;
+
+		uint32_t AddMesh(const Ref<VertexArray>& vertexArray) override;
+		void RemoveMesh(uint32_t mesh) override;
+		bool Submit(uint32_t mesh, const glm::mat4& transform) override;
+		void Flush() override;
+
+		uint32_t GetDrawCount() const override { return m_DrawCount; }
+		uint32_t GetMeshCount() const override { return static_cast<uint32_t>(m_Meshes.size() - m_FreeMeshes.size()); }
+		const MeshBatchSpecification& GetSpecification() const override { return m_Specification; }
+	private:
+		MeshBatchSpecification m_Specification;
+		uint32_t m_ResourceID;
+
+		struct MeshRange
+		{
+			OffsetAllocator::Allocation Vertices, Indices; // Invalid once removed
+		};
+
+		OffsetAllocator m_VertexAllocator;
+		OffsetAllocator m_IndexAllocator;
+		std::vector<MeshRange> m_Meshes;
+		std::vector<uint32_t> m_FreeMeshes;
+		uint32_t m_DrawCount = 0;
+
+		std::vector<glm::mat4> m_Transforms; // Kept so the CPU cost matches the real backends
+	};
+
+}
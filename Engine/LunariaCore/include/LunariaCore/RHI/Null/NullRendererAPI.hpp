@@ -0,0 +1,32 @@
+#pragma once
+
+#include "LunariaCore/Renderer/RendererAPI.hpp"
+
+namespace Lunaria {
+
+	class LUNARIA_API NullRendererAPI : public RendererAPI
+	{
+	public:
+		void Init() override;
+
+		void SetViewport(int x, int y, uint32_t width, uint32_t height) override;
+
+		void SetClearColor(const glm::vec4& color) override;
+		void Clear() override;
+
+		void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t instanceCount = 1) override;
+
+		void Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+		void Barrier(uint32_t flags) override;
+
+		void PushDebugGroup(const char* name) override;
+		void PopDebugGroup() override;
+
+		void ResetStateStats() override;
+		StateStatistics GetStateStats() const override;
+	private:
+		uint32_t m_DebugGroupDepth = 0;
+		StateStatistics m_Stats;
+	};
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Shader.hpp"
+
+namespace Lunaria {
+
+	class NullShader final : public Shader
+	{
+	public:
+		NullShader(const std::string& filepath);
+		NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		~NullShader() override;
+
+		void Bind() const override;
+		void Unbind() const override;
+
+		const std::string& GetName() const override { return m_Name; }
+
+		void SetMat4(const std::string& name, const glm::mat4& /*value*/) const override { ValidateUniform(name); }
+		void SetFloat3(const std::string& name, const glm::vec3& /*value*/) const override { ValidateUniform(name); }
+		void SetFloat4(const std::string& name, const glm::vec4& /*value*/) const override { ValidateUniform(name); }
+		void SetFloat(const std::string& name, float /*value*/) const override { ValidateUniform(name); }
+		void SetInt(const std::string& name, int /*value*/) const override { ValidateUniform(name); }
+		void SetIntArray(const std::string& name, int* /*values*/, uint32_t /*count*/) const override { ValidateUniform(name); }
+	private:
+		// Uniforms are set on the bound program, as in the OpenGL backend
+		void ValidateUniform(const std::string& name) const;
+	private:
+		uint32_t m_ResourceID;
+		std::string m_Name;
+	};
+
+}
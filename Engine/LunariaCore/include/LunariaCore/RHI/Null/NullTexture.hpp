@@ -0,0 +1,46 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Texture.hpp"
+#include "LunariaCore/Renderer/TextureStreamer.hpp"
+
+namespace Lunaria {
+
+	class NullTexture2D final : public Texture2D
+	{
+	public:
+		// Only the image header is read, for the size
+		NullTexture2D(const std::string& path, const TextureSpecification& specification);
+		NullTexture2D(uint32_t width, uint32_t height, const TextureSpecification& specification);
+		~NullTexture2D() override;
+
+		uint32_t GetWidth() const override { return m_Width; }
+		uint32_t GetHeight() const override { return m_Height; }
+		uint32_t GetRendererID() const override { return m_ResourceID; }
+
+		bool IsLoaded() const override { return true; }
+
+		const TextureSpecification& GetSpecification() const override { return m_Specification; }
+
+		void SetData(void* data, uint32_t size) override;
+		void Bind(uint32_t slot) const override;
+
+		bool operator==(const Texture2D& other) const override { return m_ResourceID == other.GetRendererID(); }
+	private:
+		uint32_t m_ResourceID = 0;
+		uint32_t m_Width = 1, m_Height = 1;
+		TextureSpecification m_Specification;
+	};
+
+	// Nothing to stream, textures are complete right away
+	class NullTextureStreamer final : public TextureStreamer
+	{
+	public:
+		Ref<Texture2D> Load(const std::string& path, const TextureSpecification& specification) override;
+		void Update() override {}
+
+		Statistics GetStats() const override { return m_Stats; }
+	private:
+		Statistics m_Stats;
+	};
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "LunariaCore/Renderer/TimerQuery.hpp"
+
+namespace Lunaria {
+
+	// Every query completes instantly and reports no GPU time
+	class NullTimerQueryPool final : public TimerQueryPool
+	{
+	public:
+		NullTimerQueryPool(uint32_t count) : m_Count(count) {}
+
+		void WriteTimestamp([[maybe_unused]] uint32_t query) override { LU_CORE_ASSERT(query < m_Count, "Query index out of range!"); }
+
+		bool IsResultAvailable(uint32_t /*query*/) const override { return true; }
+		uint64_t GetResultNanoseconds(uint32_t /*query*/) const override { return 0; }
+
+		uint32_t GetCount() const override { return m_Count; }
+	private:
+		uint32_t m_Count;
+	};
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "LunariaCore/Renderer/VertexArray.hpp"
+
+namespace Lunaria {
+
+	class NullVertexArray final : public VertexArray
+	{
+	public:
+		NullVertexArray();
+		~NullVertexArray() override;
+
+		void Bind() const override;
+		void Unbind() const override;
+
+		void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+		void SetVertexBuffer(uint32_t index, const Ref<VertexBuffer>& vertexBuffer) override;
+		void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override;
+
+		const std::vector<Ref<VertexBuffer>> GetVertexBuffers() const override { return m_VertexBuffers; }
+		const Ref<IndexBuffer> GetIndexBuffer() const override { return m_IndexBuffer; }
+	private:
+		uint32_t m_ResourceID;
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+	};
+
+}
@@ -1,14 +1,54 @@
 #pragma once
 
 #include "LunariaCore/Renderer/Buffer.hpp"
+#include "LunariaCore/Renderer/BufferArena.hpp"
+#include "LunariaCore/Renderer/OffsetAllocator.hpp"
+
+#include <mutex>
 
 namespace Lunaria {
 
+	// Shared buffers of an OpenGLBufferArena, kept alive by every range handed out from them.
+	// Only used on the thread owning the context, the mutex guards the statistics.
+	class OpenGLBufferPool
+	{
+	public:
+		struct Range
+		{
+			uint32_t Block = 0;
+			uint32_t RendererID = 0;
+			OffsetAllocator::Allocation Allocation;
+		};
+
+		OpenGLBufferPool(const BufferArenaSpecification& specification);
+		~OpenGLBufferPool();
+
+		Range Allocate(uint32_t size);
+		void Free(const Range& range);
+
+		BufferArena::Statistics GetStats() const;
+		BufferUsage GetUsage() const { return m_Specification.Usage; }
+	private:
+		struct Block
+		{
+			uint32_t RendererID = 0;
+			OffsetAllocator Allocator;
+		};
+
+		BufferArenaSpecification m_Specification;
+
+		// Blocks are kept for reuse once empty
+		std::vector<Block> m_Blocks;
+		uint32_t m_Allocations = 0;
+		mutable std::mutex m_Mutex;
+	};
+
 	class OpenGLVertexBuffer final : public VertexBuffer
 	{
 	public:
-		OpenGLVertexBuffer(uint32_t size);
-		OpenGLVertexBuffer(float* vertices, uint32_t size);
+		OpenGLVertexBuffer(uint32_t size, BufferUsage usage = BufferUsage::Dynamic);
+		OpenGLVertexBuffer(const float* vertices, uint32_t size, BufferUsage usage = BufferUsage::Static);
+		OpenGLVertexBuffer(const Ref<OpenGLBufferPool>& pool, const void* vertices, uint32_t size);
 		~OpenGLVertexBuffer() override;
 
 		void Bind() const override;
@@ -18,24 +58,64 @@ namespace Lunaria {
 		void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
 		void SetData(const void* data, uint32_t size) override;
 
+		uint32_t GetRendererID() const { return m_RendererID; }
+		uint32_t GetOffset() const { return m_Offset; } // Start of the contents in a shared buffer
+		uint32_t GetSize() const { return m_Size; }
+		BufferUsage GetUsage() const { return m_Usage; }
 	private:
 		uint32_t m_RendererID;
+		uint32_t m_Offset = 0;
+		uint32_t m_Size;
+		BufferUsage m_Usage;
 		BufferLayout m_Layout;
+
+		Ref<OpenGLBufferPool> m_Pool;
+		OpenGLBufferPool::Range m_Range;
 	};
 
 	class OpenGLIndexBuffer final : public IndexBuffer
 	{
 	public:
-		OpenGLIndexBuffer(uint32_t* indices, uint32_t count);
+		OpenGLIndexBuffer(const void* indices, uint32_t count, IndexType type, BufferUsage usage = BufferUsage::Static);
+		OpenGLIndexBuffer(const Ref<OpenGLBufferPool>& pool, const void* indices, uint32_t count, IndexType type);
 		~OpenGLIndexBuffer() override;
 
 		void Bind() const override;
 		void Unbind() const override;
 
 		uint32_t GetCount() const override { return m_Count; }
+		IndexType GetIndexType() const override { return m_Type; }
+
+		uint32_t GetRendererID() const { return m_RendererID; }
+		uint32_t GetOffset() const { return m_Offset; }
+		uint32_t GetOpenGLIndexType() const;
 	private:
 		uint32_t m_RendererID;
+		uint32_t m_Offset = 0;
 		uint32_t m_Count;
+		IndexType m_Type;
+
+		Ref<OpenGLBufferPool> m_Pool;
+		OpenGLBufferPool::Range m_Range;
+	};
+
+	class OpenGLStorageBuffer final : public StorageBuffer
+	{
+	public:
+		OpenGLStorageBuffer(const void* data, uint32_t size, BufferUsage usage);
+		~OpenGLStorageBuffer() override;
+
+		void Bind(uint32_t binding) const override;
+
+		void SetData(const void* data, uint32_t size, uint32_t offset) override;
+		void GetData(void* data, uint32_t size, uint32_t offset) const override;
+
+		uint32_t GetSize() const override { return m_Size; }
+
+		uint32_t GetRendererID() const { return m_RendererID; }
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Size;
 	};
 
 }
\ No newline at end of file
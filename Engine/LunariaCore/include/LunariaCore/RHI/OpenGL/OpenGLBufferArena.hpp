@@ -0,0 +1,22 @@
+#pragma once
+
+#include "LunariaCore/RHI/OpenGL/OpenGLBuffer.hpp"
+
+namespace Lunaria {
+
+	class OpenGLBufferArena final : public BufferArena
+	{
+	public:
+		OpenGLBufferArena(const BufferArenaSpecification& specification);
+
+		Ref<VertexBuffer> CreateVertexBuffer(const void* vertices, uint32_t size) override;
+		Ref<IndexBuffer> CreateIndexBuffer(const void* indices, uint32_t count, IndexType type) override;
+
+		Statistics GetStats() const override { return m_Pool->GetStats(); }
+		const BufferArenaSpecification& GetSpecification() const override { return m_Specification; }
+	private:
+		BufferArenaSpecification m_Specification;
+		Ref<OpenGLBufferPool> m_Pool;
+	};
+
+}
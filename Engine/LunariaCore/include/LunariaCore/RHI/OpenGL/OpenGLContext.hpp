@@ -13,7 +13,11 @@ namespace Lunaria {
 
 		void Init() override;
 		void SwapBuffers() override;
+
+		void MakeCurrent() override;
+		void ReleaseCurrent() override;
 	private:
 		SDL_Window* m_WindowHandle;
+		void* m_Context = nullptr; // SDL_GLContext
 	};
 }
@@ -18,6 +18,9 @@ namespace Lunaria {
 		void Unbind() override;
 		void Resize(uint32_t width, uint32_t height) override;
 
+		void SetRenderSize(uint32_t width, uint32_t height) override;
+		glm::uvec2 GetRenderSize() const override { return m_RenderSize; }
+
 		const FrameBufferSpecification& GetSpecification() const override { return m_Specification; }
 		uint32_t GetColorAttachmentRendererID() const override { return m_ColorAttachment; }
 
@@ -28,6 +31,7 @@ namespace Lunaria {
 		uint32_t m_ColorAttachment = 0;
 		uint32_t m_DepthAttachment = 0;
 		FrameBufferSpecification m_Specification;
+		glm::uvec2 m_RenderSize;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "LunariaCore/Renderer/GpuFence.hpp"
+
+namespace Lunaria {
+
+	class OpenGLGpuFence final : public GpuFence
+	{
+	public:
+		OpenGLGpuFence() = default;
+		OpenGLGpuFence(const OpenGLGpuFence&) = delete;
+		OpenGLGpuFence& operator=(const OpenGLGpuFence&) = delete;
+		~OpenGLGpuFence() override;
+
+		void Signal() override;
+
+		bool IsSignaled() const override;
+		bool Wait(uint64_t timeoutNanoseconds) override;
+
+		float GetLastWaitMilliseconds() const override { return m_LastWaitMilliseconds; }
+	private:
+		void* m_Sync = nullptr; // GLsync, replaced by every Signal
+		float m_LastWaitMilliseconds = 0.0f;
+	};
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "LunariaCore/Renderer/MeshBatch.hpp"
+#include "LunariaCore/Renderer/OffsetAllocator.hpp"
+
+namespace Lunaria {
+
+	class OpenGLMeshBatch final : public MeshBatch
+	{
+	public:
+		OpenGLMeshBatch(const MeshBatchSpecification& specification);
+		~OpenGLMeshBatch() override;
+
+		uint32_t AddMesh(const Ref<VertexArray>& vertexArray) override;
+		void RemoveMesh(uint32_t mesh) override;
+		bool Submit(uint32_t mesh, const glm::mat4& transform) override;
+		void Flush() override;
+
+		uint32_t GetDrawCount() const override { return static_cast<uint32_t>(m_Commands.size()); }
+		uint32_t GetMeshCount() const override { return static_cast<uint32_t>(m_Meshes.size() - m_FreeMeshes.size()); }
+		const MeshBatchSpecification& GetSpecification() const override { return m_Specification; }
+	private:
+		// Matches the layout glMultiDrawElementsIndirect expects
+		struct DrawElementsIndirectCommand
+		{
+			uint32_t Count;
+			uint32_t InstanceCount;
+			uint32_t FirstIndex;
+			int32_t BaseVertex;
+			uint32_t BaseInstance;
+		};
+
+		struct MeshRange
+		{
+			uint32_t IndexCount;
+			uint32_t FirstIndex;
+			int32_t BaseVertex;
+
+			// In vertices and indices, invalid once removed
+			OffsetAllocator::Allocation Vertices, Indices;
+		};
+
+		MeshBatchSpecification m_Specification;
+
+		Ref<VertexArray> m_VertexArray;
+		Ref<VertexBuffer> m_VertexArena;
+		Ref<IndexBuffer> m_IndexArena;
+
+		// One region of m_RegionDraws per frame in flight, persistently mapped. A frame only writes its own
+		// region, FrameSync makes sure the GPU is done with it
+		uint32_t m_TransformBuffer = 0;
+		uint32_t m_IndirectBuffer = 0;
+		glm::mat4* m_TransformMemory = nullptr;
+		DrawElementsIndirectCommand* m_CommandMemory = nullptr;
+		uint32_t m_RegionCount = 0;
+		uint32_t m_RegionDraws = 0; // MaxDraws rounded up to the alignment
+		uint32_t m_TransformAlignment = 1; // GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, in transforms
+
+		// Draws already written to the region of the current frame, by earlier flushes
+		uint64_t m_RegionFrame = 0;
+		uint32_t m_RegionCursor = 0;
+
+		OffsetAllocator m_VertexAllocator;
+		OffsetAllocator m_IndexAllocator;
+
+		std::vector<MeshRange> m_Meshes;
+		std::vector<uint32_t> m_FreeMeshes;
+		std::vector<DrawElementsIndirectCommand> m_Commands;
+		std::vector<glm::mat4> m_Transforms;
+	};
+
+}
@@ -14,7 +14,16 @@ namespace Lunaria {
 		void SetClearColor(const glm::vec4& color) override;
 		void Clear() override;
 
-		void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t instanceCount = 1) override;
+
+		void Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+		void Barrier(uint32_t flags) override;
+
+		void PushDebugGroup(const char* name) override;
+		void PopDebugGroup() override;
+
+		void ResetStateStats() override;
+		StateStatistics GetStateStats() const override;
 	};
 
 }
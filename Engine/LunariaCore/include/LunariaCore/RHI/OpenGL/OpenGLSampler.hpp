@@ -0,0 +1,32 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Texture.hpp"
+
+#include <glad/glad.h>
+
+namespace Lunaria {
+
+	// Sampling state shared by every texture with the same filtering, wrap mode and anisotropy
+	class OpenGLSampler
+	{
+	public:
+		OpenGLSampler(const TextureSpecification& specification);
+		~OpenGLSampler();
+
+		OpenGLSampler(const OpenGLSampler&) = delete;
+		OpenGLSampler& operator=(const OpenGLSampler&) = delete;
+
+		uint32_t GetRendererID() const { return m_RendererID; }
+
+		// Returns the existing sampler for this state or creates one, it lives as long as a texture uses it
+		static Ref<OpenGLSampler> Get(const TextureSpecification& specification);
+
+		static GLenum MinFilterToGL(const TextureSpecification& specification);
+		static GLenum MagFilterToGL(const TextureSpecification& specification);
+		static GLenum WrapToGL(TextureWrap wrap);
+		static float ClampAnisotropy(float anisotropy);
+	private:
+		uint32_t m_RendererID = 0;
+	};
+
+}
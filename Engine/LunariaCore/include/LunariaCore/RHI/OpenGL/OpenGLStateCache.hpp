@@ -0,0 +1,51 @@
+#pragma once
+
+#include "LunariaCore/Renderer/RendererAPI.hpp"
+
+#include <glad/glad.h>
+
+namespace Lunaria {
+
+	// Shadow copy of the GL context state that the RHI touches.
+	// Every state change in the OpenGL backend goes through here, calls that would not
+	// change anything are skipped. Anything that changes state behind our back
+	// (external libraries, context switches) must call Invalidate().
+	class LUNARIA_API OpenGLStateCache
+	{
+	public:
+		static constexpr uint32_t MaxTextureUnits = 32;
+
+		// Forget everything, the next call of each kind is always issued
+		static void Invalidate();
+
+		static void UseProgram(uint32_t program);
+		static void BindVertexArray(uint32_t vertexArray);
+		static void BindBuffer(GLenum target, uint32_t buffer);
+		static void BindBufferBase(GLenum target, uint32_t index, uint32_t buffer);
+		static void BindBufferRange(GLenum target, uint32_t index, uint32_t buffer, GLintptr offset, GLsizeiptr size);
+		static void BindTextureUnit(uint32_t unit, uint32_t texture);
+		static void BindSampler(uint32_t unit, uint32_t sampler);
+		static void BindFramebuffer(uint32_t framebuffer);
+
+		static void SetCapability(GLenum capability, bool enabled);
+		static void BlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+		static void DepthMask(bool enabled);
+		static void Viewport(int x, int y, uint32_t width, uint32_t height);
+		static void ClearColor(const glm::vec4& color);
+
+		// GL silently rebinds to 0 when a bound object is deleted, keep the cache in sync
+		static void OnProgramDeleted(uint32_t program);
+		static void OnVertexArrayDeleted(uint32_t vertexArray);
+		static void OnBufferDeleted(uint32_t buffer);
+		static void OnTextureDeleted(uint32_t texture);
+		static void OnSamplerDeleted(uint32_t sampler);
+		static void OnFramebufferDeleted(uint32_t framebuffer);
+
+		// Direct state access edits of a bound vertex array change the element array binding
+		static void OnElementBufferChanged(uint32_t vertexArray);
+
+		static void ResetStats();
+		static RendererAPI::StateStatistics GetStats();
+	};
+
+}
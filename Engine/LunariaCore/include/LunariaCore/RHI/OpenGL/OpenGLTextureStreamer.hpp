@@ -0,0 +1,75 @@
+#pragma once
+
+#include "LunariaCore/Renderer/TextureStreamer.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLTexure.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLGpuFence.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Lunaria {
+
+	class OpenGLTextureStreamer final : public TextureStreamer
+	{
+	public:
+		OpenGLTextureStreamer(const TextureStreamerSpecification& specification);
+		~OpenGLTextureStreamer() override;
+
+		Ref<Texture2D> Load(const std::string& path, const TextureSpecification& specification) override;
+		void Update() override;
+
+		Statistics GetStats() const override;
+	private:
+		struct DecodeRequest
+		{
+			std::weak_ptr<OpenGLTexture2D> Texture;
+			std::string Path;
+		};
+
+		struct DecodedImage
+		{
+			std::weak_ptr<OpenGLTexture2D> Texture;
+			std::unique_ptr<uint8_t, void(*)(void*)> Pixels{ nullptr, nullptr };
+			uint32_t Width = 0, Height = 0;
+			uint32_t UploadedRows = 0;
+		};
+
+		// One region of the staging ring per frame, reused once its fence has signaled
+		struct StagingRegion
+		{
+			OpenGLGpuFence Fence; // Signaled after the uploads reading the region
+		};
+
+		static constexpr uint32_t RegionCount = 3;
+
+		void WorkerLoop();
+	private:
+		TextureStreamerSpecification m_Specification;
+
+		Ref<OpenGLTexture2D> m_Placeholder;
+
+		uint32_t m_StagingBuffer = 0;
+		uint8_t* m_StagingMemory = nullptr;
+		uint32_t m_RegionSize = 0;
+		std::array<StagingRegion, RegionCount> m_Regions;
+		uint32_t m_RegionIndex = 0;
+
+		std::vector<std::thread> m_Workers;
+		mutable std::mutex m_Mutex;
+		std::condition_variable m_WorkAvailable;
+		bool m_Running = true;
+
+		// Guarded by m_Mutex
+		std::deque<DecodeRequest> m_DecodeQueue;
+		std::deque<DecodedImage> m_UploadQueue;
+		uint32_t m_FailedTextures = 0;
+
+		// Render thread only
+		std::deque<DecodedImage> m_Uploading;
+		uint32_t m_UploadedBytes = 0;
+		uint32_t m_LoadedTextures = 0;
+	};
+
+}
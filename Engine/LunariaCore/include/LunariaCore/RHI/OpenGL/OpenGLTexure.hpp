@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "LunariaCore/Renderer/Texture.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLSampler.hpp"
 
 #include "LunariaCore/UI/UI.hpp"
 
@@ -11,14 +12,21 @@ namespace Lunaria {
     class LUNARIA_API OpenGLTexture2D : public Texture2D
     {
     public:
-        OpenGLTexture2D(const std::string& path);
-        OpenGLTexture2D(uint32_t width, uint32_t height);
+        OpenGLTexture2D(const std::string& path, const TextureSpecification& specification);
+        OpenGLTexture2D(uint32_t width, uint32_t height, const TextureSpecification& specification);
+
+        // Streamed texture, shows the placeholder (and reports its size) until FinishStreaming
+        OpenGLTexture2D(const std::string& path, const TextureSpecification& specification, const OpenGLTexture2D& placeholder);
         ~OpenGLTexture2D() override;
         
         uint32_t GetWidth() const override { return m_Width; }
         uint32_t GetHeight() const override { return m_Height; }
         uint32_t GetRendererID() const override { return m_RendererID; }
 
+        bool IsLoaded() const override { return m_Loaded; }
+
+        const TextureSpecification& GetSpecification() const override { return m_Specification; }
+
         void SetData(void* data, uint32_t size) override;
         void Bind(uint32_t slot) const override;
 
@@ -30,12 +38,32 @@ namespace Lunaria {
 
         GLenum ImageFormatToGL(UI::ImageFormat format) const;
 
+        const std::string& GetPath() const { return m_Path; }
+
+        // Streaming, the storage is filled in slices and swapped in once complete
+        void AllocateStreamingStorage(uint32_t width, uint32_t height);
+        uint32_t GetStreamingRendererID() const { return m_StreamingRendererID; }
+        void FinishStreaming();
+
+    private:
+        // KTX2/DDS, see CompressedTextureLoader
+        void LoadContainer();
+
+        uint32_t CreateStorage(uint32_t width, uint32_t height) const;
+        uint32_t CreateStorage(uint32_t width, uint32_t height, uint32_t levels) const;
+        void GenerateMips(uint32_t rendererID) const;
     private:
         std::string m_Path;
+        TextureSpecification m_Specification;
+        Ref<OpenGLSampler> m_Sampler;
         
         uint32_t m_Width, m_Height;
         uint32_t m_RendererID;
         GLenum m_DataFormat = 0, m_InternalFormat = 0;
+
+        uint32_t m_StreamingRendererID = 0;
+        uint32_t m_StreamingWidth = 0, m_StreamingHeight = 0;
+        bool m_Loaded = true;
     };
     
 }
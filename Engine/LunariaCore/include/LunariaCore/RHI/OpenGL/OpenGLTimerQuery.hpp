@@ -0,0 +1,23 @@
+#pragma once
+
+#include "LunariaCore/Renderer/TimerQuery.hpp"
+
+namespace Lunaria {
+
+	class OpenGLTimerQueryPool final : public TimerQueryPool
+	{
+	public:
+		OpenGLTimerQueryPool(uint32_t count);
+		~OpenGLTimerQueryPool() override;
+
+		void WriteTimestamp(uint32_t query) override;
+
+		bool IsResultAvailable(uint32_t query) const override;
+		uint64_t GetResultNanoseconds(uint32_t query) const override;
+
+		uint32_t GetCount() const override { return static_cast<uint32_t>(m_Queries.size()); }
+	private:
+		std::vector<uint32_t> m_Queries;
+	};
+
+}
@@ -14,13 +14,14 @@ namespace Lunaria {
 		void Unbind() const override;
 
 		void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+		void SetVertexBuffer(uint32_t index, const Ref<VertexBuffer>& vertexBuffer) override;
 		void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override;
 
 		const std::vector<Ref<VertexBuffer>> GetVertexBuffers() const override { return m_VertexBuffers; }
 		const Ref<IndexBuffer> GetIndexBuffer() const override { return m_IndexBuffer; }
 	private:
 		uint32_t m_RendererID;
-		uint32_t m_VertexBufferIndexOffset = 0;
+		uint32_t m_VertexBufferIndexOffset = 0; // First attribute location of the next buffer
 
 		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
 		Ref<IndexBuffer> m_IndexBuffer;
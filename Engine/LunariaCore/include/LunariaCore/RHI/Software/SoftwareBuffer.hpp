@@ -0,0 +1,60 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Buffer.hpp"
+
+namespace Lunaria {
+
+	class SoftwareVertexBuffer final : public VertexBuffer
+	{
+	public:
+		SoftwareVertexBuffer(uint32_t size);
+		SoftwareVertexBuffer(const float* vertices, uint32_t size);
+
+		void Bind() const override {}
+		void Unbind() const override {}
+
+		const BufferLayout& GetLayout() const override { return m_Layout; }
+		void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+		void SetData(const void* data, uint32_t size) override;
+
+		const std::vector<uint8_t>& GetData() const { return m_Data; }
+	private:
+		std::vector<uint8_t> m_Data;
+		BufferLayout m_Layout;
+	};
+
+	class SoftwareIndexBuffer final : public IndexBuffer
+	{
+	public:
+		SoftwareIndexBuffer(const void* indices, uint32_t count, IndexType type);
+
+		void Bind() const override {}
+		void Unbind() const override {}
+
+		uint32_t GetCount() const override { return static_cast<uint32_t>(m_Indices.size()); }
+		IndexType GetIndexType() const override { return m_Type; }
+
+		// Always 32-bit, 16-bit indices are widened once so the rasterizer reads a single format
+		const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+	private:
+		std::vector<uint32_t> m_Indices;
+		IndexType m_Type;
+	};
+
+	// Plain memory, compute dispatches are not supported by the software backend
+	class SoftwareStorageBuffer final : public StorageBuffer
+	{
+	public:
+		SoftwareStorageBuffer(const void* data, uint32_t size);
+
+		void Bind(uint32_t /*binding*/) const override {}
+
+		void SetData(const void* data, uint32_t size, uint32_t offset) override;
+		void GetData(void* data, uint32_t size, uint32_t offset) const override;
+
+		uint32_t GetSize() const override { return static_cast<uint32_t>(m_Data.size()); }
+	private:
+		std::vector<uint8_t> m_Data;
+	};
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "LunariaCore/Renderer/GraphicsContext.hpp"
+
+struct SDL_Window;
+
+namespace Lunaria {
+
+	// Presents the software default target through the SDL window surface
+	class SoftwareContext : public GraphicsContext
+	{
+	public:
+		SoftwareContext(SDL_Window* windowHandle);
+
+		void Init() override;
+		void SwapBuffers() override;
+	private:
+		SDL_Window* m_WindowHandle;
+		std::vector<uint32_t> m_Flipped;
+	};
+
+}
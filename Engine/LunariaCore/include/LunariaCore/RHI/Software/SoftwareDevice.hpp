@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "LunariaCore/Core/ThreadPool.hpp"
+
+namespace Lunaria {
+
+	class SoftwareTexture2D;
+	class SoftwareShader;
+	class SoftwareVertexArray;
+
+	// Color and depth in plain memory. Rows are stored bottom up like a GL framebuffer,
+	// so pixel (0, 0) is the lower left corner and reads match glReadPixels.
+	struct SoftwareRenderTarget
+	{
+		uint32_t Width = 0, Height = 0;
+		std::vector<uint32_t> Color; // RGBA8, R in the lowest byte
+		std::vector<float> Depth;
+
+		void Resize(uint32_t width, uint32_t height);
+		uint32_t GetPixel(uint32_t x, uint32_t y) const { return Color[static_cast<size_t>(y) * Width + x]; }
+	};
+
+	// Pipeline state of the software backend (RendererAPI::API::Software), mirrors what
+	// the OpenGL backend keeps in the GL context
+	class LUNARIA_API SoftwareDevice
+	{
+	public:
+		static constexpr uint32_t MaxTextureUnits = 32;
+
+		struct PipelineState
+		{
+			const SoftwareShader* Shader = nullptr;
+			SoftwareRenderTarget* Target = nullptr; // Never null while initialized, the default target when no framebuffer is bound
+			std::array<const SoftwareTexture2D*, MaxTextureUnits> Textures{};
+
+			int ViewportX = 0, ViewportY = 0;
+			uint32_t ViewportWidth = 0, ViewportHeight = 0;
+
+			glm::vec4 ClearColor = glm::vec4(0.0f);
+			bool Blend = false;
+			bool DepthTest = false;
+		};
+
+		static void Init();
+		static void Shutdown();
+
+		static PipelineState& GetState();
+		static ThreadPool& GetThreadPool();
+
+		// Window surface, resized with the viewport while it is bound
+		static SoftwareRenderTarget& GetDefaultTarget();
+		static void BindTarget(SoftwareRenderTarget* target); // nullptr binds the default target
+
+		static uint32_t AllocateID();
+	};
+
+}
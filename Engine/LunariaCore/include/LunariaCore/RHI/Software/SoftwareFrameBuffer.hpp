@@ -0,0 +1,36 @@
+#pragma once
+
+#include "LunariaCore/Renderer/FrameBuffer.hpp"
+#include "LunariaCore/RHI/Software/SoftwareDevice.hpp"
+
+namespace Lunaria {
+
+	// Multisampling is ignored, the target always has one sample
+	class SoftwareFrameBuffer final : public FrameBuffer
+	{
+	public:
+		SoftwareFrameBuffer(const FrameBufferSpecification& specification);
+		~SoftwareFrameBuffer() override;
+
+		void Bind() override;
+		void Unbind() override;
+
+		void Resize(uint32_t width, uint32_t height) override;
+
+		void SetRenderSize(uint32_t width, uint32_t height) override;
+		glm::uvec2 GetRenderSize() const override { return m_RenderSize; }
+
+		const FrameBufferSpecification& GetSpecification() const override { return m_Specification; }
+
+		// Not a texture any backend can sample, read the pixels through GetTarget
+		uint32_t GetColorAttachmentRendererID() const override { return m_RendererID; }
+
+		const SoftwareRenderTarget& GetTarget() const { return m_Target; }
+	private:
+		uint32_t m_RendererID;
+		FrameBufferSpecification m_Specification;
+		glm::uvec2 m_RenderSize;
+		SoftwareRenderTarget m_Target;
+	};
+
+}
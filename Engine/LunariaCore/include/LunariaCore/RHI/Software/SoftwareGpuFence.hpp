@@ -0,0 +1,19 @@
+#pragma once
+
+#include "LunariaCore/Renderer/GpuFence.hpp"
+
+namespace Lunaria {
+
+	// Draws finish before they return, so everything before Signal is already done
+	class SoftwareGpuFence final : public GpuFence
+	{
+	public:
+		void Signal() override {}
+
+		bool IsSignaled() const override { return true; }
+		bool Wait(uint64_t /*timeoutNanoseconds*/) override { return true; }
+
+		float GetLastWaitMilliseconds() const override { return 0.0f; }
+	};
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "LunariaCore/RHI/Software/SoftwareDevice.hpp"
+
+namespace Lunaria {
+
+	// Tile based triangle rasterizer behind SoftwareRendererAPI.
+	//
+	// A draw shades its vertices in parallel, sets up and bins the triangles into
+	// TileSize x TileSize screen tiles, then shades the tiles in parallel. Each tile
+	// is owned by one thread and walks its triangles in submission order, so blending
+	// and depth testing give the same result as a serial renderer without any locking.
+	class SoftwareRasterizer
+	{
+	public:
+		static constexpr uint32_t TileSize = 64;
+
+		struct Statistics
+		{
+			uint32_t Triangles = 0;		// Submitted
+			uint32_t Rejected = 0;		// Degenerate, behind the camera or off screen
+			uint64_t Fragments = 0;		// Passed the coverage test
+		};
+
+		// Uses the shader, textures, target and fixed function state bound in SoftwareDevice
+		static void DrawIndexed(const SoftwareVertexArray& vertexArray, uint32_t indexCount);
+
+		// Whole target, as glClear without a scissor
+		static void Clear(SoftwareRenderTarget& target, const glm::vec4& color);
+
+		static const Statistics& GetStats();
+		static void ResetStats();
+	};
+
+}
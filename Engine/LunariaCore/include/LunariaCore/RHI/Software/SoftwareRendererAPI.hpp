@@ -0,0 +1,35 @@
+#pragma once
+
+#include "LunariaCore/Renderer/RendererAPI.hpp"
+
+namespace Lunaria {
+
+	class LUNARIA_API SoftwareRendererAPI : public RendererAPI
+	{
+	public:
+		~SoftwareRendererAPI() override;
+
+		void Init() override;
+
+		void SetViewport(int x, int y, uint32_t width, uint32_t height) override;
+
+		void SetClearColor(const glm::vec4& color) override;
+		void Clear() override;
+
+		void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t instanceCount = 1) override;
+
+		// Nothing to debug with external tools
+		// Storage buffers are plain memory, there is nothing to order
+		void Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+		void Barrier(uint32_t /*flags*/) override {}
+
+		void PushDebugGroup(const char* /*name*/) override {}
+		void PopDebugGroup() override {}
+
+		void ResetStateStats() override;
+		StateStatistics GetStateStats() const override;
+	private:
+		StateStatistics m_Stats;
+	};
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Shader.hpp"
+#include "LunariaCore/Renderer/Buffer.hpp"
+#include "LunariaCore/RHI/Software/SoftwareDevice.hpp"
+
+namespace Lunaria {
+
+	// Uniform values of one shader, set through the Shader interface
+	struct SoftwareUniforms
+	{
+		std::unordered_map<std::string, glm::mat4> Mat4s;
+		std::unordered_map<std::string, glm::vec4> Float4s; // Float3 is stored with w = 0
+		std::unordered_map<std::string, float> Floats;
+		std::unordered_map<std::string, int> Ints;
+		std::unordered_map<std::string, std::vector<int>> IntArrays;
+
+		glm::mat4 GetMat4(const std::string& name, const glm::mat4& fallback = glm::mat4(1.0f)) const;
+		glm::vec4 GetFloat4(const std::string& name, const glm::vec4& fallback = glm::vec4(0.0f)) const;
+	};
+
+	using SoftwareTextureUnits = std::array<const SoftwareTexture2D*, SoftwareDevice::MaxTextureUnits>;
+
+	// C++ stand-in for a GLSL program. GLSL sources are not compiled, each shader is mapped
+	// by name to a registered program that reproduces it.
+	class SoftwareProgram
+	{
+	public:
+		static constexpr uint32_t MaxVaryings = 16;
+
+		virtual ~SoftwareProgram() = default;
+
+		virtual uint32_t GetVaryingCount() const = 0;
+
+		// Once per draw before any vertex is shaded, cache uniforms and attribute offsets here
+		virtual void Prepare(const SoftwareUniforms& uniforms, const BufferLayout& layout) = 0;
+
+		// Called from several threads at once. Returns the clip space position.
+		virtual glm::vec4 ShadeVertex(const uint8_t* vertex, float* varyings) const = 0;
+
+		// Called from several threads at once. Returns false to discard the fragment.
+		virtual bool ShadeFragment(const float* varyings, const SoftwareTextureUnits& textures, glm::vec4& color) const = 0;
+	protected:
+		// Attribute 'location' of the layout, missing components read as (0, 0, 0, 1)
+		static glm::vec4 ReadAttribute(const uint8_t* vertex, const BufferLayout& layout, uint32_t location);
+	};
+
+	class SoftwareShader final : public Shader
+	{
+	public:
+		using ProgramFactory = std::function<Scope<SoftwareProgram>()>;
+
+		SoftwareShader(const std::string& filepath);
+		SoftwareShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+
+		void Bind() const override;
+		void Unbind() const override;
+
+		const std::string& GetName() const override { return m_Name; }
+
+		void SetMat4(const std::string& name, const glm::mat4& value) const override { m_Uniforms.Mat4s[name] = value; }
+		void SetFloat3(const std::string& name, const glm::vec3& value) const override { m_Uniforms.Float4s[name] = glm::vec4(value, 0.0f); }
+		void SetFloat4(const std::string& name, const glm::vec4& value) const override { m_Uniforms.Float4s[name] = value; }
+		void SetFloat(const std::string& name, float value) const override { m_Uniforms.Floats[name] = value; }
+		void SetInt(const std::string& name, int value) const override { m_Uniforms.Ints[name] = value; }
+		void SetIntArray(const std::string& name, int* values, uint32_t count) const override;
+
+		SoftwareProgram& GetProgram() const { return *m_Program; }
+		const SoftwareUniforms& GetUniforms() const { return m_Uniforms; }
+
+		// Shaders named 'name' use programs made by 'factory', the built-in programs
+		// are "Texture" and "FlatColor"
+		static void RegisterProgram(const std::string& name, const ProgramFactory& factory);
+	private:
+		std::string m_Name;
+		Scope<SoftwareProgram> m_Program;
+
+		// Uniforms can be set on a const shader, as with a GL program object
+		mutable SoftwareUniforms m_Uniforms;
+	};
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Texture.hpp"
+#include "LunariaCore/Renderer/TextureStreamer.hpp"
+
+#include <glm/glm.hpp>
+
+namespace Lunaria {
+
+	// RGBA8 texels in memory, only the base level is kept: minification uses MinFilter
+	// on level 0, there is no mip selection
+	class SoftwareTexture2D final : public Texture2D
+	{
+	public:
+		SoftwareTexture2D(const std::string& path, const TextureSpecification& specification);
+		SoftwareTexture2D(uint32_t width, uint32_t height, const TextureSpecification& specification);
+
+		uint32_t GetWidth() const override { return m_Width; }
+		uint32_t GetHeight() const override { return m_Height; }
+		uint32_t GetRendererID() const override { return m_RendererID; }
+
+		bool IsLoaded() const override { return true; }
+
+		const TextureSpecification& GetSpecification() const override { return m_Specification; }
+
+		void SetData(void* data, uint32_t size) override;
+		void Bind(uint32_t slot = 0) const override;
+
+		// Filtered with the texture's specification, coordinates as in GLSL texture()
+		glm::vec4 Sample(glm::vec2 uv) const;
+
+		bool operator==(const Texture2D& other) const override { return m_RendererID == other.GetRendererID(); }
+	private:
+		glm::vec4 Fetch(int x, int y) const;
+		int Wrap(int coordinate, int size) const;
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Width = 1, m_Height = 1;
+		TextureSpecification m_Specification;
+
+		std::vector<uint32_t> m_Texels;
+	};
+
+	// Decoding is the only work, textures are loaded on the calling thread
+	class SoftwareTextureStreamer final : public TextureStreamer
+	{
+	public:
+		Ref<Texture2D> Load(const std::string& path, const TextureSpecification& specification) override;
+		void Update() override {}
+
+		Statistics GetStats() const override { return m_Stats; }
+	private:
+		Statistics m_Stats;
+	};
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "LunariaCore/Renderer/TimerQuery.hpp"
+
+namespace Lunaria {
+
+	// Draws finish before they return, so the CPU clock at the query is the "GPU" time
+	class SoftwareTimerQueryPool final : public TimerQueryPool
+	{
+	public:
+		SoftwareTimerQueryPool(uint32_t count) : m_Timestamps(count, 0) {}
+
+		void WriteTimestamp(uint32_t query) override;
+
+		bool IsResultAvailable(uint32_t /*query*/) const override { return true; }
+		uint64_t GetResultNanoseconds(uint32_t query) const override { return m_Timestamps[query]; }
+
+		uint32_t GetCount() const override { return static_cast<uint32_t>(m_Timestamps.size()); }
+	private:
+		std::vector<uint64_t> m_Timestamps;
+	};
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "LunariaCore/Renderer/VertexArray.hpp"
+
+namespace Lunaria {
+
+	class SoftwareVertexArray final : public VertexArray
+	{
+	public:
+		void Bind() const override {}
+		void Unbind() const override {}
+
+		void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+		void SetVertexBuffer(uint32_t index, const Ref<VertexBuffer>& vertexBuffer) override;
+		void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override { m_IndexBuffer = indexBuffer; }
+
+		const std::vector<Ref<VertexBuffer>> GetVertexBuffers() const override { return m_VertexBuffers; }
+		const Ref<IndexBuffer> GetIndexBuffer() const override { return m_IndexBuffer; }
+	private:
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+	};
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Buffer.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanDevice.hpp"
+
+#include <mutex>
+
+namespace Lunaria {
+
+	// Buffers created with vertices live in their own host visible allocation. Contents set with
+	// SetData go into the frame's transient buffer instead, every call gets a fresh slice so draws
+	// recorded earlier in the frame keep their data, like a GL buffer orphaned by glBufferSubData.
+	class VulkanVertexBuffer final : public VertexBuffer
+	{
+	public:
+		VulkanVertexBuffer(uint32_t size);
+		VulkanVertexBuffer(const float* vertices, uint32_t size);
+		~VulkanVertexBuffer() override;
+
+		void Bind() const override {}
+		void Unbind() const override {}
+
+		const BufferLayout& GetLayout() const override { return m_Layout; }
+		void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+		void SetData(const void* data, uint32_t size) override;
+
+		// Buffer and offset holding the current contents this frame. Thread safe.
+		void GetBinding(VkBuffer& buffer, VkDeviceSize& offset) const;
+	private:
+		void UploadTransient() const;
+	private:
+		VulkanBufferAllocation m_Static;
+		BufferLayout m_Layout;
+
+		// Re-uploaded when the buffer is drawn in a later frame than its last SetData
+		std::vector<uint8_t> m_Shadow;
+		mutable std::mutex m_TransientMutex;
+		mutable VulkanTransientAllocation m_Transient;
+		mutable uint64_t m_TransientFrame = std::numeric_limits<uint64_t>::max();
+	};
+
+	class VulkanIndexBuffer final : public IndexBuffer
+	{
+	public:
+		VulkanIndexBuffer(const void* indices, uint32_t count, IndexType type);
+		~VulkanIndexBuffer() override;
+
+		void Bind() const override {}
+		void Unbind() const override {}
+
+		uint32_t GetCount() const override { return m_Count; }
+		IndexType GetIndexType() const override { return m_Type; }
+
+		VkBuffer GetBuffer() const { return m_Buffer.Buffer; }
+		VkIndexType GetVkIndexType() const { return m_Type == IndexType::UInt16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32; }
+	private:
+		VulkanBufferAllocation m_Buffer;
+		uint32_t m_Count;
+		IndexType m_Type;
+	};
+
+	// Host visible storage. The shared descriptor set has no storage binding and no compute
+	// pipelines are built, so Bind is a no-op and the contents only round trip on the CPU.
+	class VulkanStorageBuffer final : public StorageBuffer
+	{
+	public:
+		VulkanStorageBuffer(const void* data, uint32_t size);
+		~VulkanStorageBuffer() override;
+
+		void Bind(uint32_t /*binding*/) const override {}
+
+		void SetData(const void* data, uint32_t size, uint32_t offset) override;
+		void GetData(void* data, uint32_t size, uint32_t offset) const override;
+
+		uint32_t GetSize() const override { return m_Size; }
+
+		VkBuffer GetBuffer() const { return m_Buffer.Buffer; }
+	private:
+		VulkanBufferAllocation m_Buffer;
+		uint32_t m_Size;
+	};
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "LunariaCore/RHI/Vulkan/VulkanDevice.hpp"
+
+#include <glm/glm.hpp>
+
+namespace Lunaria {
+
+	class VulkanShader;
+	class VulkanTexture2D;
+	class VulkanVertexArray;
+
+	// Attachments a render pass draws to. FirstPass is begun for the first pass of a frame
+	// on targets whose contents do not survive between frames, LoadPass for every other.
+	// Both are compatible, pipelines are created against LoadPass.
+	struct VulkanRenderTarget
+	{
+		VkRenderPass FirstPass = VK_NULL_HANDLE;
+		VkRenderPass LoadPass = VK_NULL_HANDLE;
+		VkFramebuffer Framebuffer = VK_NULL_HANDLE;
+		VkExtent2D Extent{};
+	};
+
+	using VulkanTextureUnits = std::array<const VulkanTexture2D*, VulkanDevice::MaxTextureUnits>;
+
+	// Turns the immediate mode RendererAPI calls into render passes.
+	//
+	// Render passes are begun lazily on the first draw or clear and recorded with secondary
+	// command buffers, so other threads can record into the same pass (RecordParallel).
+	// The primary command buffer only begins and ends passes and executes the secondaries
+	// in the order they were started.
+	class LUNARIA_API VulkanCommandStream
+	{
+	public:
+		// Binding state, mirrors what the OpenGL backend keeps in the GL context
+		struct PipelineState
+		{
+			const VulkanShader* Shader = nullptr;
+			VulkanTextureUnits Textures{};
+			const VulkanRenderTarget* Target = nullptr; // nullptr is the swapchain
+
+			int ViewportX = 0, ViewportY = 0;
+			uint32_t ViewportWidth = 0, ViewportHeight = 0;
+
+			glm::vec4 ClearColor = glm::vec4(0.0f);
+		};
+
+		static PipelineState& GetState();
+
+		// Ends the open render pass when the target changes, nullptr binds the swapchain
+		static void BindTarget(const VulkanRenderTarget* target);
+		static void SetViewport(int x, int y, uint32_t width, uint32_t height);
+
+		// Main thread command buffer for commands that work in and outside of render passes:
+		// the open secondary while a pass is recorded, the frame's primary otherwise
+		static VkCommandBuffer GetCommandBuffer();
+
+		// Main thread command buffer inside the bound target's render pass, begun if needed.
+		// VK_NULL_HANDLE when the target cannot be drawn to (minimized window).
+		static VkCommandBuffer GetRenderPassCommandBuffer();
+		static void EndRenderPass();
+
+		// Calls record(i, commandBuffer) for i in [0, count) on the recording threads, each with its
+		// own secondary command buffer inside the bound target's render pass. They execute in index
+		// order, after everything the main thread recorded before the call.
+		static void RecordParallel(uint32_t count, const std::function<void(uint32_t, VkCommandBuffer)>& record);
+
+		// Thread safe, 'uniforms' is a copy of the shader's uniform block (see VulkanShader::GetUniformData)
+		static void RecordDrawIndexed(VkCommandBuffer commandBuffer, const VulkanShader& shader, const std::vector<uint8_t>& uniforms,
+			const VulkanTextureUnits& textures, const VulkanVertexArray& vertexArray, uint32_t indexCount, uint32_t instanceCount = 1);
+
+		static void PushDebugGroup(const char* name);
+		static void PopDebugGroup();
+
+		// Called by VulkanDevice::EndFrame before the primary command buffer is closed
+		static void OnFrameEnd();
+	};
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "LunariaCore/Renderer/GraphicsContext.hpp"
+
+struct SDL_Window;
+
+namespace Lunaria {
+
+	// Owns the VulkanDevice, SwapBuffers submits the frame and presents
+	class VulkanContext : public GraphicsContext
+	{
+	public:
+		VulkanContext(SDL_Window* windowHandle);
+		~VulkanContext() override;
+
+		void Init() override;
+		void SwapBuffers() override;
+	private:
+		SDL_Window* m_WindowHandle;
+		bool m_Initialized = false;
+	};
+
+}
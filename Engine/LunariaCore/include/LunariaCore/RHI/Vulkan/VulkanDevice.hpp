@@ -0,0 +1,130 @@
+#pragma once
+
+#include "LunariaCore/Core/ThreadPool.hpp"
+#include "LunariaCore/Renderer/Texture.hpp"
+
+#include <vulkan/vulkan.h>
+
+struct SDL_Window;
+
+// Logs failing Vulkan calls, like LU_CORE_ASSERT this does not abort
+#define LU_VK_CHECK(call) \
+	do { \
+		const VkResult luVkResult = (call); \
+		if (luVkResult < VK_SUCCESS) \
+			LU_CORE_ERROR("{0} failed with VkResult {1}", #call, static_cast<int>(luVkResult)); \
+	} while (false)
+
+namespace Lunaria {
+
+	class VulkanSwapchain;
+
+	struct VulkanBufferAllocation
+	{
+		VkBuffer Buffer = VK_NULL_HANDLE;
+		VkDeviceMemory Memory = VK_NULL_HANDLE;
+		void* Mapped = nullptr; // Host visible buffers stay mapped
+		VkDeviceSize Size = 0;
+	};
+
+	struct VulkanImageAllocation
+	{
+		VkImage Image = VK_NULL_HANDLE;
+		VkDeviceMemory Memory = VK_NULL_HANDLE;
+	};
+
+	// Slice of the current frame's upload buffer, Mapped is null when the buffer is full
+	struct VulkanTransientAllocation
+	{
+		VkBuffer Buffer = VK_NULL_HANDLE;
+		VkDeviceSize Offset = 0;
+		void* Mapped = nullptr;
+	};
+
+	// Instance, device and frame in flight bookkeeping of the Vulkan backend
+	// (RendererAPI::API::Vulkan).
+	//
+	// A frame starts lazily with the first command that needs a command buffer: it waits
+	// for the fence of the frame that last used the same slot, frees what that frame
+	// deferred, resets every thread's command pool for the slot and acquires the next
+	// swapchain image. VulkanContext::SwapBuffers submits and presents it.
+	class LUNARIA_API VulkanDevice
+	{
+	public:
+		static constexpr uint32_t FramesInFlight = 2;
+		static constexpr uint32_t MaxTextureUnits = 32;
+		static constexpr VkDeviceSize TransientBufferSize = 32 * 1024 * 1024;
+
+		static constexpr VkFormat OffscreenColorFormat = VK_FORMAT_R8G8B8A8_UNORM;
+		static constexpr VkFormat DepthFormat = VK_FORMAT_D32_SFLOAT;
+
+		// Descriptor set 0 shared by every pipeline
+		static constexpr uint32_t UniformBinding = 0;	// Dynamic uniform buffer, the shader's loose uniforms
+		static constexpr uint32_t TextureBinding = 1;	// sampler2D[MaxTextureUnits], indexed by texture unit
+
+		static bool Init(SDL_Window* window);
+		static void Shutdown();
+
+		static VkInstance GetInstance();
+		static VkPhysicalDevice GetPhysicalDevice();
+		static VkDevice GetDevice();
+		static VkQueue GetQueue();
+		static const VkPhysicalDeviceProperties& GetProperties();
+		static VulkanSwapchain& GetSwapchain();
+
+		static VkDescriptorSetLayout GetDescriptorSetLayout();
+		static VkPipelineLayout GetPipelineLayout();
+
+		// Shared by every FrameBuffer, color is kept in SHADER_READ_ONLY_OPTIMAL between passes
+		static VkRenderPass GetOffscreenRenderPass();
+
+		// Frames
+		static void BeginFrame();
+		static void EndFrame(); // Submits the frame's primary command buffer and presents
+		static bool IsFrameActive();
+		static uint32_t GetFrameIndex();	// Slot in [0, FramesInFlight)
+		static uint64_t GetFrameNumber();	// Increases by one per frame
+
+		// Waits for the GPU to finish a frame by number, returns false on timeout and for a frame
+		// that was not submitted yet
+		static bool WaitForFrame(uint64_t frameNumber, uint64_t timeoutNanoseconds);
+		static VkCommandBuffer GetFrameCommandBuffer(); // Primary, begins the frame if needed
+
+		// From the calling thread's command pool for the current frame slot, recycled once
+		// the slot comes around again. Safe to call from any thread.
+		static VkCommandBuffer AllocateThreadCommandBuffer(VkCommandBufferLevel level);
+
+		// Records, submits and waits, for uploads outside the frame's command buffer
+		static void ImmediateSubmit(const std::function<void(VkCommandBuffer)>& record);
+
+		// Runs once the GPU finished the current frame, or right away without one
+		static void DeferDestroy(std::function<void()>&& destroy);
+
+		// Per frame resources, thread safe
+		static VulkanTransientAllocation AllocateTransient(VkDeviceSize size, VkDeviceSize alignment);
+		static VkDescriptorSet AllocateDescriptorSet();
+
+		// Resources, each with its own allocation
+		static VulkanBufferAllocation CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+		static void DestroyBuffer(const VulkanBufferAllocation& buffer);
+		static VulkanImageAllocation CreateImage(const VkImageCreateInfo& createInfo, VkMemoryPropertyFlags properties);
+		static void DestroyImage(const VulkanImageAllocation& image);
+		static uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties);
+
+		// Shared between textures with the same specification
+		static VkSampler GetSampler(const TextureSpecification& specification);
+
+		// 1x1 white, bound to texture units without a texture
+		static VkImageView GetDefaultImageView();
+
+		// Worker threads for VulkanCommandStream::RecordParallel
+		static ThreadPool& GetRecordingPool();
+
+		// VK_EXT_debug_utils labels, no-ops when the extension is missing
+		static void BeginDebugLabel(VkCommandBuffer commandBuffer, const char* name);
+		static void EndDebugLabel(VkCommandBuffer commandBuffer);
+
+		static uint32_t AllocateID();
+	};
+
+}
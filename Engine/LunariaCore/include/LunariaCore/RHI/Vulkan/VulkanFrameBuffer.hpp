@@ -0,0 +1,44 @@
+#pragma once
+
+#include "LunariaCore/Renderer/FrameBuffer.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanCommandStream.hpp"
+
+namespace Lunaria {
+
+	// RGBA8 color and D32 depth drawn with VulkanDevice::GetOffscreenRenderPass.
+	// Multisampling is ignored, the attachments always have one sample.
+	class VulkanFrameBuffer final : public FrameBuffer
+	{
+	public:
+		VulkanFrameBuffer(const FrameBufferSpecification& specification);
+		~VulkanFrameBuffer() override;
+
+		void Invalidate(); // Re-creating frame buffer
+
+		void Bind() override;
+		void Unbind() override;
+		void Resize(uint32_t width, uint32_t height) override;
+
+		void SetRenderSize(uint32_t width, uint32_t height) override;
+		glm::uvec2 GetRenderSize() const override { return m_RenderSize; }
+
+		const FrameBufferSpecification& GetSpecification() const override { return m_Specification; }
+
+		// Not a GL texture name, sample the color attachment through GetColorImageView
+		uint32_t GetColorAttachmentRendererID() const override { return m_RendererID; }
+
+		VkImageView GetColorImageView() const { return m_ColorView; }
+		const VulkanRenderTarget& GetTarget() const { return m_Target; }
+	private:
+		void Release();
+	private:
+		uint32_t m_RendererID;
+		FrameBufferSpecification m_Specification;
+		glm::uvec2 m_RenderSize;
+
+		VulkanImageAllocation m_Color, m_Depth;
+		VkImageView m_ColorView = VK_NULL_HANDLE, m_DepthView = VK_NULL_HANDLE;
+		VulkanRenderTarget m_Target;
+	};
+
+}
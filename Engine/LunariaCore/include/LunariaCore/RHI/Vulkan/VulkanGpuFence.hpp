@@ -0,0 +1,25 @@
+#pragma once
+
+#include "LunariaCore/Renderer/GpuFence.hpp"
+
+namespace Lunaria {
+
+	// The backend submits once per frame, so a fence covers the frame it was signaled in and
+	// completes with that frame's submission. Waiting before the frame was submitted times out.
+	class VulkanGpuFence final : public GpuFence
+	{
+	public:
+		void Signal() override;
+
+		bool IsSignaled() const override;
+		bool Wait(uint64_t timeoutNanoseconds) override;
+
+		float GetLastWaitMilliseconds() const override { return m_LastWaitMilliseconds; }
+	private:
+		static constexpr uint64_t NoFrame = 0xffffffffffffffffull;
+
+		uint64_t m_Frame = NoFrame;
+		float m_LastWaitMilliseconds = 0.0f;
+	};
+
+}
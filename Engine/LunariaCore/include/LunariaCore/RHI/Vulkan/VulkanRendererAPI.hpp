@@ -0,0 +1,31 @@
+#pragma once
+
+#include "LunariaCore/Renderer/RendererAPI.hpp"
+
+namespace Lunaria {
+
+	class LUNARIA_API VulkanRendererAPI : public RendererAPI
+	{
+	public:
+		void Init() override;
+
+		void SetViewport(int x, int y, uint32_t width, uint32_t height) override;
+
+		void SetClearColor(const glm::vec4& color) override;
+		void Clear() override;
+
+		void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t instanceCount = 1) override;
+
+		void Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+		void Barrier(uint32_t flags) override;
+
+		void PushDebugGroup(const char* name) override;
+		void PopDebugGroup() override;
+
+		void ResetStateStats() override { m_Stats = {}; }
+		StateStatistics GetStateStats() const override { return m_Stats; }
+	private:
+		StateStatistics m_Stats;
+	};
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Shader.hpp"
+#include "LunariaCore/Renderer/Buffer.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanDevice.hpp"
+
+#include <mutex>
+
+namespace Lunaria {
+
+	// Loads precompiled SPIR-V, no GLSL compiler is linked. 'Resources/Shaders/Texture.lusf'
+	// loads 'Resources/Shaders/Vulkan/Texture.vert.spv' and 'Texture.frag.spv'.
+	//
+	// Loose uniforms live in the block at set 0, binding 0 of both stages. Its layout is
+	// reflected, the Set* functions write into a CPU copy that is uploaded with every draw.
+	class VulkanShader final : public Shader
+	{
+	public:
+		VulkanShader(const std::string& filepath);
+		VulkanShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		~VulkanShader() override;
+
+		void Bind() const override;
+		void Unbind() const override;
+
+		const std::string& GetName() const override { return m_Name; }
+
+		void SetMat4(const std::string& name, const glm::mat4& value) const override;
+		void SetFloat3(const std::string& name, const glm::vec3& value) const override;
+		void SetFloat4(const std::string& name, const glm::vec4& value) const override;
+		void SetFloat(const std::string& name, float value) const override;
+		void SetInt(const std::string& name, int value) const override;
+		void SetIntArray(const std::string& name, int* values, uint32_t count) const override;
+
+		bool IsValid() const { return m_VertexModule && m_FragmentModule; }
+
+		const std::vector<uint8_t>& GetUniformData() const { return m_UniformData; }
+
+		// Created on first use for each render pass and vertex layout. Thread safe.
+		VkPipeline GetPipeline(VkRenderPass renderPass, const BufferLayout& layout) const;
+	private:
+		bool Reflect(const std::vector<uint32_t>& spirv);
+		void WriteUniform(const std::string& name, const void* data, uint32_t size) const;
+	private:
+		struct UniformMember
+		{
+			uint32_t Offset = 0;
+			uint32_t Size = 0;
+			uint32_t ArrayStride = 0; // 0 when the member is not an array
+		};
+
+		std::string m_Name;
+
+		VkShaderModule m_VertexModule = VK_NULL_HANDLE;
+		VkShaderModule m_FragmentModule = VK_NULL_HANDLE;
+
+		std::unordered_map<std::string, UniformMember> m_UniformMembers;
+
+		// Uniforms can be set on a const shader, as with a GL program object
+		mutable std::vector<uint8_t> m_UniformData;
+
+		mutable std::mutex m_PipelineMutex;
+		mutable std::unordered_map<uint64_t, VkPipeline> m_Pipelines;
+	};
+
+}
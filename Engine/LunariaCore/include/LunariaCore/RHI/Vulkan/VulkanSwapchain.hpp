@@ -0,0 +1,57 @@
+#pragma once
+
+#include "LunariaCore/RHI/Vulkan/VulkanCommandStream.hpp"
+
+namespace Lunaria {
+
+	// Window surface images with a shared depth buffer. Recreated before the next acquire
+	// once it is out of date or Invalidate was called, the render passes are kept.
+	class VulkanSwapchain
+	{
+	public:
+		VulkanSwapchain(SDL_Window* window, VkSurfaceKHR surface);
+		~VulkanSwapchain();
+
+		// False when there is nothing to render to, e.g. while the window is minimized
+		bool AcquireNextImage(VkSemaphore imageAvailable);
+		void Present();
+
+		void Invalidate() { m_Invalid = true; }
+
+		bool HasImage() const { return m_HasImage; }
+		VkExtent2D GetExtent() const { return m_Extent; }
+
+		// Signaled by the frame's submission, waited on by the presentation of the current image
+		VkSemaphore GetRenderFinishedSemaphore() const { return m_RenderFinished[m_ImageIndex]; }
+
+		// Current image, only valid while HasImage()
+		const VulkanRenderTarget& GetTarget() const { return m_Targets[m_ImageIndex]; }
+	private:
+		void Create();
+		void Destroy();
+		void CreateRenderPasses();
+	private:
+		SDL_Window* m_Window;
+		VkSurfaceKHR m_Surface;
+
+		VkSwapchainKHR m_Swapchain = VK_NULL_HANDLE;
+		VkFormat m_Format = VK_FORMAT_UNDEFINED;
+		VkExtent2D m_Extent{};
+
+		VkRenderPass m_FirstPass = VK_NULL_HANDLE;
+		VkRenderPass m_LoadPass = VK_NULL_HANDLE;
+
+		std::vector<VkImage> m_Images;
+		std::vector<VkImageView> m_ImageViews;
+		std::vector<VulkanRenderTarget> m_Targets;
+		std::vector<VkSemaphore> m_RenderFinished;
+
+		VulkanImageAllocation m_DepthImage;
+		VkImageView m_DepthView = VK_NULL_HANDLE;
+
+		uint32_t m_ImageIndex = 0;
+		bool m_HasImage = false;
+		bool m_Invalid = false;
+	};
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Texture.hpp"
+#include "LunariaCore/Renderer/TextureStreamer.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanDevice.hpp"
+
+namespace Lunaria {
+
+	struct CompressedTextureLevel;
+
+	// Device local image kept in SHADER_READ_ONLY_OPTIMAL. Uploads go through a staging buffer and
+	// wait for the GPU, mips are generated with blits. Block compressed containers are uploaded
+	// as they are when the device samples the format, decoded on the CPU otherwise.
+	class VulkanTexture2D final : public Texture2D
+	{
+	public:
+		VulkanTexture2D(const std::string& path, const TextureSpecification& specification);
+		VulkanTexture2D(uint32_t width, uint32_t height, const TextureSpecification& specification);
+		~VulkanTexture2D() override;
+
+		uint32_t GetWidth() const override { return m_Width; }
+		uint32_t GetHeight() const override { return m_Height; }
+		uint32_t GetRendererID() const override { return m_RendererID; }
+
+		bool IsLoaded() const override { return true; }
+
+		const TextureSpecification& GetSpecification() const override { return m_Specification; }
+
+		void SetData(void* data, uint32_t size) override;
+		void Bind(uint32_t slot = 0) const override;
+
+		VkImageView GetImageView() const { return m_View; }
+		VkSampler GetSampler() const { return m_Sampler; }
+
+		bool operator==(const Texture2D& other) const override { return m_RendererID == other.GetRendererID(); }
+	private:
+		void LoadContainer(const std::string& path);
+		void CreateStorage(VkFormat format, uint32_t levels);
+
+		// Levels point into 'data'. With a single level the rest of the chain is generated.
+		void Upload(const uint8_t* data, const std::vector<CompressedTextureLevel>& levels);
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Width = 1, m_Height = 1;
+		uint32_t m_MipLevels = 1;
+		VkFormat m_Format = VK_FORMAT_R8G8B8A8_UNORM;
+		TextureSpecification m_Specification;
+
+		VulkanImageAllocation m_Image;
+		VkImageView m_View = VK_NULL_HANDLE;
+		VkSampler m_Sampler = VK_NULL_HANDLE; // Owned by VulkanDevice
+	};
+
+	// Uploads already wait for the GPU, textures are loaded on the calling thread
+	class VulkanTextureStreamer final : public TextureStreamer
+	{
+	public:
+		Ref<Texture2D> Load(const std::string& path, const TextureSpecification& specification) override;
+		void Update() override {}
+
+		Statistics GetStats() const override { return m_Stats; }
+	private:
+		Statistics m_Stats;
+	};
+
+}
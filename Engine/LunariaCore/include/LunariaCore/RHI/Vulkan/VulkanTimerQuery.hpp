@@ -0,0 +1,27 @@
+#pragma once
+
+#include "LunariaCore/Renderer/TimerQuery.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanDevice.hpp"
+
+namespace Lunaria {
+
+	// Queries are reset from the host right before they are written, a query must not be
+	// rewritten while the frame that wrote it is still in flight (GPUProfiler waits longer)
+	class VulkanTimerQueryPool final : public TimerQueryPool
+	{
+	public:
+		VulkanTimerQueryPool(uint32_t count);
+		~VulkanTimerQueryPool() override;
+
+		void WriteTimestamp(uint32_t query) override;
+
+		bool IsResultAvailable(uint32_t query) const override;
+		uint64_t GetResultNanoseconds(uint32_t query) const override;
+
+		uint32_t GetCount() const override { return m_Count; }
+	private:
+		VkQueryPool m_Pool = VK_NULL_HANDLE;
+		uint32_t m_Count;
+	};
+
+}
@@ -16,6 +16,9 @@ namespace Lunaria {
 
 		void OnUpdate() override;
 
+		void PollEvents() override;
+		GraphicsContext& GetGraphicsContext() const override { return *m_Context; }
+
 		unsigned int GetWidth() const override { return m_Data.Width; }
 		unsigned int GetHeight() const override { return m_Data.Height; }
 
@@ -48,6 +48,12 @@ namespace Lunaria {
 		{
 		}
 
+		// Matrices take one attribute location per column
+		uint32_t GetLocationCount() const
+		{
+			return Type == ShaderDataType::Mat3 || Type == ShaderDataType::Mat4 ? GetComponentCount() : 1;
+		}
+
 		uint32_t GetComponentCount() const
 		{
 			switch (Type)
@@ -69,15 +75,25 @@ namespace Lunaria {
 			LU_CORE_ASSERT(false, "Unknown ShaderDataType!");
 			return 0;
 		}
+
+		bool operator==(const BufferElement& other) const
+		{
+			return Type == other.Type && Offset == other.Offset && Normalized == other.Normalized;
+		}
 	};
 
+	// Format of one vertex stream. Elements are interleaved within the stream, a vertex array
+	// with several buffers reads split streams, each from its own binding slot.
 	class LUNARIA_API BufferLayout
 	{
 	public:
+		static constexpr uint32_t AutoBinding = 0xffffffff; // Slot of the buffer in its vertex array
+
 		BufferLayout() = default;
 
-		BufferLayout(const std::initializer_list<BufferElement>& elements)
-			: m_Elements(elements)
+		// A step rate of 0 advances per vertex, N advances every N instances
+		BufferLayout(const std::initializer_list<BufferElement>& elements, uint32_t stepRate = 0, uint32_t binding = AutoBinding)
+			: m_Elements(elements), m_StepRate(stepRate), m_Binding(binding)
 		{
 			CalculateOffsetsAndStride();
 		}
@@ -86,10 +102,32 @@ namespace Lunaria {
 
 		int32_t GetStride() const { return m_Stride; }
 
+		uint32_t GetStepRate() const { return m_StepRate; }
+		void SetStepRate(uint32_t stepRate) { m_StepRate = stepRate; }
+		bool IsPerInstance() const { return m_StepRate > 0; }
+
+		uint32_t GetBinding() const { return m_Binding; }
+		void SetBinding(uint32_t binding) { m_Binding = binding; }
+
+		uint32_t GetLocationCount() const
+		{
+			uint32_t count = 0;
+			for (const auto& element : m_Elements)
+				count += element.GetLocationCount();
+			return count;
+		}
+
 		std::vector<BufferElement>::iterator begin() { return m_Elements.begin(); }
 		std::vector<BufferElement>::iterator end() { return m_Elements.end(); }
 		std::vector<BufferElement>::const_iterator begin() const { return m_Elements.begin(); }
 		std::vector<BufferElement>::const_iterator end() const { return m_Elements.end(); }
+
+		// Two layouts are compatible when the attribute formats match, names are ignored
+		bool operator==(const BufferLayout& other) const
+		{
+			return m_Stride == other.m_Stride && m_StepRate == other.m_StepRate && m_Binding == other.m_Binding
+				&& m_Elements == other.m_Elements;
+		}
 	private:
 		void CalculateOffsetsAndStride()
 		{
@@ -105,8 +143,29 @@ namespace Lunaria {
 		
 		std::vector<BufferElement> m_Elements;
 		uint32_t m_Stride = 0;
+		uint32_t m_StepRate = 0;
+		uint32_t m_Binding = AutoBinding;
 	};
 
+	// How often the contents change, backends pick the memory placement from it
+	enum class BufferUsage
+	{
+		Static = 0, // Written once, drawn many times
+		Dynamic,    // Rewritten every few frames
+		Stream      // Rewritten every frame
+	};
+
+	enum class IndexType
+	{
+		UInt16 = 0, // Half the memory, for meshes with at most 65536 vertices
+		UInt32
+	};
+
+	static uint32_t IndexTypeSize(IndexType type)
+	{
+		return type == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+	}
+
 	class LUNARIA_API VertexBuffer
 	{
 	public:
@@ -119,11 +178,10 @@ namespace Lunaria {
 		virtual void SetLayout(const BufferLayout& layout) = 0;
 		virtual void SetData(const void* data, uint32_t size) = 0;
 
-		static Ref<VertexBuffer> Create(uint32_t size);
-		static Ref<VertexBuffer> Create(float* vertices, uint32_t size);
+		static Ref<VertexBuffer> Create(uint32_t size, BufferUsage usage = BufferUsage::Dynamic);
+		static Ref<VertexBuffer> Create(float* vertices, uint32_t size, BufferUsage usage = BufferUsage::Static);
 	};
 
-	// Currently Lunaria only supports 32-bit index buffers
 	class LUNARIA_API IndexBuffer
 	{
 	public:
@@ -133,8 +191,31 @@ namespace Lunaria {
 		virtual void Unbind() const = 0;
 
 		virtual uint32_t GetCount() const = 0;
+		virtual IndexType GetIndexType() const = 0;
+
+		static Ref<IndexBuffer> Create(const uint32_t* indices, uint32_t count, BufferUsage usage = BufferUsage::Static);
+		static Ref<IndexBuffer> Create(const uint16_t* indices, uint32_t count, BufferUsage usage = BufferUsage::Static);
+	};
+
+	// Buffer shaders read and write through 'layout(std430, binding = N) buffer', e.g. the
+	// input and output of a compute dispatch
+	class LUNARIA_API StorageBuffer
+	{
+	public:
+		virtual ~StorageBuffer() = default;
+
+		virtual void Bind(uint32_t binding) const = 0;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+		// Reads the contents back, waits until the GPU is done with the buffer. Writes of a
+		// dispatch need a RenderCommand::Barrier(BarrierBufferUpdate) first.
+		virtual void GetData(void* data, uint32_t size, uint32_t offset = 0) const = 0;
+
+		virtual uint32_t GetSize() const = 0;
 
-		static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t count);
+		static Ref<StorageBuffer> Create(uint32_t size, BufferUsage usage = BufferUsage::Dynamic);
+		static Ref<StorageBuffer> Create(const void* data, uint32_t size, BufferUsage usage = BufferUsage::Dynamic);
 	};
 
 }
\ No newline at end of file
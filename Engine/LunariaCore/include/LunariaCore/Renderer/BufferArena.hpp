@@ -0,0 +1,40 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Buffer.hpp"
+
+namespace Lunaria {
+
+	struct BufferArenaSpecification
+	{
+		// Size of every shared buffer, ranges larger than this get a block of their own
+		uint32_t BlockSize = 16 * 1024 * 1024;
+		BufferUsage Usage = BufferUsage::Static;
+	};
+
+	// Vertex and index buffers sub-allocated from a few large shared buffers, so thousands of
+	// small meshes don't each need their own buffer object. The returned buffers behave like
+	// regular ones, their range goes back to the arena when the last reference is dropped.
+	class LUNARIA_API BufferArena
+	{
+	public:
+		struct Statistics
+		{
+			uint32_t Blocks = 0;
+			uint32_t Allocations = 0;
+			uint64_t UsedBytes = 0;
+			uint64_t CapacityBytes = 0;
+			uint32_t FreeRanges = 0; // Grows with fragmentation
+		};
+
+		virtual ~BufferArena() = default;
+
+		virtual Ref<VertexBuffer> CreateVertexBuffer(const void* vertices, uint32_t size) = 0;
+		virtual Ref<IndexBuffer> CreateIndexBuffer(const void* indices, uint32_t count, IndexType type) = 0;
+
+		virtual Statistics GetStats() const = 0;
+		virtual const BufferArenaSpecification& GetSpecification() const = 0;
+
+		static Ref<BufferArena> Create(const BufferArenaSpecification& specification = {});
+	};
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+namespace Lunaria {
+
+	enum class CompressedTextureFormat
+	{
+		None = 0,
+		RGBA8,			// Uncompressed payload
+		BC1,			// RGB, 1 bit alpha
+		BC2,			// RGBA, explicit 4 bit alpha
+		BC3,			// RGBA, interpolated alpha
+		BC4,			// R
+		BC5,			// RG
+		BC6H,			// RGB half float, unsigned
+		BC7,			// RGBA
+		ETC2_RGB8,
+		ETC2_RGB8A1,
+		ETC2_RGBA8
+	};
+
+	struct CompressedTextureLevel
+	{
+		uint32_t Width = 0, Height = 0;
+		size_t Offset = 0, Size = 0; // Into CompressedTextureData::Data
+	};
+
+	struct CompressedTextureData
+	{
+		CompressedTextureFormat Format = CompressedTextureFormat::None;
+		bool SRGB = false;
+
+		uint32_t Width = 0, Height = 0;
+		std::vector<CompressedTextureLevel> Levels; // Precomputed mip chain, largest first
+		std::vector<uint8_t> Data;
+	};
+
+	// Reads KTX2 and DDS containers holding block compressed (BCn/ETC2) 2D textures
+	class LUNARIA_API CompressedTextureLoader
+	{
+	public:
+		// By extension, .ktx2 or .dds
+		static bool IsContainer(const std::string& path);
+
+		// Only plain 2D textures are accepted: no arrays, cube maps or supercompression
+		static bool Load(const std::string& path, CompressedTextureData& outData);
+
+		static uint32_t GetBlockSize(CompressedTextureFormat format); // Bytes per 4x4 block, 0 for RGBA8
+
+		// CPU decode of one level to RGBA8, for devices without the format. Only BC1-BC3 can be
+		// missing on an OpenGL 4.5 core device (S3TC is an extension), so only those are supported.
+		static bool CanDecompress(CompressedTextureFormat format);
+		static bool Decompress(const CompressedTextureData& data, uint32_t level, std::vector<uint8_t>& outPixels);
+	};
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Lunaria {
+
+	struct DynamicResolutionSpecification
+	{
+		float TargetMilliseconds = 16.0f; // GPU time budget of the scaled pass
+		float MinScale = 0.5f;
+		float MaxScale = 1.0f;
+
+		// Timings within this fraction of the target leave the scale alone
+		float Hysteresis = 0.1f;
+		// Consecutive frames under budget before the scale grows again, drops happen right away
+		uint32_t GrowFrames = 30;
+		// Largest growth per step, so one cheap frame can't push the scale back up
+		float MaxGrowStep = 0.05f;
+		// Frames the GPU timings lag behind, samples taken before a change lands are ignored
+		uint32_t LatencyFrames = 4;
+	};
+
+	// Picks the render scale of a fill rate bound pass from its GPU time. The cost is assumed to
+	// follow the pixel count, so the scale moves by the square root of the budget ratio.
+	// Width and height are both multiplied by the scale, the aspect ratio never changes.
+	class LUNARIA_API DynamicResolution
+	{
+	public:
+		DynamicResolution(const DynamicResolutionSpecification& specification = {});
+
+		// Feeds the GPU time of the last measured frame, returns the scale to render with
+		float Update(float gpuMilliseconds);
+		void Reset();
+
+		float GetScale() const { return m_Enabled ? m_Scale : m_Specification.MaxScale; }
+		glm::uvec2 GetScaledSize(uint32_t width, uint32_t height) const;
+
+		// Disabled always renders at MaxScale
+		void SetEnabled(bool enabled);
+		bool IsEnabled() const { return m_Enabled; }
+
+		const DynamicResolutionSpecification& GetSpecification() const { return m_Specification; }
+		void SetSpecification(const DynamicResolutionSpecification& specification);
+	private:
+		DynamicResolutionSpecification m_Specification;
+		bool m_Enabled = true;
+
+		float m_Scale = 1.0f;
+		float m_SmoothedMilliseconds = 0.0f;
+		uint32_t m_FramesUnderBudget = 0;
+		uint32_t m_SettleFrames = 0;
+	};
+
+}
@@ -26,6 +26,11 @@ namespace Lunaria {
 
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
 
+		// Bind renders into the bottom left width x height pixels only, changing it never
+		// reallocates the attachments (dynamic resolution). Resize resets it to the full size.
+		virtual void SetRenderSize(uint32_t width, uint32_t height) = 0;
+		virtual glm::uvec2 GetRenderSize() const = 0;
+
 		static Ref<FrameBuffer> Create(const FrameBufferSpecification& specification);
 
 		virtual const FrameBufferSpecification& GetSpecification() const = 0;
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Lunaria {
+
+	// Bounds how far the CPU runs ahead of the GPU. Every frame signals a fence before it is
+	// presented, BeginFrame waits for the frame that last used the same slot, so per frame
+	// resources indexed by GetFrameSlot() are safe to overwrite afterwards. With the render
+	// thread running the wait happens there, ordered before the frame's own commands.
+	class LUNARIA_API FrameSync
+	{
+	public:
+		static constexpr uint32_t MaxFramesInFlight = 4;
+
+		static void Init(uint32_t framesInFlight = 2);
+		static void Shutdown();
+
+		static void BeginFrame();
+		static void EndFrame();
+
+		static uint32_t GetFramesInFlight();
+		static uint64_t GetCurrentFrame(); // Frame being recorded, the first one is 1
+		static uint32_t GetFrameSlot(); // In [0, GetFramesInFlight())
+
+		// Last frame the GPU finished, 0 before the first one
+		static uint64_t GetCompletedFrame();
+		static bool IsFrameComplete(uint64_t frame) { return frame <= GetCompletedFrame(); }
+
+		struct Statistics
+		{
+			float WaitMilliseconds = 0.0f; // Fence wait of the last frame
+			float MaxWaitMilliseconds = 0.0f;
+			uint32_t Stalls = 0; // Frames that had to wait for the GPU
+			uint32_t FramesAhead = 0; // Recorded but not finished by the GPU
+		};
+
+		static Statistics GetStats();
+		static void ResetStats();
+	};
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace Lunaria {
+
+	// GPU time per render pass, measured with timestamp queries.
+	// Results are read back FramesInFlight frames late so the CPU never waits on the GPU,
+	// a frame whose queries are still not ready by then is dropped instead of stalling.
+	// Every scope is also pushed as a debug group, so passes show up named in RenderDoc/Nsight.
+	class LUNARIA_API GPUProfiler
+	{
+	public:
+		static constexpr uint32_t FramesInFlight = 4;
+		static constexpr uint32_t MaxScopesPerFrame = 32;
+		static constexpr uint32_t HistorySize = 120;
+
+		struct PassTiming
+		{
+			std::string Name;
+			uint32_t Depth = 0;
+			float Milliseconds = 0.0f;
+
+			// Ring buffer, HistoryOffset is the oldest sample (ImGui::PlotLines values_offset)
+			std::array<float, HistorySize> History{};
+			uint32_t HistoryOffset = 0;
+		};
+
+		static void Init();
+		static void Shutdown();
+
+		// Opens the root "Frame" scope, call before any rendering of the frame
+		static void BeginFrame();
+		static void EndFrame();
+
+		static void BeginScope(const std::string& name);
+		static void EndScope();
+
+		// Passes in the order they were first seen, the first one is the whole frame.
+		// Returned as a copy, the render thread may be resolving the next frame.
+		static std::vector<PassTiming> GetPassTimings();
+		// Latest time of the first pass with this name, 0 until it was measured
+		static float GetPassMilliseconds(const std::string& name);
+		static uint32_t GetDroppedFrames();
+	};
+
+	class LUNARIA_API GPUProfileScope
+	{
+	public:
+		GPUProfileScope(const std::string& name) { GPUProfiler::BeginScope(name); }
+		~GPUProfileScope() { GPUProfiler::EndScope(); }
+
+		GPUProfileScope(const GPUProfileScope&) = delete;
+		GPUProfileScope& operator=(const GPUProfileScope&) = delete;
+	};
+
+}
+
+#define LU_GPU_SCOPE_LINE2(name, line) ::Lunaria::GPUProfileScope gpuScope##line(name)
+#define LU_GPU_SCOPE_LINE(name, line) LU_GPU_SCOPE_LINE2(name, line)
+#define LU_GPU_SCOPE(name) LU_GPU_SCOPE_LINE(name, __LINE__)
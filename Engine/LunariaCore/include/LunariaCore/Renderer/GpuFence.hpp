@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Lunaria {
+
+	// Point in the GPU command stream. Signal marks everything submitted so far, the fence is
+	// signaled once the GPU finished all of it. Like TimerQueryPool, calls go straight to the
+	// backend, with the render thread running they belong inside RenderThread::Submit.
+	class LUNARIA_API GpuFence
+	{
+	public:
+		static constexpr uint64_t InfiniteTimeout = 0xffffffffffffffffull;
+
+		virtual ~GpuFence() = default;
+
+		virtual void Signal() = 0;
+
+		// Doesn't block, a fence that was never signaled counts as signaled
+		virtual bool IsSignaled() const = 0;
+
+		// Blocks until the fence is signaled, returns false on timeout
+		virtual bool Wait(uint64_t timeoutNanoseconds = InfiniteTimeout) = 0;
+
+		// CPU time the last Wait blocked, 0 when the GPU was already done
+		virtual float GetLastWaitMilliseconds() const = 0;
+
+		static Ref<GpuFence> Create();
+	};
+
+}
@@ -9,6 +9,11 @@ class LUNARIA_API GraphicsContext {
 		virtual void Init() = 0;
 		virtual void SwapBuffers() = 0;
 
+		// Moves the context between the main and the render thread (see RenderThread).
+		// Contexts that aren't bound to a thread leave these empty.
+		virtual void MakeCurrent() {}
+		virtual void ReleaseCurrent() {}
+
 		static Scope<GraphicsContext> Create(void* window);
 	};
 
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "LunariaCore/Renderer/VertexArray.hpp"
+
+#include <glm/glm.hpp>
+
+namespace Lunaria {
+
+	struct MeshBatchSpecification
+	{
+		// Vertex format shared by every mesh in the batch
+		BufferLayout Layout;
+
+		// 16-bit indices halve the index arena, every mesh is rebased so only its own vertex count must fit
+		IndexType IndexFormat = IndexType::UInt32;
+
+		uint32_t MaxVertices = 1024 * 1024;
+		uint32_t MaxIndices = 3 * 1024 * 1024;
+		uint32_t MaxDraws = 32768;
+	};
+
+	// Meshes sharing a shader and vertex format, packed into shared vertex/index arenas.
+	// All draws of a frame go out in a single indirect multi-draw, the per-draw transform
+	// is read by the shader from the storage buffer at binding 0, indexed with gl_DrawID.
+	class LUNARIA_API MeshBatch
+	{
+	public:
+		static constexpr uint32_t InvalidMesh = 0xffffffff;
+
+		virtual ~MeshBatch() = default;
+
+		// Copies the mesh into the arenas, returns InvalidMesh when it does not fit or the format or index type differs.
+		// The copy is taken once, vertex buffers that aren't BufferUsage::Static are refused.
+		virtual uint32_t AddMesh(const Ref<VertexArray>& vertexArray) = 0;
+		// Frees the ranges of the mesh for later meshes, its handle may be handed out again
+		virtual void RemoveMesh(uint32_t mesh) = 0;
+
+		// Returns false when the draw list is full
+		virtual bool Submit(uint32_t mesh, const glm::mat4& transform) = 0;
+
+		// Issues all submitted draws, the shader must be bound
+		virtual void Flush() = 0;
+
+		virtual uint32_t GetDrawCount() const = 0;
+		virtual uint32_t GetMeshCount() const = 0;
+		virtual const MeshBatchSpecification& GetSpecification() const = 0;
+
+		static Ref<MeshBatch> Create(const MeshBatchSpecification& specification);
+	};
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <map>
+
+namespace Lunaria {
+
+	// Hands out ranges of a fixed size address space, e.g. a GPU buffer. Best fit from a free list,
+	// freed ranges are merged with their free neighbours so the space doesn't fragment over time.
+	// Sizes are rounded up to the granularity, every offset is a multiple of it.
+	class LUNARIA_API OffsetAllocator
+	{
+	public:
+		static constexpr uint32_t InvalidOffset = 0xffffffff;
+
+		struct Allocation
+		{
+			uint32_t Offset = InvalidOffset;
+			uint32_t Size = 0;
+
+			bool IsValid() const { return Offset != InvalidOffset; }
+		};
+
+		OffsetAllocator() = default;
+		OffsetAllocator(uint32_t capacity, uint32_t granularity = 16);
+
+		// Returns an invalid allocation when no free range is large enough
+		Allocation Allocate(uint32_t size);
+		void Free(const Allocation& allocation);
+
+		uint32_t GetCapacity() const { return m_Capacity; }
+		uint32_t GetUsedSize() const { return m_UsedSize; }
+		uint32_t GetLargestFreeRange() const;
+		uint32_t GetFreeRangeCount() const { return static_cast<uint32_t>(m_FreeByOffset.size()); }
+		bool IsEmpty() const { return m_UsedSize == 0; }
+	private:
+		void InsertFreeRange(uint32_t offset, uint32_t size);
+		void EraseFreeRange(std::map<uint32_t, uint32_t>::iterator range);
+	private:
+		uint32_t m_Capacity = 0;
+		uint32_t m_Granularity = 16;
+		uint32_t m_UsedSize = 0;
+
+		// The same free ranges twice, by offset for merging and by size for best fit lookups
+		std::map<uint32_t, uint32_t> m_FreeByOffset;
+		std::multimap<uint32_t, uint32_t> m_FreeBySize;
+	};
+
+}
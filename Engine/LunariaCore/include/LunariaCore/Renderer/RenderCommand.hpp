@@ -1,6 +1,7 @@
 #pragma once
 
 #include "LunariaCore/Renderer/RendererAPI.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
 
 namespace Lunaria {
 
@@ -9,31 +10,76 @@ namespace Lunaria {
 	public:
 		static void Init()
 		{
+			s_RendererAPI = RendererAPI::Create();
 			s_RendererAPI->Init();
 		}
+
+		static void Shutdown()
+		{
+			s_RendererAPI.reset();
+		}
 		
 		static void SetClearColor(const glm::vec4& color)
 		{
-			s_RendererAPI->SetClearColor(color);
+			RenderThread::Submit([color] { s_RendererAPI->SetClearColor(color); });
 		}
 
 		static void Clear()
 		{
-			s_RendererAPI->Clear();
+			RenderThread::Submit([] { s_RendererAPI->Clear(); });
 		}
 
-		static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count = 0)
+		static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t count = 0, uint32_t instanceCount = 1)
 		{
-			s_RendererAPI->DrawIndexed(vertexArray, count);
+			RenderThread::Submit([vertexArray, count, instanceCount] { s_RendererAPI->DrawIndexed(vertexArray, count, instanceCount); });
 		}
 
 		static void SetViewport(const int x, const int y, const uint32_t width, const uint32_t height)
 		{
-			s_RendererAPI->SetViewport(x, y, width, height);
+			RenderThread::Submit([x, y, width, height] { s_RendererAPI->SetViewport(x, y, width, height); });
+		}
+
+		static void Dispatch(const uint32_t groupsX, const uint32_t groupsY = 1, const uint32_t groupsZ = 1)
+		{
+			RenderThread::Submit([groupsX, groupsY, groupsZ] { s_RendererAPI->Dispatch(groupsX, groupsY, groupsZ); });
+		}
+
+		static void Barrier(const uint32_t flags = BarrierAll)
+		{
+			RenderThread::Submit([flags] { s_RendererAPI->Barrier(flags); });
+		}
+
+		static void PushDebugGroup(const char* name)
+		{
+			RenderThread::Submit([name = std::string(name)] { s_RendererAPI->PushDebugGroup(name.c_str()); });
+		}
+
+		static void PopDebugGroup()
+		{
+			RenderThread::Submit([] { s_RendererAPI->PopDebugGroup(); });
+		}
+
+		static void ResetStateStats()
+		{
+			RenderThread::Submit([]
+			{
+				// The counters belong to the render thread, the finished frame is handed back
+				const RendererAPI::StateStatistics stats = s_RendererAPI->GetStateStats();
+				RenderThread::SubmitToMainThread([stats] { s_LastStateStats = stats; });
+
+				s_RendererAPI->ResetStateStats();
+			});
+		}
+
+		// With a render thread these are the counters of the last executed frame
+		static RendererAPI::StateStatistics GetStateStats()
+		{
+			return RenderThread::IsRunning() ? s_LastStateStats : s_RendererAPI->GetStateStats();
 		}
 
 	private:
 		static Scope<RendererAPI> s_RendererAPI;
+		static RendererAPI::StateStatistics s_LastStateStats;
 	};
 
 }
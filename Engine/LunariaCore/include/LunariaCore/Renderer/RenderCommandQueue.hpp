@@ -0,0 +1,64 @@
+#pragma once
+
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Lunaria {
+
+	// Linear buffer of type erased commands, recorded on one thread and executed on another.
+	// Commands and their data stay in place until Execute, memory is kept for the next frame.
+	class LUNARIA_API RenderCommandQueue
+	{
+	public:
+		using CommandFn = void(*)(void*);
+
+		static constexpr uint32_t PageSize = 1024 * 1024;
+
+		RenderCommandQueue() = default;
+		~RenderCommandQueue();
+
+		RenderCommandQueue(const RenderCommandQueue&) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+		template<typename FuncT>
+		void Submit(FuncT&& func)
+		{
+			using Command = std::decay_t<FuncT>;
+
+			// Calls the command and destroys it, the captures may own resources
+			auto execute = [](void* memory)
+			{
+				auto* command = static_cast<Command*>(memory);
+				(*command)();
+				command->~Command();
+			};
+
+			void* memory = Allocate(execute, sizeof(Command));
+			new (memory) Command(std::forward<FuncT>(func));
+		}
+
+		// Raw memory that lives until the queue was executed, for data copied with a command
+		void* AllocateData(uint32_t size) { return Allocate(nullptr, size); }
+
+		// Runs every command in submission order and resets the queue
+		void Execute();
+
+		uint32_t GetCommandCount() const { return m_CommandCount; }
+		bool IsEmpty() const { return m_CommandCount == 0; }
+	private:
+		void* Allocate(CommandFn fn, uint32_t size);
+	private:
+		struct Page
+		{
+			uint8_t* Memory = nullptr;
+			uint32_t Size = 0;
+			uint32_t Used = 0;
+		};
+
+		std::vector<Page> m_Pages;
+		uint32_t m_PageIndex = 0;
+		uint32_t m_CommandCount = 0;
+	};
+
+}
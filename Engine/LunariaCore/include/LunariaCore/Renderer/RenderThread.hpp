@@ -0,0 +1,104 @@
+#pragma once
+
+#include "LunariaCore/Renderer/RenderCommandQueue.hpp"
+
+#include <functional>
+
+namespace Lunaria {
+
+	class GraphicsContext;
+
+	// Optional dedicated thread that owns the graphics context and executes the frame.
+	// The main thread records frame N+1 into one queue while the render thread executes
+	// frame N from the other, EndFrame waits for N before handing over N+1.
+	//
+	// Backend code routes every graphics call through Submit, which runs it inline when the
+	// render thread is not running or when already on it. Resources created with CreateResource
+	// are built on the render thread and destroyed there, once the frame fence shows no
+	// recorded command can still reference them.
+	class LUNARIA_API RenderThread
+	{
+	public:
+		// Must be called before the Application is created, only the OpenGL backend records through the queue
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		static void Start(GraphicsContext& context);
+		static void Stop();
+
+		static bool IsRunning();
+		static bool IsRenderThread();
+
+		template<typename FuncT>
+		static void Submit(FuncT&& func)
+		{
+			if (!IsRecording())
+			{
+				func();
+				return;
+			}
+
+			GetRecordQueue().Submit(std::forward<FuncT>(func));
+		}
+
+		// Copies data that is read by a command submitted afterwards, e.g. buffer contents.
+		// Returns the data itself when commands are executed inline.
+		static const void* CopyFrameData(const void* data, uint32_t size);
+
+		// Runs func on the render thread and waits for it, together with everything recorded before
+		template<typename FuncT>
+		static void ExecuteSync(FuncT&& func)
+		{
+			if (!IsRecording())
+			{
+				func();
+				return;
+			}
+
+			GetRecordQueue().Submit(std::forward<FuncT>(func));
+			Flush();
+		}
+
+		// Hands the recorded commands to the render thread and waits until they were executed
+		static void Flush();
+
+		// Closes the recorded frame. Waits for the previous frame, then starts executing this one.
+		static void EndFrame();
+
+		// Frame fence, a frame is completed once the render thread executed all of its commands
+		static uint64_t GetRecordFrame();
+		static uint64_t GetCompletedFrame();
+		static void WaitForFrame(uint64_t frame);
+
+		// Runs on the render thread once the frame being recorded has completed
+		static void SubmitResourceFree(std::function<void()>&& func);
+
+		// Runs on the main thread at the next EndFrame while the render thread is idle,
+		// for results that recording code reads
+		static void SubmitToMainThread(std::function<void()>&& func);
+
+		template<typename T, typename... Args>
+		static Ref<T> CreateResource(Args&&... args)
+		{
+			T* resource = nullptr;
+			ExecuteSync([&] { resource = new T(std::forward<Args>(args)...); });
+
+			// The last reference may be dropped while commands using the resource are still queued
+			return Ref<T>(resource, [](T* released) { SubmitResourceFree([released] { delete released; }); });
+		}
+
+		struct Statistics
+		{
+			uint32_t RecordedCommands = 0;
+			uint32_t Flushes = 0; // Mid frame syncs, every one stalls the main thread
+			float WaitMilliseconds = 0.0f; // Main thread time spent waiting on the render thread
+			float ExecuteMilliseconds = 0.0f; // Render thread time of the last completed frame
+		};
+
+		static Statistics GetStats();
+	private:
+		static bool IsRecording();
+		static RenderCommandQueue& GetRecordQueue();
+	};
+
+}
@@ -3,6 +3,7 @@
 #include "LunariaCore/Renderer/Shader.hpp"
 #include "LunariaCore/Renderer/RenderCommand.hpp"
 #include "LunariaCore/Renderer/OrthographicCamera.hpp"
+#include "LunariaCore/Renderer/TextureStreamer.hpp"
 
 namespace Lunaria {
 
@@ -19,11 +20,32 @@ namespace Lunaria {
 		static void Submit(const Ref<Shader>& shader,
 			const Ref<VertexArray>& vertexArray, glm::mat4 transform = glm::mat4(1.0f));
 
+		// Batched path, meshes sharing a shader and vertex format are drawn with one indirect
+		// multi-draw in EndScene. The shader reads its transform from the storage buffer at
+		// binding 0 with gl_DrawID (see FlatColorIndirect.lusf). A full batch is flushed early.
+		// Meshes that can't be batched go to Submit with the fallback shader, which reads
+		// u_Transform like any other (see FlatColor.lusf).
+		static void SubmitBatched(const Ref<Shader>& shader, const Ref<Shader>& fallbackShader,
+			const Ref<VertexArray>& vertexArray, const glm::mat4& transform = glm::mat4(1.0f));
+
 		static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
+
+		static TextureStreamer& GetTextureStreamer();
+
+		struct Statistics
+		{
+			uint32_t DrawCalls = 0;
+			uint32_t MeshCount = 0;
+			uint32_t BatchedMeshCount = 0;
+		};
+
+		static void ResetStats();
+		static Statistics GetStats();
 	private:
 		struct SceneData
 		{
 			glm::mat4 ViewProjectionMatrix;
+			Statistics Stats;
 		};
 
 		static Scope<SceneData> s_SceneData;
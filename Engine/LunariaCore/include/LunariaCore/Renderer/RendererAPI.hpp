@@ -6,6 +6,19 @@
 
 namespace Lunaria {
 
+	// What a Barrier makes shader storage writes visible to
+	enum MemoryBarrierFlags : uint32_t
+	{
+		BarrierStorageBuffer = BIT(0), // Storage buffer reads of later shaders
+		BarrierVertexBuffer = BIT(1),
+		BarrierIndexBuffer = BIT(2),
+		BarrierIndirectCommand = BIT(3),
+		BarrierTextureFetch = BIT(4),
+		BarrierShaderImage = BIT(5),
+		BarrierBufferUpdate = BIT(6), // SetData and GetData on the CPU side
+		BarrierAll = 0xffffffff
+	};
+
 	class LUNARIA_API RendererAPI
 	{
 	public:
@@ -13,10 +26,20 @@ namespace Lunaria {
 		
 		enum class API
 		{
-			None = 0,
+			None = 0, // Null backend, no GPU work (see NullDevice)
 			OpenGL = 1,
 			// DirectX = 2,
-			// Vulkan = 3
+			Vulkan = 3, // Multi-threaded command recording (see VulkanCommandStream)
+			Software = 4 // Multi-threaded CPU rasterizer (see SoftwareRasterizer)
+		};
+
+		// Redundant state elimination counters of the backend
+		struct StateStatistics
+		{
+			uint32_t IssuedCalls = 0;
+			uint32_t SkippedCalls = 0;
+
+			uint32_t GetTotalCalls() const { return IssuedCalls + SkippedCalls; }
 		};
 
 		virtual void Init() = 0;
@@ -26,9 +49,25 @@ namespace Lunaria {
 		virtual void SetClearColor(const glm::vec4& color) = 0;
 		virtual void Clear() = 0;
 
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
+		// Per instance streams (BufferLayout step rate) advance once per instance
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t instanceCount = 1) = 0;
+
+		// Runs the bound compute shader, the counts are work groups
+		virtual void Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) = 0;
+		// Orders shader storage writes before later reads, takes MemoryBarrierFlags
+		virtual void Barrier(uint32_t flags) = 0;
+
+		// Named regions shown by graphics debuggers (RenderDoc, Nsight)
+		virtual void PushDebugGroup(const char* name) = 0;
+		virtual void PopDebugGroup() = 0;
+
+		virtual void ResetStateStats() = 0;
+		virtual StateStatistics GetStateStats() const = 0;
 
 		static API GetAPI() { return s_RendererAPI; }
+
+		// Must be called before Renderer::Init, every resource is created for the API chosen here
+		static void SetAPI(API api) { s_RendererAPI = api; }
 		static Scope<RendererAPI> Create();
 	private:
 		static API s_RendererAPI;
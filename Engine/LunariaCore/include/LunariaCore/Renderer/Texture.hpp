@@ -2,6 +2,34 @@
 
 namespace Lunaria {
 
+    enum class TextureFilter
+    {
+        None = 0, // Only valid as MipFilter, no mip chain is allocated
+        Nearest,
+        Linear
+    };
+
+    enum class TextureWrap
+    {
+        Repeat = 0,
+        MirroredRepeat,
+        ClampToEdge
+    };
+
+    struct TextureSpecification
+    {
+        TextureFilter MinFilter = TextureFilter::Linear;
+        TextureFilter MagFilter = TextureFilter::Nearest;
+        TextureFilter MipFilter = TextureFilter::Linear;
+
+        TextureWrap Wrap = TextureWrap::Repeat;
+
+        // Clamped to what the device supports, 1 disables anisotropic filtering
+        float MaxAnisotropy = 8.0f;
+
+        bool operator==(const TextureSpecification& other) const = default;
+    };
+
     class LUNARIA_API Texture
     {
     public:
@@ -11,6 +39,11 @@ namespace Lunaria {
         virtual uint32_t GetHeight() const = 0;
         virtual uint32_t GetRendererID() const = 0;
 
+        // False while an asynchronously created texture still shows its placeholder
+        virtual bool IsLoaded() const = 0;
+
+        virtual const TextureSpecification& GetSpecification() const = 0;
+
         virtual void SetData(void* data, uint32_t size) = 0;
         virtual void Bind(uint32_t slot = 0) const = 0;
     };
@@ -18,8 +51,12 @@ namespace Lunaria {
     class LUNARIA_API Texture2D : public Texture
     {
     public:
-        static Ref<Texture2D> Create(const std::string& path);
-        static Ref<Texture2D> Create(uint32_t width, uint32_t height);
+        // Mip chains are generated after every upload unless MipFilter is None
+        static Ref<Texture2D> Create(const std::string& path, const TextureSpecification& specification = {});
+        static Ref<Texture2D> Create(uint32_t width, uint32_t height, const TextureSpecification& specification = {});
+
+        // Returns immediately, see TextureStreamer
+        static Ref<Texture2D> CreateAsync(const std::string& path, const TextureSpecification& specification = {});
 
         virtual bool operator==(const Texture2D& other) const = 0;
     };
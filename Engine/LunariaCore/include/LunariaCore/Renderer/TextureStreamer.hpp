@@ -0,0 +1,45 @@
+#pragma once
+
+#include "LunariaCore/Renderer/Texture.hpp"
+
+namespace Lunaria {
+
+	struct TextureStreamerSpecification
+	{
+		uint32_t WorkerCount = 2;
+
+		// Staging memory, split into one region per frame in flight
+		uint32_t StagingBufferSize = 48 * 1024 * 1024;
+
+		// Bytes uploaded per frame at most, large images are uploaded in row slices over several frames
+		uint32_t UploadBudget = 8 * 1024 * 1024;
+	};
+
+	// Loads textures without blocking the frame. Images are decoded on worker threads and
+	// uploaded through a staging ring within a per-frame budget. Until then the returned
+	// texture shows a placeholder, check Texture::IsLoaded.
+	class LUNARIA_API TextureStreamer
+	{
+	public:
+		struct Statistics
+		{
+			uint32_t PendingDecodes = 0;
+			uint32_t PendingUploads = 0;
+			uint32_t UploadedBytes = 0; // This frame
+			uint32_t LoadedTextures = 0;
+			uint32_t FailedTextures = 0;
+		};
+
+		virtual ~TextureStreamer() = default;
+
+		virtual Ref<Texture2D> Load(const std::string& path, const TextureSpecification& specification = {}) = 0;
+
+		// Uploads decoded images, call once per frame on the thread owning the graphics context
+		virtual void Update() = 0;
+
+		virtual Statistics GetStats() const = 0;
+
+		static Scope<TextureStreamer> Create(const TextureStreamerSpecification& specification = {});
+	};
+
+}
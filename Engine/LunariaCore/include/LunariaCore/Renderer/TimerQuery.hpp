@@ -0,0 +1,22 @@
+#pragma once
+
+namespace Lunaria {
+
+	// Pool of GPU timestamp queries, results are read back without stalling
+	class LUNARIA_API TimerQueryPool
+	{
+	public:
+		virtual ~TimerQueryPool() = default;
+
+		// Records the GPU time once all previously submitted commands have completed
+		virtual void WriteTimestamp(uint32_t query) = 0;
+
+		virtual bool IsResultAvailable(uint32_t query) const = 0;
+		virtual uint64_t GetResultNanoseconds(uint32_t query) const = 0;
+
+		virtual uint32_t GetCount() const = 0;
+
+		static Scope<TimerQueryPool> Create(uint32_t count);
+	};
+
+}
@@ -12,7 +12,13 @@ namespace Lunaria {
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
+		// Adds a stream, its attributes take the locations after those of the previous buffers
 		virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) = 0;
+
+		// Points the stream at 'index' to another buffer of the same layout, the vertex format is
+		// kept, so meshes of one format can share a vertex array
+		virtual void SetVertexBuffer(uint32_t index, const Ref<VertexBuffer>& vertexBuffer) = 0;
+
 		virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) = 0;
 
 		virtual const std::vector<Ref<VertexBuffer>> GetVertexBuffers() const = 0;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+namespace Lunaria {
+
+	// Entities whose component was added, patched or removed since the observer was last cleared,
+	// each listed once. Removals are listed too, the entity may have lost the component or be gone
+	// when the list is read. Writes through a plain reference aren't seen, they have to go through
+	// Entity::PatchComponent. A reset observer lists nothing, anything may have changed and the
+	// subsystem starts over. Observers start reset, see Scene::Observe.
+	class LUNARIA_API ComponentObserver
+	{
+	public:
+		using Connector = void(*)(ComponentObserver& observer, entt::registry& registry, bool connect);
+
+		ComponentObserver(Connector connector)
+			: m_Connector(connector) {}
+
+		ComponentObserver(const ComponentObserver&) = delete;
+		ComponentObserver& operator=(const ComponentObserver&) = delete;
+
+		const std::vector<entt::entity>& GetEntities() const { return m_Entities; }
+		bool IsReset() const { return m_Reset; }
+		bool IsEmpty() const { return m_Entities.empty() && !m_Reset; }
+
+		// Once the changes are handled
+		void Clear();
+		void Reset();
+
+		template<typename T>
+		static void Connect(ComponentObserver& observer, entt::registry& registry, const bool connect)
+		{
+			if (connect)
+			{
+				registry.on_construct<T>().template connect<&ComponentObserver::OnChange>(observer);
+				registry.on_update<T>().template connect<&ComponentObserver::OnChange>(observer);
+				registry.on_destroy<T>().template connect<&ComponentObserver::OnChange>(observer);
+			}
+			else
+			{
+				registry.on_construct<T>().disconnect(&observer);
+				registry.on_update<T>().disconnect(&observer);
+				registry.on_destroy<T>().disconnect(&observer);
+			}
+		}
+	private:
+		void OnChange(entt::registry& registry, entt::entity entity);
+	private:
+		Connector m_Connector;
+
+		std::vector<entt::entity> m_Entities;
+		std::vector<uint32_t> m_Positions; // By entity index, position in m_Entities plus one
+		bool m_Reset = true;
+
+		friend class Scene;
+	};
+
+}
@@ -1,38 +1,67 @@
 #pragma once
 
+#include "LunariaCore/Core/StringID.hpp"
 #include "LunariaCore/Renderer/Camera.hpp"
 
 #include "LunariaCore/Scene/SceneCamera.hpp"
 #include "LunariaCore/Scene/ScriptableEntity.hpp"
 
+#include <entt/entt.hpp>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace Lunaria {
 
+	// Interned, entities with the same name share the characters
 	struct TagComponent
 	{
-		std::string Tag;
+		StringID Tag;
 
 		TagComponent() = default;
 		TagComponent(const TagComponent&) = default;
-		explicit TagComponent(const std::string& tag)
+		explicit TagComponent(const StringID tag)
+			: Tag(tag) {}
+		explicit TagComponent(const std::string_view tag)
 			: Tag(tag) {}
 	};
 
+	// Local translation, rotation and scale. The matrix is cached in WorldTransformComponent and only
+	// rebuilt for dirty transforms, so writes must go through the setters, Entity::PatchComponent,
+	// or be followed by MarkDirty.
 	struct TransformComponent
 	{
 		glm::vec3 Translation = { 0.0f, 0.0f, 0.0f };
 		glm::vec3 Rotation = { 0.0f, 0.0f, 0.0f };
 		glm::vec3 Scale = { 1.0f, 1.0f, 1.0f };
 
+		bool Dirty = true;
+
 		TransformComponent() = default;
 		TransformComponent(const TransformComponent&) = default;
 		TransformComponent(const glm::vec3& translation)
 			: Translation(translation) {}
 
+		void SetTranslation(const glm::vec3& translation) { Translation = translation; Dirty = true; }
+		void SetRotation(const glm::vec3& rotation) { Rotation = rotation; Dirty = true; }
+		void SetScale(const glm::vec3& scale) { Scale = scale; Dirty = true; }
+		void MarkDirty() { Dirty = true; }
+
 		glm::mat4 GetTransform() const
 		{
+			// 2D fast path, only rotated around Z
+			if (Rotation.x == 0.0f && Rotation.y == 0.0f)
+			{
+				const float c = std::cos(Rotation.z);
+				const float s = std::sin(Rotation.z);
+
+				return glm::mat4(
+					c * Scale.x, s * Scale.x, 0.0f, 0.0f,
+					-s * Scale.y, c * Scale.y, 0.0f, 0.0f,
+					0.0f, 0.0f, Scale.z, 0.0f,
+					Translation.x, Translation.y, Translation.z, 1.0f);
+			}
+
 			glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), Rotation.x, { 1, 0, 0 })
 				* glm::rotate(glm::mat4(1.0f), Rotation.y, { 0, 1, 0 })
 				* glm::rotate(glm::mat4(1.0f), Rotation.z, { 0, 0, 1 });
@@ -43,6 +72,31 @@ namespace Lunaria {
 		}
 	};
 
+	// Added and kept up to date by the Scene, read it instead of calling GetTransform.
+	// The parent's world transform times the local one.
+	struct WorldTransformComponent
+	{
+		glm::mat4 Transform{ 1.0f };
+		bool Changed = true; // Rebuilt by the last propagation, the children follow
+
+		WorldTransformComponent() = default;
+		WorldTransformComponent(const WorldTransformComponent&) = default;
+	};
+
+	// Links of the entity hierarchy, added with the transform. Change it through Scene::SetParent.
+	struct RelationshipComponent
+	{
+		entt::entity Parent = entt::null;
+		entt::entity FirstChild = entt::null;
+		entt::entity NextSibling = entt::null;
+		entt::entity PreviousSibling = entt::null;
+		uint32_t Children = 0;
+		uint32_t Depth = 0; // Roots are 0
+
+		RelationshipComponent() = default;
+		RelationshipComponent(const RelationshipComponent&) = default;
+	};
+
 	struct SpriteRendererComponent
 	{
 		glm::vec4 Color{ 1.0f, 1.0f, 1.0f, 1.0f };
@@ -64,18 +118,63 @@ namespace Lunaria {
 		CameraComponent(const CameraComponent&) = default;
 	};
 
+	// Simulated by the scene's PhysicsWorld2D in the XY plane, the body follows the translation and
+	// Z rotation of the transform. Bodies are expected to be roots of the hierarchy.
+	struct Rigidbody2DComponent
+	{
+		enum class BodyType { Static = 0, Dynamic, Kinematic };
+		BodyType Type = BodyType::Static;
+		bool FixedRotation = false;
+		float GravityScale = 1.0f;
+
+		// Written back every step, setting them wakes the body up
+		glm::vec2 LinearVelocity = { 0.0f, 0.0f };
+		float AngularVelocity = 0.0f;
+		bool Awake = true;
+
+		Rigidbody2DComponent() = default;
+		Rigidbody2DComponent(const Rigidbody2DComponent&) = default;
+	};
+
+	// Colliders are sized in local space and scaled with the transform. A body uses its box, or its
+	// circle when it has no box, colliders without a Rigidbody2DComponent are ignored.
+	struct BoxCollider2DComponent
+	{
+		glm::vec2 Offset = { 0.0f, 0.0f };
+		glm::vec2 Size = { 0.5f, 0.5f }; // Half extents, fits the unit quad of a sprite
+
+		float Density = 1.0f;
+		float Friction = 0.5f;
+		float Restitution = 0.0f;
+
+		BoxCollider2DComponent() = default;
+		BoxCollider2DComponent(const BoxCollider2DComponent&) = default;
+	};
+
+	struct CircleCollider2DComponent
+	{
+		glm::vec2 Offset = { 0.0f, 0.0f };
+		float Radius = 0.5f;
+
+		float Density = 1.0f;
+		float Friction = 0.5f;
+		float Restitution = 0.0f;
+
+		CircleCollider2DComponent() = default;
+		CircleCollider2DComponent(const CircleCollider2DComponent&) = default;
+	};
+
 	struct NativeScriptComponent
 	{
 		ScriptableEntity* Instance = nullptr;
 
-		ScriptableEntity* (*InstantiateScript)();
-		void (*DestroyScript)(NativeScriptComponent*);
+		// The instance is allocated from the scene's pool for the type, see Scene::OnScenePlay
+		ScriptPoolFactory CreatePool = nullptr;
 
 		template<typename T>
 		void Bind()
 		{
-			InstantiateScript = []() { return static_cast<ScriptableEntity*>(new T()); };
-			DestroyScript = [](NativeScriptComponent* nsc) { delete nsc->Instance; nsc->Instance = nullptr; };
+			CreatePool = []() -> Scope<ScriptPool> { return CreateScope<TypedScriptPool<T>>(); };
 		}
 	};
 
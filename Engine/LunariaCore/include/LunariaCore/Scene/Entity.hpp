@@ -6,6 +6,47 @@
 
 namespace Lunaria {
 
+	// A component of one entity with its storage and address looked up once. Components move around
+	// as their storage is sorted or others are removed, the cached address is used as long as the
+	// entity is still found at the cached position of the packed array. Pages of a storage never
+	// move, so the component is still at the same address then. Otherwise it is looked up again.
+	template<typename T>
+	class ComponentRef
+	{
+	public:
+		ComponentRef() = default;
+		ComponentRef(entt::storage_for_t<T>& storage, const entt::entity entity)
+			: m_Storage(&storage), m_EntityHandle(entity) {}
+
+		T& Get() const
+		{
+			if (!IsCached())
+			{
+				LU_CORE_ASSERT(m_Storage && m_Storage->contains(m_EntityHandle), "Entity does not have component!");
+				m_Index = m_Storage->index(m_EntityHandle);
+				m_Component = &m_Storage->get(m_EntityHandle);
+			}
+
+			return *m_Component;
+		}
+
+		T& operator*() const { return Get(); }
+		T* operator->() const { return &Get(); }
+
+		explicit operator bool() const { return m_Storage && (IsCached() || m_Storage->contains(m_EntityHandle)); }
+	private:
+		bool IsCached() const
+		{
+			return m_Component && m_Index < m_Storage->size() && m_Storage->data()[m_Index] == m_EntityHandle;
+		}
+	private:
+		entt::storage_for_t<T>* m_Storage = nullptr;
+		entt::entity m_EntityHandle{ entt::null };
+
+		mutable T* m_Component = nullptr;
+		mutable size_t m_Index = 0; // Of m_Component in the packed array
+	};
+
 	class LUNARIA_API Entity
 	{
 	public:
@@ -28,6 +69,22 @@ namespace Lunaria {
 			return m_Scene->m_Registry.get<T>(m_EntityHandle);
 		}
 
+		// For components used every frame, skips looking the storage up by type
+		template<typename T>
+		ComponentRef<T> GetComponentRef()
+		{
+			LU_CORE_ASSERT(HasComponent<T>(), "Entity does not have component!");
+			return { m_Scene->m_Registry.storage<T>(), m_EntityHandle };
+		}
+
+		// Modifies the component through the registry, so on_update listeners see the change
+		template<typename T, typename... Func>
+		T& PatchComponent(Func&&... func)
+		{
+			LU_CORE_ASSERT(HasComponent<T>(), "Entity does not have component!");
+			return m_Scene->m_Registry.patch<T>(m_EntityHandle, std::forward<Func>(func)...);
+		}
+
 		template<typename T>
 		bool HasComponent() const
 		{
@@ -41,6 +98,9 @@ namespace Lunaria {
 			m_Scene->m_Registry.remove<T>(m_EntityHandle);
 		}
 
+		void SetParent(Entity parent);
+		Entity GetParent() const;
+
 		explicit operator bool() const { return m_EntityHandle != entt::null; }
 		operator entt::entity() const { return m_EntityHandle; }
 		operator uint32_t() const { return static_cast<uint32_t>(m_EntityHandle); }
@@ -1,12 +1,20 @@
 #pragma once
 
 #include "LunariaCore/Core/Timestep.hpp"
+#include "LunariaCore/Physics/PhysicsWorld2D.hpp"
+#include "LunariaCore/Scene/ComponentObserver.hpp"
+#include "LunariaCore/Scene/SystemScheduler.hpp"
+#include "LunariaCore/Scene/SceneSnapshot.hpp"
+#include "LunariaCore/Scene/ScriptPool.hpp"
+#include "LunariaCore/Scene/SpatialGrid.hpp"
 
 #include <entt/entt.hpp>
 
 namespace Lunaria {
 
 	class Entity;
+	class ThreadPool;
+	struct NativeScriptComponent;
 
 	class LUNARIA_API Scene
 	{
@@ -14,20 +22,162 @@ namespace Lunaria {
 		Scene();
 		~Scene();
 
-		Entity CreateEntity(const std::string& name = std::string());
+		// Same entities with the same ids and systems, the copy is not playing
+		static Ref<Scene> Copy(const Ref<Scene>& other);
+
+		// Instantiates every bound script from the pool of its type and calls OnCreate. Scripts
+		// added while playing are instantiated before the next update. Scripts only run while playing.
+		void OnScenePlay();
+		// Calls OnDestroy and releases every script instance
+		void OnSceneStop();
+		bool IsPlaying() const { return m_Playing; }
+
+		void TakeSnapshot(SceneSnapshot& snapshot) const;
+		// Script instances of entities that still have the same script keep running with their
+		// current state, the others are destroyed. Scripts own state is not rolled back. While
+		// playing, scripts that have no instance anymore are instantiated again.
+		void RestoreSnapshot(const SceneSnapshot& snapshot);
+
+		Entity CreateEntity(std::string_view name = {});
+		// Same components as CreateEntity, appended to outEntities. The storages grow once and the
+		// name is interned once, so a burst doesn't allocate per entity.
+		void CreateEntities(uint32_t count, std::vector<Entity>& outEntities, std::string_view name = {});
+		// Destroys the children too
 		void DestroyEntity(Entity entity);
 
+		// A null parent makes the entity a root, the local transform is kept as is
+		void SetParent(Entity entity, Entity parent);
+		Entity GetParent(Entity entity);
+
+		// Systems run in registration order, after the scripts and the physics and before the
+		// transforms are propagated. Every component a system touches has to be listed, see SystemScheduler.
+		template<typename... Read, typename... Write>
+		uint32_t AddSystem(const std::string& name, Reads<Read...>, Writes<Write...>, SystemFunction function, bool mainThread = false)
+		{
+			// Creating a storage isn't thread safe, concurrent systems must only find existing ones
+			(m_Registry.storage<Read>(), ...);
+			(m_Registry.storage<Write>(), ...);
+
+			return m_Scheduler.Add({ name, { entt::type_hash<Read>::value()... }, { entt::type_hash<Write>::value()... }, mainThread }, std::move(function));
+		}
+		void RemoveSystem(uint32_t id) { m_Scheduler.Remove(id); }
+
+		// Calls function(entity, components&...) for every entity having all the components, split
+		// into chunks over the worker threads. Serial inside a system sharing its wave with others.
+		template<typename... Components, typename Func>
+		void ParallelEach(Func function, uint32_t chunkSize = 1024)
+		{
+			const auto view = m_Registry.view<Components...>();
+			const entt::sparse_set& leading = *view.handle();
+
+			ParallelRange(static_cast<uint32_t>(leading.size()), chunkSize, [&](const uint32_t begin, const uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
+				{
+					const entt::entity entity = leading.data()[i];
+					if (view.contains(entity))
+						function(entity, view.template get<Components>(entity)...);
+				}
+			});
+		}
+
+		// Sprites by their world space bounds in the XY plane, as of the last update. Results are
+		// appended in no particular order. Raycast returns an invalid entity when nothing is hit.
+		void QueryAABB(const glm::vec2& min, const glm::vec2& max, std::vector<Entity>& outEntities);
+		void QueryRadius(const glm::vec2& center, float radius, std::vector<Entity>& outEntities);
+		Entity Raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, float* outDistance = nullptr);
+
+		// Changes of component T from now on, for subsystems that only redo what changed. Cleared by
+		// the caller once handled. Owned by the scene, valid until StopObserving.
+		template<typename T>
+		ComponentObserver& Observe()
+		{
+			ComponentObserver& observer = *m_Observers.emplace_back(CreateScope<ComponentObserver>(&ComponentObserver::Connect<T>));
+			ComponentObserver::Connect<T>(observer, m_Registry, true);
+			return observer;
+		}
+		void StopObserving(ComponentObserver& observer);
+
+		// Steps the bodies as a system right after the scripts
+		PhysicsWorld2D& GetPhysicsWorld() { return m_PhysicsWorld; }
+
 		void OnUpdate(Timestep timestep);
 		void OnViewportResize(uint32_t width, uint32_t height);
 	private:
 		template<typename T>
 		void OnComponentAdded(Entity entity, T& component);
+
+		void ConnectSignals();
+		void DisconnectSignals();
+
+		void UpdateScripts(Timestep timestep);
+		void UpdateCameras();
+		void InstantiateScript(entt::entity entity, NativeScriptComponent& script);
+		void DestroyScript(NativeScriptComponent& script);
+		ScriptPool& GetScriptPool(ScriptPoolFactory factory);
+		void RenderScene();
+
+		ThreadPool& GetWorkers();
+		void ParallelRange(uint32_t count, uint32_t chunkSize, const std::function<void(uint32_t, uint32_t)>& function);
+
+		void UpdateWorldTransforms();
+		void SortHierarchy();
+		void UpdateSpatialIndex();
+
+		void DetachFromParent(entt::entity entity);
+		void UpdateDepth(entt::entity entity, uint32_t depth);
+
+		void OnTransformConstruct(entt::registry& registry, entt::entity entity);
+		void OnTransformUpdate(entt::registry& registry, entt::entity entity);
+		void OnTransformDestroy(entt::registry& registry, entt::entity entity);
+		void OnRelationshipDestroy(entt::registry& registry, entt::entity entity);
+		void OnSpriteConstruct(entt::registry& registry, entt::entity entity);
+		void OnSpriteDestroy(entt::registry& registry, entt::entity entity);
+		void OnRigidbodyConstruct(entt::registry& registry, entt::entity entity);
+		void OnRigidbodyDestroy(entt::registry& registry, entt::entity entity);
+		void OnColliderChange(entt::registry& registry, entt::entity entity);
+		void OnScriptConstruct(entt::registry& registry, entt::entity entity);
+		void OnScriptDestroy(entt::registry& registry, entt::entity entity);
 	private:
 		entt::registry m_Registry;
 		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
 
+		// Transform storages are sorted by depth, propagation walks them level by level
+		bool m_HierarchyDirty = true;
+		// By packed index of the sorted storages, which is the reverse of their iteration order
+		std::vector<uint32_t> m_ParentIndices; // Packed index of the parent
+		// Lowest packed index of every depth. Depth 0 runs to the end of the storages, so a new root
+		// appended there is in place without sorting, every other depth runs up to the one before it
+		std::vector<uint32_t> m_LevelOffsets;
+
+		// Sprite bounds, moved only for changed transforms and sprites added since the last update
+		SpatialGrid m_SpatialIndex;
+		std::vector<entt::entity> m_SpatialPending;
+		bool m_SpatialIndexDirty = true; // Rebuilt from scratch, e.g. after a copy
+		std::vector<entt::entity> m_VisibleSprites;
+
+		PhysicsWorld2D m_PhysicsWorld;
+
+		// Updated in the order the types were first instantiated
+		std::vector<std::pair<ScriptPoolFactory, Scope<ScriptPool>>> m_ScriptPools;
+		std::vector<entt::entity> m_PendingScripts; // Added while playing
+		bool m_Playing = false;
+
+		std::vector<entt::entity> m_CreatedEntities; // Scratch of CreateEntities
+
+		// Disconnected and reset around copies into the registry, nothing is signaled one by one there
+		std::vector<Scope<ComponentObserver>> m_Observers;
+
+		// Looked for again only when a camera changed
+		ComponentObserver* m_CameraChanges = nullptr;
+		entt::entity m_PrimaryCamera = entt::null;
+
+		SystemScheduler m_Scheduler;
+		Scope<ThreadPool> m_Workers; // Shared by the systems and the transform propagation
+
 		friend class Entity;
 		friend class SceneHierarchyPanel;
+		friend class SceneSerializer;
 	};
 
 }
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "LunariaCore/Scene/Scene.hpp"
+
+namespace Lunaria {
+
+	// Binary scene files, one block per component type holding a column of entity indices and a
+	// column of components. Trivially copyable components are stored as they are in memory and
+	// loaded straight from the memory mapped file, tags go into a string table.
+	// Native scripts and the derived world transforms are not stored.
+	class LUNARIA_API SceneSerializer
+	{
+	public:
+		SceneSerializer(const Ref<Scene>& scene);
+
+		bool Serialize(const std::string& path);
+		// The scene has to be a newly created one, entities keep the indices they were saved with
+		bool Deserialize(const std::string& path);
+	private:
+		Ref<Scene> m_Scene;
+	};
+
+}
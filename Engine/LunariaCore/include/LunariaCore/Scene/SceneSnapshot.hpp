@@ -0,0 +1,58 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+namespace Lunaria {
+
+	class Scene;
+
+	// Components of a scene at one point in time, entity ids included. Taking a snapshot into an
+	// old one reuses its memory. Script instances are not part of it, see Scene::RestoreSnapshot.
+	class LUNARIA_API SceneSnapshot
+	{
+	public:
+		uint64_t GetFrame() const { return m_Frame; }
+		bool IsValid() const { return m_Valid; }
+	private:
+		entt::registry m_Registry;
+		uint64_t m_Frame = 0;
+
+		// Sorted hierarchy of the copied storages, a restore doesn't have to sort again
+		std::vector<uint32_t> m_ParentIndices;
+		std::vector<uint32_t> m_LevelOffsets;
+		bool m_HierarchyDirty = true;
+
+		bool m_Valid = false;
+
+		friend class Scene;
+		friend class SceneSnapshotRing;
+	};
+
+	// The last few snapshots of a scene for rollback and replays, the oldest is overwritten once
+	// the ring is full. Frames are expected to be captured in increasing order.
+	class LUNARIA_API SceneSnapshotRing
+	{
+	public:
+		SceneSnapshotRing(uint32_t capacity);
+
+		const SceneSnapshot& Capture(const Scene& scene, uint64_t frame);
+
+		// Newest snapshot taken at or before the frame, nullptr once it left the ring
+		const SceneSnapshot* Find(uint64_t frame) const;
+		const SceneSnapshot* GetLatest() const;
+
+		// Drops the snapshots newer than the frame, they are captured again while re-simulating
+		void DiscardAfter(uint64_t frame);
+		void Clear();
+
+		uint32_t GetSize() const { return m_Size; }
+		uint32_t GetCapacity() const { return static_cast<uint32_t>(m_Snapshots.size()); }
+	private:
+		const SceneSnapshot& At(uint32_t age) const;
+	private:
+		std::vector<SceneSnapshot> m_Snapshots;
+		uint32_t m_Next = 0; // Slot the next capture goes to
+		uint32_t m_Size = 0;
+	};
+
+}
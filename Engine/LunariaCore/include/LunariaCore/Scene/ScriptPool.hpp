@@ -0,0 +1,31 @@
+#pragma once
+
+#include "LunariaCore/Core/Timestep.hpp"
+
+namespace Lunaria {
+
+	class ScriptableEntity;
+
+	// Instances of one script type, see TypedScriptPool. A scene keeps one pool per type and
+	// updates the pools one after the other.
+	class ScriptPool
+	{
+	public:
+		virtual ~ScriptPool() = default;
+
+		// Constructed in place, OnCreate/OnDestroy are left to the scene
+		virtual ScriptableEntity* Allocate() = 0;
+		virtual void Free(ScriptableEntity* instance) = 0;
+
+		// Calls OnUpdate of every instance in memory order
+		virtual void Update(Timestep timestep) = 0;
+
+		uint32_t GetSize() const { return m_Size; }
+	protected:
+		uint32_t m_Size = 0;
+	};
+
+	// Creates the pool of a script type, also identifies the type, see NativeScriptComponent::Bind
+	using ScriptPoolFactory = Scope<ScriptPool>(*)();
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "LunariaCore/Scene/Entity.hpp"
+#include "LunariaCore/Scene/ScriptPool.hpp"
 
 namespace Lunaria {
 
@@ -14,13 +15,131 @@ namespace Lunaria {
 		{
 			return m_Entity.GetComponent<T>();
 		}
+
+		// Meant to be taken in OnCreate and kept for the updates
+		template<typename T>
+		ComponentRef<T> GetComponentRef()
+		{
+			return m_Entity.GetComponentRef<T>();
+		}
 	protected:
 		virtual void OnCreate() {}
 		virtual void OnDestroy() {}
 		virtual void OnUpdate(Timestep ts) {}
 	private:
 		Entity m_Entity;
+
+		ScriptPool* m_Pool = nullptr;
+		uint32_t m_PoolSlot = 0;
+
 		friend class Scene;
+		template<typename T>
+		friend class TypedScriptPool;
+	};
+
+	// Scripts of type T packed into fixed size chunks, so they never move and neighbours in memory
+	// are updated one after the other. OnUpdate is called directly when the override is public.
+	template<typename T>
+	class TypedScriptPool final : public ScriptPool
+	{
+		static_assert(std::is_base_of_v<ScriptableEntity, T>, "Scripts have to derive from ScriptableEntity!");
+
+		static constexpr uint32_t s_ChunkSize = std::max<uint32_t>(16384 / sizeof(T), 16);
+
+		struct Chunk
+		{
+			alignas(T) std::byte Data[s_ChunkSize * sizeof(T)];
+		};
+	public:
+		~TypedScriptPool() override
+		{
+			for (uint32_t slot = 0; slot < m_Alive.size(); slot++)
+			{
+				if (m_Alive[slot])
+					GetSlot(slot)->~T();
+			}
+		}
+
+		ScriptableEntity* Allocate() override
+		{
+			uint32_t slot;
+			if (!m_FreeSlots.empty())
+			{
+				slot = m_FreeSlots.back();
+				m_FreeSlots.pop_back();
+			}
+			else
+			{
+				slot = static_cast<uint32_t>(m_Alive.size());
+				if (slot % s_ChunkSize == 0)
+					m_Chunks.push_back(CreateScope<Chunk>());
+				m_Alive.push_back(0);
+			}
+
+			ScriptableEntity* instance = new (GetSlot(slot)) T();
+			instance->m_Pool = this;
+			instance->m_PoolSlot = slot;
+
+			m_Alive[slot] = 1;
+			m_Size++;
+			return instance;
+		}
+
+		void Free(ScriptableEntity* instance) override
+		{
+			const uint32_t slot = instance->m_PoolSlot;
+			LU_CORE_ASSERT(instance->m_Pool == this && m_Alive[slot], "Script does not belong to this pool!");
+
+			m_Alive[slot] = 0;
+			m_Size--;
+
+			// A script destroying its own entity is still running, it's released once the update is over
+			if (m_Updating)
+			{
+				m_DeferredSlots.push_back(slot);
+				return;
+			}
+
+			Release(slot);
+		}
+
+		void Update(const Timestep timestep) override
+		{
+			m_Updating = true;
+			for (uint32_t slot = 0; slot < m_Alive.size(); slot++)
+			{
+				if (!m_Alive[slot])
+					continue;
+
+				T* instance = GetSlot(slot);
+				if constexpr (requires(T& script, Timestep ts) { script.T::OnUpdate(ts); })
+					instance->T::OnUpdate(timestep);
+				else
+					static_cast<ScriptableEntity*>(instance)->OnUpdate(timestep);
+			}
+			m_Updating = false;
+
+			for (const uint32_t slot : m_DeferredSlots)
+				Release(slot);
+			m_DeferredSlots.clear();
+		}
+	private:
+		T* GetSlot(const uint32_t slot)
+		{
+			return reinterpret_cast<T*>(m_Chunks[slot / s_ChunkSize]->Data + (slot % s_ChunkSize) * sizeof(T));
+		}
+
+		void Release(const uint32_t slot)
+		{
+			GetSlot(slot)->~T();
+			m_FreeSlots.push_back(slot);
+		}
+	private:
+		std::vector<Scope<Chunk>> m_Chunks;
+		std::vector<uint8_t> m_Alive; // By slot
+		std::vector<uint32_t> m_FreeSlots;
+		std::vector<uint32_t> m_DeferredSlots;
+		bool m_Updating = false;
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <glm/glm.hpp>
+
+namespace Lunaria {
+
+	// 2D bounding boxes of entities bucketed into a uniform grid of square cells, only the cells
+	// that hold something are allocated. A box is listed in every cell it overlaps, boxes spanning
+	// too many cells are kept aside and tested by every query instead.
+	// Queries don't modify anything, any number of them may run at once.
+	class LUNARIA_API SpatialGrid
+	{
+	public:
+		SpatialGrid(float cellSize = 4.0f);
+
+		// Inserts the entity or moves it to its new bounds
+		void Update(entt::entity entity, const glm::vec2& min, const glm::vec2& max);
+		void Remove(entt::entity entity);
+		void Clear();
+
+		bool Contains(entt::entity entity) const;
+		uint32_t GetCount() const { return m_Count; }
+		float GetCellSize() const { return m_CellSize; }
+
+		// Appends every entity whose bounds overlap the box, each once and in no particular order
+		void Query(const glm::vec2& min, const glm::vec2& max, std::vector<entt::entity>& outEntities) const;
+		void QueryRadius(const glm::vec2& center, float radius, std::vector<entt::entity>& outEntities) const;
+		// Closest entity whose bounds the ray enters within the distance, null when nothing is hit.
+		// The direction has to be normalized, rays starting inside bounds hit them at distance zero.
+		entt::entity Raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, float* outDistance = nullptr) const;
+	private:
+		using CellKey = uint64_t;
+
+		struct Item
+		{
+			glm::vec2 Min, Max;
+			glm::ivec2 FirstCell, LastCell;
+			entt::entity Entity = entt::null;
+			bool Oversized = false;
+		};
+
+		static CellKey GetKey(int32_t x, int32_t y);
+		glm::ivec2 GetCell(const glm::vec2& point) const;
+
+		void Link(uint32_t item);
+		void Unlink(uint32_t item);
+	private:
+		float m_CellSize;
+		float m_InverseCellSize;
+
+		// Slots of removed items are reused, cells keep pointing at the same index while an item moves
+		std::vector<Item> m_Items;
+		std::vector<uint32_t> m_FreeItems;
+		std::vector<uint32_t> m_ItemIndices; // By entity index
+		uint32_t m_Count = 0;
+
+		std::unordered_map<CellKey, std::vector<uint32_t>> m_Cells;
+		std::vector<uint32_t> m_Oversized;
+	};
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "LunariaCore/Core/Timestep.hpp"
+
+#include <entt/entt.hpp>
+
+namespace Lunaria {
+
+	class Scene;
+	class ThreadPool;
+
+	// Tags listing the components a system reads and writes, e.g. Reads<VelocityComponent>{}
+	template<typename... Components>
+	struct Reads {};
+	template<typename... Components>
+	struct Writes {};
+
+	using SystemFunction = std::function<void(Scene&, Timestep)>;
+
+	struct SystemSpecification
+	{
+		std::string Name;
+		std::vector<entt::id_type> Reads;
+		std::vector<entt::id_type> Writes;
+
+		// Runs on the thread calling Scene::OnUpdate, needed for rendering and anything
+		// that creates or destroys entities or adds and removes components
+		bool MainThread = false;
+		// Conflicts with every other system, for code whose access can't be declared, e.g. scripts
+		bool Exclusive = false;
+	};
+
+	// Runs the systems of a scene in waves. A system waits for every earlier registered system
+	// it conflicts with, one writing a component the other reads or writes, so the results are
+	// the same as running them one after another in registration order. Systems of one wave
+	// share no written components and run concurrently on the thread pool.
+	class LUNARIA_API SystemScheduler
+	{
+	public:
+		uint32_t Add(const SystemSpecification& specification, SystemFunction function);
+		void Remove(uint32_t id);
+
+		void Run(Scene& scene, Timestep timestep, ThreadPool& workers);
+
+		uint32_t GetSystemCount() const { return static_cast<uint32_t>(m_Systems.size()); }
+		uint32_t GetWaveCount();
+
+		// True on a thread running one of several concurrent systems, nested loops must stay serial
+		static bool IsRunningConcurrently();
+	private:
+		void BuildWaves();
+	private:
+		struct System
+		{
+			uint32_t ID;
+			SystemSpecification Specification;
+			SystemFunction Function;
+		};
+
+		std::vector<System> m_Systems; // Registration order
+		uint32_t m_NextID = 1;
+
+		// Indices into m_Systems, rebuilt only when the set of systems changes
+		std::vector<std::vector<uint32_t>> m_Waves;
+		bool m_WavesDirty = true;
+	};
+
+}
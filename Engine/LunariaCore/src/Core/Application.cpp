@@ -2,6 +2,10 @@
 
 #include "LunariaCore/Core/Application.hpp"
 #include "LunariaCore/Renderer/Renderer.hpp"
+#include "LunariaCore/Renderer/GPUProfiler.hpp"
+#include "LunariaCore/Renderer/FrameSync.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
+#include "LunariaCore/Renderer/GraphicsContext.hpp"
 
 #include <SDL/SDL.h>
 
@@ -64,27 +68,65 @@ namespace Lunaria {
 
 	void Application::Run()
 	{
+		// Layers were attached with the context on this thread, from here on the render thread owns it
+		if (RenderThread::IsEnabled())
+		{
+			if (Renderer::GetAPI() == RendererAPI::API::OpenGL)
+				RenderThread::Start(m_Window->GetGraphicsContext());
+			else
+				LU_CORE_WARN("The render thread needs the OpenGL backend, rendering on the main thread");
+		}
+
 		while (m_Running)
 		{
 			const float time = static_cast<float>(SDL_GetTicks()) / 1000.0f; // Convert milliseconds to seconds
 			const Timestep timestep = time - m_LastFrameTime;
 			m_LastFrameTime = time;
 
+			FrameSync::BeginFrame();
+			GPUProfiler::BeginFrame();
+
+			{
+				LU_GPU_SCOPE("Texture Streaming");
+				RenderThread::Submit([] { Renderer::GetTextureStreamer().Update(); });
+			}
+
 			if (!m_Minimized)
 			{
 				for (Layer* layer : m_LayerStack)
 					layer->OnUpdate(timestep);
 			}
 
+			GPUProfiler::BeginScope("ImGui");
 			m_ImGuiLayer->Begin();
 
 			for (Layer* layer : m_LayerStack)
 				layer->OnImGuiRender();
 
 			m_ImGuiLayer->End();
+			GPUProfiler::EndScope();
+
+			GPUProfiler::EndFrame();
 
-			m_Window->OnUpdate();
+			// Before presenting, the Vulkan backend counts the frame as submitted once it was presented
+			FrameSync::EndFrame();
+
+			if (RenderThread::IsRunning())
+			{
+				// Presenting is recorded like any other command, frame N+1 is updated while N executes
+				m_Window->PollEvents();
+
+				GraphicsContext* context = &m_Window->GetGraphicsContext();
+				RenderThread::Submit([context] { context->SwapBuffers(); });
+				RenderThread::EndFrame();
+			}
+			else
+			{
+				m_Window->OnUpdate();
+			}
 		}
+
+		RenderThread::Stop();
 	}
 
 	bool Application::OnWindowClose(WindowCloseEvent& e)
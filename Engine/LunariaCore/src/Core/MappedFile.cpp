@@ -0,0 +1,109 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Core/MappedFile.hpp"
+
+#ifdef LU_PLATFORM_LINUX
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace Lunaria {
+
+	MappedFile::MappedFile(const std::string& path)
+	{
+		Open(path);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+	#ifdef LU_PLATFORM_WINDOWS
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!data)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_File = file;
+		m_Mapping = mapping;
+		m_Data = static_cast<const uint8_t*>(data);
+		m_Size = static_cast<size_t>(size.QuadPart);
+	#elif defined(LU_PLATFORM_LINUX)
+		const int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+			return false;
+
+		struct stat status;
+		if (fstat(file, &status) != 0 || status.st_size == 0)
+		{
+			close(file);
+			return false;
+		}
+
+		void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		// The mapping keeps its own reference to the file
+		close(file);
+		if (data == MAP_FAILED)
+			return false;
+
+		// Read front to back, let the kernel read ahead
+		madvise(data, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+
+		m_Data = static_cast<const uint8_t*>(data);
+		m_Size = static_cast<size_t>(status.st_size);
+	#else
+		LU_CORE_ASSERT(false, "Unknown platform!");
+		return false;
+	#endif
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (!m_Data)
+			return;
+
+	#ifdef LU_PLATFORM_WINDOWS
+		UnmapViewOfFile(m_Data);
+		CloseHandle(m_Mapping);
+		CloseHandle(m_File);
+		m_Mapping = nullptr;
+		m_File = nullptr;
+	#elif defined(LU_PLATFORM_LINUX)
+		munmap(const_cast<uint8_t*>(m_Data), m_Size);
+	#endif
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+
+}
@@ -0,0 +1,119 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Core/StringID.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace Lunaria {
+
+	static constexpr size_t s_ArenaBlockSize = 64 * 1024;
+	// Strings are resolved through fixed pages, so a new page never moves the ones in use
+	static constexpr uint32_t s_PageSize = 4096;
+	static constexpr uint32_t s_MaxPages = 4096;
+
+	struct StringTable
+	{
+		std::mutex Mutex;
+		std::unordered_map<std::string_view, uint32_t> IDs;
+
+		std::vector<Scope<char[]>> Blocks; // The last one is filled up
+		std::vector<Scope<char[]>> LargeStrings;
+		size_t BlockOffset = s_ArenaBlockSize;
+		size_t ArenaSize = 0;
+
+		std::array<std::atomic<std::string_view*>, s_MaxPages> Pages{};
+		std::atomic<uint32_t> Count = 0;
+
+		StringTable()
+		{
+			Pages[0] = new std::string_view[s_PageSize];
+			Pages[0][0] = std::string_view("", 0);
+			Count = 1;
+		}
+
+		char* Allocate(const size_t size)
+		{
+			// Long strings get memory of their own, they would waste most of a block
+			if (size > s_ArenaBlockSize / 4)
+			{
+				ArenaSize += size;
+				return LargeStrings.emplace_back(new char[size]).get();
+			}
+
+			if (BlockOffset + size > s_ArenaBlockSize)
+			{
+				Blocks.emplace_back(new char[s_ArenaBlockSize]);
+				BlockOffset = 0;
+				ArenaSize += s_ArenaBlockSize;
+			}
+
+			char* data = Blocks.back().get() + BlockOffset;
+			BlockOffset += size;
+			return data;
+		}
+	};
+
+	static StringTable& GetStringTable()
+	{
+		// Never destroyed, IDs held by static objects stay valid until the very end
+		static StringTable* table = new StringTable();
+		return *table;
+	}
+
+	StringID::StringID(const std::string_view string)
+	{
+		if (string.empty())
+			return;
+
+		StringTable& table = GetStringTable();
+		std::lock_guard lock(table.Mutex);
+
+		if (const auto it = table.IDs.find(string); it != table.IDs.end())
+		{
+			m_ID = it->second;
+			return;
+		}
+
+		const uint32_t id = table.Count.load(std::memory_order_relaxed);
+		const uint32_t page = id / s_PageSize;
+		LU_CORE_ASSERT(page < s_MaxPages, "String table is full!");
+		if (!table.Pages[page].load(std::memory_order_relaxed))
+			table.Pages[page].store(new std::string_view[s_PageSize], std::memory_order_release);
+
+		char* data = table.Allocate(string.size() + 1);
+		std::memcpy(data, string.data(), string.size());
+		data[string.size()] = '\0';
+
+		const std::string_view interned(data, string.size());
+		table.Pages[page].load(std::memory_order_relaxed)[id % s_PageSize] = interned;
+		table.IDs.emplace(interned, id);
+		table.Count.store(id + 1, std::memory_order_release);
+
+		m_ID = id;
+	}
+
+	std::string_view StringID::GetString() const
+	{
+		const StringTable& table = GetStringTable();
+		return table.Pages[m_ID / s_PageSize].load(std::memory_order_acquire)[m_ID % s_PageSize];
+	}
+
+	const char* StringID::CStr() const
+	{
+		return GetString().data();
+	}
+
+	uint32_t StringID::GetStringCount()
+	{
+		return GetStringTable().Count.load(std::memory_order_acquire);
+	}
+
+	size_t StringID::GetArenaSize()
+	{
+		StringTable& table = GetStringTable();
+		std::lock_guard lock(table.Mutex);
+		return table.ArenaSize;
+	}
+
+}
@@ -0,0 +1,91 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Core/ThreadPool.hpp"
+
+namespace Lunaria {
+
+	ThreadPool::ThreadPool(uint32_t workerCount)
+	{
+		for (uint32_t i = 0; i < workerCount; i++)
+			m_Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Running = false;
+		}
+		m_WorkAvailable.notify_all();
+
+		for (auto& worker : m_Workers)
+			worker.join();
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		uint64_t generation = 0;
+		while (true)
+		{
+			const std::function<void(uint32_t)>* task;
+			uint32_t count;
+			{
+				std::unique_lock lock(m_Mutex);
+				m_WorkAvailable.wait(lock, [&] { return !m_Running || m_Generation != generation; });
+
+				if (!m_Running)
+					return;
+
+				generation = m_Generation;
+
+				// Woke up after the caller already finished the batch
+				if (!m_Task)
+					continue;
+
+				task = m_Task;
+				count = m_TaskCount;
+				m_ActiveWorkers++;
+			}
+
+			for (uint32_t i = m_NextTask++; i < count; i = m_NextTask++)
+				(*task)(i);
+
+			{
+				std::lock_guard lock(m_Mutex);
+				m_ActiveWorkers--;
+			}
+			m_WorkDone.notify_one();
+		}
+	}
+
+	void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t)>& task)
+	{
+		if (count == 0)
+			return;
+
+		if (m_Workers.empty() || count == 1)
+		{
+			for (uint32_t i = 0; i < count; i++)
+				task(i);
+			return;
+		}
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Task = &task;
+			m_TaskCount = count;
+			m_NextTask = 0;
+			m_Generation++;
+		}
+		m_WorkAvailable.notify_all();
+
+		for (uint32_t i = m_NextTask++; i < count; i = m_NextTask++)
+			task(i);
+
+		// Every task is claimed now, wait for the workers still running one
+		std::unique_lock lock(m_Mutex);
+		m_WorkDone.wait(lock, [this] { return m_ActiveWorkers == 0; });
+		m_Task = nullptr;
+	}
+
+}
@@ -9,6 +9,7 @@
 #include "LunariaCore/Core/Log.hpp"
 #include "LunariaCore/Core/Input.hpp"
 #include "LunariaCore/Core/Assert.hpp"
+#include "LunariaCore/Core/StringID.hpp"
 
 #include "LunariaCore/UI/ImGuiLayer.hpp"
 #include "LunariaCore/UI/UI.hpp"
@@ -21,19 +22,35 @@
 #include "LunariaCore/Scene/Entity.hpp"
 #include "LunariaCore/Scene/Components.hpp"
 #include "LunariaCore/Scene/ScriptableEntity.hpp"
+#include "LunariaCore/Scene/SceneSerializer.hpp"
+#include "LunariaCore/Physics/PhysicsWorld2D.hpp"
 // ------------------------------------------------
 
 // ------------------- Renderer -------------------
 #include "LunariaCore/Renderer/Renderer.hpp"
 #include "LunariaCore/Renderer/Renderer2D.hpp"
 #include "LunariaCore/Renderer/RenderCommand.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
+#include "LunariaCore/Renderer/GPUProfiler.hpp"
+#include "LunariaCore/Renderer/FrameSync.hpp"
+#include "LunariaCore/Renderer/GpuFence.hpp"
+#include "LunariaCore/Renderer/DynamicResolution.hpp"
 
 #include "LunariaCore/Renderer/Buffer.hpp"
+#include "LunariaCore/Renderer/BufferArena.hpp"
 #include "LunariaCore/Renderer/FrameBuffer.hpp"
 #include "LunariaCore/Renderer/Shader.hpp"
 #include "LunariaCore/Renderer/VertexArray.hpp"
+#include "LunariaCore/Renderer/MeshBatch.hpp"
 
 #include "LunariaCore/Renderer/Texture.hpp"
+#include "LunariaCore/Renderer/CompressedTexture.hpp"
+
+#include "LunariaCore/RHI/Null/NullDevice.hpp"
+#include "LunariaCore/RHI/Software/SoftwareDevice.hpp"
+#include "LunariaCore/RHI/Software/SoftwareShader.hpp"
+#include "LunariaCore/RHI/Software/SoftwareFrameBuffer.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanCommandStream.hpp"
 
 #include "LunariaCore/Renderer/OrthographicCamera.hpp"
 #include "LunariaCore/Renderer/OrthographicCameraController.hpp"
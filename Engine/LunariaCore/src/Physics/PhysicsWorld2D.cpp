@@ -0,0 +1,1404 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Physics/PhysicsWorld2D.hpp"
+
+#include "LunariaCore/Core/ThreadPool.hpp"
+#include "LunariaCore/Scene/Components.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define LU_PHYSICS_SSE 1
+	#include <immintrin.h>
+#else
+	#define LU_PHYSICS_SSE 0
+#endif
+
+namespace Lunaria {
+
+	static constexpr uint32_t s_NoBody = 0xffffffff;
+	// Slow frames drop time instead of taking ever more steps to catch up
+	static constexpr uint32_t s_MaxStepsPerUpdate = 4;
+
+	// Penetration left alone, resting contacts stay touching instead of flickering
+	static constexpr float s_LinearSlop = 0.005f;
+	// Points this close are kept as contacts, a box rocking on its corner keeps both of them
+	static constexpr float s_ContactMargin = 4.0f * s_LinearSlop;
+	static constexpr float s_Baumgarte = 0.2f;
+	// Slower impacts don't bounce, stacks would never come to rest
+	static constexpr float s_RestitutionThreshold = 1.0f;
+
+	static constexpr float s_SleepLinearTolerance = 0.01f;
+	static constexpr float s_SleepAngularTolerance = glm::radians(2.0f);
+	static constexpr float s_TimeToSleep = 0.5f;
+
+	// Bodies spanning more bands than this are kept out of the sweep
+	static constexpr int64_t s_MaxBodyBands = 64;
+	// Keeps far away coordinates from overflowing the band indices
+	static constexpr float s_MaxBand = 1.0e9f;
+
+	static constexpr uint32_t s_BodyChunkSize = 1024;
+	static constexpr uint32_t s_PairChunkSize = 512;
+	static constexpr uint32_t s_IslandChunkSize = 4;
+
+	namespace Utils {
+
+		static void ParallelRange(ThreadPool* workers, const uint32_t count, const uint32_t chunkSize, const std::function<void(uint32_t, uint32_t)>& function)
+		{
+			if (!workers || count <= chunkSize)
+			{
+				function(0, count);
+				return;
+			}
+
+			workers->ParallelFor((count + chunkSize - 1) / chunkSize, [&](const uint32_t chunk)
+			{
+				const uint32_t begin = chunk * chunkSize;
+				function(begin, std::min(begin + chunkSize, count));
+			});
+		}
+
+		static float Cross(const glm::vec2& a, const glm::vec2& b)
+		{
+			return a.x * b.y - a.y * b.x;
+		}
+
+		// Velocity of a point at the offset from the center of an angular velocity
+		static glm::vec2 Cross(const float angular, const glm::vec2& offset)
+		{
+			return { -angular * offset.y, angular * offset.x };
+		}
+
+		struct BoxShape
+		{
+			glm::vec2 Center;
+			glm::mat2 Rotation; // Columns are the local axes
+			glm::vec2 HalfExtents;
+		};
+
+		struct CircleShape
+		{
+			glm::vec2 Center;
+			float Radius;
+		};
+
+		struct Manifold
+		{
+			glm::vec2 Normal; // From the first shape to the second
+			glm::vec2 Points[2];
+			float Separations[2];
+			uint32_t IDs[2];
+			uint32_t Count = 0;
+		};
+
+		static void CollideBoxCircle(const BoxShape& box, const CircleShape& circle, Manifold& outManifold)
+		{
+			const glm::vec2 local = glm::transpose(box.Rotation) * (circle.Center - box.Center);
+			glm::vec2 closest = glm::clamp(local, -box.HalfExtents, box.HalfExtents);
+
+			glm::vec2 normal;
+			float separation;
+			if (closest == local)
+			{
+				// Center inside the box, pushed out through the nearest face
+				const glm::vec2 depth = box.HalfExtents - glm::abs(local);
+				const int axis = depth.x < depth.y ? 0 : 1;
+				const float side = local[axis] < 0.0f ? -1.0f : 1.0f;
+
+				normal = glm::vec2(0.0f);
+				normal[axis] = side;
+				closest[axis] = side * box.HalfExtents[axis];
+				separation = -depth[axis] - circle.Radius;
+			}
+			else
+			{
+				const glm::vec2 offset = local - closest;
+				const float distance = glm::length(offset);
+				if (distance > circle.Radius + s_ContactMargin)
+					return;
+
+				normal = offset / distance;
+				separation = distance - circle.Radius;
+			}
+
+			const glm::vec2 worldNormal = box.Rotation * normal;
+			const glm::vec2 boxPoint = box.Center + box.Rotation * closest;
+
+			outManifold.Normal = worldNormal;
+			outManifold.Points[0] = 0.5f * (boxPoint + circle.Center - worldNormal * circle.Radius);
+			outManifold.Separations[0] = separation;
+			outManifold.IDs[0] = 0;
+			outManifold.Count = 1;
+		}
+
+		// Box/circle and circle/circle tests four at a time, one pair per lane. A circle on the first side is a
+		// box without extents rounded by its radius, so both kinds of pairs run the same code as CollideBoxCircle.
+		struct RoundedPairBatch
+		{
+			static constexpr uint32_t Width = 4;
+
+			alignas(16) float CenterX[Width], CenterY[Width];
+			alignas(16) float AxisXX[Width], AxisXY[Width], AxisYX[Width], AxisYY[Width]; // Rotation columns
+			alignas(16) float HalfX[Width], HalfY[Width], RadiusA[Width];
+			alignas(16) float CircleX[Width], CircleY[Width], RadiusB[Width];
+
+			uint32_t Pairs[Width];
+			uint32_t Count = 0;
+
+			void Add(const uint32_t pair, const BoxShape& box, const float radiusA, const CircleShape& circle)
+			{
+				const uint32_t lane = Count++;
+				CenterX[lane] = box.Center.x;
+				CenterY[lane] = box.Center.y;
+				AxisXX[lane] = box.Rotation[0].x;
+				AxisXY[lane] = box.Rotation[0].y;
+				AxisYX[lane] = box.Rotation[1].x;
+				AxisYY[lane] = box.Rotation[1].y;
+				HalfX[lane] = box.HalfExtents.x;
+				HalfY[lane] = box.HalfExtents.y;
+				RadiusA[lane] = radiusA;
+				CircleX[lane] = circle.Center.x;
+				CircleY[lane] = circle.Center.y;
+				RadiusB[lane] = circle.Radius;
+				Pairs[lane] = pair;
+			}
+		};
+
+		// One lane on its own, for the last pairs of a range and machines without SSE
+		static void CollideRoundedPair(const RoundedPairBatch& batch, const uint32_t lane, Manifold& outManifold)
+		{
+			const glm::mat2 rotation(batch.AxisXX[lane], batch.AxisXY[lane], batch.AxisYX[lane], batch.AxisYY[lane]);
+			const BoxShape box{ { batch.CenterX[lane], batch.CenterY[lane] }, rotation, { batch.HalfX[lane], batch.HalfY[lane] } };
+			const CircleShape circle{ { batch.CircleX[lane], batch.CircleY[lane] }, batch.RadiusA[lane] + batch.RadiusB[lane] };
+
+			// The rounding is moved onto the circle, the point halfway between the surfaces moves with it
+			outManifold.Count = 0;
+			CollideBoxCircle(box, circle, outManifold);
+			if (outManifold.Count > 0)
+				outManifold.Points[0] += batch.RadiusA[lane] * outManifold.Normal;
+		}
+
+#if LU_PHYSICS_SSE
+		static __m128 Select(const __m128 mask, const __m128 a, const __m128 b)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		// A full batch, the lanes are the same steps as CollideBoxCircle
+		static void CollideRoundedPairs(const RoundedPairBatch& batch, Manifold outManifolds[RoundedPairBatch::Width])
+		{
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 minusOne = _mm_set1_ps(-1.0f);
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+			const __m128 centerX = _mm_load_ps(batch.CenterX), centerY = _mm_load_ps(batch.CenterY);
+			const __m128 axisXX = _mm_load_ps(batch.AxisXX), axisXY = _mm_load_ps(batch.AxisXY);
+			const __m128 axisYX = _mm_load_ps(batch.AxisYX), axisYY = _mm_load_ps(batch.AxisYY);
+			const __m128 halfX = _mm_load_ps(batch.HalfX), halfY = _mm_load_ps(batch.HalfY);
+			const __m128 circleX = _mm_load_ps(batch.CircleX), circleY = _mm_load_ps(batch.CircleY);
+			const __m128 radiusA = _mm_load_ps(batch.RadiusA), radiusB = _mm_load_ps(batch.RadiusB);
+			const __m128 radii = _mm_add_ps(radiusA, radiusB);
+
+			// Circle center in the box frame, and the closest point of the box to it
+			const __m128 offsetX = _mm_sub_ps(circleX, centerX), offsetY = _mm_sub_ps(circleY, centerY);
+			const __m128 localX = _mm_add_ps(_mm_mul_ps(offsetX, axisXX), _mm_mul_ps(offsetY, axisXY));
+			const __m128 localY = _mm_add_ps(_mm_mul_ps(offsetX, axisYX), _mm_mul_ps(offsetY, axisYY));
+			__m128 closestX = _mm_min_ps(_mm_max_ps(localX, _mm_sub_ps(zero, halfX)), halfX);
+			__m128 closestY = _mm_min_ps(_mm_max_ps(localY, _mm_sub_ps(zero, halfY)), halfY);
+
+			// Outside, along the offset to the closest point
+			const __m128 deltaX = _mm_sub_ps(localX, closestX), deltaY = _mm_sub_ps(localY, closestY);
+			const __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY));
+			const __m128 distance = _mm_sqrt_ps(distanceSquared);
+			const __m128 inverseDistance = _mm_div_ps(one, _mm_max_ps(distance, _mm_set1_ps(1.0e-30f)));
+			const __m128 inside = _mm_cmpeq_ps(distanceSquared, zero);
+
+			// Inside, pushed out through the nearest face
+			const __m128 depthX = _mm_sub_ps(halfX, _mm_and_ps(localX, absMask));
+			const __m128 depthY = _mm_sub_ps(halfY, _mm_and_ps(localY, absMask));
+			const __m128 alongX = _mm_cmplt_ps(depthX, depthY);
+			const __m128 sideX = Select(_mm_cmplt_ps(localX, zero), minusOne, one);
+			const __m128 sideY = Select(_mm_cmplt_ps(localY, zero), minusOne, one);
+
+			const __m128 normalX = Select(inside, _mm_and_ps(alongX, sideX), _mm_mul_ps(deltaX, inverseDistance));
+			const __m128 normalY = Select(inside, _mm_andnot_ps(alongX, sideY), _mm_mul_ps(deltaY, inverseDistance));
+			closestX = Select(_mm_and_ps(inside, alongX), _mm_mul_ps(sideX, halfX), closestX);
+			closestY = Select(_mm_andnot_ps(alongX, inside), _mm_mul_ps(sideY, halfY), closestY);
+
+			const __m128 depth = Select(alongX, depthX, depthY);
+			const __m128 separation = _mm_sub_ps(Select(inside, _mm_sub_ps(zero, depth), distance), radii);
+			const __m128 touching = _mm_or_ps(inside, _mm_cmple_ps(distance, _mm_add_ps(radii, _mm_set1_ps(s_ContactMargin))));
+
+			// Back to world space, the contact point is halfway between both surfaces
+			const __m128 worldNormalX = _mm_add_ps(_mm_mul_ps(axisXX, normalX), _mm_mul_ps(axisYX, normalY));
+			const __m128 worldNormalY = _mm_add_ps(_mm_mul_ps(axisXY, normalX), _mm_mul_ps(axisYY, normalY));
+			const __m128 surfaceAX = _mm_add_ps(_mm_add_ps(centerX, _mm_add_ps(_mm_mul_ps(axisXX, closestX), _mm_mul_ps(axisYX, closestY))), _mm_mul_ps(worldNormalX, radiusA));
+			const __m128 surfaceAY = _mm_add_ps(_mm_add_ps(centerY, _mm_add_ps(_mm_mul_ps(axisXY, closestX), _mm_mul_ps(axisYY, closestY))), _mm_mul_ps(worldNormalY, radiusA));
+			const __m128 pointX = _mm_mul_ps(half, _mm_add_ps(surfaceAX, _mm_sub_ps(circleX, _mm_mul_ps(worldNormalX, radiusB))));
+			const __m128 pointY = _mm_mul_ps(half, _mm_add_ps(surfaceAY, _mm_sub_ps(circleY, _mm_mul_ps(worldNormalY, radiusB))));
+
+			alignas(16) float outNormalX[4], outNormalY[4], outPointX[4], outPointY[4], outSeparation[4];
+			_mm_store_ps(outNormalX, worldNormalX);
+			_mm_store_ps(outNormalY, worldNormalY);
+			_mm_store_ps(outPointX, pointX);
+			_mm_store_ps(outPointY, pointY);
+			_mm_store_ps(outSeparation, separation);
+			const int touchingMask = _mm_movemask_ps(touching);
+
+			for (uint32_t lane = 0; lane < RoundedPairBatch::Width; lane++)
+			{
+				Manifold& manifold = outManifolds[lane];
+				manifold.Count = (touchingMask >> lane) & 1;
+				if (manifold.Count == 0)
+					continue;
+
+				manifold.Normal = { outNormalX[lane], outNormalY[lane] };
+				manifold.Points[0] = { outPointX[lane], outPointY[lane] };
+				manifold.Separations[0] = outSeparation[lane];
+				manifold.IDs[0] = 0;
+			}
+		}
+#else
+		static void CollideRoundedPairs(const RoundedPairBatch& batch, Manifold outManifolds[RoundedPairBatch::Width])
+		{
+			for (uint32_t lane = 0; lane < RoundedPairBatch::Width; lane++)
+				CollideRoundedPair(batch, lane, outManifolds[lane]);
+		}
+#endif
+
+		// Keeps the part of the segment behind the plane, false once less than both ends are left
+		static bool ClipSegment(glm::vec2 points[2], uint32_t ids[2], const glm::vec2& normal, const float offset, const uint32_t clipID)
+		{
+			const float distance0 = glm::dot(normal, points[0]) - offset;
+			const float distance1 = glm::dot(normal, points[1]) - offset;
+
+			glm::vec2 clipped[2];
+			uint32_t clippedIDs[2];
+			uint32_t count = 0;
+
+			if (distance0 <= 0.0f)
+			{
+				clipped[count] = points[0];
+				clippedIDs[count++] = ids[0];
+			}
+			if (distance1 <= 0.0f)
+			{
+				clipped[count] = points[1];
+				clippedIDs[count++] = ids[1];
+			}
+			if (distance0 * distance1 < 0.0f)
+			{
+				clipped[count] = points[0] + distance0 / (distance0 - distance1) * (points[1] - points[0]);
+				clippedIDs[count++] = clipID;
+			}
+
+			if (count < 2)
+				return false;
+
+			points[0] = clipped[0];
+			points[1] = clipped[1];
+			ids[0] = clippedIDs[0];
+			ids[1] = clippedIDs[1];
+			return true;
+		}
+
+		// Separating axis test over the four face normals, the incident edge of one box is clipped
+		// against the side faces of the reference face of the other. Up to two points.
+		static void CollideBoxes(const BoxShape& a, const BoxShape& b, Manifold& outManifold)
+		{
+			const glm::vec2 offset = b.Center - a.Center;
+
+			const auto faceSeparation = [&offset](const BoxShape& reference, const BoxShape& other, const int axis)
+			{
+				const glm::vec2 normal = reference.Rotation[axis];
+				return std::abs(glm::dot(offset, normal)) - reference.HalfExtents[axis]
+					- other.HalfExtents.x * std::abs(glm::dot(other.Rotation[0], normal))
+					- other.HalfExtents.y * std::abs(glm::dot(other.Rotation[1], normal));
+			};
+
+			float separationsA[2], separationsB[2];
+			for (int axis = 0; axis < 2; axis++)
+			{
+				separationsA[axis] = faceSeparation(a, b, axis);
+				separationsB[axis] = faceSeparation(b, a, axis);
+				if (separationsA[axis] > s_ContactMargin || separationsB[axis] > s_ContactMargin)
+					return;
+			}
+
+			// Tolerances keep the same reference face while the separations are about equal
+			static constexpr float relativeTolerance = 0.95f;
+			static constexpr float absoluteTolerance = 0.01f;
+			const auto pickAxis = [](const float separations[2], const glm::vec2& halfExtents)
+			{
+				return separations[1] > relativeTolerance * separations[0] + absoluteTolerance * halfExtents.y ? 1 : 0;
+			};
+
+			const int axisA = pickAxis(separationsA, a.HalfExtents);
+			const int axisB = pickAxis(separationsB, b.HalfExtents);
+			const bool flip = separationsB[axisB] > relativeTolerance * separationsA[axisA] + absoluteTolerance * b.HalfExtents[axisB];
+
+			const BoxShape& reference = flip ? b : a;
+			const BoxShape& incident = flip ? a : b;
+			const int axis = flip ? axisB : axisA;
+
+			const float side = glm::dot(incident.Center - reference.Center, reference.Rotation[axis]) < 0.0f ? -1.0f : 1.0f;
+			const glm::vec2 normal = side * reference.Rotation[axis];
+
+			// Incident face is the one facing the reference face the most
+			const float dot0 = glm::dot(incident.Rotation[0], normal);
+			const float dot1 = glm::dot(incident.Rotation[1], normal);
+			const int incidentAxis = std::abs(dot0) > std::abs(dot1) ? 0 : 1;
+			const float incidentSide = (incidentAxis == 0 ? dot0 : dot1) > 0.0f ? -1.0f : 1.0f;
+
+			const glm::vec2 faceCenter = incident.Center + incidentSide * incident.HalfExtents[incidentAxis] * incident.Rotation[incidentAxis];
+			const glm::vec2 faceTangent = incident.HalfExtents[1 - incidentAxis] * incident.Rotation[1 - incidentAxis];
+
+			const uint32_t incidentFace = static_cast<uint32_t>(incidentAxis * 2 + (incidentSide > 0.0f ? 1 : 0));
+			glm::vec2 points[2] = { faceCenter + faceTangent, faceCenter - faceTangent };
+			uint32_t ids[2] = { incidentFace * 2, incidentFace * 2 + 1 };
+
+			const glm::vec2 sideNormal = reference.Rotation[1 - axis];
+			const float sideOffset = glm::dot(sideNormal, reference.Center);
+			// A little outside the face, corners of aligned boxes stay corners instead of turning into clip points every other step
+			const float sideExtent = reference.HalfExtents[1 - axis] + s_LinearSlop;
+			if (!ClipSegment(points, ids, sideNormal, sideOffset + sideExtent, 8) || !ClipSegment(points, ids, -sideNormal, -sideOffset + sideExtent, 9))
+				return;
+
+			const uint32_t referenceID = (flip ? 1u : 0u) << 6 | static_cast<uint32_t>(axis) << 5 | (side > 0.0f ? 1u : 0u) << 4;
+			const float front = glm::dot(normal, reference.Center) + reference.HalfExtents[axis];
+
+			outManifold.Normal = flip ? -normal : normal;
+			for (int i = 0; i < 2; i++)
+			{
+				const float separation = glm::dot(normal, points[i]) - front;
+				if (separation > s_ContactMargin)
+					continue;
+
+				// Halfway between the surfaces
+				outManifold.Points[outManifold.Count] = points[i] - 0.5f * separation * normal;
+				outManifold.Separations[outManifold.Count] = separation;
+				outManifold.IDs[outManifold.Count] = referenceID | ids[i];
+				outManifold.Count++;
+			}
+		}
+
+	}
+
+	void PhysicsWorld2D::Update(entt::registry& registry, const Timestep timestep, ThreadPool* workers)
+	{
+		if (m_Invalid)
+			Rebuild(registry);
+		else
+			ApplyChanges(registry);
+
+		// Every update, teleports have to be seen before the transform propagation clears them
+		ReadBodies(registry, workers);
+
+		m_Accumulator += timestep;
+		uint32_t steps = 0;
+		while (m_Accumulator >= m_FixedTimestep && steps < s_MaxStepsPerUpdate)
+		{
+			Step(m_FixedTimestep, workers);
+			m_Accumulator -= m_FixedTimestep;
+			steps++;
+		}
+
+		if (m_Accumulator >= m_FixedTimestep)
+			m_Accumulator = 0.0f;
+
+		if (steps > 0)
+			WriteBodies(registry, workers);
+	}
+
+	void PhysicsWorld2D::AddBody(const entt::entity entity)
+	{
+		if (!m_Invalid)
+			m_Added.push_back(entity);
+	}
+
+	void PhysicsWorld2D::RemoveBody(const entt::entity entity)
+	{
+		if (!m_Invalid)
+			m_Removed.push_back(entity);
+	}
+
+	void PhysicsWorld2D::RefreshBody(const entt::entity entity)
+	{
+		if (!m_Invalid)
+			m_Refreshed.push_back(entity);
+	}
+
+	void PhysicsWorld2D::SetFixedTimestep(const float timestep)
+	{
+		LU_CORE_ASSERT(timestep > 0.0f, "Physics timestep has to be positive!");
+		if (timestep > 0.0f)
+			m_FixedTimestep = timestep;
+	}
+
+	void PhysicsWorld2D::Rebuild(entt::registry& registry)
+	{
+		m_Bodies.clear();
+		m_Bounds.clear();
+		m_BodyIndices.clear();
+		m_Added.clear();
+		m_Removed.clear();
+		m_Refreshed.clear();
+		m_Cache.clear();
+
+		const auto view = registry.view<Rigidbody2DComponent, TransformComponent>();
+		for (const auto entity : view)
+			InsertBody(registry, entity);
+
+		m_Invalid = false;
+	}
+
+	void PhysicsWorld2D::ApplyChanges(entt::registry& registry)
+	{
+		// Removals first, a destroyed entity's id may already be back with a new body
+		for (const entt::entity entity : m_Removed)
+			EraseBody(entity);
+
+		for (const entt::entity entity : m_Added)
+		{
+			if (registry.valid(entity) && registry.all_of<Rigidbody2DComponent, TransformComponent>(entity) && FindBody(entity) == s_NoBody)
+				InsertBody(registry, entity);
+		}
+
+		for (const entt::entity entity : m_Refreshed)
+		{
+			const uint32_t index = FindBody(entity);
+			if (index == s_NoBody)
+				continue;
+
+			Body& body = m_Bodies[index];
+			BuildBody(body, registry, registry.get<TransformComponent>(entity), registry.get<Rigidbody2DComponent>(entity));
+			body.Awake = true;
+			body.SleepTime = 0.0f;
+			PlaceShape(index);
+		}
+
+		m_Added.clear();
+		m_Removed.clear();
+		m_Refreshed.clear();
+	}
+
+	void PhysicsWorld2D::InsertBody(entt::registry& registry, const entt::entity entity)
+	{
+		const uint32_t index = static_cast<uint32_t>(m_Bodies.size());
+		const uint32_t entityIndex = entt::to_entity(entity);
+		if (entityIndex >= m_BodyIndices.size())
+			m_BodyIndices.resize(static_cast<size_t>(entityIndex) + 1, s_NoBody);
+		m_BodyIndices[entityIndex] = index;
+
+		const auto& rigidbody = registry.get<Rigidbody2DComponent>(entity);
+
+		Body& body = m_Bodies.emplace_back();
+		body.Entity = entity;
+		body.Velocity = rigidbody.LinearVelocity;
+		body.AngularVelocity = rigidbody.AngularVelocity;
+		body.Awake = rigidbody.Awake;
+		BuildBody(body, registry, registry.get<TransformComponent>(entity), rigidbody);
+
+		m_Bounds.emplace_back();
+		PlaceShape(index);
+		m_SweepDirty = true;
+	}
+
+	void PhysicsWorld2D::EraseBody(const entt::entity entity)
+	{
+		const uint32_t index = FindBody(entity);
+		if (index == s_NoBody)
+			return;
+
+		// Swapped with the last body, the cache is keyed by entity and doesn't care
+		const uint32_t last = static_cast<uint32_t>(m_Bodies.size() - 1);
+		if (index != last)
+		{
+			m_Bodies[index] = m_Bodies[last];
+			m_Bounds[index] = m_Bounds[last];
+			m_BodyIndices[entt::to_entity(m_Bodies[index].Entity)] = index;
+		}
+
+		m_Bodies.pop_back();
+		m_Bounds.pop_back();
+		m_BodyIndices[entt::to_entity(entity)] = s_NoBody;
+		m_SweepDirty = true;
+	}
+
+	uint32_t PhysicsWorld2D::FindBody(const entt::entity entity) const
+	{
+		const uint32_t entityIndex = entt::to_entity(entity);
+		if (entityIndex >= m_BodyIndices.size() || m_BodyIndices[entityIndex] == s_NoBody)
+			return s_NoBody;
+
+		const uint32_t index = m_BodyIndices[entityIndex];
+		return m_Bodies[index].Entity == entity ? index : s_NoBody;
+	}
+
+	void PhysicsWorld2D::ReadBodies(entt::registry& registry, ThreadPool* workers)
+	{
+		const auto& transforms = registry.storage<TransformComponent>();
+		const auto& rigidbodies = registry.storage<Rigidbody2DComponent>();
+
+		Utils::ParallelRange(workers, static_cast<uint32_t>(m_Bodies.size()), s_BodyChunkSize, [&](const uint32_t begin, const uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				Body& body = m_Bodies[i];
+				const auto& transform = transforms.get(body.Entity);
+				const auto& rigidbody = rigidbodies.get(body.Entity);
+
+				bool wake = false;
+				if (transform.Dirty || static_cast<BodyType>(rigidbody.Type) != body.Type
+					|| rigidbody.FixedRotation != body.FixedRotation || rigidbody.GravityScale != body.GravityScale)
+				{
+					BuildBody(body, registry, transform, rigidbody);
+					PlaceShape(i);
+					wake = true;
+				}
+
+				if (rigidbody.LinearVelocity != body.Velocity || rigidbody.AngularVelocity != body.AngularVelocity)
+				{
+					body.Velocity = rigidbody.LinearVelocity;
+					body.AngularVelocity = rigidbody.AngularVelocity;
+					wake = true;
+				}
+
+				if (wake || (rigidbody.Awake && !body.Awake))
+				{
+					body.Awake = true;
+					body.SleepTime = 0.0f;
+				}
+				else if (!rigidbody.Awake)
+				{
+					body.Awake = false;
+				}
+			}
+		});
+	}
+
+	void PhysicsWorld2D::WriteBodies(entt::registry& registry, ThreadPool* workers)
+	{
+		auto& transforms = registry.storage<TransformComponent>();
+		auto& rigidbodies = registry.storage<Rigidbody2DComponent>();
+
+		// Bodies at rest keep their transforms clean, nothing downstream has to look at them
+		Utils::ParallelRange(workers, static_cast<uint32_t>(m_Bodies.size()), s_BodyChunkSize, [&](const uint32_t begin, const uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				Body& body = m_Bodies[i];
+				if (body.Type == BodyType::Static)
+					continue;
+
+				if (body.Moved)
+				{
+					auto& transform = transforms.get(body.Entity);
+					transform.Translation.x = body.Position.x;
+					transform.Translation.y = body.Position.y;
+					transform.Rotation.z = body.Angle;
+					transform.Dirty = true;
+					body.Moved = false;
+				}
+
+				auto& rigidbody = rigidbodies.get(body.Entity);
+				rigidbody.LinearVelocity = body.Velocity;
+				rigidbody.AngularVelocity = body.AngularVelocity;
+				rigidbody.Awake = body.Awake;
+			}
+		});
+	}
+
+	void PhysicsWorld2D::BuildBody(Body& body, const entt::registry& registry, const TransformComponent& transform, const Rigidbody2DComponent& rigidbody)
+	{
+		static_assert(static_cast<int>(BodyType::Static) == static_cast<int>(Rigidbody2DComponent::BodyType::Static)
+			&& static_cast<int>(BodyType::Dynamic) == static_cast<int>(Rigidbody2DComponent::BodyType::Dynamic)
+			&& static_cast<int>(BodyType::Kinematic) == static_cast<int>(Rigidbody2DComponent::BodyType::Kinematic));
+
+		body.Position = transform.Translation;
+		body.Angle = transform.Rotation.z;
+		body.Type = static_cast<BodyType>(rigidbody.Type);
+		body.FixedRotation = rigidbody.FixedRotation;
+		body.GravityScale = rigidbody.GravityScale;
+
+		const glm::vec2 scale = transform.Scale;
+		float mass = 0.0f, inertia = 0.0f;
+
+		// Inertia around the entity origin, offset shapes rotate around it too
+		if (const auto* box = registry.try_get<BoxCollider2DComponent>(body.Entity))
+		{
+			body.Shape = ShapeType::Box;
+			body.Offset = box->Offset * scale;
+			body.HalfExtents = box->Size * glm::abs(scale);
+			body.Friction = box->Friction;
+			body.Restitution = box->Restitution;
+
+			mass = box->Density * 4.0f * body.HalfExtents.x * body.HalfExtents.y;
+			inertia = mass * (glm::dot(body.HalfExtents, body.HalfExtents) / 3.0f + glm::dot(body.Offset, body.Offset));
+		}
+		else if (const auto* circle = registry.try_get<CircleCollider2DComponent>(body.Entity))
+		{
+			const float radius = circle->Radius * std::max(std::abs(scale.x), std::abs(scale.y));
+
+			body.Shape = ShapeType::Circle;
+			body.Offset = circle->Offset * scale;
+			body.HalfExtents = { radius, radius };
+			body.Friction = circle->Friction;
+			body.Restitution = circle->Restitution;
+
+			mass = circle->Density * glm::pi<float>() * radius * radius;
+			inertia = mass * (0.5f * radius * radius + glm::dot(body.Offset, body.Offset));
+		}
+		else
+		{
+			body.Shape = ShapeType::None;
+			body.Offset = { 0.0f, 0.0f };
+			body.HalfExtents = { 0.0f, 0.0f };
+		}
+
+		if (body.Type == BodyType::Dynamic)
+		{
+			body.InverseMass = mass > 0.0f ? 1.0f / mass : 1.0f;
+			body.InverseInertia = !body.FixedRotation && inertia > 0.0f ? 1.0f / inertia : 0.0f;
+		}
+		else
+		{
+			body.InverseMass = 0.0f;
+			body.InverseInertia = 0.0f;
+		}
+	}
+
+	void PhysicsWorld2D::PlaceShape(const uint32_t index)
+	{
+		Body& body = m_Bodies[index];
+		const float c = std::cos(body.Angle);
+		const float s = std::sin(body.Angle);
+
+		body.Rotation = glm::mat2(c, s, -s, c);
+		body.Center = body.Position + body.Rotation * body.Offset;
+
+		glm::vec2 extent = body.HalfExtents + 0.5f * s_ContactMargin;
+		if (body.Shape == ShapeType::Box)
+		{
+			extent = glm::vec2(
+				std::abs(c) * body.HalfExtents.x + std::abs(s) * body.HalfExtents.y,
+				std::abs(s) * body.HalfExtents.x + std::abs(c) * body.HalfExtents.y) + 0.5f * s_ContactMargin;
+		}
+
+		m_Bounds[index] = { body.Center - extent, body.Center + extent };
+	}
+
+	void PhysicsWorld2D::Step(const float timestep, ThreadPool* workers)
+	{
+		IntegrateVelocities(timestep, workers);
+		FindPairs(workers);
+		Collide(workers);
+		BuildIslands();
+		SolveIslands(timestep, workers);
+		IntegratePositions(timestep, workers);
+		UpdateSleep(timestep);
+		CacheImpulses();
+	}
+
+	void PhysicsWorld2D::IntegrateVelocities(const float timestep, ThreadPool* workers)
+	{
+		Utils::ParallelRange(workers, static_cast<uint32_t>(m_Bodies.size()), s_BodyChunkSize, [&](const uint32_t begin, const uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				Body& body = m_Bodies[i];
+				if (body.Type == BodyType::Dynamic && body.Awake)
+					body.Velocity += m_Gravity * body.GravityScale * timestep;
+			}
+		});
+	}
+
+	void PhysicsWorld2D::FindPairs(ThreadPool* workers)
+	{
+		const uint32_t count = static_cast<uint32_t>(m_Bodies.size());
+
+		// Sweeping along the axis the bodies are spread the most keeps the overlapping runs short
+		glm::vec2 sum(0.0f), sumSquared(0.0f);
+		for (const Bounds& bounds : m_Bounds)
+		{
+			const glm::vec2 center = 0.5f * (bounds.Min + bounds.Max);
+			sum += center;
+			sumSquared += center * center;
+		}
+
+		const glm::vec2 variance = sumSquared - sum * sum / std::max(static_cast<float>(count), 1.0f);
+		const int axis = variance.y > variance.x ? 1 : 0;
+		const int other = 1 - axis;
+		if (axis != m_SweepAxis)
+		{
+			m_SweepAxis = axis;
+			m_SweepDirty = true;
+		}
+
+		// A single sweep degrades to long runs once the bodies cover an area, so the perpendicular
+		// axis is sliced into bands a few bodies wide, each swept on its own
+		if (m_SweepDirty && count > 0)
+		{
+			std::vector<float> extents(count);
+			for (uint32_t i = 0; i < count; i++)
+				extents[i] = m_Bounds[i].Max[other] - m_Bounds[i].Min[other];
+
+			std::nth_element(extents.begin(), extents.begin() + count / 2, extents.end());
+			m_BandSize = std::max(4.0f * extents[count / 2], s_ContactMargin);
+		}
+
+		const float inverseBandSize = 1.0f / m_BandSize;
+		const auto getBand = [inverseBandSize](const float value)
+		{
+			return static_cast<int32_t>(glm::clamp(std::floor(value * inverseBandSize), -s_MaxBand, s_MaxBand));
+		};
+		const auto isLarge = [](const glm::ivec2& bands) { return static_cast<int64_t>(bands.y) - bands.x >= s_MaxBodyBands; };
+
+		m_BodyBands.resize(count);
+		uint32_t largeCount = 0;
+		bool largeChanged = false;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const glm::ivec2 bands = { getBand(m_Bounds[i].Min[other]), getBand(m_Bounds[i].Max[other]) };
+			m_BodyBands[i] = bands;
+			if (!isLarge(bands))
+				continue;
+
+			if (largeCount < m_LargeBodies.size())
+			{
+				largeChanged |= m_LargeBodies[largeCount] != i;
+				m_LargeBodies[largeCount] = i;
+			}
+			else
+			{
+				largeChanged = true;
+				m_LargeBodies.push_back(i);
+			}
+			largeCount++;
+		}
+
+		// Bodies that stopped being large aren't in the last order
+		largeChanged |= largeCount != m_LargeBodies.size();
+		m_LargeBodies.resize(largeCount);
+		if (largeChanged)
+			m_SweepDirty = true;
+
+		m_SweepScratch.clear();
+		const auto addEntries = [&](const uint32_t index)
+		{
+			const glm::ivec2 bands = m_BodyBands[index];
+			if (isLarge(bands))
+				return;
+
+			const Bounds& bounds = m_Bounds[index];
+			for (int32_t band = bands.x; band <= bands.y; band++)
+				m_SweepScratch.push_back({ bounds.Min[axis], bounds.Max[axis], bounds.Min[other], bounds.Max[other], index, band, bands.x });
+		};
+
+		if (m_SweepDirty)
+		{
+			for (uint32_t i = 0; i < count; i++)
+				addEntries(i);
+		}
+		else
+		{
+			// In the last order, every body has exactly one entry in its first band
+			for (const SweepEntry& entry : m_Sweep)
+			{
+				if (entry.Band == entry.FirstBand)
+					addEntries(entry.Body);
+			}
+		}
+
+		const auto byBandAndMin = [](const SweepEntry& lhs, const SweepEntry& rhs)
+		{
+			return lhs.Band != rhs.Band ? lhs.Band < rhs.Band : lhs.Min < rhs.Min;
+		};
+
+		const uint32_t entryCount = static_cast<uint32_t>(m_SweepScratch.size());
+		int32_t minBand = std::numeric_limits<int32_t>::max();
+		int32_t maxBand = std::numeric_limits<int32_t>::min();
+		for (const SweepEntry& entry : m_SweepScratch)
+		{
+			minBand = std::min(minBand, entry.Band);
+			maxBand = std::max(maxBand, entry.Band);
+		}
+
+		const int64_t bandCount = static_cast<int64_t>(maxBand) - minBand + 1;
+		if (m_SweepDirty || entryCount == 0 || bandCount > static_cast<int64_t>(entryCount) * 4)
+		{
+			m_Sweep.swap(m_SweepScratch);
+			std::sort(m_Sweep.begin(), m_Sweep.end(), byBandAndMin);
+			m_SweepDirty = false;
+		}
+		else
+		{
+			// Stable counting sort into the bands, inside a band the entries stay in the last order
+			m_BandOffsets.assign(static_cast<size_t>(bandCount) + 1, 0);
+			for (const SweepEntry& entry : m_SweepScratch)
+				m_BandOffsets[entry.Band - minBand + 1]++;
+			for (int64_t band = 0; band < bandCount; band++)
+				m_BandOffsets[band + 1] += m_BandOffsets[band];
+
+			m_Sweep.resize(entryCount);
+			for (const SweepEntry& entry : m_SweepScratch)
+				m_Sweep[m_BandOffsets[entry.Band - minBand]++] = entry;
+
+			// Bodies barely move between steps, a large shuffle falls back to a full sort
+			const uint64_t maxShifts = static_cast<uint64_t>(entryCount) * 8;
+			uint64_t shifts = 0;
+			for (uint32_t i = 1; i < entryCount && shifts <= maxShifts; i++)
+			{
+				const SweepEntry entry = m_Sweep[i];
+				uint32_t j = i;
+				for (; j > 0 && byBandAndMin(entry, m_Sweep[j - 1]); j--)
+					m_Sweep[j] = m_Sweep[j - 1];
+
+				m_Sweep[j] = entry;
+				shifts += i - j;
+			}
+
+			if (shifts > maxShifts)
+				std::sort(m_Sweep.begin(), m_Sweep.end(), byBandAndMin);
+		}
+
+		const auto addPair = [this](std::vector<std::pair<uint32_t, uint32_t>>& pairs, const uint32_t index, const uint32_t otherIndex)
+		{
+			// Something has to move, and something has to be pushed
+			const Body& body = m_Bodies[index];
+			const Body& otherBody = m_Bodies[otherIndex];
+			if (body.Shape == ShapeType::None || otherBody.Shape == ShapeType::None
+				|| (body.Type != BodyType::Dynamic && otherBody.Type != BodyType::Dynamic)
+				|| ((body.Type == BodyType::Static || !body.Awake) && (otherBody.Type == BodyType::Static || !otherBody.Awake)))
+				return;
+
+			// Same order every step, the cache key of a pair must not change. Boxes come first.
+			const bool swap = body.Shape != otherBody.Shape ? body.Shape == ShapeType::Circle : otherBody.Entity < body.Entity;
+			pairs.emplace_back(swap ? otherIndex : index, swap ? index : otherIndex);
+		};
+
+		const uint32_t chunkCount = std::max((entryCount + s_PairChunkSize - 1) / s_PairChunkSize, 1u);
+		if (m_ChunkPairs.size() < chunkCount)
+			m_ChunkPairs.resize(chunkCount);
+
+		Utils::ParallelRange(workers, entryCount, s_PairChunkSize, [&](const uint32_t begin, const uint32_t end)
+		{
+			auto& pairs = m_ChunkPairs[begin / s_PairChunkSize];
+			pairs.clear();
+
+			for (uint32_t i = begin; i < end; i++)
+			{
+				const SweepEntry& entry = m_Sweep[i];
+				if (m_Bodies[entry.Body].Shape == ShapeType::None)
+					continue;
+
+				for (uint32_t j = i + 1; j < entryCount && m_Sweep[j].Band == entry.Band && m_Sweep[j].Min <= entry.Max; j++)
+				{
+					const SweepEntry& otherEntry = m_Sweep[j];
+					if (otherEntry.OtherMin > entry.OtherMax || otherEntry.OtherMax < entry.OtherMin)
+						continue;
+
+					// Bodies sharing several bands meet in each of them, the pair belongs to the first
+					if (entry.Band != std::max(entry.FirstBand, otherEntry.FirstBand))
+						continue;
+
+					addPair(pairs, entry.Body, otherEntry.Body);
+				}
+			}
+		});
+
+		m_Pairs.clear();
+		for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
+			m_Pairs.insert(m_Pairs.end(), m_ChunkPairs[chunk].begin(), m_ChunkPairs[chunk].end());
+
+		// Few of these, ground planes and walls
+		for (const uint32_t index : m_LargeBodies)
+		{
+			const Bounds& bounds = m_Bounds[index];
+			for (uint32_t otherIndex = 0; otherIndex < count; otherIndex++)
+			{
+				if (otherIndex == index || (isLarge(m_BodyBands[otherIndex]) && otherIndex < index))
+					continue;
+
+				const Bounds& otherBounds = m_Bounds[otherIndex];
+				if (otherBounds.Min.x > bounds.Max.x || otherBounds.Max.x < bounds.Min.x || otherBounds.Min.y > bounds.Max.y || otherBounds.Max.y < bounds.Min.y)
+					continue;
+
+				addPair(m_Pairs, index, otherIndex);
+			}
+		}
+	}
+
+	void PhysicsWorld2D::Collide(ThreadPool* workers)
+	{
+		m_Contacts.resize(m_Pairs.size());
+
+		const auto toBox = [](const Body& body) { return Utils::BoxShape{ body.Center, body.Rotation, body.HalfExtents }; };
+		const auto toCircle = [](const Body& body) { return Utils::CircleShape{ body.Center, body.HalfExtents.x }; };
+
+		const auto addContact = [this](const uint32_t pair, const Utils::Manifold& manifold)
+		{
+			const auto [indexA, indexB] = m_Pairs[pair];
+			const Body& a = m_Bodies[indexA];
+			const Body& b = m_Bodies[indexB];
+
+			Contact& contact = m_Contacts[pair];
+			contact.BodyA = indexA;
+			contact.BodyB = indexB;
+			contact.PointCount = manifold.Count;
+			if (manifold.Count == 0)
+				return;
+
+			contact.Normal = manifold.Normal;
+			contact.Friction = std::sqrt(a.Friction * b.Friction);
+			contact.Restitution = std::max(a.Restitution, b.Restitution);
+
+			const uint64_t key = GetContactKey(indexA, indexB);
+			const auto cached = std::lower_bound(m_Cache.begin(), m_Cache.end(), key, [](const CachedContact& entry, const uint64_t value) { return entry.Key < value; });
+			const bool hasCache = cached != m_Cache.end() && cached->Key == key;
+
+			for (uint32_t p = 0; p < manifold.Count; p++)
+			{
+				ContactPoint& point = contact.Points[p];
+				point.AnchorA = manifold.Points[p] - a.Position;
+				point.AnchorB = manifold.Points[p] - b.Position;
+				point.Separation = manifold.Separations[p];
+				point.ID = manifold.IDs[p];
+				point.NormalImpulse = 0.0f;
+				point.TangentImpulse = 0.0f;
+				point.BiasImpulse = 0.0f;
+
+				for (uint32_t c = 0; hasCache && c < cached->PointCount; c++)
+				{
+					if (cached->IDs[c] == point.ID)
+					{
+						point.NormalImpulse = cached->NormalImpulses[c];
+						point.TangentImpulse = cached->TangentImpulses[c];
+						break;
+					}
+				}
+			}
+		};
+
+		Utils::ParallelRange(workers, static_cast<uint32_t>(m_Pairs.size()), s_PairChunkSize, [&](const uint32_t begin, const uint32_t end)
+		{
+			// Pairs with a circle are gathered and tested a batch at a time
+			Utils::RoundedPairBatch batch;
+			Utils::Manifold manifolds[Utils::RoundedPairBatch::Width];
+
+			for (uint32_t i = begin; i < end; i++)
+			{
+				const auto [indexA, indexB] = m_Pairs[i];
+				const Body& a = m_Bodies[indexA];
+				const Body& b = m_Bodies[indexB];
+
+				if (a.Shape == ShapeType::Box && b.Shape == ShapeType::Box)
+				{
+					Utils::Manifold manifold;
+					Utils::CollideBoxes(toBox(a), toBox(b), manifold);
+					addContact(i, manifold);
+					continue;
+				}
+
+				// A circle first is a box without extents rounded by its radius
+				if (a.Shape == ShapeType::Box)
+					batch.Add(i, toBox(a), 0.0f, toCircle(b));
+				else
+					batch.Add(i, Utils::BoxShape{ a.Center, glm::mat2(1.0f), glm::vec2(0.0f) }, a.HalfExtents.x, toCircle(b));
+
+				if (batch.Count == Utils::RoundedPairBatch::Width)
+				{
+					Utils::CollideRoundedPairs(batch, manifolds);
+					for (uint32_t lane = 0; lane < batch.Count; lane++)
+						addContact(batch.Pairs[lane], manifolds[lane]);
+					batch.Count = 0;
+				}
+			}
+
+			for (uint32_t lane = 0; lane < batch.Count; lane++)
+			{
+				Utils::CollideRoundedPair(batch, lane, manifolds[lane]);
+				addContact(batch.Pairs[lane], manifolds[lane]);
+			}
+		});
+
+		m_Contacts.erase(std::remove_if(m_Contacts.begin(), m_Contacts.end(), [](const Contact& contact) { return contact.PointCount == 0; }), m_Contacts.end());
+	}
+
+	void PhysicsWorld2D::BuildIslands()
+	{
+		const uint32_t count = static_cast<uint32_t>(m_Bodies.size());
+		m_Parents.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			m_Parents[i] = i;
+
+		// Static and kinematic bodies don't carry anything from one body to the next, they stay out
+		for (const Contact& contact : m_Contacts)
+		{
+			if (m_Bodies[contact.BodyA].Type == BodyType::Dynamic && m_Bodies[contact.BodyB].Type == BodyType::Dynamic)
+			{
+				const uint32_t rootA = FindRoot(contact.BodyA);
+				const uint32_t rootB = FindRoot(contact.BodyB);
+				if (rootA != rootB)
+					m_Parents[std::max(rootA, rootB)] = std::min(rootA, rootB);
+			}
+		}
+
+		// Anything awake in an island wakes the rest of it, so does a moving kinematic body touching it
+		m_RootAwake.assign(count, 0);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (m_Bodies[i].Type == BodyType::Dynamic && m_Bodies[i].Awake)
+				m_RootAwake[FindRoot(i)] = 1;
+		}
+
+		for (const Contact& contact : m_Contacts)
+		{
+			const Body& a = m_Bodies[contact.BodyA];
+			const Body& b = m_Bodies[contact.BodyB];
+			if (a.Type == BodyType::Kinematic && a.Awake)
+				m_RootAwake[FindRoot(contact.BodyB)] = 1;
+			if (b.Type == BodyType::Kinematic && b.Awake)
+				m_RootAwake[FindRoot(contact.BodyA)] = 1;
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Body& body = m_Bodies[i];
+			if (body.Type == BodyType::Dynamic && !body.Awake && m_RootAwake[FindRoot(i)])
+			{
+				body.Awake = true;
+				body.SleepTime = 0.0f;
+			}
+		}
+
+		// Contacts grouped by island, in the order they were found
+		m_RootIslands.assign(count, s_NoBody);
+		m_IslandOffsets.assign(1, 0);
+		for (const Contact& contact : m_Contacts)
+		{
+			const uint32_t body = m_Bodies[contact.BodyA].Type == BodyType::Dynamic ? contact.BodyA : contact.BodyB;
+			uint32_t& island = m_RootIslands[FindRoot(body)];
+			if (island == s_NoBody)
+			{
+				island = static_cast<uint32_t>(m_IslandOffsets.size() - 1);
+				m_IslandOffsets.push_back(0);
+			}
+
+			m_IslandOffsets[island + 1]++;
+		}
+
+		for (size_t i = 1; i < m_IslandOffsets.size(); i++)
+			m_IslandOffsets[i] += m_IslandOffsets[i - 1];
+
+		m_IslandContacts.resize(m_Contacts.size());
+		std::vector<uint32_t> next(m_IslandOffsets.begin(), m_IslandOffsets.end() - 1);
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_Contacts.size()); i++)
+		{
+			const Contact& contact = m_Contacts[i];
+			const uint32_t body = m_Bodies[contact.BodyA].Type == BodyType::Dynamic ? contact.BodyA : contact.BodyB;
+			m_IslandContacts[next[m_RootIslands[FindRoot(body)]]++] = i;
+		}
+	}
+
+	void PhysicsWorld2D::SolveIslands(const float timestep, ThreadPool* workers)
+	{
+		const float inverseTimestep = 1.0f / timestep;
+
+		// Islands share no dynamic body, each is solved start to end by one thread
+		Utils::ParallelRange(workers, GetIslandCount(), s_IslandChunkSize, [&](const uint32_t begin, const uint32_t end)
+		{
+			for (uint32_t island = begin; island < end; island++)
+			{
+				const uint32_t first = m_IslandOffsets[island];
+				const uint32_t last = m_IslandOffsets[island + 1];
+
+				for (uint32_t i = first; i < last; i++)
+					PrepareContact(m_Contacts[m_IslandContacts[i]], inverseTimestep);
+
+				for (uint32_t iteration = 0; iteration < m_VelocityIterations; iteration++)
+				{
+					for (uint32_t i = first; i < last; i++)
+						SolveContact(m_Contacts[m_IslandContacts[i]]);
+				}
+			}
+		});
+	}
+
+	void PhysicsWorld2D::PrepareContact(Contact& contact, const float inverseTimestep)
+	{
+		Body& a = m_Bodies[contact.BodyA];
+		Body& b = m_Bodies[contact.BodyB];
+		const glm::vec2 normal = contact.Normal;
+		const glm::vec2 tangent = { normal.y, -normal.x };
+
+		for (uint32_t p = 0; p < contact.PointCount; p++)
+		{
+			ContactPoint& point = contact.Points[p];
+
+			const float normalA = Utils::Cross(point.AnchorA, normal);
+			const float normalB = Utils::Cross(point.AnchorB, normal);
+			point.NormalMass = 1.0f / (a.InverseMass + b.InverseMass + a.InverseInertia * normalA * normalA + b.InverseInertia * normalB * normalB);
+
+			const float tangentA = Utils::Cross(point.AnchorA, tangent);
+			const float tangentB = Utils::Cross(point.AnchorB, tangent);
+			point.TangentMass = 1.0f / (a.InverseMass + b.InverseMass + a.InverseInertia * tangentA * tangentA + b.InverseInertia * tangentB * tangentB);
+
+			// A gap may close within the step, anything faster is stopped at the surface
+			point.Bias = point.Separation > 0.0f ? -point.Separation * inverseTimestep : 0.0f;
+			point.PositionBias = -s_Baumgarte * inverseTimestep * std::min(0.0f, point.Separation + s_LinearSlop);
+
+			// Bounces off the approach speed, not whatever the iterations end up with
+			const glm::vec2 relative = b.Velocity + Utils::Cross(b.AngularVelocity, point.AnchorB) - a.Velocity - Utils::Cross(a.AngularVelocity, point.AnchorA);
+			const float approach = glm::dot(relative, normal);
+			if (approach < -s_RestitutionThreshold)
+				point.Bias = std::max(point.Bias, -contact.Restitution * approach);
+
+			// Last step's impulses as the starting guess
+			const glm::vec2 impulse = point.NormalImpulse * normal + point.TangentImpulse * tangent;
+			if (a.Type == BodyType::Dynamic)
+			{
+				a.Velocity -= a.InverseMass * impulse;
+				a.AngularVelocity -= a.InverseInertia * Utils::Cross(point.AnchorA, impulse);
+			}
+			if (b.Type == BodyType::Dynamic)
+			{
+				b.Velocity += b.InverseMass * impulse;
+				b.AngularVelocity += b.InverseInertia * Utils::Cross(point.AnchorB, impulse);
+			}
+		}
+
+		contact.BlockSolve = false;
+		if (contact.PointCount == 2)
+		{
+			const ContactPoint& point0 = contact.Points[0];
+			const ContactPoint& point1 = contact.Points[1];
+			const float coupling = a.InverseMass + b.InverseMass
+				+ a.InverseInertia * Utils::Cross(point0.AnchorA, normal) * Utils::Cross(point1.AnchorA, normal)
+				+ b.InverseInertia * Utils::Cross(point0.AnchorB, normal) * Utils::Cross(point1.AnchorB, normal);
+			const float mass0 = 1.0f / point0.NormalMass;
+			const float mass1 = 1.0f / point1.NormalMass;
+
+			// Points almost on top of each other make the matrix singular, those are solved one at a time
+			if (mass0 * mass0 < 1000.0f * (mass0 * mass1 - coupling * coupling))
+			{
+				contact.BlockMass = glm::mat2(mass0, coupling, coupling, mass1);
+				contact.InverseBlockMass = glm::inverse(contact.BlockMass);
+				contact.BlockSolve = true;
+			}
+		}
+	}
+
+	void PhysicsWorld2D::SolveContact(Contact& contact)
+	{
+		Body& a = m_Bodies[contact.BodyA];
+		Body& b = m_Bodies[contact.BodyB];
+		const glm::vec2 normal = contact.Normal;
+		const glm::vec2 tangent = { normal.y, -normal.x };
+
+		// Only dynamic bodies are written, static and kinematic ones are shared between islands
+		const auto apply = [&a, &b](const ContactPoint& point, const glm::vec2& impulse)
+		{
+			if (a.Type == BodyType::Dynamic)
+			{
+				a.Velocity -= a.InverseMass * impulse;
+				a.AngularVelocity -= a.InverseInertia * Utils::Cross(point.AnchorA, impulse);
+			}
+			if (b.Type == BodyType::Dynamic)
+			{
+				b.Velocity += b.InverseMass * impulse;
+				b.AngularVelocity += b.InverseInertia * Utils::Cross(point.AnchorB, impulse);
+			}
+		};
+
+		const auto relativeVelocity = [&a, &b](const ContactPoint& point)
+		{
+			return b.Velocity + Utils::Cross(b.AngularVelocity, point.AnchorB) - a.Velocity - Utils::Cross(a.AngularVelocity, point.AnchorA);
+		};
+
+		// Friction first, it is bounded by the normal impulses of the last iteration
+		for (uint32_t p = 0; p < contact.PointCount; p++)
+		{
+			ContactPoint& point = contact.Points[p];
+
+			const float tangentSpeed = glm::dot(relativeVelocity(point), tangent);
+			const float maxFriction = contact.Friction * point.NormalImpulse;
+			const float tangentImpulse = glm::clamp(point.TangentImpulse - point.TangentMass * tangentSpeed, -maxFriction, maxFriction);
+			apply(point, (tangentImpulse - point.TangentImpulse) * tangent);
+			point.TangentImpulse = tangentImpulse;
+		}
+
+		// Accumulated impulses are clamped, not the increments, so the solver can take some back
+		if (contact.BlockSolve)
+		{
+			ContactPoint& point0 = contact.Points[0];
+			ContactPoint& point1 = contact.Points[1];
+			const glm::vec2 accumulated = { point0.NormalImpulse, point1.NormalImpulse };
+			const glm::vec2 speeds = {
+				glm::dot(relativeVelocity(point0), normal) - point0.Bias,
+				glm::dot(relativeVelocity(point1), normal) - point1.Bias
+			};
+			const glm::vec2 residual = speeds - contact.BlockMass * accumulated;
+
+			// The linear complementarity problem of two points, tries both pushing, either one and none
+			glm::vec2 impulses = -(contact.InverseBlockMass * residual);
+			if (impulses.x < 0.0f || impulses.y < 0.0f)
+			{
+				const float only0 = -residual.x / contact.BlockMass[0][0];
+				const float only1 = -residual.y / contact.BlockMass[1][1];
+				if (only0 >= 0.0f && contact.BlockMass[0][1] * only0 + residual.y >= 0.0f)
+					impulses = { only0, 0.0f };
+				else if (only1 >= 0.0f && contact.BlockMass[1][0] * only1 + residual.x >= 0.0f)
+					impulses = { 0.0f, only1 };
+				else if (residual.x >= 0.0f && residual.y >= 0.0f)
+					impulses = { 0.0f, 0.0f };
+				else
+					impulses = accumulated; // No solution, leaves the impulses alone
+			}
+
+			apply(point0, (impulses.x - accumulated.x) * normal);
+			apply(point1, (impulses.y - accumulated.y) * normal);
+			point0.NormalImpulse = impulses.x;
+			point1.NormalImpulse = impulses.y;
+		}
+		else
+		{
+			for (uint32_t p = 0; p < contact.PointCount; p++)
+			{
+				ContactPoint& point = contact.Points[p];
+
+				const float normalSpeed = glm::dot(relativeVelocity(point), normal);
+				const float normalImpulse = std::max(point.NormalImpulse + point.NormalMass * (point.Bias - normalSpeed), 0.0f);
+				apply(point, (normalImpulse - point.NormalImpulse) * normal);
+				point.NormalImpulse = normalImpulse;
+			}
+		}
+
+		// Penetration is resolved on the bias velocities, kept in the velocity it would make resting stacks rock
+		for (uint32_t p = 0; p < contact.PointCount; p++)
+		{
+			ContactPoint& point = contact.Points[p];
+			if (point.PositionBias == 0.0f && point.BiasImpulse == 0.0f)
+				continue;
+
+			const glm::vec2 relative = b.BiasVelocity + Utils::Cross(b.BiasAngularVelocity, point.AnchorB) - a.BiasVelocity - Utils::Cross(a.BiasAngularVelocity, point.AnchorA);
+			const float biasImpulse = std::max(point.BiasImpulse + point.NormalMass * (point.PositionBias - glm::dot(relative, normal)), 0.0f);
+			const glm::vec2 impulse = (biasImpulse - point.BiasImpulse) * normal;
+			point.BiasImpulse = biasImpulse;
+
+			if (a.Type == BodyType::Dynamic)
+			{
+				a.BiasVelocity -= a.InverseMass * impulse;
+				a.BiasAngularVelocity -= a.InverseInertia * Utils::Cross(point.AnchorA, impulse);
+			}
+			if (b.Type == BodyType::Dynamic)
+			{
+				b.BiasVelocity += b.InverseMass * impulse;
+				b.BiasAngularVelocity += b.InverseInertia * Utils::Cross(point.AnchorB, impulse);
+			}
+		}
+	}
+
+	void PhysicsWorld2D::IntegratePositions(const float timestep, ThreadPool* workers)
+	{
+		Utils::ParallelRange(workers, static_cast<uint32_t>(m_Bodies.size()), s_BodyChunkSize, [&](const uint32_t begin, const uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				Body& body = m_Bodies[i];
+				if (body.Type == BodyType::Static || !body.Awake)
+					continue;
+
+				body.Position += (body.Velocity + body.BiasVelocity) * timestep;
+				body.Angle += (body.AngularVelocity + body.BiasAngularVelocity) * timestep;
+				body.BiasVelocity = glm::vec2(0.0f);
+				body.BiasAngularVelocity = 0.0f;
+				body.Moved = true;
+				PlaceShape(i);
+			}
+		});
+	}
+
+	void PhysicsWorld2D::UpdateSleep(const float timestep)
+	{
+		const uint32_t count = static_cast<uint32_t>(m_Bodies.size());
+		static constexpr float linearTolerance = s_SleepLinearTolerance * s_SleepLinearTolerance;
+		static constexpr float angularTolerance = s_SleepAngularTolerance * s_SleepAngularTolerance;
+
+		// An island sleeps once every body in it has been slow for long enough
+		m_RootSleepTimes.assign(count, std::numeric_limits<float>::max());
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Body& body = m_Bodies[i];
+			if (body.Type == BodyType::Kinematic)
+			{
+				body.Awake = body.Velocity != glm::vec2(0.0f) || body.AngularVelocity != 0.0f;
+				continue;
+			}
+
+			if (body.Type != BodyType::Dynamic || !body.Awake)
+				continue;
+
+			if (glm::dot(body.Velocity, body.Velocity) > linearTolerance || body.AngularVelocity * body.AngularVelocity > angularTolerance)
+				body.SleepTime = 0.0f;
+			else
+				body.SleepTime += timestep;
+
+			float& rootSleepTime = m_RootSleepTimes[FindRoot(i)];
+			rootSleepTime = std::min(rootSleepTime, body.SleepTime);
+		}
+
+		m_AwakeCount = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Body& body = m_Bodies[i];
+			if (body.Type == BodyType::Dynamic && body.Awake && m_RootSleepTimes[FindRoot(i)] >= s_TimeToSleep)
+			{
+				body.Awake = false;
+				body.Velocity = { 0.0f, 0.0f };
+				body.AngularVelocity = 0.0f;
+			}
+
+			if (body.Type != BodyType::Static && body.Awake)
+				m_AwakeCount++;
+		}
+	}
+
+	void PhysicsWorld2D::CacheImpulses()
+	{
+		m_Cache.resize(m_Contacts.size());
+		for (size_t i = 0; i < m_Contacts.size(); i++)
+		{
+			const Contact& contact = m_Contacts[i];
+			CachedContact& entry = m_Cache[i];
+			entry.Key = GetContactKey(contact.BodyA, contact.BodyB);
+			entry.PointCount = contact.PointCount;
+			for (uint32_t p = 0; p < contact.PointCount; p++)
+			{
+				entry.IDs[p] = contact.Points[p].ID;
+				entry.NormalImpulses[p] = contact.Points[p].NormalImpulse;
+				entry.TangentImpulses[p] = contact.Points[p].TangentImpulse;
+			}
+		}
+
+		std::sort(m_Cache.begin(), m_Cache.end(), [](const CachedContact& lhs, const CachedContact& rhs) { return lhs.Key < rhs.Key; });
+	}
+
+	uint32_t PhysicsWorld2D::FindRoot(uint32_t body)
+	{
+		while (m_Parents[body] != body)
+		{
+			m_Parents[body] = m_Parents[m_Parents[body]];
+			body = m_Parents[body];
+		}
+
+		return body;
+	}
+
+	uint64_t PhysicsWorld2D::GetContactKey(const uint32_t bodyA, const uint32_t bodyB) const
+	{
+		// Entities, unlike body indices, stay the same when other bodies are removed
+		return static_cast<uint64_t>(entt::to_integral(m_Bodies[bodyA].Entity)) << 32 | entt::to_integral(m_Bodies[bodyB].Entity);
+	}
+
+}
@@ -0,0 +1,61 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Null/NullBuffer.hpp"
+#include "LunariaCore/RHI/Null/NullDevice.hpp"
+
+namespace Lunaria {
+
+	NullVertexBuffer::NullVertexBuffer(const uint32_t size, const BufferUsage usage)
+		: m_ResourceID(NullDevice::CreateResource(NullResourceType::VertexBuffer, size)), m_Size(size), m_Usage(usage)
+	{
+	}
+
+	NullVertexBuffer::~NullVertexBuffer()
+	{
+		NullDevice::DestroyResource(m_ResourceID);
+	}
+
+	void NullVertexBuffer::SetData(const void* data, const uint32_t size)
+	{
+		if (!data || size > m_Size)
+			NullDevice::ValidationError("VertexBuffer::SetData writes past the end of the buffer");
+	}
+
+	NullIndexBuffer::NullIndexBuffer(const void* /*indices*/, const uint32_t count, const IndexType type)
+		: m_ResourceID(NullDevice::CreateResource(NullResourceType::IndexBuffer, count * IndexTypeSize(type))), m_Count(count), m_Type(type)
+	{
+	}
+
+	NullIndexBuffer::~NullIndexBuffer()
+	{
+		NullDevice::DestroyResource(m_ResourceID);
+	}
+
+	NullStorageBuffer::NullStorageBuffer(const uint32_t size)
+		: m_ResourceID(NullDevice::CreateResource(NullResourceType::StorageBuffer, size)), m_Size(size)
+	{
+	}
+
+	NullStorageBuffer::~NullStorageBuffer()
+	{
+		NullDevice::DestroyResource(m_ResourceID);
+	}
+
+	void NullStorageBuffer::SetData(const void* data, const uint32_t size, const uint32_t offset)
+	{
+		if (!data || offset + size > m_Size)
+			NullDevice::ValidationError("StorageBuffer::SetData writes past the end of the buffer");
+	}
+
+	void NullStorageBuffer::GetData(void* data, const uint32_t size, const uint32_t offset) const
+	{
+		if (!data || offset + size > m_Size)
+		{
+			NullDevice::ValidationError("StorageBuffer::GetData reads past the end of the buffer");
+			return;
+		}
+
+		std::memset(data, 0, size);
+	}
+
+}
@@ -0,0 +1,172 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Null/NullDevice.hpp"
+
+namespace Lunaria {
+
+	struct NullResource
+	{
+		NullResourceType Type;
+		size_t Bytes = 0;
+	};
+
+	struct NullDeviceData
+	{
+		std::unordered_map<uint32_t, NullResource> Resources;
+		uint32_t NextID = 1; // 0 is the default object, as in GL
+
+		uint32_t BoundShader = 0;
+		uint32_t BoundVertexArray = 0;
+		uint32_t BoundFrameBuffer = 0;
+
+		bool CommandLogEnabled = true;
+		std::vector<NullCommand> Commands;
+
+		NullDevice::MemoryStatistics Memory;
+		uint32_t ValidationErrors = 0;
+	};
+
+	static NullDeviceData s_Device;
+
+	size_t NullDevice::MemoryStatistics::GetTotalBytes() const
+	{
+		size_t total = 0;
+		for (const size_t bytes : Bytes)
+			total += bytes;
+		return total;
+	}
+
+	uint32_t NullDevice::CreateResource(NullResourceType type, size_t bytes)
+	{
+		const uint32_t id = s_Device.NextID++;
+		s_Device.Resources[id] = { type, bytes };
+
+		const auto index = static_cast<size_t>(type);
+		s_Device.Memory.Resources[index]++;
+		s_Device.Memory.Bytes[index] += bytes;
+
+		return id;
+	}
+
+	void NullDevice::ResizeResource(uint32_t id, size_t bytes)
+	{
+		const auto it = s_Device.Resources.find(id);
+		if (it == s_Device.Resources.end())
+		{
+			ValidationError("Resize of a destroyed resource");
+			return;
+		}
+
+		const auto index = static_cast<size_t>(it->second.Type);
+		s_Device.Memory.Bytes[index] -= it->second.Bytes;
+		s_Device.Memory.Bytes[index] += bytes;
+		it->second.Bytes = bytes;
+	}
+
+	void NullDevice::DestroyResource(uint32_t id)
+	{
+		const auto it = s_Device.Resources.find(id);
+		if (it == s_Device.Resources.end())
+		{
+			ValidationError("Double destruction of a resource");
+			return;
+		}
+
+		const auto index = static_cast<size_t>(it->second.Type);
+		s_Device.Memory.Resources[index]--;
+		s_Device.Memory.Bytes[index] -= it->second.Bytes;
+
+		// Deleting bound objects unbinds them
+		if (s_Device.BoundShader == id)
+			s_Device.BoundShader = 0;
+		if (s_Device.BoundVertexArray == id)
+			s_Device.BoundVertexArray = 0;
+		if (s_Device.BoundFrameBuffer == id)
+			s_Device.BoundFrameBuffer = 0;
+
+		s_Device.Resources.erase(it);
+	}
+
+	bool NullDevice::IsAlive(uint32_t id, NullResourceType type)
+	{
+		const auto it = s_Device.Resources.find(id);
+		return it != s_Device.Resources.end() && it->second.Type == type;
+	}
+
+	void NullDevice::BindShader(uint32_t shader)
+	{
+		if (shader && !IsAlive(shader, NullResourceType::Shader))
+			ValidationError("Bind of a destroyed shader");
+
+		s_Device.BoundShader = shader;
+	}
+
+	void NullDevice::BindVertexArray(uint32_t vertexArray)
+	{
+		if (vertexArray && !IsAlive(vertexArray, NullResourceType::VertexArray))
+			ValidationError("Bind of a destroyed vertex array");
+
+		s_Device.BoundVertexArray = vertexArray;
+	}
+
+	void NullDevice::BindFrameBuffer(uint32_t frameBuffer)
+	{
+		if (frameBuffer && !IsAlive(frameBuffer, NullResourceType::FrameBuffer))
+			ValidationError("Bind of a destroyed frame buffer");
+
+		s_Device.BoundFrameBuffer = frameBuffer;
+	}
+
+	uint32_t NullDevice::GetBoundShader()
+	{
+		return s_Device.BoundShader;
+	}
+
+	uint32_t NullDevice::GetBoundVertexArray()
+	{
+		return s_Device.BoundVertexArray;
+	}
+
+	void NullDevice::Record(NullCommand command)
+	{
+		if (!s_Device.CommandLogEnabled)
+			return;
+
+		command.Shader = s_Device.BoundShader;
+		command.VertexArray = s_Device.BoundVertexArray;
+		command.FrameBuffer = s_Device.BoundFrameBuffer;
+		s_Device.Commands.push_back(command);
+	}
+
+	void NullDevice::ValidationError(const std::string& message)
+	{
+		s_Device.ValidationErrors++;
+		LU_CORE_ERROR("Null device validation: {0}", message);
+	}
+
+	void NullDevice::SetCommandLogEnabled(bool enabled)
+	{
+		s_Device.CommandLogEnabled = enabled;
+	}
+
+	const std::vector<NullCommand>& NullDevice::GetCommands()
+	{
+		return s_Device.Commands;
+	}
+
+	void NullDevice::ClearCommands()
+	{
+		s_Device.Commands.clear();
+	}
+
+	NullDevice::MemoryStatistics NullDevice::GetMemoryStats()
+	{
+		return s_Device.Memory;
+	}
+
+	uint32_t NullDevice::GetValidationErrorCount()
+	{
+		return s_Device.ValidationErrors;
+	}
+
+}
@@ -0,0 +1,58 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Null/NullFrameBuffer.hpp"
+#include "LunariaCore/RHI/Null/NullDevice.hpp"
+
+namespace Lunaria {
+
+	// RGBA8 color and 24/8 depth stencil, as the OpenGL backend allocates
+	static size_t FrameBufferBytes(const FrameBufferSpecification& specification)
+	{
+		return static_cast<size_t>(specification.Width) * specification.Height * specification.Samples * 8;
+	}
+
+	NullFrameBuffer::NullFrameBuffer(const FrameBufferSpecification& specification)
+		: m_ResourceID(NullDevice::CreateResource(NullResourceType::FrameBuffer, FrameBufferBytes(specification))),
+		  m_Specification(specification), m_RenderSize(specification.Width, specification.Height)
+	{
+	}
+
+	NullFrameBuffer::~NullFrameBuffer()
+	{
+		NullDevice::DestroyResource(m_ResourceID);
+	}
+
+	void NullFrameBuffer::Bind()
+	{
+		if (m_Specification.Width == 0 || m_Specification.Height == 0)
+			NullDevice::ValidationError("Bind of a frame buffer with zero size");
+
+		NullDevice::BindFrameBuffer(m_ResourceID);
+	}
+
+	void NullFrameBuffer::Unbind()
+	{
+		NullDevice::BindFrameBuffer(0);
+	}
+
+	void NullFrameBuffer::Resize(const uint32_t width, const uint32_t height)
+	{
+		if (width == m_Specification.Width && height == m_Specification.Height)
+			return;
+
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+		m_RenderSize = { width, height };
+
+		NullDevice::ResizeResource(m_ResourceID, FrameBufferBytes(m_Specification));
+	}
+
+	void NullFrameBuffer::SetRenderSize(const uint32_t width, const uint32_t height)
+	{
+		if (width == 0 || height == 0)
+			NullDevice::ValidationError("Empty frame buffer render size");
+
+		m_RenderSize = glm::clamp(glm::uvec2(width, height), glm::uvec2(1), glm::uvec2(m_Specification.Width, m_Specification.Height));
+	}
+
+}
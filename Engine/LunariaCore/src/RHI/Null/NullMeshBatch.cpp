@@ -0,0 +1,108 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Null/NullMeshBatch.hpp"
+#include "LunariaCore/RHI/Null/NullBuffer.hpp"
+#include "LunariaCore/RHI/Null/NullDevice.hpp"
+
+namespace Lunaria {
+
+	NullMeshBatch::NullMeshBatch(const MeshBatchSpecification& specification)
+		: m_Specification(specification), m_VertexAllocator(specification.MaxVertices, 1), m_IndexAllocator(specification.MaxIndices, 1)
+	{
+		const size_t bytes = static_cast<size_t>(specification.MaxVertices) * specification.Layout.GetStride()
+			+ static_cast<size_t>(specification.MaxIndices) * IndexTypeSize(specification.IndexFormat)
+			+ static_cast<size_t>(specification.MaxDraws) * (sizeof(glm::mat4) + 5 * sizeof(uint32_t));
+
+		m_ResourceID = NullDevice::CreateResource(NullResourceType::VertexBuffer, bytes);
+		m_Transforms.reserve(specification.MaxDraws);
+	}
+
+	NullMeshBatch::~NullMeshBatch()
+	{
+		NullDevice::DestroyResource(m_ResourceID);
+	}
+
+	uint32_t NullMeshBatch::AddMesh(const Ref<VertexArray>& vertexArray)
+	{
+		const auto& vertexBuffers = vertexArray->GetVertexBuffers();
+		const auto& indexBuffer = vertexArray->GetIndexBuffer();
+
+		if (vertexBuffers.size() != 1 || !indexBuffer || !(vertexBuffers[0]->GetLayout() == m_Specification.Layout))
+			return InvalidMesh;
+
+		if (indexBuffer->GetIndexType() != m_Specification.IndexFormat)
+			return InvalidMesh;
+
+		const auto& source = static_cast<const NullVertexBuffer&>(*vertexBuffers[0]);
+		if (source.GetUsage() != BufferUsage::Static)
+			return InvalidMesh;
+
+		MeshRange range;
+		range.Vertices = m_VertexAllocator.Allocate(source.GetSize() / m_Specification.Layout.GetStride());
+		if (!range.Vertices.IsValid())
+			return InvalidMesh;
+
+		range.Indices = m_IndexAllocator.Allocate(indexBuffer->GetCount());
+		if (!range.Indices.IsValid())
+		{
+			m_VertexAllocator.Free(range.Vertices);
+			return InvalidMesh;
+		}
+
+		if (!m_FreeMeshes.empty())
+		{
+			const uint32_t mesh = m_FreeMeshes.back();
+			m_FreeMeshes.pop_back();
+			m_Meshes[mesh] = range;
+			return mesh;
+		}
+
+		m_Meshes.push_back(range);
+		return static_cast<uint32_t>(m_Meshes.size() - 1);
+	}
+
+	void NullMeshBatch::RemoveMesh(const uint32_t mesh)
+	{
+		if (mesh >= m_Meshes.size() || !m_Meshes[mesh].Vertices.IsValid())
+		{
+			NullDevice::ValidationError("RemoveMesh of an invalid mesh handle");
+			return;
+		}
+
+		m_VertexAllocator.Free(m_Meshes[mesh].Vertices);
+		m_IndexAllocator.Free(m_Meshes[mesh].Indices);
+		m_Meshes[mesh] = {};
+		m_FreeMeshes.push_back(mesh);
+	}
+
+	bool NullMeshBatch::Submit(const uint32_t mesh, const glm::mat4& transform)
+	{
+		if (mesh >= m_Meshes.size() || !m_Meshes[mesh].Vertices.IsValid())
+			NullDevice::ValidationError("Submit of an invalid mesh handle");
+
+		if (m_DrawCount >= m_Specification.MaxDraws)
+			return false;
+
+		m_Transforms.push_back(transform);
+		m_DrawCount++;
+		return true;
+	}
+
+	void NullMeshBatch::Flush()
+	{
+		if (m_DrawCount == 0)
+			return;
+
+		if (NullDevice::GetBoundShader() == 0)
+			NullDevice::ValidationError("MeshBatch::Flush without a bound shader");
+
+		NullCommand command;
+		command.CommandType = NullCommand::Type::MultiDrawIndexedIndirect;
+		command.Count = m_DrawCount;
+		NullDevice::Record(command);
+
+		m_Transforms.clear();
+		m_DrawCount = 0;
+	}
+
+}
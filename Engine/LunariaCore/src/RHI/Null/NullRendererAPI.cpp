@@ -0,0 +1,114 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Null/NullRendererAPI.hpp"
+#include "LunariaCore/RHI/Null/NullDevice.hpp"
+
+namespace Lunaria {
+
+	void NullRendererAPI::Init()
+	{
+		LU_CORE_INFO("Null renderer backend, nothing will be drawn");
+	}
+
+	void NullRendererAPI::SetViewport(const int /*x*/, const int /*y*/, const uint32_t width, const uint32_t height)
+	{
+		if (width == 0 || height == 0)
+			NullDevice::ValidationError("Empty viewport");
+
+		m_Stats.IssuedCalls++;
+		NullDevice::Record({ NullCommand::Type::SetViewport });
+	}
+
+	void NullRendererAPI::SetClearColor(const glm::vec4& /*color*/)
+	{
+		m_Stats.IssuedCalls++;
+		NullDevice::Record({ NullCommand::Type::SetClearColor });
+	}
+
+	void NullRendererAPI::Clear()
+	{
+		NullDevice::Record({ NullCommand::Type::Clear });
+	}
+
+	void NullRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, const uint32_t indexCount, const uint32_t instanceCount)
+	{
+		vertexArray->Bind();
+
+		const auto& indexBuffer = vertexArray->GetIndexBuffer();
+		if (!indexBuffer)
+		{
+			NullDevice::ValidationError("DrawIndexed with a vertex array without index buffer");
+			return;
+		}
+
+		const uint32_t count = indexCount ? indexCount : indexBuffer->GetCount();
+		if (count > indexBuffer->GetCount())
+			NullDevice::ValidationError("DrawIndexed reads past the end of the index buffer");
+
+		if (NullDevice::GetBoundShader() == 0)
+			NullDevice::ValidationError("DrawIndexed without a bound shader");
+
+		if (instanceCount == 0)
+			NullDevice::ValidationError("DrawIndexed with zero instances");
+
+		NullCommand command;
+		command.CommandType = NullCommand::Type::DrawIndexed;
+		command.Count = count;
+		command.InstanceCount = instanceCount;
+		NullDevice::Record(command);
+	}
+
+	void NullRendererAPI::Dispatch(const uint32_t groupsX, const uint32_t groupsY, const uint32_t groupsZ)
+	{
+		if (NullDevice::GetBoundShader() == 0)
+			NullDevice::ValidationError("Dispatch without a bound shader");
+
+		if (groupsX == 0 || groupsY == 0 || groupsZ == 0)
+			NullDevice::ValidationError("Dispatch with zero work groups");
+
+		NullCommand command;
+		command.CommandType = NullCommand::Type::Dispatch;
+		command.Count = groupsX * groupsY * groupsZ;
+		NullDevice::Record(command);
+	}
+
+	void NullRendererAPI::Barrier(const uint32_t flags)
+	{
+		if (flags == 0)
+			NullDevice::ValidationError("Barrier without flags");
+
+		NullCommand command;
+		command.CommandType = NullCommand::Type::Barrier;
+		command.Count = flags;
+		NullDevice::Record(command);
+	}
+
+	void NullRendererAPI::PushDebugGroup(const char* /*name*/)
+	{
+		m_DebugGroupDepth++;
+		NullDevice::Record({ NullCommand::Type::PushDebugGroup });
+	}
+
+	void NullRendererAPI::PopDebugGroup()
+	{
+		if (m_DebugGroupDepth == 0)
+		{
+			NullDevice::ValidationError("PopDebugGroup without PushDebugGroup");
+			return;
+		}
+
+		m_DebugGroupDepth--;
+		NullDevice::Record({ NullCommand::Type::PopDebugGroup });
+	}
+
+	void NullRendererAPI::ResetStateStats()
+	{
+		m_Stats = {};
+	}
+
+	RendererAPI::StateStatistics NullRendererAPI::GetStateStats() const
+	{
+		return m_Stats;
+	}
+
+}
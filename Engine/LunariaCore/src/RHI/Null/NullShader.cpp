@@ -0,0 +1,46 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Null/NullShader.hpp"
+#include "LunariaCore/RHI/Null/NullDevice.hpp"
+
+#include <filesystem>
+
+namespace Lunaria {
+
+	NullShader::NullShader(const std::string& filepath)
+		: m_ResourceID(NullDevice::CreateResource(NullResourceType::Shader)),
+		  m_Name(std::filesystem::path(filepath).stem().string())
+	{
+		if (!std::filesystem::exists(filepath))
+			NullDevice::ValidationError("Shader file '" + filepath + "' does not exist");
+	}
+
+	NullShader::NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+		: m_ResourceID(NullDevice::CreateResource(NullResourceType::Shader)), m_Name(name)
+	{
+		if (vertexSrc.empty() || fragmentSrc.empty())
+			NullDevice::ValidationError("Shader '" + name + "' has an empty stage");
+	}
+
+	NullShader::~NullShader()
+	{
+		NullDevice::DestroyResource(m_ResourceID);
+	}
+
+	void NullShader::Bind() const
+	{
+		NullDevice::BindShader(m_ResourceID);
+	}
+
+	void NullShader::Unbind() const
+	{
+		NullDevice::BindShader(0);
+	}
+
+	void NullShader::ValidateUniform(const std::string& name) const
+	{
+		if (NullDevice::GetBoundShader() != m_ResourceID)
+			NullDevice::ValidationError("Uniform '" + name + "' set on shader '" + m_Name + "' while it is not bound");
+	}
+
+}
@@ -0,0 +1,76 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Null/NullTexture.hpp"
+#include "LunariaCore/RHI/Null/NullDevice.hpp"
+#include "LunariaCore/Renderer/CompressedTexture.hpp"
+
+#include <stb_image/stb_image.h>
+
+namespace Lunaria {
+
+	static size_t TextureBytes(const uint32_t width, const uint32_t height, const TextureSpecification& specification)
+	{
+		const size_t baseLevel = static_cast<size_t>(width) * height * 4;
+
+		// A full mip chain adds a third
+		return specification.MipFilter == TextureFilter::None ? baseLevel : baseLevel * 4 / 3;
+	}
+
+	NullTexture2D::NullTexture2D(const std::string& path, const TextureSpecification& specification)
+		: m_Specification(specification)
+	{
+		int width, height, channels;
+		if (CompressedTextureLoader::IsContainer(path))
+		{
+			CompressedTextureData data;
+			if (CompressedTextureLoader::Load(path, data))
+			{
+				m_Width = data.Width;
+				m_Height = data.Height;
+			}
+			else
+				NullDevice::ValidationError("Failed to load texture '" + path + "'");
+		}
+		else if (stbi_info(path.c_str(), &width, &height, &channels))
+		{
+			m_Width = static_cast<uint32_t>(width);
+			m_Height = static_cast<uint32_t>(height);
+		}
+		else
+			NullDevice::ValidationError("Failed to load texture '" + path + "'");
+
+		m_ResourceID = NullDevice::CreateResource(NullResourceType::Texture, TextureBytes(m_Width, m_Height, m_Specification));
+	}
+
+	NullTexture2D::NullTexture2D(const uint32_t width, const uint32_t height, const TextureSpecification& specification)
+		: m_ResourceID(NullDevice::CreateResource(NullResourceType::Texture, TextureBytes(width, height, specification))),
+		  m_Width(width), m_Height(height), m_Specification(specification)
+	{
+		if (width == 0 || height == 0)
+			NullDevice::ValidationError("Texture with zero size");
+	}
+
+	NullTexture2D::~NullTexture2D()
+	{
+		NullDevice::DestroyResource(m_ResourceID);
+	}
+
+	void NullTexture2D::SetData(void* data, const uint32_t size)
+	{
+		if (!data || size != m_Width * m_Height * 4)
+			NullDevice::ValidationError("Texture2D::SetData must write the entire texture");
+	}
+
+	void NullTexture2D::Bind(const uint32_t slot) const
+	{
+		if (slot >= 32)
+			NullDevice::ValidationError("Texture bound to slot " + std::to_string(slot));
+	}
+
+	Ref<Texture2D> NullTextureStreamer::Load(const std::string& path, const TextureSpecification& specification)
+	{
+		m_Stats.LoadedTextures++;
+		return CreateRef<NullTexture2D>(path, specification);
+	}
+
+}
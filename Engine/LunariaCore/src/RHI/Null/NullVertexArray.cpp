@@ -0,0 +1,55 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Null/NullVertexArray.hpp"
+#include "LunariaCore/RHI/Null/NullDevice.hpp"
+
+namespace Lunaria {
+
+	NullVertexArray::NullVertexArray()
+		: m_ResourceID(NullDevice::CreateResource(NullResourceType::VertexArray))
+	{
+	}
+
+	NullVertexArray::~NullVertexArray()
+	{
+		NullDevice::DestroyResource(m_ResourceID);
+	}
+
+	void NullVertexArray::Bind() const
+	{
+		NullDevice::BindVertexArray(m_ResourceID);
+	}
+
+	void NullVertexArray::Unbind() const
+	{
+		NullDevice::BindVertexArray(0);
+	}
+
+	void NullVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		if (vertexBuffer->GetLayout().GetElements().empty())
+			NullDevice::ValidationError("Vertex buffer without layout added to a vertex array");
+
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+	void NullVertexArray::SetVertexBuffer(uint32_t index, const Ref<VertexBuffer>& vertexBuffer)
+	{
+		if (index >= m_VertexBuffers.size())
+		{
+			NullDevice::ValidationError("Vertex buffer index out of range");
+			return;
+		}
+
+		if (!(vertexBuffer->GetLayout() == m_VertexBuffers[index]->GetLayout()))
+			NullDevice::ValidationError("Vertex buffer layout doesn't match the vertex format");
+
+		m_VertexBuffers[index] = vertexBuffer;
+	}
+
+	void NullVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
+	{
+		m_IndexBuffer = indexBuffer;
+	}
+
+}
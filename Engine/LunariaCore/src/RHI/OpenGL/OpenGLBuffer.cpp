@@ -1,72 +1,240 @@
 #include "lepch.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLBuffer.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLStateCache.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
 
 #include <glad/glad.h>
 
 namespace Lunaria {
 
+	static GLenum BufferUsageToOpenGL(BufferUsage usage)
+	{
+		switch (usage)
+		{
+			case BufferUsage::Static:	return GL_STATIC_DRAW;
+			case BufferUsage::Dynamic:	return GL_DYNAMIC_DRAW;
+			case BufferUsage::Stream:	return GL_STREAM_DRAW;
+		}
+
+		LU_CORE_ASSERT(false, "Unknown BufferUsage!");
+		return GL_STATIC_DRAW;
+	}
+
+	// ----------------- BUFFER POOL -----------------
+
+	OpenGLBufferPool::OpenGLBufferPool(const BufferArenaSpecification& specification)
+		: m_Specification(specification)
+	{
+	}
+
+	OpenGLBufferPool::~OpenGLBufferPool()
+	{
+		for (const auto& block : m_Blocks)
+		{
+			OpenGLStateCache::OnBufferDeleted(block.RendererID);
+			glDeleteBuffers(1, &block.RendererID);
+		}
+	}
+
+	OpenGLBufferPool::Range OpenGLBufferPool::Allocate(uint32_t size)
+	{
+		if (size == 0)
+			return {};
+
+		std::lock_guard lock(m_Mutex);
+
+		for (uint32_t i = 0; i < m_Blocks.size(); i++)
+		{
+			const OffsetAllocator::Allocation allocation = m_Blocks[i].Allocator.Allocate(size);
+			if (allocation.IsValid())
+			{
+				m_Allocations++;
+				return { i, m_Blocks[i].RendererID, allocation };
+			}
+		}
+
+		// No block has room, ranges larger than the block size get a block of their own
+		Block& block = m_Blocks.emplace_back();
+		block.Allocator = OffsetAllocator(std::max(m_Specification.BlockSize, (size + 15) & ~15u));
+
+		glCreateBuffers(1, &block.RendererID);
+		glNamedBufferData(block.RendererID, block.Allocator.GetCapacity(), nullptr, BufferUsageToOpenGL(m_Specification.Usage));
+
+		const OffsetAllocator::Allocation allocation = block.Allocator.Allocate(size);
+		LU_CORE_ASSERT(allocation.IsValid(), "Buffer arena block can't hold the range it was created for!");
+
+		m_Allocations++;
+		return { static_cast<uint32_t>(m_Blocks.size() - 1), block.RendererID, allocation };
+	}
+
+	void OpenGLBufferPool::Free(const Range& range)
+	{
+		if (!range.Allocation.IsValid())
+			return;
+
+		std::lock_guard lock(m_Mutex);
+		m_Blocks[range.Block].Allocator.Free(range.Allocation);
+		m_Allocations--;
+	}
+
+	BufferArena::Statistics OpenGLBufferPool::GetStats() const
+	{
+		std::lock_guard lock(m_Mutex);
+
+		BufferArena::Statistics stats;
+		stats.Blocks = static_cast<uint32_t>(m_Blocks.size());
+		stats.Allocations = m_Allocations;
+
+		for (const auto& block : m_Blocks)
+		{
+			stats.UsedBytes += block.Allocator.GetUsedSize();
+			stats.CapacityBytes += block.Allocator.GetCapacity();
+			stats.FreeRanges += block.Allocator.GetFreeRangeCount();
+		}
+
+		return stats;
+	}
+
 	// ----------------- VERTEX BUFFER -----------------
 
-	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size)
+	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size, BufferUsage usage)
+		: m_Size(size), m_Usage(usage)
 	{
 		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		glNamedBufferData(m_RendererID, size, nullptr, BufferUsageToOpenGL(usage));
 	}
 
-	OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size)
+	OpenGLVertexBuffer::OpenGLVertexBuffer(const float* vertices, uint32_t size, BufferUsage usage)
+		: m_Size(size), m_Usage(usage)
 	{
 		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+		glNamedBufferData(m_RendererID, size, vertices, BufferUsageToOpenGL(usage));
+	}
+
+	OpenGLVertexBuffer::OpenGLVertexBuffer(const Ref<OpenGLBufferPool>& pool, const void* vertices, uint32_t size)
+		: m_Size(size), m_Usage(pool->GetUsage()), m_Pool(pool), m_Range(pool->Allocate(size))
+	{
+		m_RendererID = m_Range.RendererID;
+		m_Offset = m_Range.Allocation.Offset;
+
+		if (vertices)
+			glNamedBufferSubData(m_RendererID, m_Offset, size, vertices);
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
+		// Ranges of a shared buffer only go back to the pool
+		if (m_Pool)
+		{
+			m_Pool->Free(m_Range);
+			return;
+		}
+
+		OpenGLStateCache::OnBufferDeleted(m_RendererID);
 		glDeleteBuffers(1, &m_RendererID);
 	}
 
 	void OpenGLVertexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		RenderThread::Submit([this] { OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID); });
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		RenderThread::Submit([] { OpenGLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0); });
 	}
 
 	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+		LU_CORE_ASSERT(size <= m_Size, "VertexBuffer::SetData writes past the end of the buffer!");
+
+		// The caller may reuse its memory while the upload is still queued
+		data = RenderThread::CopyFrameData(data, size);
+		RenderThread::Submit([this, data, size] { glNamedBufferSubData(m_RendererID, m_Offset, size, data); });
 	}
 
 	// ----------------- INDEX BUFFER -----------------
 
-	OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
-		: m_Count(count)
+	OpenGLIndexBuffer::OpenGLIndexBuffer(const void* indices, uint32_t count, IndexType type, BufferUsage usage)
+		: m_Count(count), m_Type(type)
 	{
 		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(count * sizeof(uint32_t)),
-			indices, GL_STATIC_DRAW);
+		glNamedBufferData(m_RendererID, static_cast<GLsizeiptr>(count * IndexTypeSize(type)),
+			indices, BufferUsageToOpenGL(usage));
+	}
+
+	OpenGLIndexBuffer::OpenGLIndexBuffer(const Ref<OpenGLBufferPool>& pool, const void* indices, uint32_t count, IndexType type)
+		: m_Count(count), m_Type(type), m_Pool(pool), m_Range(pool->Allocate(count * IndexTypeSize(type)))
+	{
+		m_RendererID = m_Range.RendererID;
+		m_Offset = m_Range.Allocation.Offset;
+
+		if (indices)
+			glNamedBufferSubData(m_RendererID, m_Offset, static_cast<GLsizeiptr>(count * IndexTypeSize(type)), indices);
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
+		if (m_Pool)
+		{
+			m_Pool->Free(m_Range);
+			return;
+		}
+
+		OpenGLStateCache::OnBufferDeleted(m_RendererID);
 		glDeleteBuffers(1, &m_RendererID);
 	}
 
 	void OpenGLIndexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		RenderThread::Submit([this] { OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID); });
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		RenderThread::Submit([] { OpenGLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); });
+	}
+
+	uint32_t OpenGLIndexBuffer::GetOpenGLIndexType() const
+	{
+		return m_Type == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	}
+
+	// ----------------- STORAGE BUFFER -----------------
+
+	OpenGLStorageBuffer::OpenGLStorageBuffer(const void* data, uint32_t size, BufferUsage usage)
+		: m_Size(size)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, size, data, BufferUsageToOpenGL(usage));
+	}
+
+	OpenGLStorageBuffer::~OpenGLStorageBuffer()
+	{
+		OpenGLStateCache::OnBufferDeleted(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLStorageBuffer::Bind(uint32_t binding) const
+	{
+		RenderThread::Submit([this, binding] { OpenGLStateCache::BindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID); });
+	}
+
+	void OpenGLStorageBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		LU_CORE_ASSERT(offset + size <= m_Size, "StorageBuffer::SetData writes past the end of the buffer!");
+
+		data = RenderThread::CopyFrameData(data, size);
+		RenderThread::Submit([this, data, size, offset] { glNamedBufferSubData(m_RendererID, offset, size, data); });
+	}
+
+	void OpenGLStorageBuffer::GetData(void* data, uint32_t size, uint32_t offset) const
+	{
+		LU_CORE_ASSERT(offset + size <= m_Size, "StorageBuffer::GetData reads past the end of the buffer!");
+
+		// The driver waits for the commands writing the buffer
+		RenderThread::ExecuteSync([&] { glGetNamedBufferSubData(m_RendererID, offset, size, data); });
 	}
 
-} 
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLBufferArena.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
+
+namespace Lunaria {
+
+	OpenGLBufferArena::OpenGLBufferArena(const BufferArenaSpecification& specification)
+		: m_Specification(specification), m_Pool(CreateRef<OpenGLBufferPool>(specification))
+	{
+	}
+
+	Ref<VertexBuffer> OpenGLBufferArena::CreateVertexBuffer(const void* vertices, uint32_t size)
+	{
+		// Ranges are allocated on the render thread, the only one touching the shared buffers
+		return RenderThread::CreateResource<OpenGLVertexBuffer>(m_Pool, vertices, size);
+	}
+
+	Ref<IndexBuffer> OpenGLBufferArena::CreateIndexBuffer(const void* indices, uint32_t count, IndexType type)
+	{
+		return RenderThread::CreateResource<OpenGLIndexBuffer>(m_Pool, indices, count, type);
+	}
+
+}
@@ -16,7 +16,7 @@ namespace Lunaria {
 
 	void OpenGLContext::Init()
 	{
-		SDL_GL_CreateContext(m_WindowHandle);
+		m_Context = SDL_GL_CreateContext(m_WindowHandle);
 		int status = gladLoadGLLoader(SDL_GL_GetProcAddress);
 		LU_CORE_ASSERT(status, "Failed to initialize Glad!");
 
@@ -33,4 +33,15 @@ namespace Lunaria {
 		SDL_GL_SwapWindow(m_WindowHandle);
 	}
 
+	void OpenGLContext::MakeCurrent()
+	{
+		if (SDL_GL_MakeCurrent(m_WindowHandle, m_Context) != 0)
+			LU_CORE_ERROR("Failed to make the OpenGL context current: {0}", SDL_GetError());
+	}
+
+	void OpenGLContext::ReleaseCurrent()
+	{
+		SDL_GL_MakeCurrent(m_WindowHandle, nullptr);
+	}
+
 }
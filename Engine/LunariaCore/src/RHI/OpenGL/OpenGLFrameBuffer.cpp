@@ -1,6 +1,8 @@
 #include "lepch.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLFrameBuffer.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLStateCache.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
 
 #include <glad/glad.h>
 
@@ -10,13 +12,17 @@ namespace Lunaria {
 
 	void OpenGLFrameBuffer::Delete() const
 	{
+		OpenGLStateCache::OnFramebufferDeleted(m_RendererID);
+		OpenGLStateCache::OnTextureDeleted(m_ColorAttachment);
+		OpenGLStateCache::OnTextureDeleted(m_DepthAttachment);
+
 		glDeleteFramebuffers(1, &m_RendererID);
 		glDeleteTextures(1, &m_ColorAttachment);
 		glDeleteTextures(1, &m_DepthAttachment);
 	}
 
 	OpenGLFrameBuffer::OpenGLFrameBuffer(const FrameBufferSpecification& specification)
-		: m_Specification(specification)
+		: m_Specification(specification), m_RenderSize(specification.Width, specification.Height)
 	{
 		Invalidate();
 	}
@@ -31,45 +37,40 @@ namespace Lunaria {
 		if (m_RendererID)
 			Delete();
 
+		// Attachments are created with DSA so no binding state is disturbed
 		glCreateFramebuffers(1, &m_RendererID);
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
 
 		// Create color attachment
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_ColorAttachment);
-		glBindTexture(GL_TEXTURE_2D, m_ColorAttachment);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 
-			static_cast<GLsizei>(m_Specification.Width), static_cast<GLsizei>(m_Specification.Height), 
-			0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glTextureStorage2D(m_ColorAttachment, 1, GL_RGBA8,
+			static_cast<GLsizei>(m_Specification.Width), static_cast<GLsizei>(m_Specification.Height));
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(m_ColorAttachment, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_ColorAttachment, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, 
-			GL_TEXTURE_2D, m_ColorAttachment, 0);
+		glNamedFramebufferTexture(m_RendererID, GL_COLOR_ATTACHMENT0, m_ColorAttachment, 0);
 
 		// Create depth buffer
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_DepthAttachment);
-		glBindTexture(GL_TEXTURE_2D, m_DepthAttachment);
-		glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH32F_STENCIL8,
+		glTextureStorage2D(m_DepthAttachment, 1, GL_DEPTH32F_STENCIL8,
 			static_cast<GLsizei>(m_Specification.Width), static_cast<GLsizei>(m_Specification.Height));
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
-			GL_TEXTURE_2D, m_DepthAttachment, 0);
-
-		LU_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "FrameBuffer is incomplete!");
+		glNamedFramebufferTexture(m_RendererID, GL_DEPTH_STENCIL_ATTACHMENT, m_DepthAttachment, 0);
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		LU_CORE_ASSERT(glCheckNamedFramebufferStatus(m_RendererID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "FrameBuffer is incomplete!");
 	}
 
 	void OpenGLFrameBuffer::Bind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glViewport(0, 0, static_cast<GLsizei>(m_Specification.Width), 
-			static_cast<GLsizei>(m_Specification.Height));
+		RenderThread::Submit([this, width = m_RenderSize.x, height = m_RenderSize.y]
+		{
+			OpenGLStateCache::BindFramebuffer(m_RendererID);
+			OpenGLStateCache::Viewport(0, 0, width, height);
+		});
 	}
 
 	void OpenGLFrameBuffer::Unbind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		RenderThread::Submit([] { OpenGLStateCache::BindFramebuffer(0); });
 	}
 
 	void OpenGLFrameBuffer::Resize(uint32_t width, uint32_t height)
@@ -77,9 +78,20 @@ namespace Lunaria {
 		if (width == 0 || height == 0 || width > s_MaxFramebufferSize || height > s_MaxFramebufferSize)
 			return;
 
+		// Callers resize every frame, recreating would stall on the render thread each time
+		if (width == m_Specification.Width && height == m_Specification.Height)
+			return;
+
 		m_Specification.Width = width;
 		m_Specification.Height = height;
+		m_RenderSize = { width, height };
 
-		Invalidate();
+		// Waits for the render thread, the new attachment IDs are read right after (ImGui::Image)
+		RenderThread::ExecuteSync([this] { Invalidate(); });
+	}
+
+	void OpenGLFrameBuffer::SetRenderSize(const uint32_t width, const uint32_t height)
+	{
+		m_RenderSize = glm::clamp(glm::uvec2(width, height), glm::uvec2(1), glm::uvec2(m_Specification.Width, m_Specification.Height));
 	}
 }
@@ -0,0 +1,54 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLGpuFence.hpp"
+
+#include <glad/glad.h>
+
+#include <chrono>
+
+namespace Lunaria {
+
+	OpenGLGpuFence::~OpenGLGpuFence()
+	{
+		if (m_Sync)
+			glDeleteSync(static_cast<GLsync>(m_Sync));
+	}
+
+	void OpenGLGpuFence::Signal()
+	{
+		if (m_Sync)
+			glDeleteSync(static_cast<GLsync>(m_Sync));
+
+		m_Sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	bool OpenGLGpuFence::IsSignaled() const
+	{
+		if (!m_Sync)
+			return true;
+
+		GLint status = GL_UNSIGNALED;
+		glGetSynciv(static_cast<GLsync>(m_Sync), GL_SYNC_STATUS, 1, nullptr, &status);
+		return status == GL_SIGNALED;
+	}
+
+	bool OpenGLGpuFence::Wait(uint64_t timeoutNanoseconds)
+	{
+		m_LastWaitMilliseconds = 0.0f;
+		if (!m_Sync)
+			return true;
+
+		// Flushing makes sure the fence reaches the GPU, an unflushed fence could never signal
+		const auto start = std::chrono::steady_clock::now();
+		const GLenum result = glClientWaitSync(static_cast<GLsync>(m_Sync), GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNanoseconds);
+
+		if (result == GL_TIMEOUT_EXPIRED || result == GL_CONDITION_SATISFIED)
+			m_LastWaitMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		if (result == GL_WAIT_FAILED)
+			LU_CORE_ERROR("glClientWaitSync failed");
+
+		return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+	}
+
+}
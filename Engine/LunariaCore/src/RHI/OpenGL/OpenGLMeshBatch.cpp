@@ -0,0 +1,218 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLMeshBatch.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLBuffer.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLStateCache.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
+#include "LunariaCore/Renderer/FrameSync.hpp"
+
+#include <glad/glad.h>
+
+namespace Lunaria {
+
+	OpenGLMeshBatch::OpenGLMeshBatch(const MeshBatchSpecification& specification)
+		: m_Specification(specification), m_VertexAllocator(specification.MaxVertices, 1), m_IndexAllocator(specification.MaxIndices, 1)
+	{
+		LU_CORE_ASSERT(specification.Layout.GetStride() > 0, "Mesh batch has no vertex layout!");
+
+		m_VertexArena = VertexBuffer::Create(specification.MaxVertices * specification.Layout.GetStride());
+		m_VertexArena->SetLayout(specification.Layout);
+
+		if (specification.IndexFormat == IndexType::UInt16)
+			m_IndexArena = IndexBuffer::Create(static_cast<const uint16_t*>(nullptr), specification.MaxIndices, BufferUsage::Dynamic);
+		else
+			m_IndexArena = IndexBuffer::Create(static_cast<const uint32_t*>(nullptr), specification.MaxIndices, BufferUsage::Dynamic);
+
+		m_VertexArray = VertexArray::Create();
+		m_VertexArray->AddVertexBuffer(m_VertexArena);
+		m_VertexArray->SetIndexBuffer(m_IndexArena);
+
+		// Every range bound as the transform buffer starts on the alignment, region bases included
+		GLint alignment = 1;
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		const auto alignmentBytes = static_cast<uint32_t>(std::max(alignment, 1));
+		m_TransformAlignment = static_cast<uint32_t>((alignmentBytes + sizeof(glm::mat4) - 1) / sizeof(glm::mat4));
+		LU_CORE_ASSERT(m_TransformAlignment * sizeof(glm::mat4) % alignmentBytes == 0, "Storage buffer alignment is not a power of two!");
+
+		m_RegionCount = FrameSync::GetFramesInFlight();
+		m_RegionDraws = (specification.MaxDraws + m_TransformAlignment - 1) / m_TransformAlignment * m_TransformAlignment;
+		const auto transformSize = static_cast<GLsizeiptr>(m_RegionCount) * m_RegionDraws * sizeof(glm::mat4);
+		const auto commandSize = static_cast<GLsizeiptr>(m_RegionCount) * m_RegionDraws * sizeof(DrawElementsIndirectCommand);
+
+		// Dynamic storage too, for the flushes that don't fit into their region anymore
+		constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glCreateBuffers(1, &m_TransformBuffer);
+		glNamedBufferStorage(m_TransformBuffer, transformSize, nullptr, flags | GL_DYNAMIC_STORAGE_BIT);
+		m_TransformMemory = static_cast<glm::mat4*>(glMapNamedBufferRange(m_TransformBuffer, 0, transformSize, flags));
+
+		glCreateBuffers(1, &m_IndirectBuffer);
+		glNamedBufferStorage(m_IndirectBuffer, commandSize, nullptr, flags | GL_DYNAMIC_STORAGE_BIT);
+		m_CommandMemory = static_cast<DrawElementsIndirectCommand*>(glMapNamedBufferRange(m_IndirectBuffer, 0, commandSize, flags));
+
+		LU_CORE_ASSERT(m_TransformMemory && m_CommandMemory, "Failed to map the mesh batch buffers!");
+
+		m_Commands.reserve(specification.MaxDraws);
+		m_Transforms.reserve(specification.MaxDraws);
+	}
+
+	OpenGLMeshBatch::~OpenGLMeshBatch()
+	{
+		glUnmapNamedBuffer(m_TransformBuffer);
+		glUnmapNamedBuffer(m_IndirectBuffer);
+
+		OpenGLStateCache::OnBufferDeleted(m_TransformBuffer);
+		OpenGLStateCache::OnBufferDeleted(m_IndirectBuffer);
+
+		glDeleteBuffers(1, &m_TransformBuffer);
+		glDeleteBuffers(1, &m_IndirectBuffer);
+	}
+
+	uint32_t OpenGLMeshBatch::AddMesh(const Ref<VertexArray>& vertexArray)
+	{
+		const auto& vertexBuffers = vertexArray->GetVertexBuffers();
+		const auto& indexBuffer = vertexArray->GetIndexBuffer();
+
+		// Only single stream meshes can be packed
+		if (vertexBuffers.size() != 1 || !indexBuffer || !(vertexBuffers[0]->GetLayout() == m_Specification.Layout))
+			return InvalidMesh;
+
+		// Indices are copied as they are, without conversion
+		if (indexBuffer->GetIndexType() != m_Specification.IndexFormat)
+			return InvalidMesh;
+
+		const auto& source = static_cast<const OpenGLVertexBuffer&>(*vertexBuffers[0]);
+		const auto& sourceIndices = static_cast<const OpenGLIndexBuffer&>(*indexBuffer);
+
+		// The copy below is taken once, later SetData calls would never reach the arena
+		if (source.GetUsage() != BufferUsage::Static)
+			return InvalidMesh;
+
+		const uint32_t stride = m_Specification.Layout.GetStride();
+		const uint32_t vertexCount = source.GetSize() / stride;
+		const uint32_t indexCount = sourceIndices.GetCount();
+
+		const OffsetAllocator::Allocation vertices = m_VertexAllocator.Allocate(vertexCount);
+		if (!vertices.IsValid())
+			return InvalidMesh;
+
+		const OffsetAllocator::Allocation indices = m_IndexAllocator.Allocate(indexCount);
+		if (!indices.IsValid())
+		{
+			m_VertexAllocator.Free(vertices);
+			return InvalidMesh;
+		}
+
+		const auto& vertexArena = static_cast<const OpenGLVertexBuffer&>(*m_VertexArena);
+		const auto& indexArena = static_cast<const OpenGLIndexBuffer&>(*m_IndexArena);
+
+		// GPU side copies, indices stay local to the mesh and are rebased with BaseVertex
+		// Sources may be ranges of a shared arena buffer, copies start at their offset
+		RenderThread::Submit([source = source.GetRendererID(), sourceOffset = source.GetOffset(),
+			sourceIndices = sourceIndices.GetRendererID(), sourceIndexOffset = sourceIndices.GetOffset(),
+			vertexArena = vertexArena.GetRendererID(), indexArena = indexArena.GetRendererID(),
+			vertexOffset = vertices.Offset, indexOffset = indices.Offset, vertexCount, indexCount, stride,
+			indexSize = IndexTypeSize(m_Specification.IndexFormat)]
+		{
+			glCopyNamedBufferSubData(source, vertexArena,
+				sourceOffset, static_cast<GLintptr>(vertexOffset) * stride, static_cast<GLsizeiptr>(vertexCount) * stride);
+			glCopyNamedBufferSubData(sourceIndices, indexArena,
+				sourceIndexOffset, static_cast<GLintptr>(indexOffset) * indexSize, static_cast<GLsizeiptr>(indexCount) * indexSize);
+		});
+
+		const MeshRange range = { indexCount, indices.Offset, static_cast<int32_t>(vertices.Offset), vertices, indices };
+		if (!m_FreeMeshes.empty())
+		{
+			const uint32_t mesh = m_FreeMeshes.back();
+			m_FreeMeshes.pop_back();
+			m_Meshes[mesh] = range;
+			return mesh;
+		}
+
+		m_Meshes.push_back(range);
+		return static_cast<uint32_t>(m_Meshes.size() - 1);
+	}
+
+	void OpenGLMeshBatch::RemoveMesh(const uint32_t mesh)
+	{
+		LU_CORE_ASSERT(mesh < m_Meshes.size() && m_Meshes[mesh].Vertices.IsValid(), "Invalid mesh handle!");
+
+		// Draws already queued read the ranges first, the context runs the later copies after them
+		MeshRange& range = m_Meshes[mesh];
+		m_VertexAllocator.Free(range.Vertices);
+		m_IndexAllocator.Free(range.Indices);
+		range = {};
+		m_FreeMeshes.push_back(mesh);
+	}
+
+	bool OpenGLMeshBatch::Submit(uint32_t mesh, const glm::mat4& transform)
+	{
+		LU_CORE_ASSERT(mesh < m_Meshes.size() && m_Meshes[mesh].Vertices.IsValid(), "Invalid mesh handle!");
+
+		if (m_Commands.size() >= m_Specification.MaxDraws)
+			return false;
+
+		const MeshRange& range = m_Meshes[mesh];
+		const auto drawIndex = static_cast<uint32_t>(m_Commands.size());
+
+		m_Commands.push_back({ range.IndexCount, 1, range.FirstIndex, range.BaseVertex, drawIndex });
+		m_Transforms.push_back(transform);
+
+		return true;
+	}
+
+	void OpenGLMeshBatch::Flush()
+	{
+		if (m_Commands.empty())
+			return; // Nothing to draw
+
+		const auto drawCount = static_cast<GLsizei>(m_Commands.size());
+		const auto transformSize = static_cast<uint32_t>(drawCount * sizeof(glm::mat4));
+		const auto commandSize = static_cast<uint32_t>(drawCount * sizeof(DrawElementsIndirectCommand));
+
+		// Both arrays are cleared below, queued uploads read copies
+		const void* transforms = RenderThread::CopyFrameData(m_Transforms.data(), transformSize);
+		const void* commands = RenderThread::CopyFrameData(m_Commands.data(), commandSize);
+
+		const GLenum indexType = static_cast<const OpenGLIndexBuffer&>(*m_IndexArena).GetOpenGLIndexType();
+
+		// Several flushes in one frame are placed one after the other in the frame's region
+		const uint64_t frame = FrameSync::GetCurrentFrame();
+		if (m_RegionFrame != frame)
+		{
+			m_RegionFrame = frame;
+			m_RegionCursor = 0;
+		}
+
+		// A full region is rewritten through the driver, which orders it after the draws still reading it
+		const bool mapped = m_RegionCursor + drawCount <= m_RegionDraws;
+		const uint32_t first = FrameSync::GetFrameSlot() % m_RegionCount * m_RegionDraws + (mapped ? m_RegionCursor : 0);
+		m_RegionCursor = mapped ? (m_RegionCursor + drawCount + m_TransformAlignment - 1) / m_TransformAlignment * m_TransformAlignment : m_RegionDraws;
+
+		RenderThread::Submit([this, drawCount, transformSize, commandSize, transforms, commands, indexType, first, mapped]
+		{
+			const GLintptr transformOffset = static_cast<GLintptr>(first) * sizeof(glm::mat4);
+			const GLintptr commandOffset = static_cast<GLintptr>(first) * sizeof(DrawElementsIndirectCommand);
+
+			if (mapped)
+			{
+				memcpy(m_TransformMemory + first, transforms, transformSize);
+				memcpy(m_CommandMemory + first, commands, commandSize);
+			}
+			else
+			{
+				glNamedBufferSubData(m_TransformBuffer, transformOffset, transformSize, transforms);
+				glNamedBufferSubData(m_IndirectBuffer, commandOffset, commandSize, commands);
+			}
+
+			OpenGLStateCache::BindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, m_TransformBuffer, transformOffset, transformSize);
+			OpenGLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer);
+			m_VertexArray->Bind();
+
+			glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, reinterpret_cast<const void*>(commandOffset), drawCount, 0);
+		});
+
+		m_Commands.clear();
+		m_Transforms.clear();
+	}
+
+}
@@ -1,6 +1,8 @@
 #include "lepch.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLRendererAPI.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLBuffer.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLStateCache.hpp"
 
 #include <glad/glad.h>
 
@@ -44,20 +46,22 @@ namespace Lunaria
             glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
         #endif
 
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        OpenGLStateCache::Invalidate();
 
-        glEnable(GL_DEPTH_TEST); // Enable depth testing
+        OpenGLStateCache::SetCapability(GL_BLEND, true);
+        OpenGLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        OpenGLStateCache::SetCapability(GL_DEPTH_TEST, true); // Enable depth testing
     }
 
     void OpenGLRendererAPI::SetViewport(const int x, const int y, const uint32_t width, const uint32_t height)
     {
-        glViewport(x, y, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+        OpenGLStateCache::Viewport(x, y, width, height);
     }
 
     void OpenGLRendererAPI::SetClearColor(const glm::vec4& color)
     {
-        glClearColor(color.r, color.g, color.b, color.a);
+        OpenGLStateCache::ClearColor(color);
     }
 
     void OpenGLRendererAPI::Clear()
@@ -65,10 +69,63 @@ namespace Lunaria
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
 
-    void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
+    void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount)
+    {
+        const auto& indexBuffer = static_cast<const OpenGLIndexBuffer&>(*vertexArray->GetIndexBuffer());
+        const GLsizei count = indexCount ? static_cast<GLsizei>(indexCount) : static_cast<GLsizei>(indexBuffer.GetCount());
+        const GLenum type = indexBuffer.GetOpenGLIndexType();
+        const auto* offset = reinterpret_cast<const void*>(static_cast<uintptr_t>(indexBuffer.GetOffset()));
+        vertexArray->Bind();
+
+        if (instanceCount > 1)
+            glDrawElementsInstanced(GL_TRIANGLES, count, type, offset, static_cast<GLsizei>(instanceCount));
+        else
+            glDrawElements(GL_TRIANGLES, count, type, offset);
+    }
+
+    void OpenGLRendererAPI::Dispatch(const uint32_t groupsX, const uint32_t groupsY, const uint32_t groupsZ)
+    {
+        glDispatchCompute(groupsX, groupsY, groupsZ);
+    }
+
+    void OpenGLRendererAPI::Barrier(const uint32_t flags)
+    {
+        if (flags == BarrierAll)
+        {
+            glMemoryBarrier(GL_ALL_BARRIER_BITS);
+            return;
+        }
+
+        GLbitfield barriers = 0;
+        if (flags & BarrierStorageBuffer)   barriers |= GL_SHADER_STORAGE_BARRIER_BIT;
+        if (flags & BarrierVertexBuffer)    barriers |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+        if (flags & BarrierIndexBuffer)     barriers |= GL_ELEMENT_ARRAY_BARRIER_BIT;
+        if (flags & BarrierIndirectCommand) barriers |= GL_COMMAND_BARRIER_BIT;
+        if (flags & BarrierTextureFetch)    barriers |= GL_TEXTURE_FETCH_BARRIER_BIT;
+        if (flags & BarrierShaderImage)     barriers |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+        if (flags & BarrierBufferUpdate)    barriers |= GL_BUFFER_UPDATE_BARRIER_BIT;
+
+        if (barriers)
+            glMemoryBarrier(barriers);
+    }
+
+    void OpenGLRendererAPI::PushDebugGroup(const char* name)
+    {
+        glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+    }
+
+    void OpenGLRendererAPI::PopDebugGroup()
+    {
+        glPopDebugGroup();
+    }
+
+    void OpenGLRendererAPI::ResetStateStats()
+    {
+        OpenGLStateCache::ResetStats();
+    }
+
+    RendererAPI::StateStatistics OpenGLRendererAPI::GetStateStats() const
     {
-        const GLsizei count = indexCount ? static_cast<GLsizei>(indexCount) : static_cast<GLsizei>(vertexArray->GetIndexBuffer()->GetCount());
-        glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        return OpenGLStateCache::GetStats();
     }
 }
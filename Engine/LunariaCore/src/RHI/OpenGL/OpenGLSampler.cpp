@@ -0,0 +1,96 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLSampler.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLStateCache.hpp"
+
+#include <cstring>
+
+namespace Lunaria {
+
+	static std::unordered_map<uint64_t, std::weak_ptr<OpenGLSampler>> s_Samplers;
+
+	static uint64_t SamplerKey(const TextureSpecification& specification)
+	{
+		const float anisotropy = OpenGLSampler::ClampAnisotropy(specification.MaxAnisotropy);
+		uint32_t anisotropyBits;
+		std::memcpy(&anisotropyBits, &anisotropy, sizeof(anisotropyBits));
+
+		return static_cast<uint64_t>(specification.MinFilter)
+			| static_cast<uint64_t>(specification.MagFilter) << 4
+			| static_cast<uint64_t>(specification.MipFilter) << 8
+			| static_cast<uint64_t>(specification.Wrap) << 12
+			| static_cast<uint64_t>(anisotropyBits) << 32;
+	}
+
+	OpenGLSampler::OpenGLSampler(const TextureSpecification& specification)
+	{
+		glCreateSamplers(1, &m_RendererID);
+
+		glSamplerParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(MinFilterToGL(specification)));
+		glSamplerParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(MagFilterToGL(specification)));
+
+		glSamplerParameteri(m_RendererID, GL_TEXTURE_WRAP_S, static_cast<GLint>(WrapToGL(specification.Wrap)));
+		glSamplerParameteri(m_RendererID, GL_TEXTURE_WRAP_T, static_cast<GLint>(WrapToGL(specification.Wrap)));
+
+		glSamplerParameterf(m_RendererID, GL_TEXTURE_MAX_ANISOTROPY, ClampAnisotropy(specification.MaxAnisotropy));
+	}
+
+	OpenGLSampler::~OpenGLSampler()
+	{
+		OpenGLStateCache::OnSamplerDeleted(m_RendererID);
+		glDeleteSamplers(1, &m_RendererID);
+	}
+
+	Ref<OpenGLSampler> OpenGLSampler::Get(const TextureSpecification& specification)
+	{
+		auto& cached = s_Samplers[SamplerKey(specification)];
+		if (auto sampler = cached.lock())
+			return sampler;
+
+		auto sampler = CreateRef<OpenGLSampler>(specification);
+		cached = sampler;
+		return sampler;
+	}
+
+	GLenum OpenGLSampler::MinFilterToGL(const TextureSpecification& specification)
+	{
+		const bool linear = specification.MinFilter == TextureFilter::Linear;
+		switch (specification.MipFilter)
+		{
+			case TextureFilter::None:		return linear ? GL_LINEAR : GL_NEAREST;
+			case TextureFilter::Nearest:	return linear ? GL_LINEAR_MIPMAP_NEAREST : GL_NEAREST_MIPMAP_NEAREST;
+			case TextureFilter::Linear:		return linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR;
+		}
+
+		LU_CORE_ASSERT(false, "Unknown TextureFilter!");
+		return GL_LINEAR;
+	}
+
+	GLenum OpenGLSampler::MagFilterToGL(const TextureSpecification& specification)
+	{
+		return specification.MagFilter == TextureFilter::Linear ? GL_LINEAR : GL_NEAREST;
+	}
+
+	GLenum OpenGLSampler::WrapToGL(const TextureWrap wrap)
+	{
+		switch (wrap)
+		{
+			case TextureWrap::Repeat:			return GL_REPEAT;
+			case TextureWrap::MirroredRepeat:	return GL_MIRRORED_REPEAT;
+			case TextureWrap::ClampToEdge:		return GL_CLAMP_TO_EDGE;
+		}
+
+		LU_CORE_ASSERT(false, "Unknown TextureWrap!");
+		return GL_REPEAT;
+	}
+
+	float OpenGLSampler::ClampAnisotropy(const float anisotropy)
+	{
+		static float s_MaxAnisotropy = 0.0f;
+		if (s_MaxAnisotropy == 0.0f)
+			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &s_MaxAnisotropy);
+
+		return std::clamp(anisotropy, 1.0f, std::max(s_MaxAnisotropy, 1.0f));
+	}
+
+}
@@ -1,6 +1,8 @@
 ﻿#include "lepch.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLShader.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLStateCache.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
 
 #include <fstream>
 #include <glad/glad.h>
@@ -16,6 +18,12 @@ namespace Lunaria {
         if (type == "fragment" || type == "pixel")
             return GL_FRAGMENT_SHADER;
 
+        if (type == "geometry")
+            return GL_GEOMETRY_SHADER;
+
+        if (type == "compute")
+            return GL_COMPUTE_SHADER;
+
         LU_CORE_ASSERT(false, "Unknown shader type!");
         return 0;
     }
@@ -57,47 +65,51 @@ namespace Lunaria {
 
     OpenGLShader::~OpenGLShader()
     {
+        OpenGLStateCache::OnProgramDeleted(m_RendererID);
         glDeleteProgram(m_RendererID);
     }
 
     void OpenGLShader::Bind() const
     {
-        glUseProgram(m_RendererID);
+        RenderThread::Submit([this] { OpenGLStateCache::UseProgram(m_RendererID); });
     }
 
     void OpenGLShader::Unbind() const
     {
-        glUseProgram(0);
+        RenderThread::Submit([] { OpenGLStateCache::UseProgram(0); });
     }
 
+    // Uniforms are set on the bound program, they are recorded in order with Bind
+
     void OpenGLShader::SetMat4(const std::string& name, const glm::mat4& value) const
     {
-        UploadUniformMat4(name, value);
+        RenderThread::Submit([this, name, value] { UploadUniformMat4(name, value); });
     }
 
     void OpenGLShader::SetFloat(const std::string& name, float value) const
     {
-        UploadUniformFloat(name, value);
+        RenderThread::Submit([this, name, value] { UploadUniformFloat(name, value); });
     }
 
     void OpenGLShader::SetFloat3(const std::string& name, const glm::vec3& value) const
     {
-        UploadUniformFloat3(name, value);
+        RenderThread::Submit([this, name, value] { UploadUniformFloat3(name, value); });
     }
 
     void OpenGLShader::SetFloat4(const std::string& name, const glm::vec4& value) const
     {
-        UploadUniformFloat4(name, value);
+        RenderThread::Submit([this, name, value] { UploadUniformFloat4(name, value); });
     }
 
     void OpenGLShader::SetInt(const std::string& name, int value) const
     {
-        UploadUniformInt(name, value);
+        RenderThread::Submit([this, name, value] { UploadUniformInt(name, value); });
     }
 
     void OpenGLShader::SetIntArray(const std::string& name, int* values, uint32_t count) const
     {
-        UploadUniformIntArray(name, values, count);
+        auto* data = static_cast<int*>(const_cast<void*>(RenderThread::CopyFrameData(values, count * sizeof(int))));
+        RenderThread::Submit([this, name, data, count] { UploadUniformIntArray(name, data, count); });
     }
 
     void OpenGLShader::UploadUniformInt(const std::string& name, int value) const
@@ -204,9 +216,10 @@ namespace Lunaria {
     {
         // Get a program object.
         const GLuint program = glCreateProgram();
-        LU_CORE_ASSERT(shaderSources.size() <= 2, "Lunaria only supports 2 shaders for now!");
-        std::array<GLenum, 2> glShaderIDs;
-        int glShaderIDIndex = 0;
+        // A compute program has no other stages
+        LU_CORE_ASSERT(!shaderSources.contains(GL_COMPUTE_SHADER) || shaderSources.size() == 1, "Compute shaders can't be combined with other stages!");
+        std::vector<GLuint> glShaderIDs;
+        glShaderIDs.reserve(shaderSources.size());
 
         for (const auto& [type, source] : shaderSources)
         {
@@ -242,7 +255,7 @@ namespace Lunaria {
             // Shader are successfully compiled.
             // Now time to link it into a program.
             glAttachShader(program, shader);
-            glShaderIDs[glShaderIDIndex++] = shader;
+            glShaderIDs.push_back(shader);
         }
 
         // Link our program
@@ -275,13 +288,13 @@ namespace Lunaria {
             return;
         }
 
+        // Compute shaders often only use storage buffers
         GLint count = 0;
         glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
-        LU_CORE_ASSERT(count, "Count of uniforms must be more then 0!");
 
         GLsizei bufSize = 0;
         glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &bufSize);
-        LU_CORE_ASSERT(bufSize, "Active uniform buffer size cannot be 0!");
+        LU_CORE_ASSERT(!count || bufSize, "Active uniform buffer size cannot be 0!");
 
         for (int i = 0; i < count; i++)
         {
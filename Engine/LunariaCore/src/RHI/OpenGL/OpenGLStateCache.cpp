@@ -0,0 +1,325 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLStateCache.hpp"
+
+namespace Lunaria {
+
+	static constexpr uint32_t s_Unknown = 0xffffffff;
+
+	enum BufferTargetIndex : uint32_t
+	{
+		ArrayBuffer = 0,
+		ElementArrayBuffer,
+		UniformBuffer,
+		ShaderStorageBuffer,
+		DrawIndirectBuffer,
+		PixelUnpackBuffer,
+		PixelPackBuffer,
+		CopyReadBuffer,
+		CopyWriteBuffer,
+		BufferTargetCount
+	};
+
+	static uint32_t BufferTargetToIndex(GLenum target)
+	{
+		switch (target)
+		{
+			case GL_ARRAY_BUFFER:			return ArrayBuffer;
+			case GL_ELEMENT_ARRAY_BUFFER:	return ElementArrayBuffer;
+			case GL_UNIFORM_BUFFER:			return UniformBuffer;
+			case GL_SHADER_STORAGE_BUFFER:	return ShaderStorageBuffer;
+			case GL_DRAW_INDIRECT_BUFFER:	return DrawIndirectBuffer;
+			case GL_PIXEL_UNPACK_BUFFER:	return PixelUnpackBuffer;
+			case GL_PIXEL_PACK_BUFFER:		return PixelPackBuffer;
+			case GL_COPY_READ_BUFFER:		return CopyReadBuffer;
+			case GL_COPY_WRITE_BUFFER:		return CopyWriteBuffer;
+		}
+
+		return BufferTargetCount; // Not tracked, always issued
+	}
+
+	enum CapabilityIndex : uint32_t
+	{
+		Blend = 0,
+		DepthTest,
+		CullFace,
+		ScissorTest,
+		CapabilityCount
+	};
+
+	static uint32_t CapabilityToIndex(GLenum capability)
+	{
+		switch (capability)
+		{
+			case GL_BLEND:			return Blend;
+			case GL_DEPTH_TEST:		return DepthTest;
+			case GL_CULL_FACE:		return CullFace;
+			case GL_SCISSOR_TEST:	return ScissorTest;
+		}
+
+		return CapabilityCount; // Not tracked, always issued
+	}
+
+	struct OpenGLStateData
+	{
+		uint32_t Program = s_Unknown;
+		uint32_t VertexArray = s_Unknown;
+		uint32_t Framebuffer = s_Unknown;
+
+		std::array<uint32_t, BufferTargetCount> Buffers;
+		std::array<uint32_t, OpenGLStateCache::MaxTextureUnits> TextureUnits;
+		std::array<uint32_t, OpenGLStateCache::MaxTextureUnits> SamplerUnits;
+		std::array<uint32_t, CapabilityCount> Capabilities; // 0 - disabled, 1 - enabled
+
+		GLenum BlendSource = s_Unknown, BlendDestination = s_Unknown;
+		uint32_t DepthMask = s_Unknown;
+
+		int ViewportX = 0, ViewportY = 0;
+		uint32_t ViewportWidth = s_Unknown, ViewportHeight = s_Unknown;
+
+		glm::vec4 ClearColor = glm::vec4(-1.0f);
+		bool ClearColorKnown = false;
+
+		RendererAPI::StateStatistics Stats;
+
+		OpenGLStateData()
+		{
+			Buffers.fill(s_Unknown);
+			TextureUnits.fill(s_Unknown);
+			SamplerUnits.fill(s_Unknown);
+			Capabilities.fill(s_Unknown);
+		}
+	};
+
+	static OpenGLStateData s_State;
+
+	// Returns true when the call has to be issued
+	static bool Track(uint32_t& cached, uint32_t value)
+	{
+		if (cached == value)
+		{
+			s_State.Stats.SkippedCalls++;
+			return false;
+		}
+
+		cached = value;
+		s_State.Stats.IssuedCalls++;
+		return true;
+	}
+
+	void OpenGLStateCache::Invalidate()
+	{
+		const RendererAPI::StateStatistics stats = s_State.Stats;
+		s_State = OpenGLStateData();
+		s_State.Stats = stats;
+	}
+
+	void OpenGLStateCache::UseProgram(uint32_t program)
+	{
+		if (Track(s_State.Program, program))
+			glUseProgram(program);
+	}
+
+	void OpenGLStateCache::BindVertexArray(uint32_t vertexArray)
+	{
+		if (Track(s_State.VertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+
+			// Element array binding is part of the vertex array object state
+			s_State.Buffers[ElementArrayBuffer] = s_Unknown;
+		}
+	}
+
+	void OpenGLStateCache::BindBuffer(GLenum target, uint32_t buffer)
+	{
+		const uint32_t index = BufferTargetToIndex(target);
+		if (index == BufferTargetCount)
+		{
+			glBindBuffer(target, buffer);
+			return;
+		}
+
+		if (Track(s_State.Buffers[index], buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	void OpenGLStateCache::BindBufferBase(GLenum target, uint32_t index, uint32_t buffer)
+	{
+		// Indexed bindings are not tracked, but they also replace the generic binding point
+		glBindBufferBase(target, index, buffer);
+		s_State.Stats.IssuedCalls++;
+
+		const uint32_t targetIndex = BufferTargetToIndex(target);
+		if (targetIndex != BufferTargetCount)
+			s_State.Buffers[targetIndex] = buffer;
+	}
+
+	void OpenGLStateCache::BindBufferRange(GLenum target, uint32_t index, uint32_t buffer, GLintptr offset, GLsizeiptr size)
+	{
+		glBindBufferRange(target, index, buffer, offset, size);
+		s_State.Stats.IssuedCalls++;
+
+		const uint32_t targetIndex = BufferTargetToIndex(target);
+		if (targetIndex != BufferTargetCount)
+			s_State.Buffers[targetIndex] = buffer;
+	}
+
+	void OpenGLStateCache::BindTextureUnit(uint32_t unit, uint32_t texture)
+	{
+		if (unit >= MaxTextureUnits)
+		{
+			glBindTextureUnit(unit, texture);
+			return;
+		}
+
+		if (Track(s_State.TextureUnits[unit], texture))
+			glBindTextureUnit(unit, texture);
+	}
+
+	void OpenGLStateCache::BindSampler(uint32_t unit, uint32_t sampler)
+	{
+		if (unit >= MaxTextureUnits)
+		{
+			glBindSampler(unit, sampler);
+			return;
+		}
+
+		if (Track(s_State.SamplerUnits[unit], sampler))
+			glBindSampler(unit, sampler);
+	}
+
+	void OpenGLStateCache::BindFramebuffer(uint32_t framebuffer)
+	{
+		if (Track(s_State.Framebuffer, framebuffer))
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	}
+
+	void OpenGLStateCache::SetCapability(GLenum capability, bool enabled)
+	{
+		const uint32_t index = CapabilityToIndex(capability);
+		if (index != CapabilityCount && !Track(s_State.Capabilities[index], enabled ? 1 : 0))
+			return;
+
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+
+	void OpenGLStateCache::BlendFunc(GLenum sourceFactor, GLenum destinationFactor)
+	{
+		if (s_State.BlendSource == sourceFactor && s_State.BlendDestination == destinationFactor)
+		{
+			s_State.Stats.SkippedCalls++;
+			return;
+		}
+
+		s_State.BlendSource = sourceFactor;
+		s_State.BlendDestination = destinationFactor;
+		s_State.Stats.IssuedCalls++;
+		glBlendFunc(sourceFactor, destinationFactor);
+	}
+
+	void OpenGLStateCache::DepthMask(bool enabled)
+	{
+		if (Track(s_State.DepthMask, enabled ? 1 : 0))
+			glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+	}
+
+	void OpenGLStateCache::Viewport(int x, int y, uint32_t width, uint32_t height)
+	{
+		if (s_State.ViewportX == x && s_State.ViewportY == y
+			&& s_State.ViewportWidth == width && s_State.ViewportHeight == height)
+		{
+			s_State.Stats.SkippedCalls++;
+			return;
+		}
+
+		s_State.ViewportX = x;
+		s_State.ViewportY = y;
+		s_State.ViewportWidth = width;
+		s_State.ViewportHeight = height;
+		s_State.Stats.IssuedCalls++;
+		glViewport(x, y, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+	}
+
+	void OpenGLStateCache::ClearColor(const glm::vec4& color)
+	{
+		if (s_State.ClearColorKnown && s_State.ClearColor == color)
+		{
+			s_State.Stats.SkippedCalls++;
+			return;
+		}
+
+		s_State.ClearColor = color;
+		s_State.ClearColorKnown = true;
+		s_State.Stats.IssuedCalls++;
+		glClearColor(color.r, color.g, color.b, color.a);
+	}
+
+	void OpenGLStateCache::OnProgramDeleted(uint32_t program)
+	{
+		if (s_State.Program == program)
+			s_State.Program = 0;
+	}
+
+	void OpenGLStateCache::OnVertexArrayDeleted(uint32_t vertexArray)
+	{
+		if (s_State.VertexArray == vertexArray)
+		{
+			s_State.VertexArray = 0;
+			s_State.Buffers[ElementArrayBuffer] = s_Unknown;
+		}
+	}
+
+	void OpenGLStateCache::OnElementBufferChanged(uint32_t vertexArray)
+	{
+		if (s_State.VertexArray == vertexArray)
+			s_State.Buffers[ElementArrayBuffer] = s_Unknown;
+	}
+
+	void OpenGLStateCache::OnBufferDeleted(uint32_t buffer)
+	{
+		for (auto& bound : s_State.Buffers)
+		{
+			if (bound == buffer)
+				bound = 0;
+		}
+	}
+
+	void OpenGLStateCache::OnTextureDeleted(uint32_t texture)
+	{
+		for (auto& bound : s_State.TextureUnits)
+		{
+			if (bound == texture)
+				bound = 0;
+		}
+	}
+
+	void OpenGLStateCache::OnSamplerDeleted(uint32_t sampler)
+	{
+		for (auto& bound : s_State.SamplerUnits)
+		{
+			if (bound == sampler)
+				bound = 0;
+		}
+	}
+
+	void OpenGLStateCache::OnFramebufferDeleted(uint32_t framebuffer)
+	{
+		if (s_State.Framebuffer == framebuffer)
+			s_State.Framebuffer = 0;
+	}
+
+	void OpenGLStateCache::ResetStats()
+	{
+		s_State.Stats = {};
+	}
+
+	RendererAPI::StateStatistics OpenGLStateCache::GetStats()
+	{
+		return s_State.Stats;
+	}
+
+}
@@ -1,14 +1,103 @@
 ﻿#include "lepch.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLTexure.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLStateCache.hpp"
+#include "LunariaCore/Renderer/CompressedTexture.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
 
 #include <stb_image/stb_image.h>
 
+// S3TC is an extension, glad is generated for the core profile only
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+    #define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+    #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+    #define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+    #define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT 0x8C4E
+    #define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
 namespace Lunaria
 {
-    OpenGLTexture2D::OpenGLTexture2D(const std::string& path)
-        : m_Path(path)
+    static uint32_t CalculateMipCount(const uint32_t width, const uint32_t height)
+    {
+        return static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+    }
+
+    static GLenum CompressedFormatToGL(const CompressedTextureFormat format, const bool srgb)
+    {
+        switch (format)
+        {
+            case CompressedTextureFormat::RGBA8:        return srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+            case CompressedTextureFormat::BC1:          return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case CompressedTextureFormat::BC2:          return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT : GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case CompressedTextureFormat::BC3:          return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case CompressedTextureFormat::BC4:          return GL_COMPRESSED_RED_RGTC1;
+            case CompressedTextureFormat::BC5:          return GL_COMPRESSED_RG_RGTC2;
+            case CompressedTextureFormat::BC6H:         return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+            case CompressedTextureFormat::BC7:          return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case CompressedTextureFormat::ETC2_RGB8:    return srgb ? GL_COMPRESSED_SRGB8_ETC2 : GL_COMPRESSED_RGB8_ETC2;
+            case CompressedTextureFormat::ETC2_RGB8A1:  return srgb ? GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 : GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+            case CompressedTextureFormat::ETC2_RGBA8:   return srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC : GL_COMPRESSED_RGBA8_ETC2_EAC;
+            case CompressedTextureFormat::None:         break;
+        }
+
+        LU_CORE_ASSERT(false, "Unknown CompressedTextureFormat!");
+        return 0;
+    }
+
+    static bool HasExtension(const char* name)
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+        for (GLint i = 0; i < count; i++)
+        {
+            if (std::strcmp(reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i))), name) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    // Asked once per format, the answer can't change for the lifetime of the context
+    static bool IsFormatSupported(const CompressedTextureFormat format, const GLenum internalFormat)
+    {
+        static std::unordered_map<GLenum, bool> s_Supported;
+
+        if (const auto it = s_Supported.find(internalFormat); it != s_Supported.end())
+            return it->second;
+
+        bool supported;
+        if (format == CompressedTextureFormat::BC1 || format == CompressedTextureFormat::BC2 || format == CompressedTextureFormat::BC3)
+        {
+            // Unknown enums would raise GL_INVALID_ENUM in the query below
+            static const bool s_S3TC = HasExtension("GL_EXT_texture_compression_s3tc");
+            static const bool s_S3TCSRGB = HasExtension("GL_EXT_texture_sRGB") || HasExtension("GL_EXT_texture_compression_s3tc_srgb");
+
+            const bool srgb = internalFormat >= GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT && internalFormat <= GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            supported = s_S3TC && (!srgb || s_S3TCSRGB);
+        }
+        else
+        {
+            GLint result = GL_FALSE;
+            glGetInternalformativ(GL_TEXTURE_2D, internalFormat, GL_INTERNALFORMAT_SUPPORTED, 1, &result);
+            supported = result == GL_TRUE;
+        }
+
+        s_Supported[internalFormat] = supported;
+        return supported;
+    }
+
+    OpenGLTexture2D::OpenGLTexture2D(const std::string& path, const TextureSpecification& specification)
+        : m_Path(path), m_Specification(specification), m_Sampler(OpenGLSampler::Get(specification))
     {
+        if (CompressedTextureLoader::IsContainer(path))
+        {
+            LoadContainer();
+            return;
+        }
+
         int width, height, channels;
         //stbi_set_flip_vertically_on_load(1);
         stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
@@ -30,55 +119,198 @@ namespace Lunaria
 
         LU_CORE_ASSERT(m_InternalFormat & m_DataFormat, "Format not supported!");
 
-        glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-        glTextureStorage2D(m_RendererID, 1, m_InternalFormat, static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height));
-
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        m_RendererID = CreateStorage(m_Width, m_Height);
 
         glTextureSubImage2D(m_RendererID, 0, 0, 0, static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height),
                             m_DataFormat, GL_UNSIGNED_BYTE, data);
+        GenerateMips(m_RendererID);
 
         stbi_image_free(data);
     }
 
-    OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
-        : m_Width(width), m_Height(height)
+    OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height, const TextureSpecification& specification)
+        : m_Specification(specification), m_Sampler(OpenGLSampler::Get(specification)), m_Width(width), m_Height(height)
     {
         m_InternalFormat = GL_RGBA8;
         m_DataFormat = GL_RGBA;
 
-        glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-        glTextureStorage2D(m_RendererID, 1, m_InternalFormat, static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height));
-
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        m_RendererID = CreateStorage(m_Width, m_Height);
+    }
 
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    OpenGLTexture2D::OpenGLTexture2D(const std::string& path, const TextureSpecification& specification, const OpenGLTexture2D& placeholder)
+        : m_Path(path), m_Specification(specification), m_Sampler(OpenGLSampler::Get(specification)),
+          m_Width(placeholder.m_Width), m_Height(placeholder.m_Height), m_RendererID(placeholder.m_RendererID),
+          m_DataFormat(GL_RGBA), m_InternalFormat(GL_RGBA8), m_Loaded(false)
+    {
     }
 
     OpenGLTexture2D::~OpenGLTexture2D()
     {
-        glDeleteTextures(1, &m_RendererID);
+        // The placeholder is shared and owned by the streamer
+        const uint32_t owned = m_Loaded ? m_RendererID : m_StreamingRendererID;
+        if (owned)
+        {
+            OpenGLStateCache::OnTextureDeleted(owned);
+            glDeleteTextures(1, &owned);
+        }
+    }
+
+    void OpenGLTexture2D::LoadContainer()
+    {
+        CompressedTextureData data;
+        if (!CompressedTextureLoader::Load(m_Path, data))
+        {
+            // Keep the texture usable, it stays black
+            m_Width = m_Height = 1;
+            m_InternalFormat = GL_RGBA8;
+            m_DataFormat = GL_RGBA;
+            m_RendererID = CreateStorage(1, 1);
+            return;
+        }
+
+        m_Width = data.Width;
+        m_Height = data.Height;
+
+        // Precomputed levels are used as they are, compressed formats can't have mips generated
+        const uint32_t levels = m_Specification.MipFilter == TextureFilter::None ? 1 : static_cast<uint32_t>(data.Levels.size());
+        const bool generateMips = data.Format == CompressedTextureFormat::RGBA8 && levels == 1;
+
+        const GLenum internalFormat = CompressedFormatToGL(data.Format, data.SRGB);
+
+        if (data.Format != CompressedTextureFormat::RGBA8 && IsFormatSupported(data.Format, internalFormat))
+        {
+            m_InternalFormat = internalFormat;
+            m_DataFormat = 0; // Compressed, SetData is not available
+            m_RendererID = CreateStorage(m_Width, m_Height, levels);
+
+            for (uint32_t level = 0; level < levels; level++)
+            {
+                const CompressedTextureLevel& entry = data.Levels[level];
+                glCompressedTextureSubImage2D(m_RendererID, static_cast<GLint>(level), 0, 0,
+                    static_cast<GLsizei>(entry.Width), static_cast<GLsizei>(entry.Height), internalFormat,
+                    static_cast<GLsizei>(entry.Size), data.Data.data() + entry.Offset);
+            }
+
+            return;
+        }
+
+        if (data.Format != CompressedTextureFormat::RGBA8 && !CompressedTextureLoader::CanDecompress(data.Format))
+        {
+            LU_CORE_ERROR("Texture format of '{0}' is not supported by the device!", m_Path);
+            m_Width = m_Height = 1;
+            m_InternalFormat = GL_RGBA8;
+            m_DataFormat = GL_RGBA;
+            m_RendererID = CreateStorage(1, 1);
+            return;
+        }
+
+        if (data.Format != CompressedTextureFormat::RGBA8)
+            LU_CORE_WARN("Texture format of '{0}' is not supported by the device, decoding on the CPU", m_Path);
+
+        m_InternalFormat = data.SRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+        m_DataFormat = GL_RGBA;
+        m_RendererID = generateMips ? CreateStorage(m_Width, m_Height) : CreateStorage(m_Width, m_Height, levels);
+
+        std::vector<uint8_t> pixels;
+        for (uint32_t level = 0; level < levels; level++)
+        {
+            const CompressedTextureLevel& entry = data.Levels[level];
+
+            const uint8_t* source = data.Data.data() + entry.Offset;
+            if (data.Format != CompressedTextureFormat::RGBA8)
+            {
+                CompressedTextureLoader::Decompress(data, level, pixels);
+                source = pixels.data();
+            }
+
+            glTextureSubImage2D(m_RendererID, static_cast<GLint>(level), 0, 0, static_cast<GLsizei>(entry.Width),
+                static_cast<GLsizei>(entry.Height), GL_RGBA, GL_UNSIGNED_BYTE, source);
+        }
+
+        if (generateMips)
+            GenerateMips(m_RendererID);
+    }
+
+    uint32_t OpenGLTexture2D::CreateStorage(const uint32_t width, const uint32_t height) const
+    {
+        return CreateStorage(width, height, m_Specification.MipFilter == TextureFilter::None ? 1 : CalculateMipCount(width, height));
+    }
+
+    uint32_t OpenGLTexture2D::CreateStorage(const uint32_t width, const uint32_t height, const uint32_t levels) const
+    {
+        uint32_t rendererID;
+        glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+        glTextureStorage2D(rendererID, static_cast<GLsizei>(levels), m_InternalFormat, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+
+        // The engine samples through the shared sampler object, the texture's own state only
+        // matters to code binding the raw ID without a sampler (ImGui)
+        glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(OpenGLSampler::MinFilterToGL(m_Specification)));
+        glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(OpenGLSampler::MagFilterToGL(m_Specification)));
+
+        glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, static_cast<GLint>(OpenGLSampler::WrapToGL(m_Specification.Wrap)));
+        glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, static_cast<GLint>(OpenGLSampler::WrapToGL(m_Specification.Wrap)));
+
+        return rendererID;
+    }
+
+    void OpenGLTexture2D::GenerateMips(const uint32_t rendererID) const
+    {
+        if (m_Specification.MipFilter != TextureFilter::None)
+            glGenerateTextureMipmap(rendererID);
+    }
+
+    void OpenGLTexture2D::AllocateStreamingStorage(const uint32_t width, const uint32_t height)
+    {
+        LU_CORE_ASSERT(!m_Loaded && m_StreamingRendererID == 0, "Texture is not waiting for streamed data!");
+
+        m_StreamingWidth = width;
+        m_StreamingHeight = height;
+        m_StreamingRendererID = CreateStorage(width, height);
+    }
+
+    void OpenGLTexture2D::FinishStreaming()
+    {
+        LU_CORE_ASSERT(m_StreamingRendererID, "Texture has no streamed storage!");
+
+        GenerateMips(m_StreamingRendererID);
+
+        // Recording code reads the ID and size, they are swapped in between frames
+        RenderThread::SubmitToMainThread([this]
+        {
+            m_RendererID = m_StreamingRendererID;
+            m_Width = m_StreamingWidth;
+            m_Height = m_StreamingHeight;
+
+            m_StreamingRendererID = 0;
+            m_Loaded = true;
+        });
     }
 
     void OpenGLTexture2D::SetData(void* data, uint32_t size)
     {
+        LU_CORE_ASSERT(m_Loaded, "Texture is still streaming!");
+        LU_CORE_ASSERT(m_DataFormat, "Compressed textures can't be written!");
+
         // Check bytes per pixel (buffer must to be a size of entire texture) 
         uint32_t bytesPerPixel = m_DataFormat == GL_RGBA ? 4 : 3;
         LU_CORE_ASSERT(size == m_Width * m_Height * bytesPerPixel, "Data must be entire texture!");
         
-        glTextureSubImage2D(m_RendererID, 0, 0, 0, static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height),
-                             m_DataFormat, GL_UNSIGNED_BYTE, data);
+        const void* pixels = RenderThread::CopyFrameData(data, size);
+        RenderThread::Submit([this, pixels]
+        {
+            glTextureSubImage2D(m_RendererID, 0, 0, 0, static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height),
+                                m_DataFormat, GL_UNSIGNED_BYTE, pixels);
+            GenerateMips(m_RendererID);
+        });
     }
 
     void OpenGLTexture2D::Bind(uint32_t slot) const
     {
-        glBindTextureUnit(slot, m_RendererID);
+        RenderThread::Submit([this, slot]
+        {
+            OpenGLStateCache::BindTextureUnit(slot, m_RendererID);
+            OpenGLStateCache::BindSampler(slot, m_Sampler->GetRendererID());
+        });
     }
 
     GLenum OpenGLTexture2D::ImageFormatToGL(UI::ImageFormat format) const
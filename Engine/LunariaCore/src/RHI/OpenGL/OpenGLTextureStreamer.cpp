@@ -0,0 +1,214 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLTextureStreamer.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLStateCache.hpp"
+#include "LunariaCore/Renderer/CompressedTexture.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
+
+#include <stb_image/stb_image.h>
+
+namespace Lunaria {
+
+	static constexpr uint32_t BytesPerPixel = 4; // Streamed images are always expanded to RGBA8
+
+	OpenGLTextureStreamer::OpenGLTextureStreamer(const TextureStreamerSpecification& specification)
+		: m_Specification(specification)
+	{
+		// Gray checkerboard shown until the real data is resident
+		TextureSpecification placeholderSpecification;
+		placeholderSpecification.MipFilter = TextureFilter::None;
+		m_Placeholder = CreateRef<OpenGLTexture2D>(2, 2, placeholderSpecification);
+		uint32_t checkerboard[4] = { 0xff808080, 0xff404040, 0xff404040, 0xff808080 };
+		m_Placeholder->SetData(checkerboard, sizeof(checkerboard));
+
+		// Regions start at a 256 byte boundary
+		m_RegionSize = (specification.StagingBufferSize / RegionCount) & ~255u;
+		LU_CORE_ASSERT(m_RegionSize > 0, "Staging buffer is too small!");
+
+		constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glCreateBuffers(1, &m_StagingBuffer);
+		glNamedBufferStorage(m_StagingBuffer, static_cast<GLsizeiptr>(m_RegionSize) * RegionCount, nullptr, flags);
+		m_StagingMemory = static_cast<uint8_t*>(glMapNamedBufferRange(m_StagingBuffer, 0,
+			static_cast<GLsizeiptr>(m_RegionSize) * RegionCount, flags));
+
+		LU_CORE_ASSERT(m_StagingMemory, "Failed to map the texture staging buffer!");
+
+		const uint32_t workerCount = std::max(specification.WorkerCount, 1u);
+		for (uint32_t i = 0; i < workerCount; i++)
+			m_Workers.emplace_back(&OpenGLTextureStreamer::WorkerLoop, this);
+	}
+
+	OpenGLTextureStreamer::~OpenGLTextureStreamer()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Running = false;
+		}
+		m_WorkAvailable.notify_all();
+
+		for (auto& worker : m_Workers)
+			worker.join();
+
+		glUnmapNamedBuffer(m_StagingBuffer);
+		OpenGLStateCache::OnBufferDeleted(m_StagingBuffer);
+		glDeleteBuffers(1, &m_StagingBuffer);
+	}
+
+	Ref<Texture2D> OpenGLTextureStreamer::Load(const std::string& path, const TextureSpecification& specification)
+	{
+		// Containers hold GPU ready blocks, nothing to decode, the upload is a fraction of the raw size
+		if (CompressedTextureLoader::IsContainer(path))
+			return RenderThread::CreateResource<OpenGLTexture2D>(path, specification);
+
+		auto texture = RenderThread::CreateResource<OpenGLTexture2D>(path, specification, *m_Placeholder);
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_DecodeQueue.push_back({ texture, path });
+		}
+		m_WorkAvailable.notify_one();
+
+		return texture;
+	}
+
+	void OpenGLTextureStreamer::WorkerLoop()
+	{
+		while (true)
+		{
+			DecodeRequest request;
+			{
+				std::unique_lock lock(m_Mutex);
+				m_WorkAvailable.wait(lock, [this] { return !m_Running || !m_DecodeQueue.empty(); });
+
+				if (!m_Running)
+					return;
+
+				request = std::move(m_DecodeQueue.front());
+				m_DecodeQueue.pop_front();
+			}
+
+			// Dropped before it was decoded
+			if (request.Texture.expired())
+				continue;
+
+			int width, height, channels;
+			stbi_uc* data = stbi_load(request.Path.c_str(), &width, &height, &channels, BytesPerPixel);
+
+			std::lock_guard lock(m_Mutex);
+			if (!data)
+			{
+				LU_CORE_ERROR("Failed to load image '{0}': {1}", request.Path, stbi_failure_reason());
+				m_FailedTextures++;
+				continue;
+			}
+
+			DecodedImage& image = m_UploadQueue.emplace_back();
+			image.Texture = std::move(request.Texture);
+			image.Pixels = { data, stbi_image_free };
+			image.Width = static_cast<uint32_t>(width);
+			image.Height = static_cast<uint32_t>(height);
+		}
+	}
+
+	void OpenGLTextureStreamer::Update()
+	{
+		m_UploadedBytes = 0;
+
+		{
+			std::lock_guard lock(m_Mutex);
+			while (!m_UploadQueue.empty())
+			{
+				m_Uploading.push_back(std::move(m_UploadQueue.front()));
+				m_UploadQueue.pop_front();
+			}
+		}
+
+		if (m_Uploading.empty())
+			return;
+
+		// Never wait, the uploads simply resume next frame
+		StagingRegion& region = m_Regions[m_RegionIndex];
+		if (!region.Fence.IsSignaled())
+			return; // GPU is still reading from this region
+
+		const uint32_t regionStart = m_RegionIndex * m_RegionSize;
+		const uint32_t budget = std::min(m_Specification.UploadBudget, m_RegionSize);
+		uint32_t offset = 0;
+
+		OpenGLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_StagingBuffer);
+
+		while (!m_Uploading.empty())
+		{
+			DecodedImage& image = m_Uploading.front();
+
+			const auto texture = image.Texture.lock();
+			if (!texture)
+			{
+				m_Uploading.pop_front();
+				continue;
+			}
+
+			const uint32_t rowSize = image.Width * BytesPerPixel;
+			if (rowSize > m_RegionSize)
+			{
+				LU_CORE_ERROR("Image '{0}' is too wide to be streamed!", texture->GetPath());
+				m_Uploading.pop_front();
+				continue;
+			}
+
+			// Budget smaller than a single row, still make progress
+			uint32_t rows = (budget - offset) / rowSize;
+			if (rows == 0 && offset == 0)
+				rows = 1;
+
+			rows = std::min(rows, image.Height - image.UploadedRows);
+			if (rows == 0)
+				break;
+
+			if (image.UploadedRows == 0)
+				texture->AllocateStreamingStorage(image.Width, image.Height);
+
+			const uint32_t size = rows * rowSize;
+			memcpy(m_StagingMemory + regionStart + offset, image.Pixels.get() + static_cast<size_t>(image.UploadedRows) * rowSize, size);
+
+			glTextureSubImage2D(texture->GetStreamingRendererID(), 0, 0, static_cast<GLint>(image.UploadedRows),
+				static_cast<GLsizei>(image.Width), static_cast<GLsizei>(rows), GL_RGBA, GL_UNSIGNED_BYTE,
+				reinterpret_cast<const void*>(static_cast<uintptr_t>(regionStart + offset)));
+
+			offset += size;
+			image.UploadedRows += rows;
+
+			if (image.UploadedRows == image.Height)
+			{
+				texture->FinishStreaming();
+				m_LoadedTextures++;
+				m_Uploading.pop_front();
+			}
+		}
+
+		OpenGLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		if (offset > 0)
+		{
+			region.Fence.Signal();
+			m_RegionIndex = (m_RegionIndex + 1) % RegionCount;
+		}
+
+		m_UploadedBytes = offset;
+	}
+
+	TextureStreamer::Statistics OpenGLTextureStreamer::GetStats() const
+	{
+		Statistics stats;
+		stats.UploadedBytes = m_UploadedBytes;
+		stats.LoadedTextures = m_LoadedTextures;
+
+		std::lock_guard lock(m_Mutex);
+		stats.PendingDecodes = static_cast<uint32_t>(m_DecodeQueue.size());
+		stats.PendingUploads = static_cast<uint32_t>(m_UploadQueue.size() + m_Uploading.size());
+		stats.FailedTextures = m_FailedTextures;
+
+		return stats;
+	}
+
+}
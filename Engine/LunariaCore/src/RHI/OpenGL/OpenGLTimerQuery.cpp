@@ -0,0 +1,40 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLTimerQuery.hpp"
+
+#include <glad/glad.h>
+
+namespace Lunaria {
+
+	OpenGLTimerQueryPool::OpenGLTimerQueryPool(uint32_t count)
+		: m_Queries(count)
+	{
+		glCreateQueries(GL_TIMESTAMP, static_cast<GLsizei>(count), m_Queries.data());
+	}
+
+	OpenGLTimerQueryPool::~OpenGLTimerQueryPool()
+	{
+		glDeleteQueries(static_cast<GLsizei>(m_Queries.size()), m_Queries.data());
+	}
+
+	void OpenGLTimerQueryPool::WriteTimestamp(uint32_t query)
+	{
+		LU_CORE_ASSERT(query < m_Queries.size(), "Query index out of range!");
+		glQueryCounter(m_Queries[query], GL_TIMESTAMP);
+	}
+
+	bool OpenGLTimerQueryPool::IsResultAvailable(uint32_t query) const
+	{
+		GLint available = GL_FALSE;
+		glGetQueryObjectiv(m_Queries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+		return available == GL_TRUE;
+	}
+
+	uint64_t OpenGLTimerQueryPool::GetResultNanoseconds(uint32_t query) const
+	{
+		GLuint64 result = 0;
+		glGetQueryObjectui64v(m_Queries[query], GL_QUERY_RESULT, &result);
+		return result;
+	}
+
+}
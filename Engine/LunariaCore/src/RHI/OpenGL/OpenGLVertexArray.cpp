@@ -1,6 +1,9 @@
 #include "lepch.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLVertexArray.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLBuffer.hpp"
+#include "LunariaCore/RHI/OpenGL/OpenGLStateCache.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
 
 #include <glad/glad.h>
 
@@ -24,8 +27,9 @@ namespace Lunaria {
 			case ShaderDataType::Int4:
 				return GL_INT;
 
+			// GL_BOOL is not a valid vertex attribute type, bools are stored as bytes
 			case ShaderDataType::Bool:     
-				return GL_BOOL;
+				return GL_UNSIGNED_BYTE;
 
 			case ShaderDataType::None:     
 				break;
@@ -35,6 +39,11 @@ namespace Lunaria {
 		return 0;
 	}
 
+	static uint32_t GetBindingSlot(const BufferLayout& layout, const uint32_t index)
+	{
+		return layout.GetBinding() == BufferLayout::AutoBinding ? index : layout.GetBinding();
+	}
+
 	OpenGLVertexArray::OpenGLVertexArray()
 	{
 		glCreateVertexArrays(1, &m_RendererID);
@@ -42,86 +51,127 @@ namespace Lunaria {
 
 	OpenGLVertexArray::~OpenGLVertexArray()
 	{
+		OpenGLStateCache::OnVertexArrayDeleted(m_RendererID);
 		glDeleteVertexArrays(1, &m_RendererID);
 	} 
 
 	void OpenGLVertexArray::Bind() const
 	{
-		glBindVertexArray(m_RendererID);
+		RenderThread::Submit([this] { OpenGLStateCache::BindVertexArray(m_RendererID); });
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
-		glBindVertexArray(0);
+		RenderThread::Submit([] { OpenGLStateCache::BindVertexArray(0); });
 	}
 
 	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
 	{
 		LU_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
 
-		glBindVertexArray(m_RendererID);
-		vertexBuffer->Bind();
+		const BufferLayout& layout = vertexBuffer->GetLayout();
+		const uint32_t binding = GetBindingSlot(layout, static_cast<uint32_t>(m_VertexBuffers.size()));
+		const auto& openGLVertexBuffer = static_cast<const OpenGLVertexBuffer&>(*vertexBuffer);
+		const uint32_t buffer = openGLVertexBuffer.GetRendererID();
+		const uint32_t offset = openGLVertexBuffer.GetOffset();
 
-		uint32_t index = 0;
-		const auto& layout = vertexBuffer->GetLayout();
-		for (const auto& element : layout)
+		// The format is attached to the binding slot, not to the buffer, so the buffer can be swapped later
+		RenderThread::Submit([this, layout, binding, buffer, offset, location = m_VertexBufferIndexOffset]() mutable
 		{
-			switch (element.Type)
+			glVertexArrayVertexBuffer(m_RendererID, binding, buffer, offset, layout.GetStride());
+			glVertexArrayBindingDivisor(m_RendererID, binding, layout.GetStepRate());
+
+			for (const auto& element : layout)
 			{
-				case ShaderDataType::Float:
-				case ShaderDataType::Float2:
-				case ShaderDataType::Float3:
-				case ShaderDataType::Float4:
-				case ShaderDataType::Int:
-				case ShaderDataType::Int2:
-				case ShaderDataType::Int3:
-				case ShaderDataType::Int4:
-				case ShaderDataType::Bool:
-				{
-					glEnableVertexAttribArray(index);
-					glVertexAttribPointer(index,
-						static_cast<uint8_t>(element.GetComponentCount()),
-						ShaderDataTypeToOpenGLBaseType(element.Type),
-						element.Normalized ? GL_TRUE : GL_FALSE,
-						layout.GetStride(),
-						reinterpret_cast<const void*>(element.Offset));
-					index++;
-					break;
-				}
+				const GLenum type = ShaderDataTypeToOpenGLBaseType(element.Type);
 
-				case ShaderDataType::Mat3:
-				case ShaderDataType::Mat4:
+				switch (element.Type)
 				{
-					const auto count = static_cast<uint8_t>(element.GetComponentCount());
-					for (uint8_t i = 0; i < count; i++)
+					case ShaderDataType::Float:
+					case ShaderDataType::Float2:
+					case ShaderDataType::Float3:
+					case ShaderDataType::Float4:
 					{
-						glEnableVertexAttribArray(index);
-						glVertexAttribPointer(index,
-							count,
-							ShaderDataTypeToOpenGLBaseType(element.Type),
-							element.Normalized ? GL_TRUE : GL_FALSE,
-							layout.GetStride(),
-							reinterpret_cast<const void*>(element.Offset + sizeof(float) * count * i));
-						glVertexAttribDivisor(index, 1);
-						index++;
+						glEnableVertexArrayAttrib(m_RendererID, location);
+						glVertexArrayAttribFormat(m_RendererID, location, static_cast<GLint>(element.GetComponentCount()),
+							type, element.Normalized ? GL_TRUE : GL_FALSE, static_cast<GLuint>(element.Offset));
+						glVertexArrayAttribBinding(m_RendererID, location, binding);
+						location++;
+						break;
+					}
+
+					// Integer attributes keep their values instead of being converted to float
+					case ShaderDataType::Int:
+					case ShaderDataType::Int2:
+					case ShaderDataType::Int3:
+					case ShaderDataType::Int4:
+					case ShaderDataType::Bool:
+					{
+						glEnableVertexArrayAttrib(m_RendererID, location);
+						glVertexArrayAttribIFormat(m_RendererID, location, static_cast<GLint>(element.GetComponentCount()),
+							type, static_cast<GLuint>(element.Offset));
+						glVertexArrayAttribBinding(m_RendererID, location, binding);
+						location++;
+						break;
+					}
+
+					case ShaderDataType::Mat3:
+					case ShaderDataType::Mat4:
+					{
+						const uint32_t count = element.GetComponentCount();
+						for (uint32_t i = 0; i < count; i++)
+						{
+							glEnableVertexArrayAttrib(m_RendererID, location);
+							glVertexArrayAttribFormat(m_RendererID, location, static_cast<GLint>(count), type,
+								element.Normalized ? GL_TRUE : GL_FALSE,
+								static_cast<GLuint>(element.Offset + sizeof(float) * count * i));
+							glVertexArrayAttribBinding(m_RendererID, location, binding);
+							location++;
+						}
+						break;
 					}
-					break;
-				}
 
-				case ShaderDataType::None:
-					LU_CORE_ASSERT(false, "Unknown ShaderDataType!");
+					case ShaderDataType::None:
+						LU_CORE_ASSERT(false, "Unknown ShaderDataType!");
 				}
-		}
+			}
+		});
 
 		m_VertexBuffers.push_back(vertexBuffer);
-		m_VertexBufferIndexOffset += static_cast<uint32_t>(layout.GetElements().size());
+		m_VertexBufferIndexOffset += layout.GetLocationCount();
+	}
+
+	void OpenGLVertexArray::SetVertexBuffer(uint32_t index, const Ref<VertexBuffer>& vertexBuffer)
+	{
+		LU_CORE_ASSERT(index < m_VertexBuffers.size(), "Vertex buffer index out of range!");
+		LU_CORE_ASSERT(vertexBuffer->GetLayout() == m_VertexBuffers[index]->GetLayout(), "Vertex buffer layout doesn't match the vertex format!");
+
+		const BufferLayout& layout = vertexBuffer->GetLayout();
+		const uint32_t binding = GetBindingSlot(layout, index);
+		const auto& openGLVertexBuffer = static_cast<const OpenGLVertexBuffer&>(*vertexBuffer);
+		const uint32_t buffer = openGLVertexBuffer.GetRendererID();
+		const uint32_t offset = openGLVertexBuffer.GetOffset();
+		const auto stride = static_cast<GLsizei>(layout.GetStride());
+
+		RenderThread::Submit([this, binding, buffer, offset, stride]
+		{
+			glVertexArrayVertexBuffer(m_RendererID, binding, buffer, offset, stride);
+		});
+
+		m_VertexBuffers[index] = vertexBuffer;
 	}
 
 	void OpenGLVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
 	{
-		glBindVertexArray(m_RendererID);
-		indexBuffer->Bind();
-		
+		// Shared buffers are fine, the draw passes the range's offset
+		const uint32_t buffer = static_cast<const OpenGLIndexBuffer&>(*indexBuffer).GetRendererID();
+
+		RenderThread::Submit([this, buffer]
+		{
+			glVertexArrayElementBuffer(m_RendererID, buffer);
+			OpenGLStateCache::OnElementBufferChanged(m_RendererID);
+		});
+
 		m_IndexBuffer = indexBuffer;
 	}
 
@@ -0,0 +1,58 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Software/SoftwareBuffer.hpp"
+
+#include <cstring>
+
+namespace Lunaria {
+
+	SoftwareVertexBuffer::SoftwareVertexBuffer(const uint32_t size)
+		: m_Data(size)
+	{
+	}
+
+	SoftwareVertexBuffer::SoftwareVertexBuffer(const float* vertices, const uint32_t size)
+		: m_Data(reinterpret_cast<const uint8_t*>(vertices), reinterpret_cast<const uint8_t*>(vertices) + size)
+	{
+	}
+
+	void SoftwareVertexBuffer::SetData(const void* data, const uint32_t size)
+	{
+		LU_CORE_ASSERT(size <= m_Data.size(), "VertexBuffer::SetData writes past the end of the buffer!");
+		std::memcpy(m_Data.data(), data, std::min<size_t>(size, m_Data.size()));
+	}
+
+	SoftwareIndexBuffer::SoftwareIndexBuffer(const void* indices, const uint32_t count, const IndexType type)
+		: m_Indices(count, 0), m_Type(type)
+	{
+		if (!indices)
+			return;
+
+		if (type == IndexType::UInt16)
+			std::copy_n(static_cast<const uint16_t*>(indices), count, m_Indices.begin());
+		else
+			std::memcpy(m_Indices.data(), indices, count * sizeof(uint32_t));
+	}
+
+	SoftwareStorageBuffer::SoftwareStorageBuffer(const void* data, const uint32_t size)
+		: m_Data(size, 0)
+	{
+		if (data)
+			std::memcpy(m_Data.data(), data, size);
+	}
+
+	void SoftwareStorageBuffer::SetData(const void* data, const uint32_t size, const uint32_t offset)
+	{
+		LU_CORE_ASSERT(offset + size <= m_Data.size(), "StorageBuffer::SetData writes past the end of the buffer!");
+		if (offset < m_Data.size())
+			std::memcpy(m_Data.data() + offset, data, std::min<size_t>(size, m_Data.size() - offset));
+	}
+
+	void SoftwareStorageBuffer::GetData(void* data, const uint32_t size, const uint32_t offset) const
+	{
+		LU_CORE_ASSERT(offset + size <= m_Data.size(), "StorageBuffer::GetData reads past the end of the buffer!");
+		if (offset < m_Data.size())
+			std::memcpy(data, m_Data.data() + offset, std::min<size_t>(size, m_Data.size() - offset));
+	}
+
+}
@@ -0,0 +1,48 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Software/SoftwareContext.hpp"
+#include "LunariaCore/RHI/Software/SoftwareDevice.hpp"
+
+#include <SDL/SDL.h>
+
+#include <cstring>
+
+namespace Lunaria {
+
+	SoftwareContext::SoftwareContext(SDL_Window* windowHandle)
+		: m_WindowHandle(windowHandle)
+	{
+		LU_CORE_ASSERT(windowHandle, "Window handle is null!");
+	}
+
+	void SoftwareContext::Init()
+	{
+		LU_CORE_INFO("Presenting through the SDL window surface");
+	}
+
+	void SoftwareContext::SwapBuffers()
+	{
+		const SoftwareRenderTarget& target = SoftwareDevice::GetDefaultTarget();
+
+		SDL_Surface* surface = SDL_GetWindowSurface(m_WindowHandle);
+		if (!surface || target.Width == 0 || target.Height == 0)
+			return;
+
+		const auto width = std::min(static_cast<uint32_t>(surface->w), target.Width);
+		const auto height = std::min(static_cast<uint32_t>(surface->h), target.Height);
+
+		// The target is stored bottom up, the window surface top down
+		m_Flipped.resize(static_cast<size_t>(width) * height);
+		for (uint32_t y = 0; y < height; y++)
+		{
+			std::memcpy(&m_Flipped[static_cast<size_t>(y) * width],
+				&target.Color[static_cast<size_t>(target.Height - 1 - y) * target.Width], width * sizeof(uint32_t));
+		}
+
+		SDL_ConvertPixels(static_cast<int>(width), static_cast<int>(height), SDL_PIXELFORMAT_RGBA32, m_Flipped.data(),
+			static_cast<int>(width * sizeof(uint32_t)), surface->format->format, surface->pixels, surface->pitch);
+
+		SDL_UpdateWindowSurface(m_WindowHandle);
+	}
+
+}
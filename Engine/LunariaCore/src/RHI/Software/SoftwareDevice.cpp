@@ -0,0 +1,65 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Software/SoftwareDevice.hpp"
+
+namespace Lunaria {
+
+	void SoftwareRenderTarget::Resize(uint32_t width, uint32_t height)
+	{
+		Width = width;
+		Height = height;
+		Color.assign(static_cast<size_t>(width) * height, 0);
+		Depth.assign(static_cast<size_t>(width) * height, 1.0f);
+	}
+
+	struct SoftwareDeviceData
+	{
+		SoftwareDevice::PipelineState State;
+		SoftwareRenderTarget DefaultTarget;
+		Scope<ThreadPool> Workers;
+		uint32_t NextID = 1;
+	};
+
+	static SoftwareDeviceData s_Device;
+
+	void SoftwareDevice::Init()
+	{
+		const uint32_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+		s_Device.Workers = CreateScope<ThreadPool>(threads - 1);
+
+		s_Device.State = {};
+		s_Device.State.Target = &s_Device.DefaultTarget;
+	}
+
+	void SoftwareDevice::Shutdown()
+	{
+		s_Device.Workers.reset();
+	}
+
+	SoftwareDevice::PipelineState& SoftwareDevice::GetState()
+	{
+		return s_Device.State;
+	}
+
+	ThreadPool& SoftwareDevice::GetThreadPool()
+	{
+		LU_CORE_ASSERT(s_Device.Workers, "Software device is not initialized!");
+		return *s_Device.Workers;
+	}
+
+	SoftwareRenderTarget& SoftwareDevice::GetDefaultTarget()
+	{
+		return s_Device.DefaultTarget;
+	}
+
+	void SoftwareDevice::BindTarget(SoftwareRenderTarget* target)
+	{
+		s_Device.State.Target = target ? target : &s_Device.DefaultTarget;
+	}
+
+	uint32_t SoftwareDevice::AllocateID()
+	{
+		return s_Device.NextID++;
+	}
+
+}
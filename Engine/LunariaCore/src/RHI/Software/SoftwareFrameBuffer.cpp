@@ -0,0 +1,52 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Software/SoftwareFrameBuffer.hpp"
+
+namespace Lunaria {
+
+	SoftwareFrameBuffer::SoftwareFrameBuffer(const FrameBufferSpecification& specification)
+		: m_RendererID(SoftwareDevice::AllocateID()), m_Specification(specification), m_RenderSize(specification.Width, specification.Height)
+	{
+		m_Target.Resize(specification.Width, specification.Height);
+	}
+
+	SoftwareFrameBuffer::~SoftwareFrameBuffer()
+	{
+		if (SoftwareDevice::GetState().Target == &m_Target)
+			SoftwareDevice::BindTarget(nullptr);
+	}
+
+	void SoftwareFrameBuffer::Bind()
+	{
+		SoftwareDevice::BindTarget(&m_Target);
+
+		auto& state = SoftwareDevice::GetState();
+		state.ViewportX = 0;
+		state.ViewportY = 0;
+		state.ViewportWidth = m_RenderSize.x;
+		state.ViewportHeight = m_RenderSize.y;
+	}
+
+	void SoftwareFrameBuffer::Unbind()
+	{
+		SoftwareDevice::BindTarget(nullptr);
+	}
+
+	void SoftwareFrameBuffer::Resize(const uint32_t width, const uint32_t height)
+	{
+		if (width == m_Specification.Width && height == m_Specification.Height)
+			return;
+
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+		m_RenderSize = { width, height };
+
+		m_Target.Resize(width, height);
+	}
+
+	void SoftwareFrameBuffer::SetRenderSize(const uint32_t width, const uint32_t height)
+	{
+		m_RenderSize = glm::clamp(glm::uvec2(width, height), glm::uvec2(1), glm::uvec2(m_Specification.Width, m_Specification.Height));
+	}
+
+}
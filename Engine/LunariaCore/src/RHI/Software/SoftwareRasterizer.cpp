@@ -0,0 +1,390 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Software/SoftwareRasterizer.hpp"
+#include "LunariaCore/RHI/Software/SoftwareBuffer.hpp"
+#include "LunariaCore/RHI/Software/SoftwareShader.hpp"
+#include "LunariaCore/RHI/Software/SoftwareVertexArray.hpp"
+
+namespace Lunaria {
+
+	static constexpr uint32_t VertexChunkSize = 256;
+	static constexpr uint32_t TriangleChunkSize = 256;
+
+	// Vertices this close to the eye plane are rejected with their triangle, there is
+	// no near plane clipping
+	static constexpr float MinClipW = 1e-5f;
+
+	// Screen space triangle, vertices in counter clockwise order
+	struct SetupTriangle
+	{
+		float X[3], Y[3], Z[3];
+		float InvW[3];
+		uint32_t Vertices[3];
+		float InvArea;
+		int MinX, MinY, MaxX, MaxY; // Inclusive pixel bounds, clipped to the viewport
+		bool Valid;
+	};
+
+	struct RasterizerData
+	{
+		std::vector<float> Vertices; // Clip position followed by the varyings, per vertex
+		std::vector<SetupTriangle> Triangles;
+		std::vector<std::vector<uint32_t>> Bins; // Triangle indices per tile, in submission order
+		std::vector<uint32_t> ActiveTiles;
+		std::vector<uint64_t> TileFragments;
+
+		SoftwareRasterizer::Statistics Stats;
+	};
+
+	static RasterizerData s_Data;
+
+	static uint32_t PackColor(const glm::vec4& color)
+	{
+		const glm::vec4 scaled = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+		return static_cast<uint32_t>(scaled.r) | static_cast<uint32_t>(scaled.g) << 8
+			| static_cast<uint32_t>(scaled.b) << 16 | static_cast<uint32_t>(scaled.a) << 24;
+	}
+
+	static glm::vec4 UnpackColor(const uint32_t color)
+	{
+		return glm::vec4(color & 0xff, (color >> 8) & 0xff, (color >> 16) & 0xff, color >> 24) * (1.0f / 255.0f);
+	}
+
+	// Twice the signed area of (a, b, p), positive when p is left of a -> b
+	static float EdgeFunction(const float ax, const float ay, const float bx, const float by, const float px, const float py)
+	{
+		return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+	}
+
+	// Pixels exactly on an edge belong to the triangle only for top and left edges, so
+	// triangles sharing an edge never both shade the same pixel
+	static bool IsTopLeft(const float ax, const float ay, const float bx, const float by)
+	{
+		const float dx = bx - ax, dy = by - ay;
+		return dy < 0.0f || (dy == 0.0f && dx < 0.0f);
+	}
+
+	static void SetupTriangles(const std::vector<uint32_t>& indices, const uint32_t triangleCount, const uint32_t vertexStride,
+		const SoftwareDevice::PipelineState& state)
+	{
+		const SoftwareRenderTarget& target = *state.Target;
+
+		const int boundsMinX = std::max(state.ViewportX, 0);
+		const int boundsMinY = std::max(state.ViewportY, 0);
+		const int boundsMaxX = std::min(state.ViewportX + static_cast<int>(state.ViewportWidth), static_cast<int>(target.Width)) - 1;
+		const int boundsMaxY = std::min(state.ViewportY + static_cast<int>(state.ViewportHeight), static_cast<int>(target.Height)) - 1;
+
+		const float halfWidth = 0.5f * static_cast<float>(state.ViewportWidth);
+		const float halfHeight = 0.5f * static_cast<float>(state.ViewportHeight);
+
+		s_Data.Triangles.resize(triangleCount);
+
+		const uint32_t chunks = (triangleCount + TriangleChunkSize - 1) / TriangleChunkSize;
+		SoftwareDevice::GetThreadPool().ParallelFor(chunks, [&](const uint32_t chunk)
+		{
+			const uint32_t end = std::min(triangleCount, (chunk + 1) * TriangleChunkSize);
+			for (uint32_t i = chunk * TriangleChunkSize; i < end; i++)
+			{
+				SetupTriangle& triangle = s_Data.Triangles[i];
+				triangle.Valid = false;
+
+				bool visible = true;
+				for (int v = 0; v < 3; v++)
+				{
+					const uint32_t vertex = indices[i * 3 + v];
+					const float* clip = &s_Data.Vertices[static_cast<size_t>(vertex) * vertexStride];
+
+					if (clip[3] <= MinClipW)
+					{
+						visible = false;
+						break;
+					}
+
+					const float invW = 1.0f / clip[3];
+					triangle.X[v] = static_cast<float>(state.ViewportX) + (clip[0] * invW + 1.0f) * halfWidth;
+					triangle.Y[v] = static_cast<float>(state.ViewportY) + (clip[1] * invW + 1.0f) * halfHeight;
+					triangle.Z[v] = (clip[2] * invW + 1.0f) * 0.5f;
+					triangle.InvW[v] = invW;
+					triangle.Vertices[v] = vertex;
+				}
+
+				if (!visible)
+					continue;
+
+				float area = EdgeFunction(triangle.X[0], triangle.Y[0], triangle.X[1], triangle.Y[1], triangle.X[2], triangle.Y[2]);
+				if (area == 0.0f)
+					continue;
+
+				// No face culling, clockwise triangles are flipped
+				if (area < 0.0f)
+				{
+					std::swap(triangle.X[1], triangle.X[2]);
+					std::swap(triangle.Y[1], triangle.Y[2]);
+					std::swap(triangle.Z[1], triangle.Z[2]);
+					std::swap(triangle.InvW[1], triangle.InvW[2]);
+					std::swap(triangle.Vertices[1], triangle.Vertices[2]);
+					area = -area;
+				}
+
+				triangle.InvArea = 1.0f / area;
+
+				const auto [minX, maxX] = std::minmax({ triangle.X[0], triangle.X[1], triangle.X[2] });
+				const auto [minY, maxY] = std::minmax({ triangle.Y[0], triangle.Y[1], triangle.Y[2] });
+
+				triangle.MinX = std::max(static_cast<int>(std::floor(minX)), boundsMinX);
+				triangle.MinY = std::max(static_cast<int>(std::floor(minY)), boundsMinY);
+				triangle.MaxX = std::min(static_cast<int>(std::floor(maxX)), boundsMaxX);
+				triangle.MaxY = std::min(static_cast<int>(std::floor(maxY)), boundsMaxY);
+
+				triangle.Valid = triangle.MinX <= triangle.MaxX && triangle.MinY <= triangle.MaxY;
+			}
+		});
+	}
+
+	static uint64_t RasterizeTile(const uint32_t tile, const uint32_t tilesX, const uint32_t vertexStride, const uint32_t varyingCount,
+		const SoftwareProgram& program, const SoftwareDevice::PipelineState& state)
+	{
+		SoftwareRenderTarget& target = *state.Target;
+
+		const int tileMinX = static_cast<int>((tile % tilesX) * SoftwareRasterizer::TileSize);
+		const int tileMinY = static_cast<int>((tile / tilesX) * SoftwareRasterizer::TileSize);
+		const int tileMaxX = tileMinX + static_cast<int>(SoftwareRasterizer::TileSize) - 1;
+		const int tileMaxY = tileMinY + static_cast<int>(SoftwareRasterizer::TileSize) - 1;
+
+		// Per row scratch, the edge and coverage loops over these vectorize
+		float w0[SoftwareRasterizer::TileSize], w1[SoftwareRasterizer::TileSize], w2[SoftwareRasterizer::TileSize];
+		uint8_t covered[SoftwareRasterizer::TileSize];
+		float varyings[SoftwareProgram::MaxVaryings];
+
+		uint64_t fragments = 0;
+
+		for (const uint32_t index : s_Data.Bins[tile])
+		{
+			const SetupTriangle& triangle = s_Data.Triangles[index];
+
+			const int minX = std::max(triangle.MinX, tileMinX), maxX = std::min(triangle.MaxX, tileMaxX);
+			const int minY = std::max(triangle.MinY, tileMinY), maxY = std::min(triangle.MaxY, tileMaxY);
+			const int span = maxX - minX + 1;
+
+			// Edge i is opposite to vertex i, its function is the barycentric weight of that vertex
+			const float* x = triangle.X;
+			const float* y = triangle.Y;
+
+			const float step0 = -(y[2] - y[1]), step1 = -(y[0] - y[2]), step2 = -(y[1] - y[0]);
+			const bool topLeft0 = IsTopLeft(x[1], y[1], x[2], y[2]);
+			const bool topLeft1 = IsTopLeft(x[2], y[2], x[0], y[0]);
+			const bool topLeft2 = IsTopLeft(x[0], y[0], x[1], y[1]);
+
+			const float* attributes0 = &s_Data.Vertices[static_cast<size_t>(triangle.Vertices[0]) * vertexStride + 4];
+			const float* attributes1 = &s_Data.Vertices[static_cast<size_t>(triangle.Vertices[1]) * vertexStride + 4];
+			const float* attributes2 = &s_Data.Vertices[static_cast<size_t>(triangle.Vertices[2]) * vertexStride + 4];
+
+			for (int py = minY; py <= maxY; py++)
+			{
+				const float centerX = static_cast<float>(minX) + 0.5f;
+				const float centerY = static_cast<float>(py) + 0.5f;
+
+				const float start0 = EdgeFunction(x[1], y[1], x[2], y[2], centerX, centerY);
+				const float start1 = EdgeFunction(x[2], y[2], x[0], y[0], centerX, centerY);
+				const float start2 = EdgeFunction(x[0], y[0], x[1], y[1], centerX, centerY);
+
+				for (int i = 0; i < span; i++)
+				{
+					const float offset = static_cast<float>(i);
+					w0[i] = start0 + step0 * offset;
+					w1[i] = start1 + step1 * offset;
+					w2[i] = start2 + step2 * offset;
+				}
+
+				for (int i = 0; i < span; i++)
+				{
+					const bool inside0 = w0[i] > 0.0f || (topLeft0 && w0[i] == 0.0f);
+					const bool inside1 = w1[i] > 0.0f || (topLeft1 && w1[i] == 0.0f);
+					const bool inside2 = w2[i] > 0.0f || (topLeft2 && w2[i] == 0.0f);
+					covered[i] = inside0 & inside1 & inside2;
+				}
+
+				const size_t row = static_cast<size_t>(py) * target.Width;
+
+				for (int i = 0; i < span; i++)
+				{
+					if (!covered[i])
+						continue;
+
+					fragments++;
+
+					const float b0 = w0[i] * triangle.InvArea;
+					const float b1 = w1[i] * triangle.InvArea;
+					const float b2 = w2[i] * triangle.InvArea;
+
+					// Window space depth is linear on screen, the varyings are not
+					const float depth = b0 * triangle.Z[0] + b1 * triangle.Z[1] + b2 * triangle.Z[2];
+					if (depth < 0.0f || depth > 1.0f)
+						continue;
+
+					const size_t pixel = row + static_cast<size_t>(minX + i);
+					if (state.DepthTest && depth >= target.Depth[pixel])
+						continue;
+
+					const float p0 = b0 * triangle.InvW[0];
+					const float p1 = b1 * triangle.InvW[1];
+					const float p2 = b2 * triangle.InvW[2];
+					const float normalize = 1.0f / (p0 + p1 + p2);
+
+					for (uint32_t k = 0; k < varyingCount; k++)
+						varyings[k] = (p0 * attributes0[k] + p1 * attributes1[k] + p2 * attributes2[k]) * normalize;
+
+					glm::vec4 color;
+					if (!program.ShadeFragment(varyings, state.Textures, color))
+						continue;
+
+					if (state.Blend)
+					{
+						// GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA on every channel
+						const glm::vec4 destination = UnpackColor(target.Color[pixel]);
+						color = color * color.a + destination * (1.0f - color.a);
+					}
+
+					target.Color[pixel] = PackColor(color);
+					if (state.DepthTest)
+						target.Depth[pixel] = depth;
+				}
+			}
+		}
+
+		return fragments;
+	}
+
+	void SoftwareRasterizer::DrawIndexed(const SoftwareVertexArray& vertexArray, const uint32_t indexCount)
+	{
+		const SoftwareDevice::PipelineState& state = SoftwareDevice::GetState();
+		if (!state.Shader)
+		{
+			LU_CORE_ERROR("DrawIndexed without a bound shader");
+			return;
+		}
+
+		const auto& vertexBuffers = vertexArray.GetVertexBuffers();
+		const auto& indexBuffer = vertexArray.GetIndexBuffer();
+		if (vertexBuffers.empty() || !indexBuffer)
+		{
+			LU_CORE_ERROR("DrawIndexed with an incomplete vertex array");
+			return;
+		}
+
+		const auto& vertexBuffer = static_cast<const SoftwareVertexBuffer&>(*vertexBuffers[0]);
+		const auto& indices = static_cast<const SoftwareIndexBuffer&>(*indexBuffer).GetIndices();
+
+		const BufferLayout& layout = vertexBuffer.GetLayout();
+		const auto layoutStride = static_cast<uint32_t>(layout.GetStride());
+		if (layoutStride == 0)
+			return;
+
+		const uint32_t triangleCount = std::min<uint32_t>(indexCount ? indexCount : indexBuffer->GetCount(),
+			static_cast<uint32_t>(indices.size())) / 3;
+		if (triangleCount == 0)
+			return;
+
+		const auto bufferVertices = static_cast<uint32_t>(vertexBuffer.GetData().size() / layoutStride);
+
+		// Only shade the referenced prefix, dynamic buffers are rarely full
+		uint32_t vertexCount = 0;
+		for (uint32_t i = 0; i < triangleCount * 3; i++)
+			vertexCount = std::max(vertexCount, indices[i] + 1);
+
+		if (vertexCount > bufferVertices)
+		{
+			LU_CORE_ERROR("DrawIndexed reads past the end of the vertex buffer");
+			return;
+		}
+
+		SoftwareProgram& program = state.Shader->GetProgram();
+		program.Prepare(state.Shader->GetUniforms(), layout);
+
+		const uint32_t varyingCount = std::min(program.GetVaryingCount(), SoftwareProgram::MaxVaryings);
+		const uint32_t vertexStride = 4 + varyingCount;
+
+		// Vertex stage
+		s_Data.Vertices.resize(static_cast<size_t>(vertexCount) * vertexStride);
+
+		const uint8_t* vertexData = vertexBuffer.GetData().data();
+		const uint32_t vertexChunks = (vertexCount + VertexChunkSize - 1) / VertexChunkSize;
+		SoftwareDevice::GetThreadPool().ParallelFor(vertexChunks, [&](const uint32_t chunk)
+		{
+			const uint32_t end = std::min(vertexCount, (chunk + 1) * VertexChunkSize);
+			for (uint32_t v = chunk * VertexChunkSize; v < end; v++)
+			{
+				float* output = &s_Data.Vertices[static_cast<size_t>(v) * vertexStride];
+				const glm::vec4 position = program.ShadeVertex(vertexData + static_cast<size_t>(v) * layoutStride, output + 4);
+
+				output[0] = position.x;
+				output[1] = position.y;
+				output[2] = position.z;
+				output[3] = position.w;
+			}
+		});
+
+		// Triangle setup and binning
+		SetupTriangles(indices, triangleCount, vertexStride, state);
+
+		const SoftwareRenderTarget& target = *state.Target;
+		const uint32_t tilesX = (target.Width + TileSize - 1) / TileSize;
+		const uint32_t tilesY = (target.Height + TileSize - 1) / TileSize;
+
+		s_Data.Bins.resize(static_cast<size_t>(tilesX) * tilesY);
+		for (auto& bin : s_Data.Bins)
+			bin.clear();
+
+		s_Data.Stats.Triangles += triangleCount;
+
+		for (uint32_t i = 0; i < triangleCount; i++)
+		{
+			const SetupTriangle& triangle = s_Data.Triangles[i];
+			if (!triangle.Valid)
+			{
+				s_Data.Stats.Rejected++;
+				continue;
+			}
+
+			for (uint32_t ty = triangle.MinY / TileSize; ty <= triangle.MaxY / TileSize; ty++)
+			{
+				for (uint32_t tx = triangle.MinX / TileSize; tx <= triangle.MaxX / TileSize; tx++)
+					s_Data.Bins[ty * tilesX + tx].push_back(i);
+			}
+		}
+
+		s_Data.ActiveTiles.clear();
+		for (uint32_t tile = 0; tile < s_Data.Bins.size(); tile++)
+		{
+			if (!s_Data.Bins[tile].empty())
+				s_Data.ActiveTiles.push_back(tile);
+		}
+
+		// Fragment stage, one thread per tile
+		s_Data.TileFragments.assign(s_Data.ActiveTiles.size(), 0);
+		SoftwareDevice::GetThreadPool().ParallelFor(static_cast<uint32_t>(s_Data.ActiveTiles.size()), [&](const uint32_t i)
+		{
+			s_Data.TileFragments[i] = RasterizeTile(s_Data.ActiveTiles[i], tilesX, vertexStride, varyingCount, program, state);
+		});
+
+		for (const uint64_t fragments : s_Data.TileFragments)
+			s_Data.Stats.Fragments += fragments;
+	}
+
+	void SoftwareRasterizer::Clear(SoftwareRenderTarget& target, const glm::vec4& color)
+	{
+		std::fill(target.Color.begin(), target.Color.end(), PackColor(color));
+		std::fill(target.Depth.begin(), target.Depth.end(), 1.0f);
+	}
+
+	const SoftwareRasterizer::Statistics& SoftwareRasterizer::GetStats()
+	{
+		return s_Data.Stats;
+	}
+
+	void SoftwareRasterizer::ResetStats()
+	{
+		s_Data.Stats = {};
+	}
+
+}
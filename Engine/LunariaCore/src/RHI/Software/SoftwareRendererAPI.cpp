@@ -0,0 +1,90 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Software/SoftwareRendererAPI.hpp"
+#include "LunariaCore/RHI/Software/SoftwareDevice.hpp"
+#include "LunariaCore/RHI/Software/SoftwareRasterizer.hpp"
+#include "LunariaCore/RHI/Software/SoftwareVertexArray.hpp"
+
+namespace Lunaria {
+
+	SoftwareRendererAPI::~SoftwareRendererAPI()
+	{
+		SoftwareDevice::Shutdown();
+	}
+
+	void SoftwareRendererAPI::Init()
+	{
+		SoftwareDevice::Init();
+
+		// Same fixed function state the OpenGL backend starts with
+		auto& state = SoftwareDevice::GetState();
+		state.Blend = true;
+		state.DepthTest = true;
+
+		LU_CORE_INFO("Software renderer backend, {0} worker threads", SoftwareDevice::GetThreadPool().GetWorkerCount());
+	}
+
+	void SoftwareRendererAPI::SetViewport(const int x, const int y, const uint32_t width, const uint32_t height)
+	{
+		auto& state = SoftwareDevice::GetState();
+
+		if (state.ViewportX == x && state.ViewportY == y && state.ViewportWidth == width && state.ViewportHeight == height)
+		{
+			m_Stats.SkippedCalls++;
+			return;
+		}
+
+		m_Stats.IssuedCalls++;
+
+		state.ViewportX = x;
+		state.ViewportY = y;
+		state.ViewportWidth = width;
+		state.ViewportHeight = height;
+
+		// The default target stands in for the window, it follows the window size
+		SoftwareRenderTarget& defaultTarget = SoftwareDevice::GetDefaultTarget();
+		const uint32_t targetWidth = static_cast<uint32_t>(std::max(x, 0)) + width;
+		const uint32_t targetHeight = static_cast<uint32_t>(std::max(y, 0)) + height;
+
+		if (state.Target == &defaultTarget && (defaultTarget.Width != targetWidth || defaultTarget.Height != targetHeight))
+			defaultTarget.Resize(targetWidth, targetHeight);
+	}
+
+	void SoftwareRendererAPI::SetClearColor(const glm::vec4& color)
+	{
+		SoftwareDevice::GetState().ClearColor = color;
+	}
+
+	void SoftwareRendererAPI::Clear()
+	{
+		auto& state = SoftwareDevice::GetState();
+		SoftwareRasterizer::Clear(*state.Target, state.ClearColor);
+	}
+
+	void SoftwareRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, const uint32_t indexCount, const uint32_t instanceCount)
+	{
+		// Programs read a single per vertex stream, every instance rasterizes the same vertices
+		for (uint32_t instance = 0; instance < instanceCount; instance++)
+			SoftwareRasterizer::DrawIndexed(static_cast<const SoftwareVertexArray&>(*vertexArray), indexCount);
+	}
+
+	void SoftwareRendererAPI::Dispatch(const uint32_t /*groupsX*/, const uint32_t /*groupsY*/, const uint32_t /*groupsZ*/)
+	{
+		static bool warned = false;
+		if (!warned)
+			LU_CORE_WARN("Compute dispatches are not supported by the software renderer");
+		warned = true;
+	}
+
+	void SoftwareRendererAPI::ResetStateStats()
+	{
+		m_Stats = {};
+		SoftwareRasterizer::ResetStats();
+	}
+
+	RendererAPI::StateStatistics SoftwareRendererAPI::GetStateStats() const
+	{
+		return m_Stats;
+	}
+
+}
@@ -0,0 +1,216 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Software/SoftwareShader.hpp"
+#include "LunariaCore/RHI/Software/SoftwareTexture.hpp"
+
+#include <cstring>
+#include <filesystem>
+
+namespace Lunaria {
+
+	glm::mat4 SoftwareUniforms::GetMat4(const std::string& name, const glm::mat4& fallback) const
+	{
+		const auto it = Mat4s.find(name);
+		return it != Mat4s.end() ? it->second : fallback;
+	}
+
+	glm::vec4 SoftwareUniforms::GetFloat4(const std::string& name, const glm::vec4& fallback) const
+	{
+		const auto it = Float4s.find(name);
+		return it != Float4s.end() ? it->second : fallback;
+	}
+
+	glm::vec4 SoftwareProgram::ReadAttribute(const uint8_t* vertex, const BufferLayout& layout, const uint32_t location)
+	{
+		glm::vec4 value(0.0f, 0.0f, 0.0f, 1.0f);
+
+		const auto& elements = layout.GetElements();
+		if (location >= elements.size())
+			return value;
+
+		const BufferElement& element = elements[location];
+		const uint32_t components = std::min(element.GetComponentCount(), 4u);
+
+		switch (element.Type)
+		{
+		case ShaderDataType::Float:
+		case ShaderDataType::Float2:
+		case ShaderDataType::Float3:
+		case ShaderDataType::Float4:
+			std::memcpy(&value[0], vertex + element.Offset, components * sizeof(float));
+			break;
+
+		case ShaderDataType::Int:
+		case ShaderDataType::Int2:
+		case ShaderDataType::Int3:
+		case ShaderDataType::Int4:
+		{
+			int32_t ints[4];
+			std::memcpy(ints, vertex + element.Offset, components * sizeof(int32_t));
+			for (uint32_t i = 0; i < components; i++)
+				value[static_cast<int>(i)] = static_cast<float>(ints[i]);
+			break;
+		}
+
+		default:
+			LU_CORE_ASSERT(false, "Attribute type not supported by the software renderer!");
+			break;
+		}
+
+		return value;
+	}
+
+	// Texture.lusf
+	class TextureProgram final : public SoftwareProgram
+	{
+	public:
+		uint32_t GetVaryingCount() const override { return 8; }
+
+		void Prepare(const SoftwareUniforms& uniforms, const BufferLayout& layout) override
+		{
+			m_ViewProjection = uniforms.GetMat4("u_ViewProjection");
+			m_Layout = layout;
+
+			// u_Textures[i] names the texture unit sampled for index i
+			for (uint32_t i = 0; i < SoftwareDevice::MaxTextureUnits; i++)
+				m_Samplers[i] = static_cast<int>(i);
+
+			if (const auto it = uniforms.IntArrays.find("u_Textures"); it != uniforms.IntArrays.end())
+			{
+				for (size_t i = 0; i < std::min<size_t>(it->second.size(), SoftwareDevice::MaxTextureUnits); i++)
+					m_Samplers[i] = it->second[i];
+			}
+		}
+
+		glm::vec4 ShadeVertex(const uint8_t* vertex, float* varyings) const override
+		{
+			const glm::vec4 position = ReadAttribute(vertex, m_Layout, 0);
+			const glm::vec4 color = ReadAttribute(vertex, m_Layout, 1);
+			const glm::vec4 texCoord = ReadAttribute(vertex, m_Layout, 2);
+
+			varyings[0] = color.r;
+			varyings[1] = color.g;
+			varyings[2] = color.b;
+			varyings[3] = color.a;
+			varyings[4] = texCoord.x;
+			varyings[5] = texCoord.y;
+			varyings[6] = ReadAttribute(vertex, m_Layout, 3).x; // Texture index
+			varyings[7] = ReadAttribute(vertex, m_Layout, 4).x; // Tiling factor
+
+			return m_ViewProjection * glm::vec4(glm::vec3(position), 1.0f);
+		}
+
+		bool ShadeFragment(const float* varyings, const SoftwareTextureUnits& textures, glm::vec4& color) const override
+		{
+			color = glm::vec4(varyings[0], varyings[1], varyings[2], varyings[3]);
+
+			// Interpolation leaves the flat index a hair off, round like the GPU's int() would see it
+			const int index = static_cast<int>(varyings[6] + 0.5f);
+			if (index >= 0 && index < static_cast<int>(SoftwareDevice::MaxTextureUnits))
+			{
+				const int unit = m_Samplers[index];
+				if (unit >= 0 && unit < static_cast<int>(SoftwareDevice::MaxTextureUnits) && textures[unit])
+					color *= textures[unit]->Sample(glm::vec2(varyings[4], varyings[5]) * varyings[7]);
+			}
+
+			return color.a >= 0.1f;
+		}
+	private:
+		glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+		BufferLayout m_Layout;
+		std::array<int, SoftwareDevice::MaxTextureUnits> m_Samplers{};
+	};
+
+	// FlatColor.lusf, FlatColorIndirect maps to it too so the batch shader still loads. Batched
+	// draws go to Renderer::Submit with the fallback shader on this backend
+	class FlatColorProgram : public SoftwareProgram
+	{
+	public:
+		uint32_t GetVaryingCount() const override { return 0; }
+
+		void Prepare(const SoftwareUniforms& uniforms, const BufferLayout& layout) override
+		{
+			m_Transform = uniforms.GetMat4("u_ViewProjection") * uniforms.GetMat4("u_Transform");
+			m_Color = uniforms.GetFloat4("u_Color", m_Color);
+			m_Layout = layout;
+		}
+
+		glm::vec4 ShadeVertex(const uint8_t* vertex, float* /*varyings*/) const override
+		{
+			return m_Transform * glm::vec4(glm::vec3(ReadAttribute(vertex, m_Layout, 0)), 1.0f);
+		}
+
+		bool ShadeFragment(const float* /*varyings*/, const SoftwareTextureUnits& /*textures*/, glm::vec4& color) const override
+		{
+			color = m_Color;
+			return true;
+		}
+	protected:
+		glm::mat4 m_Transform = glm::mat4(1.0f);
+		glm::vec4 m_Color = glm::vec4(1.0f);
+		BufferLayout m_Layout;
+	};
+
+	// Shaders without a program still draw their geometry, in magenta
+	class MissingProgram final : public FlatColorProgram
+	{
+	public:
+		void Prepare(const SoftwareUniforms& uniforms, const BufferLayout& layout) override
+		{
+			FlatColorProgram::Prepare(uniforms, layout);
+			m_Color = glm::vec4(1.0f, 0.0f, 1.0f, 1.0f);
+		}
+	};
+
+	static std::unordered_map<std::string, SoftwareShader::ProgramFactory>& GetProgramRegistry()
+	{
+		static std::unordered_map<std::string, SoftwareShader::ProgramFactory> registry = {
+			{ "Texture", [] { return CreateScope<TextureProgram>(); } },
+			{ "FlatColor", [] { return CreateScope<FlatColorProgram>(); } },
+			{ "FlatColorIndirect", [] { return CreateScope<FlatColorProgram>(); } }
+		};
+
+		return registry;
+	}
+
+	static Scope<SoftwareProgram> CreateProgram(const std::string& name)
+	{
+		const auto& registry = GetProgramRegistry();
+		if (const auto it = registry.find(name); it != registry.end())
+			return it->second();
+
+		LU_CORE_ERROR("No software program registered for shader '{0}', it will draw magenta", name);
+		return CreateScope<MissingProgram>();
+	}
+
+	SoftwareShader::SoftwareShader(const std::string& filepath)
+		: m_Name(std::filesystem::path(filepath).stem().string()), m_Program(CreateProgram(m_Name))
+	{
+	}
+
+	SoftwareShader::SoftwareShader(const std::string& name, const std::string& /*vertexSrc*/, const std::string& /*fragmentSrc*/)
+		: m_Name(name), m_Program(CreateProgram(name))
+	{
+	}
+
+	void SoftwareShader::Bind() const
+	{
+		SoftwareDevice::GetState().Shader = this;
+	}
+
+	void SoftwareShader::Unbind() const
+	{
+		SoftwareDevice::GetState().Shader = nullptr;
+	}
+
+	void SoftwareShader::SetIntArray(const std::string& name, int* values, const uint32_t count) const
+	{
+		m_Uniforms.IntArrays[name].assign(values, values + count);
+	}
+
+	void SoftwareShader::RegisterProgram(const std::string& name, const ProgramFactory& factory)
+	{
+		GetProgramRegistry()[name] = factory;
+	}
+
+}
@@ -0,0 +1,141 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Software/SoftwareTexture.hpp"
+#include "LunariaCore/RHI/Software/SoftwareDevice.hpp"
+#include "LunariaCore/Renderer/CompressedTexture.hpp"
+
+#include <stb_image/stb_image.h>
+
+#include <cstring>
+
+namespace Lunaria {
+
+	SoftwareTexture2D::SoftwareTexture2D(const std::string& path, const TextureSpecification& specification)
+		: m_RendererID(SoftwareDevice::AllocateID()), m_Specification(specification)
+	{
+		if (CompressedTextureLoader::IsContainer(path))
+		{
+			CompressedTextureData data;
+			std::vector<uint8_t> pixels;
+
+			if (!CompressedTextureLoader::Load(path, data))
+			{
+				LU_CORE_ERROR("Failed to load texture '{0}'", path);
+			}
+			else if (data.Format == CompressedTextureFormat::RGBA8)
+			{
+				const CompressedTextureLevel& level = data.Levels[0];
+				pixels.assign(data.Data.begin() + level.Offset, data.Data.begin() + level.Offset + level.Size);
+			}
+			else if (!CompressedTextureLoader::Decompress(data, 0, pixels))
+			{
+				LU_CORE_ERROR("Texture '{0}' has a format the software renderer cannot decode", path);
+			}
+
+			if (!pixels.empty())
+			{
+				m_Width = data.Width;
+				m_Height = data.Height;
+				m_Texels.resize(static_cast<size_t>(m_Width) * m_Height);
+				std::memcpy(m_Texels.data(), pixels.data(), std::min(pixels.size(), m_Texels.size() * sizeof(uint32_t)));
+				return;
+			}
+		}
+		else
+		{
+			int width, height, channels;
+			if (stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 4))
+			{
+				m_Width = static_cast<uint32_t>(width);
+				m_Height = static_cast<uint32_t>(height);
+				m_Texels.resize(static_cast<size_t>(m_Width) * m_Height);
+				std::memcpy(m_Texels.data(), data, m_Texels.size() * sizeof(uint32_t));
+
+				stbi_image_free(data);
+				return;
+			}
+
+			LU_CORE_ERROR("Failed to load texture '{0}'", path);
+		}
+
+		// Opaque magenta, like a missing texture in the shaders
+		m_Texels.assign(1, 0xffff00ff);
+	}
+
+	SoftwareTexture2D::SoftwareTexture2D(const uint32_t width, const uint32_t height, const TextureSpecification& specification)
+		: m_RendererID(SoftwareDevice::AllocateID()), m_Width(width), m_Height(height), m_Specification(specification),
+		  m_Texels(static_cast<size_t>(width) * height, 0)
+	{
+	}
+
+	void SoftwareTexture2D::SetData(void* data, const uint32_t size)
+	{
+		LU_CORE_ASSERT(size == m_Texels.size() * sizeof(uint32_t), "Data must be entire texture!");
+		std::memcpy(m_Texels.data(), data, std::min<size_t>(size, m_Texels.size() * sizeof(uint32_t)));
+	}
+
+	void SoftwareTexture2D::Bind(const uint32_t slot) const
+	{
+		LU_CORE_ASSERT(slot < SoftwareDevice::MaxTextureUnits, "Texture slot out of range!");
+		if (slot < SoftwareDevice::MaxTextureUnits)
+			SoftwareDevice::GetState().Textures[slot] = this;
+	}
+
+	int SoftwareTexture2D::Wrap(const int coordinate, const int size) const
+	{
+		switch (m_Specification.Wrap)
+		{
+		case TextureWrap::Repeat:
+		{
+			const int wrapped = coordinate % size;
+			return wrapped < 0 ? wrapped + size : wrapped;
+		}
+		case TextureWrap::MirroredRepeat:
+		{
+			const int period = 2 * size;
+			int wrapped = coordinate % period;
+			if (wrapped < 0)
+				wrapped += period;
+			return wrapped < size ? wrapped : period - 1 - wrapped;
+		}
+		case TextureWrap::ClampToEdge:
+			return std::clamp(coordinate, 0, size - 1);
+		}
+
+		return 0;
+	}
+
+	glm::vec4 SoftwareTexture2D::Fetch(const int x, const int y) const
+	{
+		const uint32_t texel = m_Texels[static_cast<size_t>(Wrap(y, static_cast<int>(m_Height))) * m_Width
+			+ Wrap(x, static_cast<int>(m_Width))];
+
+		return glm::vec4(texel & 0xff, (texel >> 8) & 0xff, (texel >> 16) & 0xff, texel >> 24) * (1.0f / 255.0f);
+	}
+
+	glm::vec4 SoftwareTexture2D::Sample(const glm::vec2 uv) const
+	{
+		const float x = uv.x * static_cast<float>(m_Width);
+		const float y = uv.y * static_cast<float>(m_Height);
+
+		// Without derivatives there is no telling magnification from minification, the
+		// quads the 2D renderer draws are mostly magnified so MagFilter wins
+		if (m_Specification.MagFilter != TextureFilter::Linear)
+			return Fetch(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y)));
+
+		const float sx = x - 0.5f, sy = y - 0.5f;
+		const int x0 = static_cast<int>(std::floor(sx)), y0 = static_cast<int>(std::floor(sy));
+		const float fx = sx - static_cast<float>(x0), fy = sy - static_cast<float>(y0);
+
+		const glm::vec4 bottom = glm::mix(Fetch(x0, y0), Fetch(x0 + 1, y0), fx);
+		const glm::vec4 top = glm::mix(Fetch(x0, y0 + 1), Fetch(x0 + 1, y0 + 1), fx);
+		return glm::mix(bottom, top, fy);
+	}
+
+	Ref<Texture2D> SoftwareTextureStreamer::Load(const std::string& path, const TextureSpecification& specification)
+	{
+		m_Stats.LoadedTextures++;
+		return CreateRef<SoftwareTexture2D>(path, specification);
+	}
+
+}
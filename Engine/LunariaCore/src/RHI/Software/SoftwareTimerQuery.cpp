@@ -0,0 +1,17 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Software/SoftwareTimerQuery.hpp"
+
+#include <chrono>
+
+namespace Lunaria {
+
+	void SoftwareTimerQueryPool::WriteTimestamp(const uint32_t query)
+	{
+		LU_CORE_ASSERT(query < m_Timestamps.size(), "Query index out of range!");
+
+		const auto now = std::chrono::steady_clock::now().time_since_epoch();
+		m_Timestamps[query] = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+	}
+
+}
@@ -0,0 +1,23 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Software/SoftwareVertexArray.hpp"
+
+namespace Lunaria {
+
+	void SoftwareVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		LU_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
+
+		// Programs read one interleaved stream
+		LU_CORE_ASSERT(m_VertexBuffers.empty(), "Software vertex arrays support a single vertex buffer!");
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+	void SoftwareVertexArray::SetVertexBuffer(uint32_t index, const Ref<VertexBuffer>& vertexBuffer)
+	{
+		LU_CORE_ASSERT(index < m_VertexBuffers.size(), "Vertex buffer index out of range!");
+		LU_CORE_ASSERT(vertexBuffer->GetLayout() == m_VertexBuffers[index]->GetLayout(), "Vertex buffer layout doesn't match the vertex format!");
+		m_VertexBuffers[index] = vertexBuffer;
+	}
+
+}
@@ -0,0 +1,133 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanBuffer.hpp"
+
+#include <cstring>
+
+namespace Lunaria {
+
+	/////////////////////////////////////////////////////////////////////////////
+	// VertexBuffer /////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	VulkanVertexBuffer::VulkanVertexBuffer(const uint32_t size)
+	{
+		m_Shadow.reserve(size);
+	}
+
+	VulkanVertexBuffer::VulkanVertexBuffer(const float* vertices, const uint32_t size)
+	{
+		m_Static = VulkanDevice::CreateBuffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		if (vertices && m_Static.Mapped)
+			std::memcpy(m_Static.Mapped, vertices, size);
+	}
+
+	VulkanVertexBuffer::~VulkanVertexBuffer()
+	{
+		if (m_Static.Buffer)
+			VulkanDevice::DeferDestroy([buffer = m_Static]() { VulkanDevice::DestroyBuffer(buffer); });
+	}
+
+	void VulkanVertexBuffer::SetData(const void* data, const uint32_t size)
+	{
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		m_Shadow.assign(bytes, bytes + size);
+
+		std::lock_guard lock(m_TransientMutex);
+		UploadTransient();
+	}
+
+	void VulkanVertexBuffer::GetBinding(VkBuffer& buffer, VkDeviceSize& offset) const
+	{
+		if (m_Static.Buffer && m_Shadow.empty())
+		{
+			buffer = m_Static.Buffer;
+			offset = 0;
+			return;
+		}
+
+		std::lock_guard lock(m_TransientMutex);
+		if (m_TransientFrame != VulkanDevice::GetFrameNumber())
+			UploadTransient();
+
+		buffer = m_Transient.Buffer;
+		offset = m_Transient.Offset;
+	}
+
+	void VulkanVertexBuffer::UploadTransient() const
+	{
+		// Attribute fetches need no more than 16 byte alignment
+		m_Transient = VulkanDevice::AllocateTransient(std::max<VkDeviceSize>(m_Shadow.size(), 1), 16);
+		m_TransientFrame = VulkanDevice::GetFrameNumber();
+
+		if (m_Transient.Mapped)
+			std::memcpy(m_Transient.Mapped, m_Shadow.data(), m_Shadow.size());
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// IndexBuffer //////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	VulkanIndexBuffer::VulkanIndexBuffer(const void* indices, const uint32_t count, const IndexType type)
+		: m_Count(count), m_Type(type)
+	{
+		const VkDeviceSize size = static_cast<VkDeviceSize>(count) * IndexTypeSize(type);
+
+		m_Buffer = VulkanDevice::CreateBuffer(size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		if (!m_Buffer.Mapped)
+			return;
+
+		if (indices)
+			std::memcpy(m_Buffer.Mapped, indices, size);
+		else
+			std::memset(m_Buffer.Mapped, 0, size);
+	}
+
+	VulkanIndexBuffer::~VulkanIndexBuffer()
+	{
+		VulkanDevice::DeferDestroy([buffer = m_Buffer]() { VulkanDevice::DestroyBuffer(buffer); });
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// StorageBuffer ////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	VulkanStorageBuffer::VulkanStorageBuffer(const void* data, const uint32_t size)
+		: m_Size(size)
+	{
+		m_Buffer = VulkanDevice::CreateBuffer(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		if (!m_Buffer.Mapped)
+			return;
+
+		if (data)
+			std::memcpy(m_Buffer.Mapped, data, size);
+		else
+			std::memset(m_Buffer.Mapped, 0, size);
+	}
+
+	VulkanStorageBuffer::~VulkanStorageBuffer()
+	{
+		VulkanDevice::DeferDestroy([buffer = m_Buffer]() { VulkanDevice::DestroyBuffer(buffer); });
+	}
+
+	void VulkanStorageBuffer::SetData(const void* data, const uint32_t size, const uint32_t offset)
+	{
+		LU_CORE_ASSERT(offset + size <= m_Size, "StorageBuffer::SetData writes past the end of the buffer!");
+		if (m_Buffer.Mapped && offset + size <= m_Size)
+			std::memcpy(static_cast<uint8_t*>(m_Buffer.Mapped) + offset, data, size);
+	}
+
+	void VulkanStorageBuffer::GetData(void* data, const uint32_t size, const uint32_t offset) const
+	{
+		LU_CORE_ASSERT(offset + size <= m_Size, "StorageBuffer::GetData reads past the end of the buffer!");
+		if (m_Buffer.Mapped && offset + size <= m_Size)
+			std::memcpy(data, static_cast<const uint8_t*>(m_Buffer.Mapped) + offset, size);
+	}
+
+}
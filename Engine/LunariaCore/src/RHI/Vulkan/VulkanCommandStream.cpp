@@ -0,0 +1,308 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanCommandStream.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanSwapchain.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanShader.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanTexture.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanBuffer.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanVertexArray.hpp"
+
+#include <cstring>
+
+namespace Lunaria {
+
+	struct VulkanCommandStreamData
+	{
+		VulkanCommandStream::PipelineState State;
+
+		// Render pass recorded into the frame's primary command buffer
+		const VulkanRenderTarget* PassTarget = nullptr;
+		VkCommandBuffer OpenSecondary = VK_NULL_HANDLE; // Main thread's, VK_NULL_HANDLE between RecordParallel and the next draw
+
+		// The swapchain image's first pass discards the previous contents
+		bool SwapchainStarted = false;
+	};
+
+	static VulkanCommandStreamData s_Stream;
+
+	VulkanCommandStream::PipelineState& VulkanCommandStream::GetState()
+	{
+		return s_Stream.State;
+	}
+
+	static const VulkanRenderTarget* GetCurrentTarget()
+	{
+		if (s_Stream.State.Target)
+			return s_Stream.State.Target;
+
+		VulkanDevice::BeginFrame(); // Acquires the swapchain image
+
+		const VulkanSwapchain& swapchain = VulkanDevice::GetSwapchain();
+		return swapchain.HasImage() ? &swapchain.GetTarget() : nullptr;
+	}
+
+	// GL viewports start at the bottom left, a negative height flips Vulkan's y axis to match
+	static void GetViewportAndScissor(const VulkanRenderTarget& target, VkViewport& viewport, VkRect2D& scissor)
+	{
+		const auto& state = s_Stream.State;
+		const auto targetHeight = static_cast<float>(target.Extent.height);
+
+		viewport.x = static_cast<float>(state.ViewportX);
+		viewport.y = targetHeight - static_cast<float>(state.ViewportY);
+		viewport.width = static_cast<float>(state.ViewportWidth);
+		viewport.height = -static_cast<float>(state.ViewportHeight);
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+
+		const int32_t top = static_cast<int32_t>(target.Extent.height) - state.ViewportY - static_cast<int32_t>(state.ViewportHeight);
+		scissor.offset = { std::max(state.ViewportX, 0), std::max(top, 0) };
+		scissor.extent = { std::min(state.ViewportWidth, target.Extent.width), std::min(state.ViewportHeight, target.Extent.height) };
+	}
+
+	static VkCommandBuffer BeginSecondary()
+	{
+		VkCommandBuffer commandBuffer = VulkanDevice::AllocateThreadCommandBuffer(VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+
+		VkCommandBufferInheritanceInfo inheritance{};
+		inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritance.renderPass = s_Stream.PassTarget->LoadPass;
+		inheritance.subpass = 0;
+		inheritance.framebuffer = s_Stream.PassTarget->Framebuffer;
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		beginInfo.pInheritanceInfo = &inheritance;
+		LU_VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+
+		VkViewport viewport;
+		VkRect2D scissor;
+		GetViewportAndScissor(*s_Stream.PassTarget, viewport, scissor);
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+		return commandBuffer;
+	}
+
+	static void CloseSecondary()
+	{
+		if (!s_Stream.OpenSecondary)
+			return;
+
+		LU_VK_CHECK(vkEndCommandBuffer(s_Stream.OpenSecondary));
+		vkCmdExecuteCommands(VulkanDevice::GetFrameCommandBuffer(), 1, &s_Stream.OpenSecondary);
+		s_Stream.OpenSecondary = VK_NULL_HANDLE;
+	}
+
+	void VulkanCommandStream::BindTarget(const VulkanRenderTarget* target)
+	{
+		if (s_Stream.State.Target == target)
+			return;
+
+		EndRenderPass();
+		s_Stream.State.Target = target;
+	}
+
+	void VulkanCommandStream::SetViewport(const int x, const int y, const uint32_t width, const uint32_t height)
+	{
+		auto& state = s_Stream.State;
+		state.ViewportX = x;
+		state.ViewportY = y;
+		state.ViewportWidth = width;
+		state.ViewportHeight = height;
+
+		if (s_Stream.OpenSecondary)
+		{
+			VkViewport viewport;
+			VkRect2D scissor;
+			GetViewportAndScissor(*s_Stream.PassTarget, viewport, scissor);
+			vkCmdSetViewport(s_Stream.OpenSecondary, 0, 1, &viewport);
+			vkCmdSetScissor(s_Stream.OpenSecondary, 0, 1, &scissor);
+		}
+	}
+
+	VkCommandBuffer VulkanCommandStream::GetCommandBuffer()
+	{
+		if (s_Stream.OpenSecondary)
+			return s_Stream.OpenSecondary;
+
+		if (s_Stream.PassTarget)
+			return s_Stream.OpenSecondary = BeginSecondary();
+
+		return VulkanDevice::GetFrameCommandBuffer();
+	}
+
+	VkCommandBuffer VulkanCommandStream::GetRenderPassCommandBuffer()
+	{
+		const VulkanRenderTarget* target = GetCurrentTarget();
+		if (!target)
+			return VK_NULL_HANDLE;
+
+		if (s_Stream.PassTarget != target)
+		{
+			EndRenderPass();
+
+			VkRenderPass renderPass = target->LoadPass;
+
+			const bool swapchain = !s_Stream.State.Target;
+			if (swapchain && !s_Stream.SwapchainStarted)
+			{
+				renderPass = target->FirstPass;
+				s_Stream.SwapchainStarted = true;
+			}
+
+			// Only the first pass's depth attachment is cleared, the load passes ignore the values
+			VkClearValue clearValues[2]{};
+			clearValues[1].depthStencil = { 1.0f, 0 };
+
+			VkRenderPassBeginInfo beginInfo{};
+			beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+			beginInfo.renderPass = renderPass;
+			beginInfo.framebuffer = target->Framebuffer;
+			beginInfo.renderArea.extent = target->Extent;
+			beginInfo.clearValueCount = 2;
+			beginInfo.pClearValues = clearValues;
+
+			vkCmdBeginRenderPass(VulkanDevice::GetFrameCommandBuffer(), &beginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+			s_Stream.PassTarget = target;
+		}
+
+		return GetCommandBuffer();
+	}
+
+	void VulkanCommandStream::EndRenderPass()
+	{
+		if (!s_Stream.PassTarget)
+			return;
+
+		CloseSecondary();
+		vkCmdEndRenderPass(VulkanDevice::GetFrameCommandBuffer());
+		s_Stream.PassTarget = nullptr;
+	}
+
+	void VulkanCommandStream::RecordParallel(const uint32_t count, const std::function<void(uint32_t, VkCommandBuffer)>& record)
+	{
+		if (count == 0 || !GetRenderPassCommandBuffer())
+			return;
+
+		// Keeps what the main thread recorded so far in front of the parallel work
+		CloseSecondary();
+
+		std::vector<VkCommandBuffer> commandBuffers(count);
+		VulkanDevice::GetRecordingPool().ParallelFor(count, [&](const uint32_t i)
+		{
+			VkCommandBuffer commandBuffer = BeginSecondary();
+			record(i, commandBuffer);
+			LU_VK_CHECK(vkEndCommandBuffer(commandBuffer));
+
+			commandBuffers[i] = commandBuffer;
+		});
+
+		vkCmdExecuteCommands(VulkanDevice::GetFrameCommandBuffer(), count, commandBuffers.data());
+	}
+
+	void VulkanCommandStream::RecordDrawIndexed(VkCommandBuffer commandBuffer, const VulkanShader& shader, const std::vector<uint8_t>& uniforms,
+		const VulkanTextureUnits& textures, const VulkanVertexArray& vertexArray, const uint32_t indexCount, const uint32_t instanceCount)
+	{
+		const auto& vertexBuffers = vertexArray.GetVertexBuffers();
+		const auto& indexBuffer = vertexArray.GetIndexBuffer();
+		if (vertexBuffers.empty() || !indexBuffer)
+			return;
+
+		const auto& vertexBuffer = static_cast<const VulkanVertexBuffer&>(*vertexBuffers[0]);
+
+		VkPipeline pipeline = shader.GetPipeline(s_Stream.PassTarget->LoadPass, vertexBuffer.GetLayout());
+		if (!pipeline)
+			return;
+
+		// Loose uniforms of this draw, a UBO binding can't be empty
+		const VkDeviceSize uniformSize = std::max<VkDeviceSize>(uniforms.size(), 16);
+		const VulkanTransientAllocation uniformAllocation = VulkanDevice::AllocateTransient(uniformSize,
+			VulkanDevice::GetProperties().limits.minUniformBufferOffsetAlignment);
+
+		VkDescriptorSet descriptorSet = VulkanDevice::AllocateDescriptorSet();
+		if (!uniformAllocation.Mapped || !descriptorSet)
+			return;
+
+		std::memcpy(uniformAllocation.Mapped, uniforms.data(), uniforms.size());
+
+		VkDescriptorBufferInfo bufferInfo{};
+		bufferInfo.buffer = uniformAllocation.Buffer;
+		bufferInfo.offset = 0;
+		bufferInfo.range = uniformSize;
+
+		// Every array element must be valid, empty units sample the 1x1 white texture
+		std::array<VkDescriptorImageInfo, VulkanDevice::MaxTextureUnits> imageInfos;
+		for (uint32_t unit = 0; unit < VulkanDevice::MaxTextureUnits; unit++)
+		{
+			const VulkanTexture2D* texture = textures[unit];
+			imageInfos[unit].imageView = texture ? texture->GetImageView() : VulkanDevice::GetDefaultImageView();
+			imageInfos[unit].sampler = texture ? texture->GetSampler() : VulkanDevice::GetSampler({});
+			imageInfos[unit].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		}
+
+		VkWriteDescriptorSet writes[2]{};
+		writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[0].dstSet = descriptorSet;
+		writes[0].dstBinding = VulkanDevice::UniformBinding;
+		writes[0].descriptorCount = 1;
+		writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		writes[0].pBufferInfo = &bufferInfo;
+
+		writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[1].dstSet = descriptorSet;
+		writes[1].dstBinding = VulkanDevice::TextureBinding;
+		writes[1].descriptorCount = VulkanDevice::MaxTextureUnits;
+		writes[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writes[1].pImageInfo = imageInfos.data();
+
+		vkUpdateDescriptorSets(VulkanDevice::GetDevice(), 2, writes, 0, nullptr);
+
+		VkBuffer vertexHandle;
+		VkDeviceSize vertexOffset;
+		vertexBuffer.GetBinding(vertexHandle, vertexOffset);
+		if (!vertexHandle)
+			return;
+
+		const auto dynamicOffset = static_cast<uint32_t>(uniformAllocation.Offset);
+
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, VulkanDevice::GetPipelineLayout(), 0, 1, &descriptorSet, 1, &dynamicOffset);
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexHandle, &vertexOffset);
+		const auto& vulkanIndexBuffer = static_cast<const VulkanIndexBuffer&>(*indexBuffer);
+		vkCmdBindIndexBuffer(commandBuffer, vulkanIndexBuffer.GetBuffer(), 0, vulkanIndexBuffer.GetVkIndexType());
+
+		const uint32_t count = indexCount ? indexCount : indexBuffer->GetCount();
+		vkCmdDrawIndexed(commandBuffer, count, instanceCount, 0, 0, 0);
+	}
+
+	// Labels are kept out of render passes, a pass recorded with secondary command buffers
+	// only accepts vkCmdExecuteCommands in the primary
+	void VulkanCommandStream::PushDebugGroup(const char* name)
+	{
+		EndRenderPass();
+		VulkanDevice::BeginDebugLabel(VulkanDevice::GetFrameCommandBuffer(), name);
+	}
+
+	void VulkanCommandStream::PopDebugGroup()
+	{
+		EndRenderPass();
+		VulkanDevice::EndDebugLabel(VulkanDevice::GetFrameCommandBuffer());
+	}
+
+	void VulkanCommandStream::OnFrameEnd()
+	{
+		// The image must still reach PRESENT_SRC when nothing was drawn to it this frame
+		if (!s_Stream.SwapchainStarted && VulkanDevice::GetSwapchain().HasImage())
+		{
+			const VulkanRenderTarget* target = s_Stream.State.Target;
+			s_Stream.State.Target = nullptr;
+			GetRenderPassCommandBuffer();
+			s_Stream.State.Target = target;
+		}
+
+		EndRenderPass();
+		s_Stream.SwapchainStarted = false;
+	}
+
+}
@@ -0,0 +1,31 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanContext.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanDevice.hpp"
+
+namespace Lunaria {
+
+	VulkanContext::VulkanContext(SDL_Window* windowHandle)
+		: m_WindowHandle(windowHandle)
+	{
+		LU_CORE_ASSERT(windowHandle, "Window handle is null!");
+	}
+
+	VulkanContext::~VulkanContext()
+	{
+		VulkanDevice::Shutdown();
+	}
+
+	void VulkanContext::Init()
+	{
+		m_Initialized = VulkanDevice::Init(m_WindowHandle);
+		LU_CORE_ASSERT(m_Initialized, "Failed to initialize Vulkan!");
+	}
+
+	void VulkanContext::SwapBuffers()
+	{
+		if (m_Initialized)
+			VulkanDevice::EndFrame();
+	}
+
+}
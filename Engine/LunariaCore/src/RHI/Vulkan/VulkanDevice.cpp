@@ -0,0 +1,1018 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanDevice.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanSwapchain.hpp"
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_vulkan.h>
+
+#include <cstring>
+#include <mutex>
+
+namespace Lunaria {
+
+	// Command pools of one thread, one per frame slot
+	struct ThreadCommandPools
+	{
+		std::array<VkCommandPool, VulkanDevice::FramesInFlight> Pools{};
+		std::array<std::vector<VkCommandBuffer>, VulkanDevice::FramesInFlight> Primaries, Secondaries;
+		std::array<uint32_t, VulkanDevice::FramesInFlight> UsedPrimaries{}, UsedSecondaries{};
+	};
+
+	struct FrameData
+	{
+		VkFence Fence = VK_NULL_HANDLE;
+		VkSemaphore ImageAvailable = VK_NULL_HANDLE;
+		VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+		bool HasImage = false;
+
+		VulkanBufferAllocation TransientBuffer;
+		std::atomic<VkDeviceSize> TransientOffset = 0;
+
+		VkDescriptorPool DescriptorPool = VK_NULL_HANDLE;
+
+		std::vector<std::function<void()>> Deletions;
+	};
+
+	struct VulkanDeviceData
+	{
+		VkInstance Instance = VK_NULL_HANDLE;
+		VkDebugUtilsMessengerEXT DebugMessenger = VK_NULL_HANDLE;
+		VkSurfaceKHR Surface = VK_NULL_HANDLE;
+		VkPhysicalDevice PhysicalDevice = VK_NULL_HANDLE;
+		VkPhysicalDeviceProperties Properties{};
+		VkPhysicalDeviceMemoryProperties MemoryProperties{};
+		VkDevice Device = VK_NULL_HANDLE;
+		VkQueue Queue = VK_NULL_HANDLE;
+		uint32_t QueueFamily = 0;
+
+		bool SamplerAnisotropy = false;
+
+		PFN_vkCmdBeginDebugUtilsLabelEXT CmdBeginDebugUtilsLabel = nullptr;
+		PFN_vkCmdEndDebugUtilsLabelEXT CmdEndDebugUtilsLabel = nullptr;
+
+		Scope<VulkanSwapchain> Swapchain;
+
+		VkDescriptorSetLayout DescriptorSetLayout = VK_NULL_HANDLE;
+		VkPipelineLayout PipelineLayout = VK_NULL_HANDLE;
+		VkRenderPass OffscreenRenderPass = VK_NULL_HANDLE;
+
+		std::array<FrameData, VulkanDevice::FramesInFlight> Frames;
+		uint32_t FrameIndex = 0;
+		uint64_t FrameNumber = 0;
+		bool FrameActive = false;
+
+		std::mutex ThreadPoolsMutex;
+		std::vector<Scope<ThreadCommandPools>> ThreadPools;
+		uint64_t Generation = 0; // Invalidates the thread local pool pointers of a previous Init
+
+		std::mutex DescriptorMutex;
+		std::mutex SamplerMutex;
+		std::unordered_map<uint64_t, VkSampler> Samplers;
+
+		VulkanImageAllocation DefaultImage;
+		VkImageView DefaultImageView = VK_NULL_HANDLE;
+
+		Scope<ThreadPool> RecordingPool;
+		uint32_t NextID = 1;
+	};
+
+	static VulkanDeviceData s_Device;
+
+	static thread_local ThreadCommandPools* t_ThreadPools = nullptr;
+	static thread_local uint64_t t_ThreadPoolsGeneration = 0;
+
+	static VKAPI_ATTR VkBool32 VKAPI_CALL DebugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT severity, VkDebugUtilsMessageTypeFlagsEXT /*type*/,
+		const VkDebugUtilsMessengerCallbackDataEXT* callbackData, void* /*userData*/)
+	{
+		if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+			LU_CORE_ERROR("Vulkan: {0}", callbackData->pMessage);
+		else if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
+			LU_CORE_WARN("Vulkan: {0}", callbackData->pMessage);
+
+		return VK_FALSE;
+	}
+
+	static bool HasLayer(const char* name)
+	{
+		uint32_t count = 0;
+		vkEnumerateInstanceLayerProperties(&count, nullptr);
+		std::vector<VkLayerProperties> layers(count);
+		vkEnumerateInstanceLayerProperties(&count, layers.data());
+
+		return std::any_of(layers.begin(), layers.end(), [name](const VkLayerProperties& layer) { return std::strcmp(layer.layerName, name) == 0; });
+	}
+
+	static bool HasInstanceExtension(const char* name)
+	{
+		uint32_t count = 0;
+		vkEnumerateInstanceExtensionProperties(nullptr, &count, nullptr);
+		std::vector<VkExtensionProperties> extensions(count);
+		vkEnumerateInstanceExtensionProperties(nullptr, &count, extensions.data());
+
+		return std::any_of(extensions.begin(), extensions.end(), [name](const VkExtensionProperties& extension) { return std::strcmp(extension.extensionName, name) == 0; });
+	}
+
+	static bool CreateInstance(SDL_Window* window)
+	{
+		uint32_t sdlExtensionCount = 0;
+		SDL_Vulkan_GetInstanceExtensions(window, &sdlExtensionCount, nullptr);
+		std::vector<const char*> extensions(sdlExtensionCount);
+		SDL_Vulkan_GetInstanceExtensions(window, &sdlExtensionCount, extensions.data());
+
+		const bool debugUtils = HasInstanceExtension(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+		if (debugUtils)
+			extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+
+		std::vector<const char*> layers;
+#if defined(LU_DEBUG)
+		if (HasLayer("VK_LAYER_KHRONOS_validation"))
+			layers.push_back("VK_LAYER_KHRONOS_validation");
+		else
+			LU_CORE_WARN("Vulkan validation layer is not installed");
+#endif
+
+		VkApplicationInfo applicationInfo{};
+		applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+		applicationInfo.pApplicationName = "Lunaria";
+		applicationInfo.pEngineName = "Lunaria";
+		applicationInfo.apiVersion = VK_API_VERSION_1_2;
+
+		VkInstanceCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+		createInfo.pApplicationInfo = &applicationInfo;
+		createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+		createInfo.ppEnabledExtensionNames = extensions.data();
+		createInfo.enabledLayerCount = static_cast<uint32_t>(layers.size());
+		createInfo.ppEnabledLayerNames = layers.data();
+
+		if (vkCreateInstance(&createInfo, nullptr, &s_Device.Instance) != VK_SUCCESS)
+		{
+			LU_CORE_ERROR("Failed to create Vulkan instance");
+			return false;
+		}
+
+		if (debugUtils)
+		{
+			s_Device.CmdBeginDebugUtilsLabel = reinterpret_cast<PFN_vkCmdBeginDebugUtilsLabelEXT>(
+				vkGetInstanceProcAddr(s_Device.Instance, "vkCmdBeginDebugUtilsLabelEXT"));
+			s_Device.CmdEndDebugUtilsLabel = reinterpret_cast<PFN_vkCmdEndDebugUtilsLabelEXT>(
+				vkGetInstanceProcAddr(s_Device.Instance, "vkCmdEndDebugUtilsLabelEXT"));
+
+			const auto createMessenger = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
+				vkGetInstanceProcAddr(s_Device.Instance, "vkCreateDebugUtilsMessengerEXT"));
+
+			if (createMessenger && !layers.empty())
+			{
+				VkDebugUtilsMessengerCreateInfoEXT messengerInfo{};
+				messengerInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+				messengerInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+				messengerInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT
+					| VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+				messengerInfo.pfnUserCallback = DebugCallback;
+
+				LU_VK_CHECK(createMessenger(s_Device.Instance, &messengerInfo, nullptr, &s_Device.DebugMessenger));
+			}
+		}
+
+		return true;
+	}
+
+	// Lower is better, CPU implementations (lavapipe) are accepted as a last resort
+	static int DeviceTypeRank(const VkPhysicalDeviceType type)
+	{
+		switch (type)
+		{
+		case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:		return 0;
+		case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:	return 1;
+		case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:		return 2;
+		case VK_PHYSICAL_DEVICE_TYPE_CPU:				return 3;
+		default:										return 4;
+		}
+	}
+
+	static bool FindQueueFamily(VkPhysicalDevice physicalDevice, uint32_t& outFamily)
+	{
+		uint32_t count = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, nullptr);
+		std::vector<VkQueueFamilyProperties> families(count);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &count, families.data());
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			VkBool32 present = VK_FALSE;
+			vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, s_Device.Surface, &present);
+
+			if ((families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) && present)
+			{
+				outFamily = i;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static bool HasSwapchainExtension(VkPhysicalDevice physicalDevice)
+	{
+		uint32_t count = 0;
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, nullptr);
+		std::vector<VkExtensionProperties> extensions(count);
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, extensions.data());
+
+		return std::any_of(extensions.begin(), extensions.end(), [](const VkExtensionProperties& extension)
+			{ return std::strcmp(extension.extensionName, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0; });
+	}
+
+	static bool PickPhysicalDevice()
+	{
+		uint32_t count = 0;
+		vkEnumeratePhysicalDevices(s_Device.Instance, &count, nullptr);
+		std::vector<VkPhysicalDevice> physicalDevices(count);
+		vkEnumeratePhysicalDevices(s_Device.Instance, &count, physicalDevices.data());
+
+		int bestRank = std::numeric_limits<int>::max();
+		for (VkPhysicalDevice physicalDevice : physicalDevices)
+		{
+			VkPhysicalDeviceProperties properties;
+			vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+			// Host query reset and negative viewport heights
+			uint32_t family;
+			if (properties.apiVersion < VK_API_VERSION_1_2 || !HasSwapchainExtension(physicalDevice) || !FindQueueFamily(physicalDevice, family))
+				continue;
+
+			const int rank = DeviceTypeRank(properties.deviceType);
+			if (rank < bestRank)
+			{
+				bestRank = rank;
+				s_Device.PhysicalDevice = physicalDevice;
+				s_Device.QueueFamily = family;
+				s_Device.Properties = properties;
+			}
+		}
+
+		if (!s_Device.PhysicalDevice)
+		{
+			LU_CORE_ERROR("No Vulkan 1.2 device can present to the window");
+			return false;
+		}
+
+		vkGetPhysicalDeviceMemoryProperties(s_Device.PhysicalDevice, &s_Device.MemoryProperties);
+
+		LU_CORE_INFO("Vulkan Info:");
+		LU_CORE_INFO("  Device: {0}", s_Device.Properties.deviceName);
+		LU_CORE_INFO("  API Version: {0}.{1}.{2}\n", VK_API_VERSION_MAJOR(s_Device.Properties.apiVersion),
+			VK_API_VERSION_MINOR(s_Device.Properties.apiVersion), VK_API_VERSION_PATCH(s_Device.Properties.apiVersion));
+
+		return true;
+	}
+
+	static bool CreateDevice()
+	{
+		VkPhysicalDeviceFeatures supported;
+		vkGetPhysicalDeviceFeatures(s_Device.PhysicalDevice, &supported);
+
+		VkPhysicalDeviceVulkan12Features features12{};
+		features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		features12.hostQueryReset = VK_TRUE;
+
+		VkPhysicalDeviceFeatures2 features{};
+		features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features.pNext = &features12;
+		features.features.samplerAnisotropy = supported.samplerAnisotropy;
+		features.features.textureCompressionBC = supported.textureCompressionBC;
+		features.features.textureCompressionETC2 = supported.textureCompressionETC2;
+
+		s_Device.SamplerAnisotropy = supported.samplerAnisotropy;
+
+		const float priority = 1.0f;
+		VkDeviceQueueCreateInfo queueInfo{};
+		queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+		queueInfo.queueFamilyIndex = s_Device.QueueFamily;
+		queueInfo.queueCount = 1;
+		queueInfo.pQueuePriorities = &priority;
+
+		const char* extensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+
+		VkDeviceCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+		createInfo.pNext = &features;
+		createInfo.queueCreateInfoCount = 1;
+		createInfo.pQueueCreateInfos = &queueInfo;
+		createInfo.enabledExtensionCount = 1;
+		createInfo.ppEnabledExtensionNames = extensions;
+
+		if (vkCreateDevice(s_Device.PhysicalDevice, &createInfo, nullptr, &s_Device.Device) != VK_SUCCESS)
+		{
+			LU_CORE_ERROR("Failed to create Vulkan device");
+			return false;
+		}
+
+		vkGetDeviceQueue(s_Device.Device, s_Device.QueueFamily, 0, &s_Device.Queue);
+		return true;
+	}
+
+	static void CreateLayouts()
+	{
+		VkDescriptorSetLayoutBinding bindings[2]{};
+		bindings[0].binding = VulkanDevice::UniformBinding;
+		bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		bindings[0].descriptorCount = 1;
+		bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		bindings[1].binding = VulkanDevice::TextureBinding;
+		bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		bindings[1].descriptorCount = VulkanDevice::MaxTextureUnits;
+		bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+		setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		setLayoutInfo.bindingCount = 2;
+		setLayoutInfo.pBindings = bindings;
+		LU_VK_CHECK(vkCreateDescriptorSetLayout(s_Device.Device, &setLayoutInfo, nullptr, &s_Device.DescriptorSetLayout));
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 1;
+		pipelineLayoutInfo.pSetLayouts = &s_Device.DescriptorSetLayout;
+		LU_VK_CHECK(vkCreatePipelineLayout(s_Device.Device, &pipelineLayoutInfo, nullptr, &s_Device.PipelineLayout));
+	}
+
+	static void CreateOffscreenRenderPass()
+	{
+		VkAttachmentDescription attachments[2]{};
+		attachments[0].format = VulkanDevice::OffscreenColorFormat;
+		attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
+		attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+		attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+		attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		attachments[0].initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		attachments[0].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		attachments[1] = attachments[0];
+		attachments[1].format = VulkanDevice::DepthFormat;
+		attachments[1].initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		const VkAttachmentReference colorReference{ 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+		const VkAttachmentReference depthReference{ 1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+
+		VkSubpassDescription subpass{};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = 1;
+		subpass.pColorAttachments = &colorReference;
+		subpass.pDepthStencilAttachment = &depthReference;
+
+		constexpr VkPipelineStageFlags attachmentStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+			| VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		constexpr VkAccessFlags attachmentAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
+			| VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+
+		// Previous passes and sampling of the color attachment on both sides
+		VkSubpassDependency dependencies[2]{};
+		dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+		dependencies[0].dstSubpass = 0;
+		dependencies[0].srcStageMask = attachmentStages | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		dependencies[0].dstStageMask = attachmentStages;
+		dependencies[0].srcAccessMask = attachmentAccess;
+		dependencies[0].dstAccessMask = attachmentAccess;
+
+		dependencies[1].srcSubpass = 0;
+		dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+		dependencies[1].srcStageMask = attachmentStages;
+		dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | attachmentStages;
+		dependencies[1].srcAccessMask = attachmentAccess;
+		dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT | attachmentAccess;
+
+		VkRenderPassCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		createInfo.attachmentCount = 2;
+		createInfo.pAttachments = attachments;
+		createInfo.subpassCount = 1;
+		createInfo.pSubpasses = &subpass;
+		createInfo.dependencyCount = 2;
+		createInfo.pDependencies = dependencies;
+
+		LU_VK_CHECK(vkCreateRenderPass(s_Device.Device, &createInfo, nullptr, &s_Device.OffscreenRenderPass));
+	}
+
+	static void CreateFrames()
+	{
+		VkDescriptorPoolSize poolSizes[2];
+		poolSizes[0] = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 4096 };
+		poolSizes[1] = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4096 * VulkanDevice::MaxTextureUnits };
+
+		for (FrameData& frame : s_Device.Frames)
+		{
+			VkFenceCreateInfo fenceInfo{};
+			fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+			fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+			LU_VK_CHECK(vkCreateFence(s_Device.Device, &fenceInfo, nullptr, &frame.Fence));
+
+			VkSemaphoreCreateInfo semaphoreInfo{};
+			semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+			LU_VK_CHECK(vkCreateSemaphore(s_Device.Device, &semaphoreInfo, nullptr, &frame.ImageAvailable));
+
+			frame.TransientBuffer = VulkanDevice::CreateBuffer(VulkanDevice::TransientBufferSize,
+				VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+			VkDescriptorPoolCreateInfo poolInfo{};
+			poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolInfo.maxSets = 4096;
+			poolInfo.poolSizeCount = 2;
+			poolInfo.pPoolSizes = poolSizes;
+			LU_VK_CHECK(vkCreateDescriptorPool(s_Device.Device, &poolInfo, nullptr, &frame.DescriptorPool));
+		}
+	}
+
+	static void CreateDefaultTexture()
+	{
+		VkImageCreateInfo imageInfo{};
+		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+		imageInfo.extent = { 1, 1, 1 };
+		imageInfo.mipLevels = 1;
+		imageInfo.arrayLayers = 1;
+		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+		s_Device.DefaultImage = VulkanDevice::CreateImage(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = s_Device.DefaultImage.Image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = imageInfo.format;
+		viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+		LU_VK_CHECK(vkCreateImageView(s_Device.Device, &viewInfo, nullptr, &s_Device.DefaultImageView));
+
+		// Cleared instead of uploaded, no staging buffer needed
+		VulkanDevice::ImmediateSubmit([](VkCommandBuffer commandBuffer)
+		{
+			VkImageMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.image = s_Device.DefaultImage.Image;
+			barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+			barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+			const VkClearColorValue white{ { 1.0f, 1.0f, 1.0f, 1.0f } };
+			vkCmdClearColorImage(commandBuffer, s_Device.DefaultImage.Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &white, 1, &barrier.subresourceRange);
+
+			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+		});
+	}
+
+	bool VulkanDevice::Init(SDL_Window* window)
+	{
+		s_Device.Generation++;
+
+		if (!CreateInstance(window))
+			return false;
+
+		if (!SDL_Vulkan_CreateSurface(window, s_Device.Instance, &s_Device.Surface))
+		{
+			LU_CORE_ERROR("Failed to create Vulkan surface: {0}", SDL_GetError());
+			return false;
+		}
+
+		if (!PickPhysicalDevice() || !CreateDevice())
+			return false;
+
+		CreateLayouts();
+		CreateOffscreenRenderPass();
+		CreateFrames();
+		CreateDefaultTexture();
+
+		s_Device.Swapchain = CreateScope<VulkanSwapchain>(window, s_Device.Surface);
+
+		const uint32_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+		s_Device.RecordingPool = CreateScope<ThreadPool>(threads - 1);
+
+		return true;
+	}
+
+	static void RunDeletions(FrameData& frame)
+	{
+		for (auto& destroy : frame.Deletions)
+			destroy();
+
+		frame.Deletions.clear();
+	}
+
+	void VulkanDevice::Shutdown()
+	{
+		if (!s_Device.Device)
+			return;
+
+		vkDeviceWaitIdle(s_Device.Device);
+
+		s_Device.RecordingPool.reset();
+
+		for (FrameData& frame : s_Device.Frames)
+			RunDeletions(frame);
+
+		s_Device.Swapchain.reset();
+
+		for (const auto& pools : s_Device.ThreadPools)
+		{
+			for (VkCommandPool pool : pools->Pools)
+				vkDestroyCommandPool(s_Device.Device, pool, nullptr);
+		}
+		s_Device.ThreadPools.clear();
+
+		for (const auto& [key, sampler] : s_Device.Samplers)
+			vkDestroySampler(s_Device.Device, sampler, nullptr);
+		s_Device.Samplers.clear();
+
+		vkDestroyImageView(s_Device.Device, s_Device.DefaultImageView, nullptr);
+		DestroyImage(s_Device.DefaultImage);
+
+		for (FrameData& frame : s_Device.Frames)
+		{
+			vkDestroyDescriptorPool(s_Device.Device, frame.DescriptorPool, nullptr);
+			DestroyBuffer(frame.TransientBuffer);
+			vkDestroySemaphore(s_Device.Device, frame.ImageAvailable, nullptr);
+			vkDestroyFence(s_Device.Device, frame.Fence, nullptr);
+
+			frame.Fence = VK_NULL_HANDLE;
+			frame.ImageAvailable = VK_NULL_HANDLE;
+			frame.DescriptorPool = VK_NULL_HANDLE;
+			frame.TransientBuffer = {};
+		}
+
+		vkDestroyRenderPass(s_Device.Device, s_Device.OffscreenRenderPass, nullptr);
+		vkDestroyPipelineLayout(s_Device.Device, s_Device.PipelineLayout, nullptr);
+		vkDestroyDescriptorSetLayout(s_Device.Device, s_Device.DescriptorSetLayout, nullptr);
+
+		vkDestroyDevice(s_Device.Device, nullptr);
+		s_Device.Device = VK_NULL_HANDLE;
+
+		vkDestroySurfaceKHR(s_Device.Instance, s_Device.Surface, nullptr);
+
+		if (s_Device.DebugMessenger)
+		{
+			const auto destroyMessenger = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+				vkGetInstanceProcAddr(s_Device.Instance, "vkDestroyDebugUtilsMessengerEXT"));
+			destroyMessenger(s_Device.Instance, s_Device.DebugMessenger, nullptr);
+		}
+
+		vkDestroyInstance(s_Device.Instance, nullptr);
+		s_Device.Instance = VK_NULL_HANDLE;
+
+		s_Device.FrameIndex = 0;
+		s_Device.FrameNumber = 0;
+		s_Device.FrameActive = false;
+	}
+
+	VkInstance VulkanDevice::GetInstance() { return s_Device.Instance; }
+	VkPhysicalDevice VulkanDevice::GetPhysicalDevice() { return s_Device.PhysicalDevice; }
+	VkDevice VulkanDevice::GetDevice() { return s_Device.Device; }
+	VkQueue VulkanDevice::GetQueue() { return s_Device.Queue; }
+	const VkPhysicalDeviceProperties& VulkanDevice::GetProperties() { return s_Device.Properties; }
+	VulkanSwapchain& VulkanDevice::GetSwapchain() { return *s_Device.Swapchain; }
+	VkDescriptorSetLayout VulkanDevice::GetDescriptorSetLayout() { return s_Device.DescriptorSetLayout; }
+	VkPipelineLayout VulkanDevice::GetPipelineLayout() { return s_Device.PipelineLayout; }
+	VkRenderPass VulkanDevice::GetOffscreenRenderPass() { return s_Device.OffscreenRenderPass; }
+
+	void VulkanDevice::BeginFrame()
+	{
+		if (s_Device.FrameActive)
+			return;
+
+		FrameData& frame = s_Device.Frames[s_Device.FrameIndex];
+
+		// The only wait of the frame loop, on the submission FramesInFlight frames ago
+		LU_VK_CHECK(vkWaitForFences(s_Device.Device, 1, &frame.Fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+
+		RunDeletions(frame);
+
+		frame.TransientOffset = 0;
+		LU_VK_CHECK(vkResetDescriptorPool(s_Device.Device, frame.DescriptorPool, 0));
+
+		{
+			std::lock_guard lock(s_Device.ThreadPoolsMutex);
+			for (const auto& pools : s_Device.ThreadPools)
+			{
+				LU_VK_CHECK(vkResetCommandPool(s_Device.Device, pools->Pools[s_Device.FrameIndex], 0));
+				pools->UsedPrimaries[s_Device.FrameIndex] = 0;
+				pools->UsedSecondaries[s_Device.FrameIndex] = 0;
+			}
+		}
+
+		s_Device.FrameActive = true;
+
+		frame.HasImage = s_Device.Swapchain->AcquireNextImage(frame.ImageAvailable);
+
+		frame.CommandBuffer = AllocateThreadCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		LU_VK_CHECK(vkBeginCommandBuffer(frame.CommandBuffer, &beginInfo));
+	}
+
+	void VulkanDevice::EndFrame()
+	{
+		BeginFrame();
+
+		FrameData& frame = s_Device.Frames[s_Device.FrameIndex];
+
+		VulkanCommandStream::OnFrameEnd();
+		LU_VK_CHECK(vkEndCommandBuffer(frame.CommandBuffer));
+
+		const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		const VkSemaphore renderFinished = frame.HasImage ? s_Device.Swapchain->GetRenderFinishedSemaphore() : VK_NULL_HANDLE;
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &frame.CommandBuffer;
+		if (frame.HasImage)
+		{
+			submitInfo.waitSemaphoreCount = 1;
+			submitInfo.pWaitSemaphores = &frame.ImageAvailable;
+			submitInfo.pWaitDstStageMask = &waitStage;
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = &renderFinished;
+		}
+
+		LU_VK_CHECK(vkResetFences(s_Device.Device, 1, &frame.Fence));
+		LU_VK_CHECK(vkQueueSubmit(s_Device.Queue, 1, &submitInfo, frame.Fence));
+
+		if (frame.HasImage)
+			s_Device.Swapchain->Present();
+
+		s_Device.FrameActive = false;
+		s_Device.FrameIndex = (s_Device.FrameIndex + 1) % FramesInFlight;
+		s_Device.FrameNumber++;
+	}
+
+	bool VulkanDevice::IsFrameActive()
+	{
+		return s_Device.FrameActive;
+	}
+
+	uint32_t VulkanDevice::GetFrameIndex()
+	{
+		return s_Device.FrameIndex;
+	}
+
+	uint64_t VulkanDevice::GetFrameNumber()
+	{
+		return s_Device.FrameNumber;
+	}
+
+	bool VulkanDevice::WaitForFrame(const uint64_t frameNumber, const uint64_t timeoutNanoseconds)
+	{
+		if (frameNumber >= s_Device.FrameNumber)
+			return false;
+
+		// A later frame of the same slot already waited on the slot's fence in BeginFrame
+		const uint64_t reusedBy = frameNumber + FramesInFlight;
+		if (reusedBy < s_Device.FrameNumber || (reusedBy == s_Device.FrameNumber && s_Device.FrameActive))
+			return true;
+
+		const VkFence fence = s_Device.Frames[frameNumber % FramesInFlight].Fence;
+		return vkWaitForFences(s_Device.Device, 1, &fence, VK_TRUE, timeoutNanoseconds) == VK_SUCCESS;
+	}
+
+	VkCommandBuffer VulkanDevice::GetFrameCommandBuffer()
+	{
+		BeginFrame();
+		return s_Device.Frames[s_Device.FrameIndex].CommandBuffer;
+	}
+
+	static ThreadCommandPools& GetThreadPools()
+	{
+		if (t_ThreadPools && t_ThreadPoolsGeneration == s_Device.Generation)
+			return *t_ThreadPools;
+
+		auto pools = CreateScope<ThreadCommandPools>();
+
+		VkCommandPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		poolInfo.queueFamilyIndex = s_Device.QueueFamily;
+
+		for (VkCommandPool& pool : pools->Pools)
+			LU_VK_CHECK(vkCreateCommandPool(s_Device.Device, &poolInfo, nullptr, &pool));
+
+		t_ThreadPools = pools.get();
+		t_ThreadPoolsGeneration = s_Device.Generation;
+
+		std::lock_guard lock(s_Device.ThreadPoolsMutex);
+		s_Device.ThreadPools.push_back(std::move(pools));
+
+		return *t_ThreadPools;
+	}
+
+	VkCommandBuffer VulkanDevice::AllocateThreadCommandBuffer(const VkCommandBufferLevel level)
+	{
+		ThreadCommandPools& pools = GetThreadPools();
+		const uint32_t frame = s_Device.FrameIndex;
+
+		const bool primary = level == VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		auto& buffers = primary ? pools.Primaries[frame] : pools.Secondaries[frame];
+		uint32_t& used = primary ? pools.UsedPrimaries[frame] : pools.UsedSecondaries[frame];
+
+		// Buffers of a reset pool are reused
+		if (used == buffers.size())
+		{
+			VkCommandBufferAllocateInfo allocateInfo{};
+			allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			allocateInfo.commandPool = pools.Pools[frame];
+			allocateInfo.level = level;
+			allocateInfo.commandBufferCount = 1;
+
+			VkCommandBuffer commandBuffer;
+			LU_VK_CHECK(vkAllocateCommandBuffers(s_Device.Device, &allocateInfo, &commandBuffer));
+			buffers.push_back(commandBuffer);
+		}
+
+		return buffers[used++];
+	}
+
+	void VulkanDevice::ImmediateSubmit(const std::function<void(VkCommandBuffer)>& record)
+	{
+		VkCommandPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		poolInfo.queueFamilyIndex = s_Device.QueueFamily;
+
+		VkCommandPool pool;
+		LU_VK_CHECK(vkCreateCommandPool(s_Device.Device, &poolInfo, nullptr, &pool));
+
+		VkCommandBufferAllocateInfo allocateInfo{};
+		allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocateInfo.commandPool = pool;
+		allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocateInfo.commandBufferCount = 1;
+
+		VkCommandBuffer commandBuffer;
+		LU_VK_CHECK(vkAllocateCommandBuffers(s_Device.Device, &allocateInfo, &commandBuffer));
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		LU_VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+
+		record(commandBuffer);
+
+		LU_VK_CHECK(vkEndCommandBuffer(commandBuffer));
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+
+		// Uploads are rare (texture loads and resizes), waiting keeps the staging lifetime trivial
+		LU_VK_CHECK(vkQueueSubmit(s_Device.Queue, 1, &submitInfo, VK_NULL_HANDLE));
+		LU_VK_CHECK(vkQueueWaitIdle(s_Device.Queue));
+
+		vkDestroyCommandPool(s_Device.Device, pool, nullptr);
+	}
+
+	void VulkanDevice::DeferDestroy(std::function<void()>&& destroy)
+	{
+		if (!s_Device.Device)
+			return; // Everything is gone already
+
+		// Nothing submitted yet that could use it
+		if (!s_Device.FrameActive && s_Device.FrameNumber == 0)
+		{
+			destroy();
+			return;
+		}
+
+		// Queued on the slot of the last frame that could have used it, that slot's
+		// fence is waited before its deletions run
+		const uint32_t slot = s_Device.FrameActive ? s_Device.FrameIndex : (s_Device.FrameIndex + FramesInFlight - 1) % FramesInFlight;
+		s_Device.Frames[slot].Deletions.push_back(std::move(destroy));
+	}
+
+	VulkanTransientAllocation VulkanDevice::AllocateTransient(const VkDeviceSize size, const VkDeviceSize alignment)
+	{
+		BeginFrame();
+
+		FrameData& frame = s_Device.Frames[s_Device.FrameIndex];
+
+		VkDeviceSize offset = frame.TransientOffset.load();
+		VkDeviceSize aligned;
+		do
+		{
+			aligned = (offset + alignment - 1) / alignment * alignment;
+			if (aligned + size > TransientBufferSize)
+			{
+				LU_CORE_ERROR("Vulkan transient buffer is full ({0} bytes per frame)", TransientBufferSize);
+				return {};
+			}
+		}
+		while (!frame.TransientOffset.compare_exchange_weak(offset, aligned + size));
+
+		VulkanTransientAllocation allocation;
+		allocation.Buffer = frame.TransientBuffer.Buffer;
+		allocation.Offset = aligned;
+		allocation.Mapped = static_cast<uint8_t*>(frame.TransientBuffer.Mapped) + aligned;
+		return allocation;
+	}
+
+	VkDescriptorSet VulkanDevice::AllocateDescriptorSet()
+	{
+		BeginFrame();
+
+		VkDescriptorSetAllocateInfo allocateInfo{};
+		allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocateInfo.descriptorPool = s_Device.Frames[s_Device.FrameIndex].DescriptorPool;
+		allocateInfo.descriptorSetCount = 1;
+		allocateInfo.pSetLayouts = &s_Device.DescriptorSetLayout;
+
+		VkDescriptorSet set = VK_NULL_HANDLE;
+
+		std::lock_guard lock(s_Device.DescriptorMutex);
+		if (vkAllocateDescriptorSets(s_Device.Device, &allocateInfo, &set) != VK_SUCCESS)
+		{
+			LU_CORE_ERROR("Vulkan descriptor pool is exhausted, draw skipped");
+			return VK_NULL_HANDLE;
+		}
+
+		return set;
+	}
+
+	VulkanBufferAllocation VulkanDevice::CreateBuffer(const VkDeviceSize size, const VkBufferUsageFlags usage, const VkMemoryPropertyFlags properties)
+	{
+		VulkanBufferAllocation allocation;
+		allocation.Size = size;
+
+		VkBufferCreateInfo bufferInfo{};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = std::max<VkDeviceSize>(size, 1);
+		bufferInfo.usage = usage;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		LU_VK_CHECK(vkCreateBuffer(s_Device.Device, &bufferInfo, nullptr, &allocation.Buffer));
+
+		VkMemoryRequirements requirements;
+		vkGetBufferMemoryRequirements(s_Device.Device, allocation.Buffer, &requirements);
+
+		VkMemoryAllocateInfo allocateInfo{};
+		allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocateInfo.allocationSize = requirements.size;
+		allocateInfo.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits, properties);
+		LU_VK_CHECK(vkAllocateMemory(s_Device.Device, &allocateInfo, nullptr, &allocation.Memory));
+		LU_VK_CHECK(vkBindBufferMemory(s_Device.Device, allocation.Buffer, allocation.Memory, 0));
+
+		if (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+			LU_VK_CHECK(vkMapMemory(s_Device.Device, allocation.Memory, 0, VK_WHOLE_SIZE, 0, &allocation.Mapped));
+
+		return allocation;
+	}
+
+	void VulkanDevice::DestroyBuffer(const VulkanBufferAllocation& buffer)
+	{
+		if (!s_Device.Device)
+			return;
+
+		vkDestroyBuffer(s_Device.Device, buffer.Buffer, nullptr);
+		vkFreeMemory(s_Device.Device, buffer.Memory, nullptr);
+	}
+
+	VulkanImageAllocation VulkanDevice::CreateImage(const VkImageCreateInfo& createInfo, const VkMemoryPropertyFlags properties)
+	{
+		VulkanImageAllocation allocation;
+		LU_VK_CHECK(vkCreateImage(s_Device.Device, &createInfo, nullptr, &allocation.Image));
+
+		VkMemoryRequirements requirements;
+		vkGetImageMemoryRequirements(s_Device.Device, allocation.Image, &requirements);
+
+		VkMemoryAllocateInfo allocateInfo{};
+		allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocateInfo.allocationSize = requirements.size;
+		allocateInfo.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits, properties);
+		LU_VK_CHECK(vkAllocateMemory(s_Device.Device, &allocateInfo, nullptr, &allocation.Memory));
+		LU_VK_CHECK(vkBindImageMemory(s_Device.Device, allocation.Image, allocation.Memory, 0));
+
+		return allocation;
+	}
+
+	void VulkanDevice::DestroyImage(const VulkanImageAllocation& image)
+	{
+		if (!s_Device.Device)
+			return;
+
+		vkDestroyImage(s_Device.Device, image.Image, nullptr);
+		vkFreeMemory(s_Device.Device, image.Memory, nullptr);
+	}
+
+	uint32_t VulkanDevice::FindMemoryType(const uint32_t typeBits, const VkMemoryPropertyFlags properties)
+	{
+		for (uint32_t i = 0; i < s_Device.MemoryProperties.memoryTypeCount; i++)
+		{
+			if ((typeBits & (1u << i)) && (s_Device.MemoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+				return i;
+		}
+
+		LU_CORE_ERROR("No Vulkan memory type with properties {0}", properties);
+		return 0;
+	}
+
+	static VkFilter FilterToVulkan(const TextureFilter filter)
+	{
+		return filter == TextureFilter::Linear ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+	}
+
+	static VkSamplerAddressMode WrapToVulkan(const TextureWrap wrap)
+	{
+		switch (wrap)
+		{
+		case TextureWrap::Repeat:			return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+		case TextureWrap::MirroredRepeat:	return VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+		case TextureWrap::ClampToEdge:		return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		}
+
+		return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	}
+
+	VkSampler VulkanDevice::GetSampler(const TextureSpecification& specification)
+	{
+		const float maxAnisotropy = s_Device.SamplerAnisotropy
+			? std::clamp(specification.MaxAnisotropy, 1.0f, s_Device.Properties.limits.maxSamplerAnisotropy) : 1.0f;
+
+		// Same packing as OpenGLSampler
+		const uint64_t key = static_cast<uint64_t>(specification.MinFilter)
+			| static_cast<uint64_t>(specification.MagFilter) << 4
+			| static_cast<uint64_t>(specification.MipFilter) << 8
+			| static_cast<uint64_t>(specification.Wrap) << 12
+			| static_cast<uint64_t>(maxAnisotropy * 16.0f) << 16;
+
+		std::lock_guard lock(s_Device.SamplerMutex);
+		if (const auto it = s_Device.Samplers.find(key); it != s_Device.Samplers.end())
+			return it->second;
+
+		const VkSamplerAddressMode addressMode = WrapToVulkan(specification.Wrap);
+
+		VkSamplerCreateInfo samplerInfo{};
+		samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerInfo.magFilter = FilterToVulkan(specification.MagFilter);
+		samplerInfo.minFilter = FilterToVulkan(specification.MinFilter);
+		samplerInfo.mipmapMode = specification.MipFilter == TextureFilter::Linear ? VK_SAMPLER_MIPMAP_MODE_LINEAR : VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		samplerInfo.addressModeU = addressMode;
+		samplerInfo.addressModeV = addressMode;
+		samplerInfo.addressModeW = addressMode;
+		samplerInfo.anisotropyEnable = maxAnisotropy > 1.0f;
+		samplerInfo.maxAnisotropy = maxAnisotropy;
+		samplerInfo.maxLod = specification.MipFilter == TextureFilter::None ? 0.0f : VK_LOD_CLAMP_NONE;
+
+		VkSampler sampler;
+		LU_VK_CHECK(vkCreateSampler(s_Device.Device, &samplerInfo, nullptr, &sampler));
+
+		s_Device.Samplers[key] = sampler;
+		return sampler;
+	}
+
+	VkImageView VulkanDevice::GetDefaultImageView()
+	{
+		return s_Device.DefaultImageView;
+	}
+
+	ThreadPool& VulkanDevice::GetRecordingPool()
+	{
+		LU_CORE_ASSERT(s_Device.RecordingPool, "Vulkan device is not initialized!");
+		return *s_Device.RecordingPool;
+	}
+
+	void VulkanDevice::BeginDebugLabel(VkCommandBuffer commandBuffer, const char* name)
+	{
+		if (!s_Device.CmdBeginDebugUtilsLabel)
+			return;
+
+		VkDebugUtilsLabelEXT label{};
+		label.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+		label.pLabelName = name;
+		s_Device.CmdBeginDebugUtilsLabel(commandBuffer, &label);
+	}
+
+	void VulkanDevice::EndDebugLabel(VkCommandBuffer commandBuffer)
+	{
+		if (s_Device.CmdEndDebugUtilsLabel)
+			s_Device.CmdEndDebugUtilsLabel(commandBuffer);
+	}
+
+	uint32_t VulkanDevice::AllocateID()
+	{
+		return s_Device.NextID++;
+	}
+
+}
@@ -0,0 +1,156 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanFrameBuffer.hpp"
+
+namespace Lunaria {
+
+	static constexpr uint32_t s_MaxFramebufferSize = 8192;
+
+	VulkanFrameBuffer::VulkanFrameBuffer(const FrameBufferSpecification& specification)
+		: m_RendererID(VulkanDevice::AllocateID()), m_Specification(specification), m_RenderSize(specification.Width, specification.Height)
+	{
+		Invalidate();
+	}
+
+	VulkanFrameBuffer::~VulkanFrameBuffer()
+	{
+		if (VulkanCommandStream::GetState().Target == &m_Target)
+			VulkanCommandStream::BindTarget(nullptr);
+
+		Release();
+	}
+
+	void VulkanFrameBuffer::Release()
+	{
+		if (!m_Target.Framebuffer)
+			return;
+
+		// Draws recorded this frame may still use the old attachments
+		VulkanDevice::DeferDestroy([color = m_Color, depth = m_Depth, colorView = m_ColorView, depthView = m_DepthView, framebuffer = m_Target.Framebuffer]()
+		{
+			VkDevice device = VulkanDevice::GetDevice();
+			vkDestroyFramebuffer(device, framebuffer, nullptr);
+			vkDestroyImageView(device, colorView, nullptr);
+			vkDestroyImageView(device, depthView, nullptr);
+			VulkanDevice::DestroyImage(color);
+			VulkanDevice::DestroyImage(depth);
+		});
+
+		m_Target.Framebuffer = VK_NULL_HANDLE;
+	}
+
+	void VulkanFrameBuffer::Invalidate()
+	{
+		// A pass open on this target uses the attachments about to be replaced
+		if (VulkanCommandStream::GetState().Target == &m_Target)
+			VulkanCommandStream::EndRenderPass();
+
+		Release();
+
+		VkDevice device = VulkanDevice::GetDevice();
+
+		VkImageCreateInfo imageInfo{};
+		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageInfo.extent = { m_Specification.Width, m_Specification.Height, 1 };
+		imageInfo.mipLevels = 1;
+		imageInfo.arrayLayers = 1;
+		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+
+		imageInfo.format = VulkanDevice::OffscreenColorFormat;
+		imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+		m_Color = VulkanDevice::CreateImage(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		imageInfo.format = VulkanDevice::DepthFormat;
+		imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+		m_Depth = VulkanDevice::CreateImage(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+
+		viewInfo.image = m_Color.Image;
+		viewInfo.format = VulkanDevice::OffscreenColorFormat;
+		viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+		LU_VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &m_ColorView));
+
+		viewInfo.image = m_Depth.Image;
+		viewInfo.format = VulkanDevice::DepthFormat;
+		viewInfo.subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+		LU_VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &m_DepthView));
+
+		const VkImageView views[] = { m_ColorView, m_DepthView };
+
+		VkFramebufferCreateInfo framebufferInfo{};
+		framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebufferInfo.renderPass = VulkanDevice::GetOffscreenRenderPass();
+		framebufferInfo.attachmentCount = 2;
+		framebufferInfo.pAttachments = views;
+		framebufferInfo.width = m_Specification.Width;
+		framebufferInfo.height = m_Specification.Height;
+		framebufferInfo.layers = 1;
+		LU_VK_CHECK(vkCreateFramebuffer(device, &framebufferInfo, nullptr, &m_Target.Framebuffer));
+
+		m_Target.FirstPass = VulkanDevice::GetOffscreenRenderPass();
+		m_Target.LoadPass = VulkanDevice::GetOffscreenRenderPass();
+		m_Target.Extent = { m_Specification.Width, m_Specification.Height };
+
+		// Into the layouts the render pass expects, the contents start out undefined as in GL
+		VulkanDevice::ImmediateSubmit([this](VkCommandBuffer commandBuffer)
+		{
+			VkImageMemoryBarrier barriers[2]{};
+			for (VkImageMemoryBarrier& barrier : barriers)
+			{
+				barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			}
+
+			barriers[0].image = m_Color.Image;
+			barriers[0].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+			barriers[0].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+			barriers[1].image = m_Depth.Image;
+			barriers[1].subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+			barriers[1].newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+				0, 0, nullptr, 0, nullptr, 2, barriers);
+		});
+	}
+
+	void VulkanFrameBuffer::Bind()
+	{
+		VulkanCommandStream::BindTarget(&m_Target);
+		VulkanCommandStream::SetViewport(0, 0, m_RenderSize.x, m_RenderSize.y);
+	}
+
+	void VulkanFrameBuffer::Unbind()
+	{
+		VulkanCommandStream::BindTarget(nullptr);
+	}
+
+	void VulkanFrameBuffer::Resize(const uint32_t width, const uint32_t height)
+	{
+		if (width == 0 || height == 0 || width > s_MaxFramebufferSize || height > s_MaxFramebufferSize)
+			return;
+
+		// Callers resize every frame, recreating would defer destroy the attachments each time
+		if (width == m_Specification.Width && height == m_Specification.Height)
+			return;
+
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+		m_RenderSize = { width, height };
+
+		Invalidate();
+	}
+
+	void VulkanFrameBuffer::SetRenderSize(const uint32_t width, const uint32_t height)
+	{
+		m_RenderSize = glm::clamp(glm::uvec2(width, height), glm::uvec2(1), glm::uvec2(m_Specification.Width, m_Specification.Height));
+	}
+
+}
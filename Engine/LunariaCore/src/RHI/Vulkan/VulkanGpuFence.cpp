@@ -0,0 +1,33 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanGpuFence.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanDevice.hpp"
+
+#include <chrono>
+
+namespace Lunaria {
+
+	void VulkanGpuFence::Signal()
+	{
+		m_Frame = VulkanDevice::GetFrameNumber();
+	}
+
+	bool VulkanGpuFence::IsSignaled() const
+	{
+		return m_Frame == NoFrame || VulkanDevice::WaitForFrame(m_Frame, 0);
+	}
+
+	bool VulkanGpuFence::Wait(uint64_t timeoutNanoseconds)
+	{
+		m_LastWaitMilliseconds = 0.0f;
+		if (m_Frame == NoFrame || VulkanDevice::WaitForFrame(m_Frame, 0))
+			return true;
+
+		const auto start = std::chrono::steady_clock::now();
+		const bool signaled = VulkanDevice::WaitForFrame(m_Frame, timeoutNanoseconds);
+		m_LastWaitMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		return signaled;
+	}
+
+}
@@ -0,0 +1,104 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanRendererAPI.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanCommandStream.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanSwapchain.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanShader.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanVertexArray.hpp"
+
+namespace Lunaria {
+
+	void VulkanRendererAPI::Init()
+	{
+		// Blending and depth testing are baked into every pipeline (see VulkanShader::GetPipeline)
+		LU_CORE_INFO("Vulkan renderer backend, {0} recording threads", VulkanDevice::GetRecordingPool().GetWorkerCount() + 1);
+	}
+
+	void VulkanRendererAPI::SetViewport(const int x, const int y, const uint32_t width, const uint32_t height)
+	{
+		auto& state = VulkanCommandStream::GetState();
+
+		if (state.ViewportX == x && state.ViewportY == y && state.ViewportWidth == width && state.ViewportHeight == height)
+		{
+			m_Stats.SkippedCalls++;
+			return;
+		}
+
+		m_Stats.IssuedCalls++;
+		VulkanCommandStream::SetViewport(x, y, width, height);
+
+		// Called on window resize, the swapchain follows the window size
+		VulkanSwapchain& swapchain = VulkanDevice::GetSwapchain();
+		const VkExtent2D extent = swapchain.GetExtent();
+		if (!state.Target && (extent.width != static_cast<uint32_t>(x) + width || extent.height != static_cast<uint32_t>(y) + height))
+			swapchain.Invalidate();
+	}
+
+	void VulkanRendererAPI::SetClearColor(const glm::vec4& color)
+	{
+		VulkanCommandStream::GetState().ClearColor = color;
+	}
+
+	void VulkanRendererAPI::Clear()
+	{
+		VkCommandBuffer commandBuffer = VulkanCommandStream::GetRenderPassCommandBuffer();
+		if (!commandBuffer)
+			return;
+
+		const auto& state = VulkanCommandStream::GetState();
+		const VkExtent2D extent = state.Target ? state.Target->Extent : VulkanDevice::GetSwapchain().GetExtent();
+
+		// Like glClear the whole target is cleared, the viewport does not apply
+		VkClearAttachment attachments[2]{};
+		attachments[0].aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		attachments[0].colorAttachment = 0;
+		attachments[0].clearValue.color = { { state.ClearColor.r, state.ClearColor.g, state.ClearColor.b, state.ClearColor.a } };
+		attachments[1].aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+		attachments[1].clearValue.depthStencil = { 1.0f, 0 };
+
+		VkClearRect rect{};
+		rect.rect.extent = extent;
+		rect.layerCount = 1;
+
+		vkCmdClearAttachments(commandBuffer, 2, attachments, 1, &rect);
+	}
+
+	void VulkanRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, const uint32_t indexCount, const uint32_t instanceCount)
+	{
+		const auto& state = VulkanCommandStream::GetState();
+		if (!state.Shader)
+			return; // Nothing bound, GL would draw with program 0
+
+		VkCommandBuffer commandBuffer = VulkanCommandStream::GetRenderPassCommandBuffer();
+		if (!commandBuffer)
+			return;
+
+		VulkanCommandStream::RecordDrawIndexed(commandBuffer, *state.Shader, state.Shader->GetUniformData(), state.Textures,
+			static_cast<const VulkanVertexArray&>(*vertexArray), indexCount, instanceCount);
+	}
+
+	void VulkanRendererAPI::Dispatch(const uint32_t /*groupsX*/, const uint32_t /*groupsY*/, const uint32_t /*groupsZ*/)
+	{
+		// Shaders are only translated into graphics pipelines
+		static bool warned = false;
+		if (!warned)
+			LU_CORE_WARN("Compute dispatches are not supported by the Vulkan renderer yet");
+		warned = true;
+	}
+
+	void VulkanRendererAPI::Barrier(const uint32_t /*flags*/)
+	{
+		// Storage buffers are host coherent and never written by the GPU
+	}
+
+	void VulkanRendererAPI::PushDebugGroup(const char* name)
+	{
+		VulkanCommandStream::PushDebugGroup(name);
+	}
+
+	void VulkanRendererAPI::PopDebugGroup()
+	{
+		VulkanCommandStream::PopDebugGroup();
+	}
+
+}
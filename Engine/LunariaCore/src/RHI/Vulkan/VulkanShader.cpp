@@ -0,0 +1,379 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanShader.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanCommandStream.hpp"
+
+#include <spirv_cross/spirv_cross.hpp>
+
+#include <cstring>
+#include <fstream>
+
+namespace Lunaria {
+
+	static constexpr uint32_t SpirvMagic = 0x07230203;
+
+	static std::vector<uint32_t> ReadSpirv(const std::string& path)
+	{
+		std::ifstream in(path, std::ios::in | std::ios::binary);
+		if (!in)
+		{
+			LU_CORE_ERROR("Could not open file '{0}'", path);
+			return {};
+		}
+
+		in.seekg(0, std::ios::end);
+		const auto size = static_cast<size_t>(in.tellg());
+		in.seekg(0, std::ios::beg);
+
+		std::vector<uint32_t> words(size / sizeof(uint32_t));
+		in.read(reinterpret_cast<char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+
+		if (size % sizeof(uint32_t) != 0 || words.empty() || words[0] != SpirvMagic)
+		{
+			LU_CORE_ERROR("'{0}' is not a SPIR-V binary", path);
+			return {};
+		}
+
+		return words;
+	}
+
+	static VkShaderModule CreateModule(const std::vector<uint32_t>& spirv)
+	{
+		if (spirv.empty())
+			return VK_NULL_HANDLE;
+
+		VkShaderModuleCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		createInfo.codeSize = spirv.size() * sizeof(uint32_t);
+		createInfo.pCode = spirv.data();
+
+		VkShaderModule module = VK_NULL_HANDLE;
+		LU_VK_CHECK(vkCreateShaderModule(VulkanDevice::GetDevice(), &createInfo, nullptr, &module));
+		return module;
+	}
+
+	static VkFormat ShaderDataTypeToVulkanFormat(const ShaderDataType type)
+	{
+		switch (type)
+		{
+		case ShaderDataType::Float:		return VK_FORMAT_R32_SFLOAT;
+		case ShaderDataType::Float2:	return VK_FORMAT_R32G32_SFLOAT;
+		case ShaderDataType::Float3:	return VK_FORMAT_R32G32B32_SFLOAT;
+		case ShaderDataType::Float4:	return VK_FORMAT_R32G32B32A32_SFLOAT;
+		case ShaderDataType::Mat3:		return VK_FORMAT_R32G32B32_SFLOAT;
+		case ShaderDataType::Mat4:		return VK_FORMAT_R32G32B32A32_SFLOAT;
+		case ShaderDataType::Int:		return VK_FORMAT_R32_SINT;
+		case ShaderDataType::Int2:		return VK_FORMAT_R32G32_SINT;
+		case ShaderDataType::Int3:		return VK_FORMAT_R32G32B32_SINT;
+		case ShaderDataType::Int4:		return VK_FORMAT_R32G32B32A32_SINT;
+		case ShaderDataType::Bool:		return VK_FORMAT_R8_UINT;
+		case ShaderDataType::None:		return VK_FORMAT_UNDEFINED;
+		}
+
+		LU_CORE_ASSERT(false, "Unknown ShaderDataType!");
+		return VK_FORMAT_UNDEFINED;
+	}
+
+	VulkanShader::VulkanShader(const std::string& filepath)
+	{
+		// Extract shader name and directory from filepath
+		auto lastSlash = filepath.find_last_of("/\\");
+		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+		const auto lastDot = filepath.rfind('.');
+		const auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
+		m_Name = filepath.substr(lastSlash, count);
+
+		const std::string basePath = filepath.substr(0, lastSlash) + "Vulkan/" + m_Name;
+		const std::vector<uint32_t> vertexSpirv = ReadSpirv(basePath + ".vert.spv");
+		const std::vector<uint32_t> fragmentSpirv = ReadSpirv(basePath + ".frag.spv");
+
+		if (Reflect(vertexSpirv) && Reflect(fragmentSpirv))
+		{
+			m_VertexModule = CreateModule(vertexSpirv);
+			m_FragmentModule = CreateModule(fragmentSpirv);
+		}
+
+		if (IsValid())
+			LU_CORE_INFO("Shader '{0}' successfully loaded!", m_Name);
+		else
+			LU_CORE_ERROR("Shader '{0}' failed to load!", m_Name);
+	}
+
+	VulkanShader::VulkanShader(const std::string& name, const std::string& /*vertexSrc*/, const std::string& /*fragmentSrc*/)
+		: m_Name(name)
+	{
+		LU_CORE_ERROR("Shader '{0}' failed to load! The Vulkan backend only loads precompiled SPIR-V, use Shader::Create(filepath)", m_Name);
+	}
+
+	VulkanShader::~VulkanShader()
+	{
+		auto& state = VulkanCommandStream::GetState();
+		if (state.Shader == this)
+			state.Shader = nullptr;
+
+		std::vector<VkPipeline> pipelines;
+		for (const auto& [key, pipeline] : m_Pipelines)
+			pipelines.push_back(pipeline);
+
+		VulkanDevice::DeferDestroy([vertexModule = m_VertexModule, fragmentModule = m_FragmentModule, pipelines = std::move(pipelines)]()
+		{
+			VkDevice device = VulkanDevice::GetDevice();
+			for (VkPipeline pipeline : pipelines)
+				vkDestroyPipeline(device, pipeline, nullptr);
+
+			vkDestroyShaderModule(device, vertexModule, nullptr);
+			vkDestroyShaderModule(device, fragmentModule, nullptr);
+		});
+	}
+
+	bool VulkanShader::Reflect(const std::vector<uint32_t>& spirv)
+	{
+		if (spirv.empty())
+			return false;
+
+		// spirv_cross reports malformed binaries with exceptions
+		try
+		{
+			const spirv_cross::Compiler compiler(spirv);
+			const spirv_cross::ShaderResources resources = compiler.get_shader_resources();
+
+			for (const spirv_cross::Resource& resource : resources.uniform_buffers)
+			{
+				if (compiler.get_decoration(resource.id, spv::DecorationDescriptorSet) != 0
+					|| compiler.get_decoration(resource.id, spv::DecorationBinding) != VulkanDevice::UniformBinding)
+					continue;
+
+				const spirv_cross::SPIRType& type = compiler.get_type(resource.base_type_id);
+
+				const size_t blockSize = compiler.get_declared_struct_size(type);
+				if (blockSize > m_UniformData.size())
+					m_UniformData.resize(blockSize, 0);
+
+				for (uint32_t i = 0; i < static_cast<uint32_t>(type.member_types.size()); i++)
+				{
+					UniformMember member;
+					member.Offset = compiler.type_struct_member_offset(type, i);
+					member.Size = static_cast<uint32_t>(compiler.get_declared_struct_member_size(type, i));
+
+					if (!compiler.get_type(type.member_types[i]).array.empty())
+						member.ArrayStride = compiler.type_struct_member_array_stride(type, i);
+
+					m_UniformMembers[compiler.get_member_name(resource.base_type_id, i)] = member;
+				}
+			}
+		}
+		catch (const std::exception& e)
+		{
+			LU_CORE_ERROR("Shader '{0}' reflection failed: {1}", m_Name, e.what());
+			return false;
+		}
+
+		return true;
+	}
+
+	void VulkanShader::Bind() const
+	{
+		VulkanCommandStream::GetState().Shader = this;
+	}
+
+	void VulkanShader::Unbind() const
+	{
+		VulkanCommandStream::GetState().Shader = nullptr;
+	}
+
+	void VulkanShader::WriteUniform(const std::string& name, const void* data, const uint32_t size) const
+	{
+		const auto it = m_UniformMembers.find(name);
+		if (it == m_UniformMembers.end())
+			return; // Like a GL uniform location of -1
+
+		const UniformMember& member = it->second;
+		std::memcpy(m_UniformData.data() + member.Offset, data, std::min(size, member.Size));
+	}
+
+	void VulkanShader::SetMat4(const std::string& name, const glm::mat4& value) const
+	{
+		WriteUniform(name, &value, sizeof(value));
+	}
+
+	void VulkanShader::SetFloat3(const std::string& name, const glm::vec3& value) const
+	{
+		WriteUniform(name, &value, sizeof(value));
+	}
+
+	void VulkanShader::SetFloat4(const std::string& name, const glm::vec4& value) const
+	{
+		WriteUniform(name, &value, sizeof(value));
+	}
+
+	void VulkanShader::SetFloat(const std::string& name, const float value) const
+	{
+		WriteUniform(name, &value, sizeof(value));
+	}
+
+	void VulkanShader::SetInt(const std::string& name, const int value) const
+	{
+		WriteUniform(name, &value, sizeof(value));
+	}
+
+	void VulkanShader::SetIntArray(const std::string& name, int* values, const uint32_t count) const
+	{
+		// Sampler arrays are not block members, texture units map to TextureBinding array elements
+		const auto it = m_UniformMembers.find(name);
+		if (it == m_UniformMembers.end() || it->second.ArrayStride == 0)
+			return;
+
+		const UniformMember& member = it->second;
+		const uint32_t elementCount = std::min(count, member.Size / member.ArrayStride);
+
+		for (uint32_t i = 0; i < elementCount; i++)
+			std::memcpy(m_UniformData.data() + member.Offset + i * member.ArrayStride, &values[i], sizeof(int));
+	}
+
+	static uint64_t HashPipelineKey(VkRenderPass renderPass, const BufferLayout& layout)
+	{
+		// FNV-1a over the render pass and the attribute formats
+		uint64_t hash = 14695981039346656037ull;
+		const auto mix = [&hash](const uint64_t value)
+		{
+			hash ^= value;
+			hash *= 1099511628211ull;
+		};
+
+		mix(reinterpret_cast<uint64_t>(renderPass));
+		mix(static_cast<uint64_t>(layout.GetStride()));
+		mix(static_cast<uint64_t>(layout.GetStepRate()));
+		for (const BufferElement& element : layout)
+		{
+			mix(static_cast<uint64_t>(element.Type));
+			mix(static_cast<uint64_t>(element.Offset));
+		}
+
+		return hash;
+	}
+
+	VkPipeline VulkanShader::GetPipeline(VkRenderPass renderPass, const BufferLayout& layout) const
+	{
+		if (!IsValid())
+			return VK_NULL_HANDLE;
+
+		const uint64_t key = HashPipelineKey(renderPass, layout);
+
+		std::lock_guard lock(m_PipelineMutex);
+		if (const auto it = m_Pipelines.find(key); it != m_Pipelines.end())
+			return it->second;
+
+		// One interleaved binding, matrices take one location per column like in GL
+		VkVertexInputBindingDescription binding{};
+		binding.binding = 0;
+		binding.stride = static_cast<uint32_t>(layout.GetStride());
+		binding.inputRate = layout.IsPerInstance() ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX;
+
+		// Step rates above 1 need VK_EXT_vertex_attribute_divisor, which the device doesn't enable
+		if (layout.GetStepRate() > 1)
+			LU_CORE_WARN("Vulkan: vertex step rate {0} is not supported, stepping every instance", layout.GetStepRate());
+
+		std::vector<VkVertexInputAttributeDescription> attributes;
+		for (const BufferElement& element : layout)
+		{
+			const bool matrix = element.Type == ShaderDataType::Mat3 || element.Type == ShaderDataType::Mat4;
+			const uint32_t columns = matrix ? element.GetComponentCount() : 1;
+
+			for (uint32_t column = 0; column < columns; column++)
+			{
+				VkVertexInputAttributeDescription attribute{};
+				attribute.location = static_cast<uint32_t>(attributes.size());
+				attribute.binding = 0;
+				attribute.format = ShaderDataTypeToVulkanFormat(element.Type);
+				attribute.offset = static_cast<uint32_t>(element.Offset + column * element.GetComponentCount() * sizeof(float));
+				attributes.push_back(attribute);
+			}
+		}
+
+		VkPipelineVertexInputStateCreateInfo vertexInput{};
+		vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+		vertexInput.vertexBindingDescriptionCount = 1;
+		vertexInput.pVertexBindingDescriptions = &binding;
+		vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
+		vertexInput.pVertexAttributeDescriptions = attributes.data();
+
+		VkPipelineShaderStageCreateInfo stages[2]{};
+		stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+		stages[0].module = m_VertexModule;
+		stages[0].pName = "main";
+		stages[1] = stages[0];
+		stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+		stages[1].module = m_FragmentModule;
+
+		VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+		inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+		inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+		VkPipelineViewportStateCreateInfo viewportState{};
+		viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+		viewportState.viewportCount = 1;
+		viewportState.scissorCount = 1;
+
+		VkPipelineRasterizationStateCreateInfo rasterization{};
+		rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+		rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterization.cullMode = VK_CULL_MODE_NONE;
+		rasterization.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+		rasterization.lineWidth = 1.0f;
+
+		VkPipelineMultisampleStateCreateInfo multisample{};
+		multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+		multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		// Same fixed function state OpenGLRendererAPI::Init enables
+		VkPipelineDepthStencilStateCreateInfo depthStencil{};
+		depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+		depthStencil.depthTestEnable = VK_TRUE;
+		depthStencil.depthWriteEnable = VK_TRUE;
+		depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+
+		VkPipelineColorBlendAttachmentState blendAttachment{};
+		blendAttachment.blendEnable = VK_TRUE;
+		blendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+		blendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+		blendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+		blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+		blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+		blendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+		blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+		VkPipelineColorBlendStateCreateInfo colorBlend{};
+		colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+		colorBlend.attachmentCount = 1;
+		colorBlend.pAttachments = &blendAttachment;
+
+		const VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+		VkPipelineDynamicStateCreateInfo dynamicState{};
+		dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+		dynamicState.dynamicStateCount = 2;
+		dynamicState.pDynamicStates = dynamicStates;
+
+		VkGraphicsPipelineCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		createInfo.stageCount = 2;
+		createInfo.pStages = stages;
+		createInfo.pVertexInputState = &vertexInput;
+		createInfo.pInputAssemblyState = &inputAssembly;
+		createInfo.pViewportState = &viewportState;
+		createInfo.pRasterizationState = &rasterization;
+		createInfo.pMultisampleState = &multisample;
+		createInfo.pDepthStencilState = &depthStencil;
+		createInfo.pColorBlendState = &colorBlend;
+		createInfo.pDynamicState = &dynamicState;
+		createInfo.layout = VulkanDevice::GetPipelineLayout();
+		createInfo.renderPass = renderPass;
+
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		LU_VK_CHECK(vkCreateGraphicsPipelines(VulkanDevice::GetDevice(), VK_NULL_HANDLE, 1, &createInfo, nullptr, &pipeline));
+
+		m_Pipelines[key] = pipeline;
+		return pipeline;
+	}
+
+}
@@ -0,0 +1,286 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanSwapchain.hpp"
+
+#include <SDL/SDL_vulkan.h>
+
+namespace Lunaria {
+
+	static VkSurfaceFormatKHR ChooseSurfaceFormat(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface)
+	{
+		uint32_t count = 0;
+		vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &count, nullptr);
+		std::vector<VkSurfaceFormatKHR> formats(count);
+		vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &count, formats.data());
+
+		// UNORM like the default framebuffer of the OpenGL backend, shaders write display values
+		for (const VkSurfaceFormatKHR& format : formats)
+		{
+			if ((format.format == VK_FORMAT_B8G8R8A8_UNORM || format.format == VK_FORMAT_R8G8B8A8_UNORM)
+				&& format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR)
+				return format;
+		}
+
+		return formats.empty() ? VkSurfaceFormatKHR{ VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR } : formats[0];
+	}
+
+	VulkanSwapchain::VulkanSwapchain(SDL_Window* window, VkSurfaceKHR surface)
+		: m_Window(window), m_Surface(surface)
+	{
+		m_Format = ChooseSurfaceFormat(VulkanDevice::GetPhysicalDevice(), m_Surface).format;
+
+		CreateRenderPasses();
+		Create();
+	}
+
+	VulkanSwapchain::~VulkanSwapchain()
+	{
+		Destroy();
+
+		VkDevice device = VulkanDevice::GetDevice();
+		vkDestroyRenderPass(device, m_FirstPass, nullptr);
+		vkDestroyRenderPass(device, m_LoadPass, nullptr);
+	}
+
+	void VulkanSwapchain::CreateRenderPasses()
+	{
+		VkAttachmentDescription attachments[2]{};
+		attachments[0].format = m_Format;
+		attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
+		attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+		attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+		attachments[1] = attachments[0];
+		attachments[1].format = VulkanDevice::DepthFormat;
+		attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+		const VkAttachmentReference colorReference{ 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+		const VkAttachmentReference depthReference{ 1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+
+		VkSubpassDescription subpass{};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = 1;
+		subpass.pColorAttachments = &colorReference;
+		subpass.pDepthStencilAttachment = &depthReference;
+
+		// Waits for the acquire semaphore (color output stage) and the previous pass on the depth buffer
+		VkSubpassDependency dependency{};
+		dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+		dependency.dstSubpass = 0;
+		dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+		dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+			| VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+		VkRenderPassCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		createInfo.attachmentCount = 2;
+		createInfo.pAttachments = attachments;
+		createInfo.subpassCount = 1;
+		createInfo.pSubpasses = &subpass;
+		createInfo.dependencyCount = 1;
+		createInfo.pDependencies = &dependency;
+
+		VkDevice device = VulkanDevice::GetDevice();
+
+		// First pass of the frame, nothing of the previous frame survives
+		attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+		attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		LU_VK_CHECK(vkCreateRenderPass(device, &createInfo, nullptr, &m_FirstPass));
+
+		// Later passes continue where the previous one stopped
+		attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+		attachments[0].initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+		attachments[1].initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		LU_VK_CHECK(vkCreateRenderPass(device, &createInfo, nullptr, &m_LoadPass));
+	}
+
+	void VulkanSwapchain::Create()
+	{
+		VkPhysicalDevice physicalDevice = VulkanDevice::GetPhysicalDevice();
+		VkDevice device = VulkanDevice::GetDevice();
+
+		VkSurfaceCapabilitiesKHR capabilities;
+		LU_VK_CHECK(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, m_Surface, &capabilities));
+
+		int width, height;
+		SDL_Vulkan_GetDrawableSize(m_Window, &width, &height);
+
+		if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max())
+			m_Extent = capabilities.currentExtent;
+		else
+			m_Extent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+
+		m_Invalid = false;
+
+		if (m_Extent.width == 0 || m_Extent.height == 0)
+			return; // Minimized, created again once the window has a size
+
+		uint32_t imageCount = capabilities.minImageCount + 1;
+		if (capabilities.maxImageCount > 0)
+			imageCount = std::min(imageCount, capabilities.maxImageCount);
+
+		VkSwapchainCreateInfoKHR createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+		createInfo.surface = m_Surface;
+		createInfo.minImageCount = imageCount;
+		createInfo.imageFormat = m_Format;
+		createInfo.imageColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+		createInfo.imageExtent = m_Extent;
+		createInfo.imageArrayLayers = 1;
+		createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		createInfo.preTransform = capabilities.currentTransform;
+		createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+		createInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR; // Always supported, VSync like the OpenGL context
+		createInfo.clipped = VK_TRUE;
+
+		LU_VK_CHECK(vkCreateSwapchainKHR(device, &createInfo, nullptr, &m_Swapchain));
+
+		vkGetSwapchainImagesKHR(device, m_Swapchain, &imageCount, nullptr);
+		m_Images.resize(imageCount);
+		vkGetSwapchainImagesKHR(device, m_Swapchain, &imageCount, m_Images.data());
+
+		VkImageCreateInfo depthInfo{};
+		depthInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		depthInfo.imageType = VK_IMAGE_TYPE_2D;
+		depthInfo.format = VulkanDevice::DepthFormat;
+		depthInfo.extent = { m_Extent.width, m_Extent.height, 1 };
+		depthInfo.mipLevels = 1;
+		depthInfo.arrayLayers = 1;
+		depthInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		depthInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		depthInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+
+		m_DepthImage = VulkanDevice::CreateImage(depthInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.image = m_DepthImage.Image;
+		viewInfo.format = VulkanDevice::DepthFormat;
+		viewInfo.subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+		LU_VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &m_DepthView));
+
+		m_ImageViews.resize(imageCount);
+		m_Targets.resize(imageCount);
+		m_RenderFinished.resize(imageCount);
+
+		for (uint32_t i = 0; i < imageCount; i++)
+		{
+			viewInfo.image = m_Images[i];
+			viewInfo.format = m_Format;
+			viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			LU_VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &m_ImageViews[i]));
+
+			const VkImageView views[] = { m_ImageViews[i], m_DepthView };
+
+			VkFramebufferCreateInfo framebufferInfo{};
+			framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+			framebufferInfo.renderPass = m_LoadPass;
+			framebufferInfo.attachmentCount = 2;
+			framebufferInfo.pAttachments = views;
+			framebufferInfo.width = m_Extent.width;
+			framebufferInfo.height = m_Extent.height;
+			framebufferInfo.layers = 1;
+
+			VulkanRenderTarget& target = m_Targets[i];
+			target.FirstPass = m_FirstPass;
+			target.LoadPass = m_LoadPass;
+			target.Extent = m_Extent;
+			LU_VK_CHECK(vkCreateFramebuffer(device, &framebufferInfo, nullptr, &target.Framebuffer));
+
+			VkSemaphoreCreateInfo semaphoreInfo{};
+			semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+			LU_VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &m_RenderFinished[i]));
+		}
+	}
+
+	void VulkanSwapchain::Destroy()
+	{
+		VkDevice device = VulkanDevice::GetDevice();
+
+		for (size_t i = 0; i < m_Targets.size(); i++)
+		{
+			vkDestroyFramebuffer(device, m_Targets[i].Framebuffer, nullptr);
+			vkDestroyImageView(device, m_ImageViews[i], nullptr);
+			vkDestroySemaphore(device, m_RenderFinished[i], nullptr);
+		}
+
+		m_Targets.clear();
+		m_ImageViews.clear();
+		m_RenderFinished.clear();
+		m_Images.clear();
+
+		if (m_DepthView)
+		{
+			vkDestroyImageView(device, m_DepthView, nullptr);
+			VulkanDevice::DestroyImage(m_DepthImage);
+			m_DepthView = VK_NULL_HANDLE;
+			m_DepthImage = {};
+		}
+
+		if (m_Swapchain)
+		{
+			vkDestroySwapchainKHR(device, m_Swapchain, nullptr);
+			m_Swapchain = VK_NULL_HANDLE;
+		}
+	}
+
+	bool VulkanSwapchain::AcquireNextImage(VkSemaphore imageAvailable)
+	{
+		m_HasImage = false;
+
+		if (m_Invalid || !m_Swapchain)
+		{
+			// Resizes are rare, idling the device keeps the old images' lifetime trivial
+			vkDeviceWaitIdle(VulkanDevice::GetDevice());
+			Destroy();
+			Create();
+
+			if (!m_Swapchain)
+				return false;
+		}
+
+		VkResult result = vkAcquireNextImageKHR(VulkanDevice::GetDevice(), m_Swapchain, std::numeric_limits<uint64_t>::max(),
+			imageAvailable, VK_NULL_HANDLE, &m_ImageIndex);
+
+		if (result == VK_ERROR_OUT_OF_DATE_KHR)
+		{
+			m_Invalid = true;
+			return false;
+		}
+
+		if (result == VK_SUBOPTIMAL_KHR)
+			m_Invalid = true; // The image is still usable, recreated next frame
+
+		m_HasImage = result >= VK_SUCCESS;
+		return m_HasImage;
+	}
+
+	void VulkanSwapchain::Present()
+	{
+		const VkSemaphore renderFinished = m_RenderFinished[m_ImageIndex];
+
+		VkPresentInfoKHR presentInfo{};
+		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+		presentInfo.waitSemaphoreCount = 1;
+		presentInfo.pWaitSemaphores = &renderFinished;
+		presentInfo.swapchainCount = 1;
+		presentInfo.pSwapchains = &m_Swapchain;
+		presentInfo.pImageIndices = &m_ImageIndex;
+
+		const VkResult result = vkQueuePresentKHR(VulkanDevice::GetQueue(), &presentInfo);
+		if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+			m_Invalid = true;
+
+		m_HasImage = false;
+	}
+
+}
@@ -0,0 +1,310 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanTexture.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanCommandStream.hpp"
+#include "LunariaCore/Renderer/CompressedTexture.hpp"
+
+#include <stb_image/stb_image.h>
+
+#include <cstring>
+
+namespace Lunaria {
+
+	static uint32_t CalculateMipCount(const uint32_t width, const uint32_t height)
+	{
+		return static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+	}
+
+	static VkFormat CompressedFormatToVulkan(const CompressedTextureFormat format, const bool srgb)
+	{
+		switch (format)
+		{
+		case CompressedTextureFormat::RGBA8:		return srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+		case CompressedTextureFormat::BC1:			return srgb ? VK_FORMAT_BC1_RGBA_SRGB_BLOCK : VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+		case CompressedTextureFormat::BC2:			return srgb ? VK_FORMAT_BC2_SRGB_BLOCK : VK_FORMAT_BC2_UNORM_BLOCK;
+		case CompressedTextureFormat::BC3:			return srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+		case CompressedTextureFormat::BC4:			return VK_FORMAT_BC4_UNORM_BLOCK;
+		case CompressedTextureFormat::BC5:			return VK_FORMAT_BC5_UNORM_BLOCK;
+		case CompressedTextureFormat::BC6H:			return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+		case CompressedTextureFormat::BC7:			return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+		case CompressedTextureFormat::ETC2_RGB8:	return srgb ? VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK : VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
+		case CompressedTextureFormat::ETC2_RGB8A1:	return srgb ? VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK : VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK;
+		case CompressedTextureFormat::ETC2_RGBA8:	return srgb ? VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK : VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+		case CompressedTextureFormat::None:			break;
+		}
+
+		LU_CORE_ASSERT(false, "Unknown CompressedTextureFormat!");
+		return VK_FORMAT_UNDEFINED;
+	}
+
+	static bool IsFormatSampleable(const VkFormat format)
+	{
+		VkFormatProperties properties;
+		vkGetPhysicalDeviceFormatProperties(VulkanDevice::GetPhysicalDevice(), format, &properties);
+		return properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+	}
+
+	VulkanTexture2D::VulkanTexture2D(const std::string& path, const TextureSpecification& specification)
+		: m_RendererID(VulkanDevice::AllocateID()), m_Specification(specification)
+	{
+		if (CompressedTextureLoader::IsContainer(path))
+		{
+			LoadContainer(path);
+			return;
+		}
+
+		int width, height, channels;
+		stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+		if (!data)
+		{
+			LU_CORE_ERROR("Failed to load texture '{0}'", path);
+
+			// Keep the texture usable, it stays black
+			const uint32_t black = 0xff000000;
+			CreateStorage(VK_FORMAT_R8G8B8A8_UNORM, 1);
+			Upload(reinterpret_cast<const uint8_t*>(&black), { { 1, 1, 0, sizeof(black) } });
+			return;
+		}
+
+		m_Width = static_cast<uint32_t>(width);
+		m_Height = static_cast<uint32_t>(height);
+
+		const uint32_t levels = m_Specification.MipFilter == TextureFilter::None ? 1 : CalculateMipCount(m_Width, m_Height);
+		CreateStorage(VK_FORMAT_R8G8B8A8_UNORM, levels);
+		Upload(data, { { m_Width, m_Height, 0, static_cast<size_t>(m_Width) * m_Height * 4 } });
+
+		stbi_image_free(data);
+	}
+
+	VulkanTexture2D::VulkanTexture2D(const uint32_t width, const uint32_t height, const TextureSpecification& specification)
+		: m_RendererID(VulkanDevice::AllocateID()), m_Width(width), m_Height(height), m_Specification(specification)
+	{
+		const uint32_t levels = m_Specification.MipFilter == TextureFilter::None ? 1 : CalculateMipCount(m_Width, m_Height);
+		CreateStorage(VK_FORMAT_R8G8B8A8_UNORM, levels);
+
+		// Defined contents and the layout every other texture is kept in
+		const std::vector<uint8_t> zeros(static_cast<size_t>(width) * height * 4, 0);
+		Upload(zeros.data(), { { m_Width, m_Height, 0, zeros.size() } });
+	}
+
+	VulkanTexture2D::~VulkanTexture2D()
+	{
+		for (const VulkanTexture2D*& texture : VulkanCommandStream::GetState().Textures)
+		{
+			if (texture == this)
+				texture = nullptr;
+		}
+
+		VulkanDevice::DeferDestroy([image = m_Image, view = m_View]()
+		{
+			vkDestroyImageView(VulkanDevice::GetDevice(), view, nullptr);
+			VulkanDevice::DestroyImage(image);
+		});
+	}
+
+	void VulkanTexture2D::LoadContainer(const std::string& path)
+	{
+		CompressedTextureData data;
+		if (!CompressedTextureLoader::Load(path, data))
+		{
+			// Keep the texture usable, it stays black
+			const uint32_t black = 0xff000000;
+			CreateStorage(VK_FORMAT_R8G8B8A8_UNORM, 1);
+			Upload(reinterpret_cast<const uint8_t*>(&black), { { 1, 1, 0, sizeof(black) } });
+			return;
+		}
+
+		m_Width = data.Width;
+		m_Height = data.Height;
+
+		// Precomputed levels are used as they are, compressed formats can't have mips generated
+		const uint32_t levels = m_Specification.MipFilter == TextureFilter::None ? 1 : static_cast<uint32_t>(data.Levels.size());
+		const bool generateMips = data.Format == CompressedTextureFormat::RGBA8 && levels == 1 && m_Specification.MipFilter != TextureFilter::None;
+
+		const VkFormat format = CompressedFormatToVulkan(data.Format, data.SRGB);
+		const std::vector<CompressedTextureLevel> uploadLevels(data.Levels.begin(), data.Levels.begin() + levels);
+
+		if (data.Format == CompressedTextureFormat::RGBA8 || IsFormatSampleable(format))
+		{
+			CreateStorage(format, generateMips ? CalculateMipCount(m_Width, m_Height) : levels);
+			Upload(data.Data.data(), uploadLevels);
+			return;
+		}
+
+		if (!CompressedTextureLoader::CanDecompress(data.Format))
+		{
+			LU_CORE_ERROR("Texture format of '{0}' is not supported by the device!", path);
+
+			const uint32_t black = 0xff000000;
+			m_Width = m_Height = 1;
+			CreateStorage(VK_FORMAT_R8G8B8A8_UNORM, 1);
+			Upload(reinterpret_cast<const uint8_t*>(&black), { { 1, 1, 0, sizeof(black) } });
+			return;
+		}
+
+		LU_CORE_WARN("Texture format of '{0}' is not supported by the device, decoding on the CPU", path);
+
+		// Decoded levels packed one after the other
+		std::vector<uint8_t> decoded;
+		std::vector<CompressedTextureLevel> decodedLevels;
+		std::vector<uint8_t> pixels;
+		for (uint32_t level = 0; level < levels; level++)
+		{
+			CompressedTextureLoader::Decompress(data, level, pixels);
+
+			decodedLevels.push_back({ data.Levels[level].Width, data.Levels[level].Height, decoded.size(), pixels.size() });
+			decoded.insert(decoded.end(), pixels.begin(), pixels.end());
+		}
+
+		CreateStorage(data.SRGB ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM, levels);
+		Upload(decoded.data(), decodedLevels);
+	}
+
+	void VulkanTexture2D::CreateStorage(const VkFormat format, const uint32_t levels)
+	{
+		m_Format = format;
+		m_MipLevels = levels;
+
+		VkImageCreateInfo imageInfo{};
+		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageInfo.format = format;
+		imageInfo.extent = { m_Width, m_Height, 1 };
+		imageInfo.mipLevels = levels;
+		imageInfo.arrayLayers = 1;
+		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+		m_Image = VulkanDevice::CreateImage(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = m_Image.Image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = format;
+		viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, levels, 0, 1 };
+		LU_VK_CHECK(vkCreateImageView(VulkanDevice::GetDevice(), &viewInfo, nullptr, &m_View));
+
+		m_Sampler = VulkanDevice::GetSampler(m_Specification);
+	}
+
+	void VulkanTexture2D::Upload(const uint8_t* data, const std::vector<CompressedTextureLevel>& levels)
+	{
+		size_t stagingSize = 0;
+		for (const CompressedTextureLevel& level : levels)
+			stagingSize = std::max(stagingSize, level.Offset + level.Size);
+
+		const VulkanBufferAllocation staging = VulkanDevice::CreateBuffer(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		if (staging.Mapped)
+			std::memcpy(staging.Mapped, data, stagingSize);
+
+		const uint32_t uploadedLevels = static_cast<uint32_t>(levels.size());
+		const bool generateMips = uploadedLevels < m_MipLevels;
+
+		VulkanDevice::ImmediateSubmit([&](VkCommandBuffer commandBuffer)
+		{
+			VkImageMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.image = m_Image.Image;
+			barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, m_MipLevels, 0, 1 };
+
+			// Every level is rewritten, previous contents can be discarded
+			barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+				0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+			std::vector<VkBufferImageCopy> regions(uploadedLevels);
+			for (uint32_t level = 0; level < uploadedLevels; level++)
+			{
+				regions[level] = {};
+				regions[level].bufferOffset = levels[level].Offset;
+				regions[level].imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+				regions[level].imageExtent = { levels[level].Width, levels[level].Height, 1 };
+			}
+
+			vkCmdCopyBufferToImage(commandBuffer, staging.Buffer, m_Image.Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				uploadedLevels, regions.data());
+
+			// Each level is blitted from the one above, which is moved to TRANSFER_SRC first
+			barrier.subresourceRange.levelCount = 1;
+			int32_t width = static_cast<int32_t>(m_Width), height = static_cast<int32_t>(m_Height);
+			for (uint32_t level = 1; generateMips && level < m_MipLevels; level++)
+			{
+				barrier.subresourceRange.baseMipLevel = level - 1;
+				barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+				barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+					0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+				const int32_t nextWidth = std::max(width / 2, 1), nextHeight = std::max(height / 2, 1);
+
+				VkImageBlit blit{};
+				blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1 };
+				blit.srcOffsets[1] = { width, height, 1 };
+				blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+				blit.dstOffsets[1] = { nextWidth, nextHeight, 1 };
+				vkCmdBlitImage(commandBuffer, m_Image.Image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+					m_Image.Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+				barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+				barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+				barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+					0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+				width = nextWidth;
+				height = nextHeight;
+			}
+
+			// The last generated level, or every uploaded one
+			barrier.subresourceRange.baseMipLevel = generateMips ? m_MipLevels - 1 : 0;
+			barrier.subresourceRange.levelCount = generateMips ? 1 : uploadedLevels;
+			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+				0, 0, nullptr, 0, nullptr, 1, &barrier);
+		});
+
+		VulkanDevice::DestroyBuffer(staging);
+	}
+
+	void VulkanTexture2D::SetData(void* data, const uint32_t size)
+	{
+		const uint32_t expected = m_Width * m_Height * 4;
+		LU_CORE_ASSERT(m_Format == VK_FORMAT_R8G8B8A8_UNORM || m_Format == VK_FORMAT_R8G8B8A8_SRGB, "SetData is not available on compressed textures!");
+		LU_CORE_ASSERT(size == expected, "Data must be entire texture!");
+
+		if (size != expected)
+			return;
+
+		// Replaces the contents for draws recorded earlier in the frame too, the frame is submitted after the upload
+		Upload(static_cast<const uint8_t*>(data), { { m_Width, m_Height, 0, size } });
+	}
+
+	void VulkanTexture2D::Bind(const uint32_t slot) const
+	{
+		LU_CORE_ASSERT(slot < VulkanDevice::MaxTextureUnits, "Texture slot out of range!");
+		if (slot < VulkanDevice::MaxTextureUnits)
+			VulkanCommandStream::GetState().Textures[slot] = this;
+	}
+
+	Ref<Texture2D> VulkanTextureStreamer::Load(const std::string& path, const TextureSpecification& specification)
+	{
+		m_Stats.LoadedTextures++;
+		return CreateRef<VulkanTexture2D>(path, specification);
+	}
+
+}
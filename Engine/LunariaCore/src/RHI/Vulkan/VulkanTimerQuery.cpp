@@ -0,0 +1,53 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanTimerQuery.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanCommandStream.hpp"
+
+namespace Lunaria {
+
+	VulkanTimerQueryPool::VulkanTimerQueryPool(const uint32_t count)
+		: m_Count(count)
+	{
+		VkQueryPoolCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		createInfo.queryCount = count;
+		LU_VK_CHECK(vkCreateQueryPool(VulkanDevice::GetDevice(), &createInfo, nullptr, &m_Pool));
+
+		// Queries start out in an undefined state, unavailable until written
+		vkResetQueryPool(VulkanDevice::GetDevice(), m_Pool, 0, count);
+	}
+
+	VulkanTimerQueryPool::~VulkanTimerQueryPool()
+	{
+		VulkanDevice::DeferDestroy([pool = m_Pool]() { vkDestroyQueryPool(VulkanDevice::GetDevice(), pool, nullptr); });
+	}
+
+	void VulkanTimerQueryPool::WriteTimestamp(const uint32_t query)
+	{
+		LU_CORE_ASSERT(query < m_Count, "Query index out of range!");
+
+		vkResetQueryPool(VulkanDevice::GetDevice(), m_Pool, query, 1);
+		vkCmdWriteTimestamp(VulkanCommandStream::GetCommandBuffer(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_Pool, query);
+	}
+
+	bool VulkanTimerQueryPool::IsResultAvailable(const uint32_t query) const
+	{
+		uint64_t result[2] = {}; // Value and availability
+		vkGetQueryPoolResults(VulkanDevice::GetDevice(), m_Pool, query, 1, sizeof(result), result, sizeof(result),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+		return result[1] != 0;
+	}
+
+	uint64_t VulkanTimerQueryPool::GetResultNanoseconds(const uint32_t query) const
+	{
+		uint64_t result[2] = {};
+		vkGetQueryPoolResults(VulkanDevice::GetDevice(), m_Pool, query, 1, sizeof(result), result, sizeof(result),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+		// Ticks to nanoseconds
+		return static_cast<uint64_t>(static_cast<double>(result[0]) * VulkanDevice::GetProperties().limits.timestampPeriod);
+	}
+
+}
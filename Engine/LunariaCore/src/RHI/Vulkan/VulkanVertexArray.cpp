@@ -0,0 +1,23 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/RHI/Vulkan/VulkanVertexArray.hpp"
+
+namespace Lunaria {
+
+	void VulkanVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		LU_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
+
+		// Pipelines are built for one interleaved binding
+		LU_CORE_ASSERT(m_VertexBuffers.empty(), "Vulkan vertex arrays support a single vertex buffer!");
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+	void VulkanVertexArray::SetVertexBuffer(uint32_t index, const Ref<VertexBuffer>& vertexBuffer)
+	{
+		LU_CORE_ASSERT(index < m_VertexBuffers.size(), "Vertex buffer index out of range!");
+		LU_CORE_ASSERT(vertexBuffer->GetLayout() == m_VertexBuffers[index]->GetLayout(), "Vertex buffer layout doesn't match the vertex format!");
+		m_VertexBuffers[index] = vertexBuffer;
+	}
+
+}
@@ -61,8 +61,11 @@ namespace Lunaria {
 		if (SDL_Init(SDL_INIT_VIDEO) != 0)
 			LU_CORE_ERROR("Unable to initialize SDL: {0}", SDL_GetError());
 
+		// Vulkan surfaces can only be created for windows made with SDL_WINDOW_VULKAN
+		const Uint32 apiFlag = Renderer::GetAPI() == RendererAPI::API::Vulkan ? SDL_WINDOW_VULKAN : SDL_WINDOW_OPENGL;
+
 		m_Window = SDL_CreateWindow(props.Title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-			static_cast<int>(props.Width), static_cast<int>(props.Height), SDL_WINDOW_OPENGL | SDL_WINDOW_BORDERLESS | SDL_WINDOW_RESIZABLE);
+			static_cast<int>(props.Width), static_cast<int>(props.Height), apiFlag | SDL_WINDOW_BORDERLESS | SDL_WINDOW_RESIZABLE);
 	    SDL_HideWindow(m_Window);
 
 #if defined(LU_DEBUG)
@@ -128,6 +131,12 @@ namespace Lunaria {
 	}
 
 	void WindowsWindow::OnUpdate()
+	{
+		PollEvents();
+		m_Context->SwapBuffers();
+	}
+
+	void WindowsWindow::PollEvents()
 	{
 		SDL_Event event;
 		while (SDL_PollEvent(&event))
@@ -250,13 +259,14 @@ namespace Lunaria {
 				break;
 			}
 		}
-
-		m_Context->SwapBuffers();
 	}
 
 	void WindowsWindow::SetVSync(bool enabled)
 	{
-		SDL_GL_SetSwapInterval(enabled ? 1 : -1);
+		// The Vulkan swapchain always presents with FIFO
+		if (Renderer::GetAPI() == RendererAPI::API::OpenGL)
+			SDL_GL_SetSwapInterval(enabled ? 1 : -1);
+
 		m_Data.VSync = enabled;
 	}
 
@@ -4,54 +4,108 @@
 #include "LunariaCore/Renderer/Renderer.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLBuffer.hpp"
+#include "LunariaCore/RHI/Null/NullBuffer.hpp"
+#include "LunariaCore/RHI/Software/SoftwareBuffer.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanBuffer.hpp"
 
 namespace Lunaria {
-	Ref<VertexBuffer> VertexBuffer::Create(uint32_t size)
+	Ref<VertexBuffer> VertexBuffer::Create(uint32_t size, BufferUsage usage)
 	{
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLVertexBuffer>(size);
+			return RenderThread::CreateResource<OpenGLVertexBuffer>(size, usage);
 
 		case RendererAPI::API::None:
-			LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
-			return nullptr;
+			return CreateRef<NullVertexBuffer>(size, usage);
+
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareVertexBuffer>(size);
+
+		case RendererAPI::API::Vulkan:
+			return CreateRef<VulkanVertexBuffer>(size);
 		}
 
 		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
 	}
 
-	Ref<VertexBuffer> VertexBuffer::Create(float* vertices, uint32_t size)
+	Ref<VertexBuffer> VertexBuffer::Create(float* vertices, uint32_t size, BufferUsage usage)
 	{
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
-				return CreateRef<OpenGLVertexBuffer>(vertices, size);
+				return RenderThread::CreateResource<OpenGLVertexBuffer>(vertices, size, usage);
 
 			case RendererAPI::API::None:
-				LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
-			return nullptr;
+				return CreateRef<NullVertexBuffer>(size, usage);
+
+			case RendererAPI::API::Software:
+				return CreateRef<SoftwareVertexBuffer>(vertices, size);
+
+			case RendererAPI::API::Vulkan:
+				return CreateRef<VulkanVertexBuffer>(vertices, size);
 		}
 
 		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
 	}
 
-	Ref<IndexBuffer> IndexBuffer::Create(uint32_t* indices, uint32_t count)
+	static Ref<IndexBuffer> CreateIndexBuffer(const void* indices, uint32_t count, IndexType type, BufferUsage usage)
 	{
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLIndexBuffer>(indices, count);
+			return RenderThread::CreateResource<OpenGLIndexBuffer>(indices, count, type, usage);
 
 		case RendererAPI::API::None:
-			LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
-			return nullptr;
+			return CreateRef<NullIndexBuffer>(indices, count, type);
+
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareIndexBuffer>(indices, count, type);
+
+		case RendererAPI::API::Vulkan:
+			return CreateRef<VulkanIndexBuffer>(indices, count, type);
+		}
+
+		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<IndexBuffer> IndexBuffer::Create(const uint32_t* indices, uint32_t count, BufferUsage usage)
+	{
+		return CreateIndexBuffer(indices, count, IndexType::UInt32, usage);
+	}
+
+	Ref<IndexBuffer> IndexBuffer::Create(const uint16_t* indices, uint32_t count, BufferUsage usage)
+	{
+		return CreateIndexBuffer(indices, count, IndexType::UInt16, usage);
+	}
+
+	Ref<StorageBuffer> StorageBuffer::Create(uint32_t size, BufferUsage usage)
+	{
+		return Create(nullptr, size, usage);
+	}
+
+	Ref<StorageBuffer> StorageBuffer::Create(const void* data, uint32_t size, BufferUsage usage)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+			return RenderThread::CreateResource<OpenGLStorageBuffer>(data, size, usage);
+
+		case RendererAPI::API::None:
+			return CreateRef<NullStorageBuffer>(size);
+
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareStorageBuffer>(data, size);
+
+		case RendererAPI::API::Vulkan:
+			return CreateRef<VulkanStorageBuffer>(data, size);
 		}
 
 		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
 	}
 
-}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/BufferArena.hpp"
+#include "LunariaCore/Renderer/Renderer.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLBufferArena.hpp"
+
+namespace Lunaria {
+
+	// Backends without buffer objects to share give every range its own buffer
+	class DedicatedBufferArena final : public BufferArena
+	{
+	public:
+		DedicatedBufferArena(const BufferArenaSpecification& specification)
+			: m_Specification(specification)
+		{
+		}
+
+		Ref<VertexBuffer> CreateVertexBuffer(const void* vertices, uint32_t size) override
+		{
+			Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(size, m_Specification.Usage);
+			if (vertices)
+				vertexBuffer->SetData(vertices, size);
+
+			return vertexBuffer;
+		}
+
+		Ref<IndexBuffer> CreateIndexBuffer(const void* indices, uint32_t count, IndexType type) override
+		{
+			if (type == IndexType::UInt16)
+				return IndexBuffer::Create(static_cast<const uint16_t*>(indices), count, m_Specification.Usage);
+
+			return IndexBuffer::Create(static_cast<const uint32_t*>(indices), count, m_Specification.Usage);
+		}
+
+		Statistics GetStats() const override { return {}; }
+		const BufferArenaSpecification& GetSpecification() const override { return m_Specification; }
+	private:
+		BufferArenaSpecification m_Specification;
+	};
+
+	Ref<BufferArena> BufferArena::Create(const BufferArenaSpecification& specification)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::OpenGL:
+				return RenderThread::CreateResource<OpenGLBufferArena>(specification);
+
+			case RendererAPI::API::None:
+			case RendererAPI::API::Software:
+			case RendererAPI::API::Vulkan:
+				return CreateRef<DedicatedBufferArena>(specification);
+		}
+
+		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
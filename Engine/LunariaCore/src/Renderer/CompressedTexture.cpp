@@ -0,0 +1,459 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/CompressedTexture.hpp"
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Lunaria {
+
+	namespace Utils {
+
+		static std::string GetExtension(const std::string& path)
+		{
+			std::string extension = std::filesystem::path(path).extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return extension;
+		}
+
+		static bool ReadFile(const std::string& path, std::vector<uint8_t>& outBytes)
+		{
+			std::ifstream in(path, std::ios::in | std::ios::binary);
+			if (!in)
+				return false;
+
+			in.seekg(0, std::ios::end);
+			const std::streamoff size = in.tellg();
+			if (size <= 0)
+				return false;
+
+			outBytes.resize(static_cast<size_t>(size));
+			in.seekg(0, std::ios::beg);
+			in.read(reinterpret_cast<char*>(outBytes.data()), size);
+			return static_cast<bool>(in);
+		}
+
+		template<typename T>
+		static T Read(const std::vector<uint8_t>& bytes, size_t offset)
+		{
+			T value;
+			std::memcpy(&value, bytes.data() + offset, sizeof(T)); // Both containers are little endian
+			return value;
+		}
+
+		static constexpr uint32_t FourCC(const char code[5])
+		{
+			return static_cast<uint32_t>(code[0]) | static_cast<uint32_t>(code[1]) << 8
+				| static_cast<uint32_t>(code[2]) << 16 | static_cast<uint32_t>(code[3]) << 24;
+		}
+
+		static size_t LevelSize(CompressedTextureFormat format, uint32_t width, uint32_t height)
+		{
+			const uint32_t blockSize = CompressedTextureLoader::GetBlockSize(format);
+			if (blockSize == 0)
+				return static_cast<size_t>(width) * height * 4;
+
+			const size_t blocksX = std::max(1u, (width + 3) / 4);
+			const size_t blocksY = std::max(1u, (height + 3) / 4);
+			return blocksX * blocksY * blockSize;
+		}
+
+		// Full chain down to 1x1, which also keeps every level shift below 32
+		static uint32_t MaxLevelCount(uint32_t width, uint32_t height)
+		{
+			return static_cast<uint32_t>(std::bit_width(std::max(width, height)));
+		}
+
+		static bool AddLevels(const std::vector<uint8_t>& file, CompressedTextureData& data,
+			const std::vector<std::pair<size_t, size_t>>& ranges)
+		{
+			size_t total = 0;
+			for (const auto& [offset, size] : ranges)
+			{
+				if (offset > file.size() || size > file.size() - offset)
+					return false;
+				total += size;
+			}
+
+			data.Data.resize(total);
+
+			size_t written = 0;
+			for (uint32_t level = 0; level < ranges.size(); level++)
+			{
+				const auto& [offset, size] = ranges[level];
+
+				CompressedTextureLevel& entry = data.Levels.emplace_back();
+				entry.Width = std::max(1u, data.Width >> level);
+				entry.Height = std::max(1u, data.Height >> level);
+				entry.Offset = written;
+				entry.Size = size;
+
+				if (size < LevelSize(data.Format, entry.Width, entry.Height))
+					return false;
+
+				std::memcpy(data.Data.data() + written, file.data() + offset, size);
+				written += size;
+			}
+
+			return true;
+		}
+
+		// VkFormat values used by KTX2
+		static bool VkFormatToCompressed(uint32_t vkFormat, CompressedTextureFormat& format, bool& srgb)
+		{
+			srgb = false;
+			switch (vkFormat)
+			{
+				case 37:  format = CompressedTextureFormat::RGBA8; return true;
+				case 43:  format = CompressedTextureFormat::RGBA8; srgb = true; return true;
+				case 131: case 133: format = CompressedTextureFormat::BC1; return true;
+				case 132: case 134: format = CompressedTextureFormat::BC1; srgb = true; return true;
+				case 135: format = CompressedTextureFormat::BC2; return true;
+				case 136: format = CompressedTextureFormat::BC2; srgb = true; return true;
+				case 137: format = CompressedTextureFormat::BC3; return true;
+				case 138: format = CompressedTextureFormat::BC3; srgb = true; return true;
+				case 139: format = CompressedTextureFormat::BC4; return true;
+				case 141: format = CompressedTextureFormat::BC5; return true;
+				case 143: format = CompressedTextureFormat::BC6H; return true;
+				case 145: format = CompressedTextureFormat::BC7; return true;
+				case 146: format = CompressedTextureFormat::BC7; srgb = true; return true;
+				case 147: format = CompressedTextureFormat::ETC2_RGB8; return true;
+				case 148: format = CompressedTextureFormat::ETC2_RGB8; srgb = true; return true;
+				case 149: format = CompressedTextureFormat::ETC2_RGB8A1; return true;
+				case 150: format = CompressedTextureFormat::ETC2_RGB8A1; srgb = true; return true;
+				case 151: format = CompressedTextureFormat::ETC2_RGBA8; return true;
+				case 152: format = CompressedTextureFormat::ETC2_RGBA8; srgb = true; return true;
+			}
+
+			return false;
+		}
+
+		// DXGI_FORMAT values used by the DDS DX10 header
+		static bool DXGIFormatToCompressed(uint32_t dxgiFormat, CompressedTextureFormat& format, bool& srgb)
+		{
+			srgb = false;
+			switch (dxgiFormat)
+			{
+				case 28: format = CompressedTextureFormat::RGBA8; return true;
+				case 29: format = CompressedTextureFormat::RGBA8; srgb = true; return true;
+				case 71: format = CompressedTextureFormat::BC1; return true;
+				case 72: format = CompressedTextureFormat::BC1; srgb = true; return true;
+				case 74: format = CompressedTextureFormat::BC2; return true;
+				case 75: format = CompressedTextureFormat::BC2; srgb = true; return true;
+				case 77: format = CompressedTextureFormat::BC3; return true;
+				case 78: format = CompressedTextureFormat::BC3; srgb = true; return true;
+				case 80: format = CompressedTextureFormat::BC4; return true;
+				case 83: format = CompressedTextureFormat::BC5; return true;
+				case 95: format = CompressedTextureFormat::BC6H; return true;
+				case 98: format = CompressedTextureFormat::BC7; return true;
+				case 99: format = CompressedTextureFormat::BC7; srgb = true; return true;
+			}
+
+			return false;
+		}
+
+		static bool LoadKTX2(const std::vector<uint8_t>& file, CompressedTextureData& data)
+		{
+			static constexpr uint8_t identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+			static constexpr size_t levelIndexOffset = 80;
+
+			if (file.size() < levelIndexOffset || std::memcmp(file.data(), identifier, sizeof(identifier)) != 0)
+				return false;
+
+			const auto vkFormat = Read<uint32_t>(file, 12);
+			data.Width = Read<uint32_t>(file, 20);
+			data.Height = Read<uint32_t>(file, 24);
+			const auto depth = Read<uint32_t>(file, 28);
+			const auto layerCount = Read<uint32_t>(file, 32);
+			const auto faceCount = Read<uint32_t>(file, 36);
+			uint32_t levelCount = std::max(Read<uint32_t>(file, 40), 1u); // 0 asks for runtime generation
+			const auto supercompression = Read<uint32_t>(file, 44);
+
+			if (data.Width == 0 || data.Height == 0 || depth > 1 || layerCount > 1 || faceCount != 1 || supercompression != 0)
+			{
+				LU_CORE_ERROR("Only 2D KTX2 textures without supercompression are supported!");
+				return false;
+			}
+
+			if (!VkFormatToCompressed(vkFormat, data.Format, data.SRGB))
+			{
+				LU_CORE_ERROR("Unsupported KTX2 format {0}!", vkFormat);
+				return false;
+			}
+
+			levelCount = std::min(levelCount, MaxLevelCount(data.Width, data.Height));
+			if (file.size() < levelIndexOffset + static_cast<size_t>(levelCount) * 24)
+				return false;
+
+			std::vector<std::pair<size_t, size_t>> ranges;
+			for (uint32_t level = 0; level < levelCount; level++)
+			{
+				const size_t entry = levelIndexOffset + static_cast<size_t>(level) * 24;
+				ranges.emplace_back(static_cast<size_t>(Read<uint64_t>(file, entry)), static_cast<size_t>(Read<uint64_t>(file, entry + 8)));
+			}
+
+			return AddLevels(file, data, ranges);
+		}
+
+		static bool LoadDDS(const std::vector<uint8_t>& file, CompressedTextureData& data)
+		{
+			static constexpr size_t headerEnd = 128;
+			static constexpr uint32_t pixelFormatFourCC = 0x4, pixelFormatRGB = 0x40;
+			static constexpr uint32_t caps2Cubemap = 0x200, caps2Volume = 0x200000;
+
+			if (file.size() < headerEnd || Read<uint32_t>(file, 0) != FourCC("DDS ") || Read<uint32_t>(file, 4) != 124)
+				return false;
+
+			data.Height = Read<uint32_t>(file, 12);
+			data.Width = Read<uint32_t>(file, 16);
+			const uint32_t mipMapCount = Read<uint32_t>(file, 28);
+
+			const auto pixelFormatFlags = Read<uint32_t>(file, 80);
+			const auto fourCC = Read<uint32_t>(file, 84);
+			const auto caps2 = Read<uint32_t>(file, 112);
+
+			if (data.Width == 0 || data.Height == 0 || caps2 & (caps2Cubemap | caps2Volume))
+			{
+				LU_CORE_ERROR("Only 2D DDS textures are supported!");
+				return false;
+			}
+
+			size_t dataOffset = headerEnd;
+			bool supported = true;
+
+			if (pixelFormatFlags & pixelFormatFourCC)
+			{
+				if (fourCC == FourCC("DX10"))
+				{
+					static constexpr uint32_t dimensionTexture2D = 3, miscCubemap = 0x4;
+
+					if (file.size() < headerEnd + 20)
+						return false;
+
+					supported = DXGIFormatToCompressed(Read<uint32_t>(file, 128), data.Format, data.SRGB)
+						&& Read<uint32_t>(file, 132) == dimensionTexture2D
+						&& !(Read<uint32_t>(file, 136) & miscCubemap)
+						&& Read<uint32_t>(file, 140) <= 1;
+					dataOffset += 20;
+				}
+				else if (fourCC == FourCC("DXT1"))
+					data.Format = CompressedTextureFormat::BC1;
+				else if (fourCC == FourCC("DXT2") || fourCC == FourCC("DXT3"))
+					data.Format = CompressedTextureFormat::BC2;
+				else if (fourCC == FourCC("DXT4") || fourCC == FourCC("DXT5"))
+					data.Format = CompressedTextureFormat::BC3;
+				else if (fourCC == FourCC("ATI1") || fourCC == FourCC("BC4U"))
+					data.Format = CompressedTextureFormat::BC4;
+				else if (fourCC == FourCC("ATI2") || fourCC == FourCC("BC5U"))
+					data.Format = CompressedTextureFormat::BC5;
+				else
+					supported = false;
+			}
+			else if (pixelFormatFlags & pixelFormatRGB && Read<uint32_t>(file, 88) == 32
+				&& Read<uint32_t>(file, 92) == 0x000000ff && Read<uint32_t>(file, 96) == 0x0000ff00
+				&& Read<uint32_t>(file, 100) == 0x00ff0000)
+			{
+				data.Format = CompressedTextureFormat::RGBA8;
+			}
+			else
+				supported = false;
+
+			if (!supported)
+			{
+				LU_CORE_ERROR("Unsupported DDS format!");
+				return false;
+			}
+
+			// Levels follow each other tightly packed, largest first
+			const uint32_t levelCount = std::min(std::max(mipMapCount, 1u), MaxLevelCount(data.Width, data.Height));
+			std::vector<std::pair<size_t, size_t>> ranges;
+			for (uint32_t level = 0; level < levelCount && dataOffset <= file.size(); level++)
+			{
+				const size_t size = LevelSize(data.Format, std::max(1u, data.Width >> level), std::max(1u, data.Height >> level));
+				ranges.emplace_back(dataOffset, size);
+				dataOffset += size;
+			}
+
+			return AddLevels(file, data, ranges);
+		}
+
+		static void DecodeRGB565(uint16_t color, uint8_t* out)
+		{
+			out[0] = static_cast<uint8_t>((color >> 11 & 0x1f) * 255 / 31);
+			out[1] = static_cast<uint8_t>((color >> 5 & 0x3f) * 255 / 63);
+			out[2] = static_cast<uint8_t>((color & 0x1f) * 255 / 31);
+		}
+
+		// 8 byte BC1 color block into 16 RGBA pixels
+		static void DecodeColorBlock(const uint8_t* block, uint8_t pixels[16][4], bool allowTransparent)
+		{
+			const auto color0 = static_cast<uint16_t>(block[0] | block[1] << 8);
+			const auto color1 = static_cast<uint16_t>(block[2] | block[3] << 8);
+			const uint32_t indices = block[4] | block[5] << 8 | block[6] << 16 | static_cast<uint32_t>(block[7]) << 24;
+
+			uint8_t palette[4][4] = {};
+			DecodeRGB565(color0, palette[0]);
+			DecodeRGB565(color1, palette[1]);
+			palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+
+			for (int channel = 0; channel < 3; channel++)
+			{
+				if (color0 > color1 || !allowTransparent)
+				{
+					palette[2][channel] = static_cast<uint8_t>((2 * palette[0][channel] + palette[1][channel]) / 3);
+					palette[3][channel] = static_cast<uint8_t>((palette[0][channel] + 2 * palette[1][channel]) / 3);
+				}
+				else
+				{
+					palette[2][channel] = static_cast<uint8_t>((palette[0][channel] + palette[1][channel]) / 2);
+					palette[3][channel] = 0;
+				}
+			}
+
+			if (color0 <= color1 && allowTransparent)
+				palette[3][3] = 0;
+
+			for (int i = 0; i < 16; i++)
+				std::memcpy(pixels[i], palette[indices >> (2 * i) & 0x3], 4);
+		}
+
+		// 8 byte BC3 alpha block
+		static void DecodeAlphaBlock(const uint8_t* block, uint8_t pixels[16][4])
+		{
+			uint8_t alpha[8];
+			alpha[0] = block[0];
+			alpha[1] = block[1];
+
+			if (alpha[0] > alpha[1])
+			{
+				for (int i = 1; i < 7; i++)
+					alpha[i + 1] = static_cast<uint8_t>(((7 - i) * alpha[0] + i * alpha[1]) / 7);
+			}
+			else
+			{
+				for (int i = 1; i < 5; i++)
+					alpha[i + 1] = static_cast<uint8_t>(((5 - i) * alpha[0] + i * alpha[1]) / 5);
+				alpha[6] = 0;
+				alpha[7] = 255;
+			}
+
+			uint64_t indices = 0;
+			for (int i = 0; i < 6; i++)
+				indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+
+			for (int i = 0; i < 16; i++)
+				pixels[i][3] = alpha[indices >> (3 * i) & 0x7];
+		}
+
+	}
+
+	bool CompressedTextureLoader::IsContainer(const std::string& path)
+	{
+		const std::string extension = Utils::GetExtension(path);
+		return extension == ".ktx2" || extension == ".dds";
+	}
+
+	bool CompressedTextureLoader::Load(const std::string& path, CompressedTextureData& outData)
+	{
+		std::vector<uint8_t> file;
+		if (!Utils::ReadFile(path, file))
+		{
+			LU_CORE_ERROR("Could not open file '{0}'", path);
+			return false;
+		}
+
+		outData = {};
+
+		const bool loaded = Utils::GetExtension(path) == ".dds" ? Utils::LoadDDS(file, outData) : Utils::LoadKTX2(file, outData);
+
+		if (!loaded)
+		{
+			LU_CORE_ERROR("Failed to read texture container '{0}'!", path);
+			return false;
+		}
+
+		return true;
+	}
+
+	uint32_t CompressedTextureLoader::GetBlockSize(const CompressedTextureFormat format)
+	{
+		switch (format)
+		{
+			case CompressedTextureFormat::BC1:
+			case CompressedTextureFormat::BC4:
+			case CompressedTextureFormat::ETC2_RGB8:
+			case CompressedTextureFormat::ETC2_RGB8A1:
+				return 8;
+
+			case CompressedTextureFormat::BC2:
+			case CompressedTextureFormat::BC3:
+			case CompressedTextureFormat::BC5:
+			case CompressedTextureFormat::BC6H:
+			case CompressedTextureFormat::BC7:
+			case CompressedTextureFormat::ETC2_RGBA8:
+				return 16;
+
+			default:
+				return 0;
+		}
+	}
+
+	bool CompressedTextureLoader::CanDecompress(const CompressedTextureFormat format)
+	{
+		return format == CompressedTextureFormat::BC1 || format == CompressedTextureFormat::BC2 || format == CompressedTextureFormat::BC3;
+	}
+
+	bool CompressedTextureLoader::Decompress(const CompressedTextureData& data, const uint32_t level, std::vector<uint8_t>& outPixels)
+	{
+		if (!CanDecompress(data.Format) || level >= data.Levels.size())
+			return false;
+
+		const CompressedTextureLevel& entry = data.Levels[level];
+		const uint32_t blockSize = GetBlockSize(data.Format);
+		const uint32_t blocksX = std::max(1u, (entry.Width + 3) / 4);
+		const uint32_t blocksY = std::max(1u, (entry.Height + 3) / 4);
+
+		outPixels.resize(static_cast<size_t>(entry.Width) * entry.Height * 4);
+
+		const uint8_t* block = data.Data.data() + entry.Offset;
+		for (uint32_t by = 0; by < blocksY; by++)
+		{
+			for (uint32_t bx = 0; bx < blocksX; bx++, block += blockSize)
+			{
+				uint8_t pixels[16][4];
+				switch (data.Format)
+				{
+					case CompressedTextureFormat::BC1:
+						Utils::DecodeColorBlock(block, pixels, true);
+						break;
+
+					case CompressedTextureFormat::BC2:
+						Utils::DecodeColorBlock(block + 8, pixels, false);
+						for (int i = 0; i < 16; i++)
+							pixels[i][3] = static_cast<uint8_t>((block[i / 2] >> (4 * (i % 2)) & 0xf) * 17);
+						break;
+
+					default:
+						Utils::DecodeColorBlock(block + 8, pixels, false);
+						Utils::DecodeAlphaBlock(block, pixels);
+						break;
+				}
+
+				// Edge blocks of non multiple of 4 sizes are clipped
+				for (uint32_t y = 0; y < 4 && by * 4 + y < entry.Height; y++)
+				{
+					for (uint32_t x = 0; x < 4 && bx * 4 + x < entry.Width; x++)
+					{
+						const size_t pixel = (static_cast<size_t>(by * 4 + y) * entry.Width + bx * 4 + x) * 4;
+						std::memcpy(outPixels.data() + pixel, pixels[y * 4 + x], 4);
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,97 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/DynamicResolution.hpp"
+
+namespace Lunaria {
+
+	DynamicResolution::DynamicResolution(const DynamicResolutionSpecification& specification)
+	{
+		SetSpecification(specification);
+		Reset();
+	}
+
+	float DynamicResolution::Update(const float gpuMilliseconds)
+	{
+		if (!m_Enabled || gpuMilliseconds <= 0.0f)
+			return GetScale();
+
+		// Timings of frames still rendered at the previous scale
+		if (m_SettleFrames > 0)
+		{
+			m_SettleFrames--;
+			return m_Scale;
+		}
+
+		m_SmoothedMilliseconds = m_SmoothedMilliseconds > 0.0f ? glm::mix(m_SmoothedMilliseconds, gpuMilliseconds, 0.25f) : gpuMilliseconds;
+
+		const float target = m_Specification.TargetMilliseconds;
+		float scale = m_Scale;
+
+		if (gpuMilliseconds > target * (1.0f + m_Specification.Hysteresis))
+		{
+			// Over budget drops at once on the raw timing, a spike must not cost several frames
+			scale = m_Scale * std::sqrt(target / gpuMilliseconds);
+			m_FramesUnderBudget = 0;
+		}
+		else if (m_SmoothedMilliseconds < target * (1.0f - m_Specification.Hysteresis))
+		{
+			if (++m_FramesUnderBudget >= m_Specification.GrowFrames)
+			{
+				scale = std::min(m_Scale * std::sqrt(target / m_SmoothedMilliseconds), m_Scale + m_Specification.MaxGrowStep);
+				m_FramesUnderBudget = 0;
+			}
+		}
+		else
+		{
+			m_FramesUnderBudget = 0;
+		}
+
+		scale = std::clamp(scale, m_Specification.MinScale, m_Specification.MaxScale);
+		if (scale != m_Scale)
+		{
+			m_Scale = scale;
+			m_SmoothedMilliseconds = 0.0f;
+			m_SettleFrames = m_Specification.LatencyFrames;
+		}
+
+		return m_Scale;
+	}
+
+	void DynamicResolution::Reset()
+	{
+		m_Scale = m_Specification.MaxScale;
+		m_SmoothedMilliseconds = 0.0f;
+		m_FramesUnderBudget = 0;
+		m_SettleFrames = 0;
+	}
+
+	glm::uvec2 DynamicResolution::GetScaledSize(const uint32_t width, const uint32_t height) const
+	{
+		const float scale = GetScale();
+		return {
+			std::max(1u, static_cast<uint32_t>(static_cast<float>(width) * scale + 0.5f)),
+			std::max(1u, static_cast<uint32_t>(static_cast<float>(height) * scale + 0.5f))
+		};
+	}
+
+	void DynamicResolution::SetEnabled(const bool enabled)
+	{
+		if (enabled == m_Enabled)
+			return;
+
+		m_Enabled = enabled;
+		Reset();
+	}
+
+	void DynamicResolution::SetSpecification(const DynamicResolutionSpecification& specification)
+	{
+		LU_CORE_ASSERT(specification.MinScale > 0.0f && specification.MinScale <= specification.MaxScale, "Invalid dynamic resolution scale range!");
+		LU_CORE_ASSERT(specification.TargetMilliseconds > 0.0f, "Dynamic resolution needs a frame time budget!");
+
+		m_Specification = specification;
+		m_Specification.MinScale = std::clamp(m_Specification.MinScale, 0.01f, 1.0f);
+		m_Specification.MaxScale = std::clamp(m_Specification.MaxScale, m_Specification.MinScale, 1.0f);
+		m_Scale = std::clamp(m_Scale, m_Specification.MinScale, m_Specification.MaxScale);
+	}
+
+}
@@ -0,0 +1,122 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/FrameSync.hpp"
+#include "LunariaCore/Renderer/GpuFence.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
+
+#include <mutex>
+
+namespace Lunaria {
+
+	struct FrameSyncData
+	{
+		uint32_t FramesInFlight = 2;
+		std::array<Ref<GpuFence>, FrameSync::MaxFramesInFlight> Fences;
+		std::array<uint64_t, FrameSync::MaxFramesInFlight> SlotFrames{}; // Frame that last signaled the slot, 0 for none
+
+		uint64_t CurrentFrame = 1;
+		std::atomic<uint64_t> CompletedFrame = 0; // Written where the fences are waited on
+
+		std::mutex StatsMutex;
+		FrameSync::Statistics Stats;
+	};
+
+	static FrameSyncData s_Data;
+
+	void FrameSync::Init(const uint32_t framesInFlight)
+	{
+		LU_CORE_ASSERT(framesInFlight > 0 && framesInFlight <= MaxFramesInFlight, "Invalid number of frames in flight!");
+
+		s_Data.FramesInFlight = std::clamp(framesInFlight, 1u, MaxFramesInFlight);
+		for (uint32_t i = 0; i < s_Data.FramesInFlight; i++)
+			s_Data.Fences[i] = GpuFence::Create();
+
+		s_Data.SlotFrames = {};
+		s_Data.CurrentFrame = 1;
+		s_Data.CompletedFrame = 0;
+		ResetStats();
+	}
+
+	void FrameSync::Shutdown()
+	{
+		for (auto& fence : s_Data.Fences)
+			fence.reset();
+	}
+
+	void FrameSync::BeginFrame()
+	{
+		const uint32_t slot = GetFrameSlot();
+		if (!s_Data.Fences[slot] || s_Data.SlotFrames[slot] == 0)
+			return; // Slot never used
+
+		// Fences of the frames after the waited one, oldest first, to advance the completed frame further
+		std::array<Ref<GpuFence>, MaxFramesInFlight> newer;
+		uint32_t newerCount = 0;
+		for (uint64_t frame = s_Data.SlotFrames[slot] + 1; frame < s_Data.CurrentFrame; frame++)
+			newer[newerCount++] = s_Data.Fences[frame % s_Data.FramesInFlight];
+
+		RenderThread::Submit([fence = s_Data.Fences[slot], waitedFrame = s_Data.SlotFrames[slot], newer, newerCount,
+			currentFrame = s_Data.CurrentFrame]
+		{
+			fence->Wait();
+			const float waitMilliseconds = fence->GetLastWaitMilliseconds();
+
+			uint64_t completed = waitedFrame;
+			for (uint32_t i = 0; i < newerCount && newer[i]->IsSignaled(); i++)
+				completed++;
+
+			if (completed > s_Data.CompletedFrame)
+				s_Data.CompletedFrame = completed;
+
+			std::lock_guard lock(s_Data.StatsMutex);
+			s_Data.Stats.WaitMilliseconds = waitMilliseconds;
+			s_Data.Stats.MaxWaitMilliseconds = std::max(s_Data.Stats.MaxWaitMilliseconds, waitMilliseconds);
+			s_Data.Stats.FramesAhead = static_cast<uint32_t>(currentFrame - 1 - completed);
+			if (waitMilliseconds > 0.0f)
+				s_Data.Stats.Stalls++;
+		});
+	}
+
+	void FrameSync::EndFrame()
+	{
+		const uint32_t slot = GetFrameSlot();
+		if (!s_Data.Fences[slot])
+			return;
+
+		RenderThread::Submit([fence = s_Data.Fences[slot]] { fence->Signal(); });
+		s_Data.SlotFrames[slot] = s_Data.CurrentFrame++;
+	}
+
+	uint32_t FrameSync::GetFramesInFlight()
+	{
+		return s_Data.FramesInFlight;
+	}
+
+	uint64_t FrameSync::GetCurrentFrame()
+	{
+		return s_Data.CurrentFrame;
+	}
+
+	uint32_t FrameSync::GetFrameSlot()
+	{
+		return static_cast<uint32_t>(s_Data.CurrentFrame % s_Data.FramesInFlight);
+	}
+
+	uint64_t FrameSync::GetCompletedFrame()
+	{
+		return s_Data.CompletedFrame;
+	}
+
+	FrameSync::Statistics FrameSync::GetStats()
+	{
+		std::lock_guard lock(s_Data.StatsMutex);
+		return s_Data.Stats;
+	}
+
+	void FrameSync::ResetStats()
+	{
+		std::lock_guard lock(s_Data.StatsMutex);
+		s_Data.Stats = {};
+	}
+
+}
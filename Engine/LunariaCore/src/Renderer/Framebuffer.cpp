@@ -4,6 +4,9 @@
 #include "LunariaCore/Renderer/Renderer.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLFrameBuffer.hpp"
+#include "LunariaCore/RHI/Null/NullFrameBuffer.hpp"
+#include "LunariaCore/RHI/Software/SoftwareFrameBuffer.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanFrameBuffer.hpp"
 
 namespace Lunaria {
 
@@ -12,11 +15,16 @@ namespace Lunaria {
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLFrameBuffer>(specification);
+			return RenderThread::CreateResource<OpenGLFrameBuffer>(specification);
 
 		case RendererAPI::API::None:
-			LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
-			return nullptr;
+			return CreateRef<NullFrameBuffer>(specification);
+
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareFrameBuffer>(specification);
+
+		case RendererAPI::API::Vulkan:
+			return CreateRef<VulkanFrameBuffer>(specification);
 		}
 
 		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
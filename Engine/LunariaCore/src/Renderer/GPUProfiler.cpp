@@ -0,0 +1,204 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/GPUProfiler.hpp"
+#include "LunariaCore/Renderer/TimerQuery.hpp"
+#include "LunariaCore/Renderer/RenderCommand.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
+
+#include <mutex>
+
+namespace Lunaria {
+
+	static constexpr uint32_t InvalidScope = 0xffffffff;
+
+	struct ScopeRecord
+	{
+		std::string Name;
+		uint32_t Depth = 0;
+		uint32_t BeginQuery = 0;
+		uint32_t EndQuery = 0;
+	};
+
+	struct FrameRecord
+	{
+		std::vector<ScopeRecord> Scopes;
+		uint32_t QueryCount = 0;
+		bool Pending = false; // Queries issued, results not read yet
+	};
+
+	struct GPUProfilerData
+	{
+		static constexpr uint32_t MaxQueriesPerFrame = GPUProfiler::MaxScopesPerFrame * 2;
+
+		Scope<TimerQueryPool> Queries;
+
+		std::array<FrameRecord, GPUProfiler::FramesInFlight> Frames;
+		uint32_t FrameIndex = 0;
+		bool InFrame = false;
+
+		std::vector<uint32_t> OpenScopes; // Indices into the current frame's scopes
+
+		// Written where the queries are read back, the render thread when there is one
+		std::mutex PassesMutex;
+		std::vector<GPUProfiler::PassTiming> Passes;
+		std::atomic<uint32_t> DroppedFrames = 0;
+	};
+
+	static GPUProfilerData s_Data;
+
+	static GPUProfiler::PassTiming& FindPass(const ScopeRecord& scope)
+	{
+		for (auto& pass : s_Data.Passes)
+		{
+			if (pass.Depth == scope.Depth && pass.Name == scope.Name)
+				return pass;
+		}
+
+		auto& pass = s_Data.Passes.emplace_back();
+		pass.Name = scope.Name;
+		pass.Depth = scope.Depth;
+		return pass;
+	}
+
+	static void ResolveFrame(FrameRecord& frame)
+	{
+		if (frame.Scopes.empty())
+			return;
+
+		// Timestamps complete in submission order and the frame scope ends last,
+		// once its end is ready every other query of the frame is too
+		if (!s_Data.Queries->IsResultAvailable(frame.Scopes.front().EndQuery))
+		{
+			s_Data.DroppedFrames++;
+			return;
+		}
+
+		std::lock_guard lock(s_Data.PassesMutex);
+		for (const auto& scope : frame.Scopes)
+		{
+			const uint64_t begin = s_Data.Queries->GetResultNanoseconds(scope.BeginQuery);
+			const uint64_t end = s_Data.Queries->GetResultNanoseconds(scope.EndQuery);
+			const float milliseconds = end > begin ? static_cast<float>(end - begin) / 1000000.0f : 0.0f;
+
+			auto& pass = FindPass(scope);
+			pass.Milliseconds = milliseconds;
+			pass.History[pass.HistoryOffset] = milliseconds;
+			pass.HistoryOffset = (pass.HistoryOffset + 1) % GPUProfiler::HistorySize;
+		}
+	}
+
+	void GPUProfiler::Init()
+	{
+		s_Data.Queries = TimerQueryPool::Create(FramesInFlight * GPUProfilerData::MaxQueriesPerFrame);
+
+		for (auto& frame : s_Data.Frames)
+			frame.Scopes.reserve(MaxScopesPerFrame);
+		s_Data.OpenScopes.reserve(MaxScopesPerFrame);
+	}
+
+	void GPUProfiler::Shutdown()
+	{
+		s_Data.Queries.reset();
+	}
+
+	void GPUProfiler::BeginFrame()
+	{
+		// Queries are issued and read where the GPU commands execute
+		RenderThread::Submit([]
+		{
+			LU_CORE_ASSERT(!s_Data.InFrame, "GPUProfiler::BeginFrame called twice without EndFrame!");
+
+			s_Data.FrameIndex = (s_Data.FrameIndex + 1) % FramesInFlight;
+			FrameRecord& frame = s_Data.Frames[s_Data.FrameIndex];
+
+			// The slot was last used FramesInFlight frames ago, read it back before reusing its queries
+			if (frame.Pending)
+				ResolveFrame(frame);
+
+			frame.Scopes.clear();
+			frame.QueryCount = 0;
+			frame.Pending = false;
+
+			s_Data.InFrame = true;
+			BeginScope("Frame");
+		});
+	}
+
+	void GPUProfiler::EndFrame()
+	{
+		RenderThread::Submit([]
+		{
+			LU_CORE_ASSERT(s_Data.InFrame, "GPUProfiler::EndFrame called without BeginFrame!");
+			LU_CORE_ASSERT(s_Data.OpenScopes.size() == 1, "Unbalanced GPU profiler scopes!");
+
+			EndScope();
+
+			s_Data.Frames[s_Data.FrameIndex].Pending = true;
+			s_Data.InFrame = false;
+		});
+	}
+
+	void GPUProfiler::BeginScope(const std::string& name)
+	{
+		RenderThread::Submit([name]
+		{
+			RenderCommand::PushDebugGroup(name.c_str());
+
+			FrameRecord& frame = s_Data.Frames[s_Data.FrameIndex];
+			if (!s_Data.Queries || !s_Data.InFrame || frame.QueryCount + 2 > GPUProfilerData::MaxQueriesPerFrame)
+			{
+				// Still tracked so EndScope stays balanced
+				s_Data.OpenScopes.push_back(InvalidScope);
+				return;
+			}
+
+			const uint32_t query = s_Data.FrameIndex * GPUProfilerData::MaxQueriesPerFrame + frame.QueryCount;
+			frame.QueryCount += 2; // End query is reserved up front
+
+			s_Data.Queries->WriteTimestamp(query);
+
+			s_Data.OpenScopes.push_back(static_cast<uint32_t>(frame.Scopes.size()));
+			frame.Scopes.push_back({ name, static_cast<uint32_t>(s_Data.OpenScopes.size() - 1), query, query + 1 });
+		});
+	}
+
+	void GPUProfiler::EndScope()
+	{
+		RenderThread::Submit([]
+		{
+			LU_CORE_ASSERT(!s_Data.OpenScopes.empty(), "GPUProfiler::EndScope called without BeginScope!");
+
+			const uint32_t scope = s_Data.OpenScopes.back();
+			s_Data.OpenScopes.pop_back();
+
+			if (scope != InvalidScope)
+				s_Data.Queries->WriteTimestamp(s_Data.Frames[s_Data.FrameIndex].Scopes[scope].EndQuery);
+
+			RenderCommand::PopDebugGroup();
+		});
+	}
+
+	std::vector<GPUProfiler::PassTiming> GPUProfiler::GetPassTimings()
+	{
+		std::lock_guard lock(s_Data.PassesMutex);
+		return s_Data.Passes;
+	}
+
+	float GPUProfiler::GetPassMilliseconds(const std::string& name)
+	{
+		std::lock_guard lock(s_Data.PassesMutex);
+		for (const auto& pass : s_Data.Passes)
+		{
+			if (pass.Name == name)
+				return pass.Milliseconds;
+		}
+
+		return 0.0f;
+	}
+
+	uint32_t GPUProfiler::GetDroppedFrames()
+	{
+		return s_Data.DroppedFrames;
+	}
+
+}
@@ -0,0 +1,34 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/GpuFence.hpp"
+#include "LunariaCore/Renderer/Renderer.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLGpuFence.hpp"
+#include "LunariaCore/RHI/Null/NullGpuFence.hpp"
+#include "LunariaCore/RHI/Software/SoftwareGpuFence.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanGpuFence.hpp"
+
+namespace Lunaria {
+
+	Ref<GpuFence> GpuFence::Create()
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+			return RenderThread::CreateResource<OpenGLGpuFence>();
+
+		case RendererAPI::API::None:
+			return CreateRef<NullGpuFence>();
+
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareGpuFence>();
+
+		case RendererAPI::API::Vulkan:
+			return CreateRef<VulkanGpuFence>();
+		}
+
+		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
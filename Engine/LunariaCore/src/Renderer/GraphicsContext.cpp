@@ -4,6 +4,9 @@
 
 #include "LunariaCore/Renderer/Renderer.hpp"
 #include "LunariaCore/RHI/OpenGL/OpenGLContext.hpp"
+#include "LunariaCore/RHI/Null/NullContext.hpp"
+#include "LunariaCore/RHI/Software/SoftwareContext.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanContext.hpp"
 
 namespace Lunaria {
 
@@ -12,7 +15,13 @@ namespace Lunaria {
         switch (Renderer::GetAPI())
         {
         case RendererAPI::API::None:
-            LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+            return CreateScope<NullContext>();
+
+        case RendererAPI::API::Software:
+            return CreateScope<SoftwareContext>(static_cast<SDL_Window*>(window));
+
+        case RendererAPI::API::Vulkan:
+            return CreateScope<VulkanContext>(static_cast<SDL_Window*>(window));
             
         case RendererAPI::API::OpenGL:
             return CreateScope<OpenGLContext>(static_cast<SDL_Window*>(window));
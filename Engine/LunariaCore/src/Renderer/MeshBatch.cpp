@@ -0,0 +1,30 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/MeshBatch.hpp"
+#include "LunariaCore/Renderer/Renderer.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLMeshBatch.hpp"
+#include "LunariaCore/RHI/Null/NullMeshBatch.hpp"
+
+namespace Lunaria {
+
+	Ref<MeshBatch> MeshBatch::Create(const MeshBatchSpecification& specification)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+			return RenderThread::CreateResource<OpenGLMeshBatch>(specification);
+
+		case RendererAPI::API::None:
+			return CreateRef<NullMeshBatch>(specification);
+
+		case RendererAPI::API::Software:
+		case RendererAPI::API::Vulkan:
+			return nullptr; // No indirect draws, Renderer::SubmitBatched uses the fallback shader
+		}
+
+		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
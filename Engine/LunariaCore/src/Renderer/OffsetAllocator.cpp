@@ -0,0 +1,99 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/OffsetAllocator.hpp"
+
+namespace Lunaria {
+
+	OffsetAllocator::OffsetAllocator(const uint32_t capacity, const uint32_t granularity)
+		: m_Capacity(capacity - capacity % granularity), m_Granularity(granularity)
+	{
+		LU_CORE_ASSERT(granularity > 0, "Offset allocator granularity can't be zero!");
+
+		if (m_Capacity)
+			InsertFreeRange(0, m_Capacity);
+	}
+
+	OffsetAllocator::Allocation OffsetAllocator::Allocate(const uint32_t size)
+	{
+		if (size == 0 || size > m_Capacity)
+			return {};
+
+		const uint32_t alignedSize = (size + m_Granularity - 1) / m_Granularity * m_Granularity;
+
+		// Smallest free range that fits, the rest of it stays free
+		const auto fit = m_FreeBySize.lower_bound(alignedSize);
+		if (fit == m_FreeBySize.end())
+			return {};
+
+		const uint32_t offset = fit->second;
+		const uint32_t rangeSize = fit->first;
+
+		EraseFreeRange(m_FreeByOffset.find(offset));
+		if (rangeSize > alignedSize)
+			InsertFreeRange(offset + alignedSize, rangeSize - alignedSize);
+
+		m_UsedSize += alignedSize;
+		return { offset, alignedSize };
+	}
+
+	void OffsetAllocator::Free(const Allocation& allocation)
+	{
+		if (!allocation.IsValid())
+			return;
+
+		LU_CORE_ASSERT(allocation.Offset + allocation.Size <= m_Capacity, "Allocation is not part of this allocator!");
+
+		uint32_t offset = allocation.Offset;
+		uint32_t size = allocation.Size;
+
+		// Merge with the free range that ends where this one starts
+		auto next = m_FreeByOffset.lower_bound(offset);
+		if (next != m_FreeByOffset.begin())
+		{
+			const auto previous = std::prev(next);
+			if (previous->first + previous->second == offset)
+			{
+				offset = previous->first;
+				size += previous->second;
+				EraseFreeRange(previous);
+			}
+		}
+
+		// And with the one starting where it ends
+		if (next != m_FreeByOffset.end() && next->first == allocation.Offset + allocation.Size)
+		{
+			size += next->second;
+			EraseFreeRange(next);
+		}
+
+		InsertFreeRange(offset, size);
+		m_UsedSize -= allocation.Size;
+	}
+
+	uint32_t OffsetAllocator::GetLargestFreeRange() const
+	{
+		return m_FreeBySize.empty() ? 0 : m_FreeBySize.rbegin()->first;
+	}
+
+	void OffsetAllocator::InsertFreeRange(const uint32_t offset, const uint32_t size)
+	{
+		m_FreeByOffset.emplace(offset, size);
+		m_FreeBySize.emplace(size, offset);
+	}
+
+	void OffsetAllocator::EraseFreeRange(const std::map<uint32_t, uint32_t>::iterator range)
+	{
+		auto [first, last] = m_FreeBySize.equal_range(range->second);
+		for (auto it = first; it != last; ++it)
+		{
+			if (it->second == range->first)
+			{
+				m_FreeBySize.erase(it);
+				break;
+			}
+		}
+
+		m_FreeByOffset.erase(range);
+	}
+
+}
@@ -2,10 +2,9 @@
 
 #include "LunariaCore/Renderer/RenderCommand.hpp"
 
-#include "LunariaCore/RHI/OpenGL/OpenGLRendererAPI.hpp"
-
 namespace Lunaria {
 
-	Scope<RendererAPI> RenderCommand::s_RendererAPI = RendererAPI::Create();
+	Scope<RendererAPI> RenderCommand::s_RendererAPI = nullptr; // Created in Init, after the API was chosen
+	RendererAPI::StateStatistics RenderCommand::s_LastStateStats;
 
 }
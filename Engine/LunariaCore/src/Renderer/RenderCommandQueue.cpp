@@ -0,0 +1,76 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/RenderCommandQueue.hpp"
+
+namespace Lunaria {
+
+	static constexpr uint32_t CommandAlignment = alignof(std::max_align_t);
+
+	struct alignas(CommandAlignment) CommandHeader
+	{
+		RenderCommandQueue::CommandFn Fn = nullptr; // Null for data blocks
+		uint32_t Size = 0; // Payload size, rounded up to CommandAlignment
+	};
+
+	static constexpr uint32_t AlignSize(const uint32_t size)
+	{
+		return (size + CommandAlignment - 1) & ~(CommandAlignment - 1);
+	}
+
+	RenderCommandQueue::~RenderCommandQueue()
+	{
+		// Commands that were never executed still own their captures
+		Execute();
+
+		for (const auto& page : m_Pages)
+			::operator delete(page.Memory, std::align_val_t(CommandAlignment));
+	}
+
+	void* RenderCommandQueue::Allocate(const CommandFn fn, const uint32_t size)
+	{
+		const uint32_t payloadSize = AlignSize(size);
+		const uint32_t entrySize = static_cast<uint32_t>(sizeof(CommandHeader)) + payloadSize;
+
+		// Move on to the next page, commands can't be relocated once they were constructed
+		while (m_PageIndex < m_Pages.size() && m_Pages[m_PageIndex].Size - m_Pages[m_PageIndex].Used < entrySize)
+			m_PageIndex++;
+
+		if (m_PageIndex == m_Pages.size())
+		{
+			Page& page = m_Pages.emplace_back();
+			page.Size = std::max(PageSize, entrySize);
+			page.Memory = static_cast<uint8_t*>(::operator new(page.Size, std::align_val_t(CommandAlignment)));
+		}
+
+		Page& page = m_Pages[m_PageIndex];
+		auto* header = new (page.Memory + page.Used) CommandHeader{ fn, payloadSize };
+		page.Used += entrySize;
+
+		if (fn)
+			m_CommandCount++;
+
+		return header + 1;
+	}
+
+	void RenderCommandQueue::Execute()
+	{
+		for (auto& page : m_Pages)
+		{
+			uint32_t offset = 0;
+			while (offset < page.Used)
+			{
+				const auto* header = reinterpret_cast<const CommandHeader*>(page.Memory + offset);
+				if (header->Fn)
+					header->Fn(const_cast<CommandHeader*>(header) + 1);
+
+				offset += static_cast<uint32_t>(sizeof(CommandHeader)) + header->Size;
+			}
+
+			page.Used = 0;
+		}
+
+		m_PageIndex = 0;
+		m_CommandCount = 0;
+	}
+
+}
@@ -0,0 +1,333 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/RenderThread.hpp"
+#include "LunariaCore/Renderer/GraphicsContext.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Lunaria {
+
+	using Clock = std::chrono::steady_clock;
+
+	struct PendingRelease
+	{
+		uint64_t Frame = 0;
+		std::function<void()> Func;
+	};
+
+	struct RenderThreadData
+	{
+		bool Enabled = false;
+		std::atomic<bool> Running = false;
+
+		std::thread Thread;
+		GraphicsContext* Context = nullptr;
+
+		// One queue is recorded while the other one executes
+		std::array<RenderCommandQueue, 2> Queues;
+		uint32_t RecordIndex = 0;
+
+		std::mutex Mutex;
+		std::condition_variable WorkAvailable, WorkDone;
+
+		// Guarded by Mutex
+		RenderCommandQueue* Pending = nullptr;
+		uint64_t PendingFrame = 0; // 0 for flushes, they don't close a frame
+		bool Exit = false;
+		RenderThread::Statistics Stats;
+
+		// Main thread only, published to Stats at EndFrame
+		uint32_t FrameCommands = 0;
+		uint32_t FrameFlushes = 0;
+
+		std::atomic<uint64_t> RecordFrame = 1;
+		std::atomic<uint64_t> CompletedFrame = 0;
+
+		std::mutex CallbackMutex;
+		std::deque<PendingRelease> Releases; // Ordered by frame
+		std::vector<std::function<void()>> MainThreadQueue;
+	};
+
+	static RenderThreadData s_Data;
+
+	thread_local bool t_IsRenderThread = false;
+
+	static float MillisecondsSince(const Clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	static void RunReleases(const uint64_t completedFrame, const bool all)
+	{
+		while (true)
+		{
+			std::function<void()> func;
+			{
+				std::lock_guard lock(s_Data.CallbackMutex);
+				if (s_Data.Releases.empty() || (!all && s_Data.Releases.front().Frame > completedFrame))
+					return;
+
+				func = std::move(s_Data.Releases.front().Func);
+				s_Data.Releases.pop_front();
+			}
+
+			// Destructors may release more resources, the lock is not held
+			func();
+		}
+	}
+
+	static void RenderThreadLoop()
+	{
+		t_IsRenderThread = true;
+		s_Data.Context->MakeCurrent();
+
+		while (true)
+		{
+			RenderCommandQueue* queue;
+			uint64_t frame;
+			{
+				std::unique_lock lock(s_Data.Mutex);
+				s_Data.WorkAvailable.wait(lock, [] { return s_Data.Pending || s_Data.Exit; });
+
+				if (!s_Data.Pending)
+					break;
+
+				queue = s_Data.Pending;
+				frame = s_Data.PendingFrame;
+			}
+
+			const auto start = Clock::now();
+			queue->Execute();
+
+			if (frame)
+			{
+				s_Data.CompletedFrame = frame;
+				RunReleases(frame, false);
+			}
+
+			{
+				std::lock_guard lock(s_Data.Mutex);
+				if (frame)
+					s_Data.Stats.ExecuteMilliseconds = MillisecondsSince(start);
+				s_Data.Pending = nullptr;
+			}
+			s_Data.WorkDone.notify_all();
+		}
+
+		RunReleases(0, true);
+		s_Data.Context->ReleaseCurrent();
+	}
+
+	// Waits for the render thread, then gives it the recorded queue
+	static void Kick(const uint64_t frame)
+	{
+		RenderCommandQueue& queue = s_Data.Queues[s_Data.RecordIndex];
+		s_Data.FrameCommands += queue.GetCommandCount();
+
+		{
+			std::unique_lock lock(s_Data.Mutex);
+			s_Data.WorkDone.wait(lock, [] { return !s_Data.Pending; });
+
+			s_Data.Pending = &queue;
+			s_Data.PendingFrame = frame;
+		}
+		s_Data.WorkAvailable.notify_one();
+
+		s_Data.RecordIndex = (s_Data.RecordIndex + 1) % static_cast<uint32_t>(s_Data.Queues.size());
+	}
+
+	static void WaitIdle()
+	{
+		std::unique_lock lock(s_Data.Mutex);
+		s_Data.WorkDone.wait(lock, [] { return !s_Data.Pending; });
+	}
+
+	static void RunMainThreadQueue()
+	{
+		std::vector<std::function<void()>> queue;
+		{
+			std::lock_guard lock(s_Data.CallbackMutex);
+			queue.swap(s_Data.MainThreadQueue);
+		}
+
+		for (const auto& func : queue)
+			func();
+	}
+
+	void RenderThread::SetEnabled(const bool enabled)
+	{
+		LU_CORE_ASSERT(!IsRunning(), "Render thread mode can't change while it is running!");
+		s_Data.Enabled = enabled;
+	}
+
+	bool RenderThread::IsEnabled()
+	{
+		return s_Data.Enabled;
+	}
+
+	void RenderThread::Start(GraphicsContext& context)
+	{
+		if (IsRunning())
+			return;
+
+		// The context can only be current on one thread
+		context.ReleaseCurrent();
+
+		s_Data.Context = &context;
+		s_Data.Exit = false;
+		s_Data.Stats = {};
+		s_Data.FrameCommands = 0;
+		s_Data.FrameFlushes = 0;
+		s_Data.Running = true;
+		s_Data.Thread = std::thread(RenderThreadLoop);
+
+		LU_CORE_INFO("Render thread started");
+	}
+
+	void RenderThread::Stop()
+	{
+		if (!IsRunning())
+			return;
+
+		// Close the last frame so every pending release runs
+		Kick(s_Data.RecordFrame++);
+
+		{
+			std::unique_lock lock(s_Data.Mutex);
+			s_Data.WorkDone.wait(lock, [] { return !s_Data.Pending; });
+			s_Data.Exit = true;
+		}
+		s_Data.WorkAvailable.notify_one();
+		s_Data.Thread.join();
+
+		s_Data.Running = false;
+		RunMainThreadQueue();
+
+		s_Data.Context->MakeCurrent();
+		s_Data.Context = nullptr;
+
+		LU_CORE_INFO("Render thread stopped");
+	}
+
+	bool RenderThread::IsRunning()
+	{
+		return s_Data.Running;
+	}
+
+	bool RenderThread::IsRenderThread()
+	{
+		return t_IsRenderThread;
+	}
+
+	bool RenderThread::IsRecording()
+	{
+		return s_Data.Running && !t_IsRenderThread;
+	}
+
+	RenderCommandQueue& RenderThread::GetRecordQueue()
+	{
+		return s_Data.Queues[s_Data.RecordIndex];
+	}
+
+	const void* RenderThread::CopyFrameData(const void* data, const uint32_t size)
+	{
+		if (!IsRecording() || size == 0)
+			return data;
+
+		void* copy = GetRecordQueue().AllocateData(size);
+		memcpy(copy, data, size);
+		return copy;
+	}
+
+	void RenderThread::Flush()
+	{
+		if (!IsRecording())
+			return;
+
+		Kick(0);
+		WaitIdle();
+
+		s_Data.FrameFlushes++;
+	}
+
+	void RenderThread::EndFrame()
+	{
+		if (!IsRecording())
+			return;
+
+		// Frame N-1 must be done before frame N+1 can be recorded into its queue
+		const auto start = Clock::now();
+		WaitIdle();
+		const float waitMilliseconds = MillisecondsSince(start);
+
+		RunMainThreadQueue();
+
+		Kick(s_Data.RecordFrame++);
+
+		{
+			std::lock_guard lock(s_Data.Mutex);
+			s_Data.Stats.WaitMilliseconds = waitMilliseconds;
+			s_Data.Stats.RecordedCommands = s_Data.FrameCommands;
+			s_Data.Stats.Flushes = s_Data.FrameFlushes;
+		}
+
+		s_Data.FrameCommands = 0;
+		s_Data.FrameFlushes = 0;
+	}
+
+	uint64_t RenderThread::GetRecordFrame()
+	{
+		return s_Data.RecordFrame;
+	}
+
+	uint64_t RenderThread::GetCompletedFrame()
+	{
+		return s_Data.CompletedFrame;
+	}
+
+	void RenderThread::WaitForFrame(const uint64_t frame)
+	{
+		LU_CORE_ASSERT(!IsRenderThread(), "The render thread can't wait for itself!");
+
+		if (!IsRunning() || frame >= s_Data.RecordFrame)
+			return; // Not kicked yet, waiting would never return
+
+		std::unique_lock lock(s_Data.Mutex);
+		s_Data.WorkDone.wait(lock, [frame] { return s_Data.CompletedFrame >= frame; });
+	}
+
+	void RenderThread::SubmitResourceFree(std::function<void()>&& func)
+	{
+		if (!IsRunning())
+		{
+			func();
+			return;
+		}
+
+		std::lock_guard lock(s_Data.CallbackMutex);
+		s_Data.Releases.push_back({ s_Data.RecordFrame, std::move(func) });
+	}
+
+	void RenderThread::SubmitToMainThread(std::function<void()>&& func)
+	{
+		if (!IsRunning())
+		{
+			func();
+			return;
+		}
+
+		std::lock_guard lock(s_Data.CallbackMutex);
+		s_Data.MainThreadQueue.push_back(std::move(func));
+	}
+
+	RenderThread::Statistics RenderThread::GetStats()
+	{
+		std::lock_guard lock(s_Data.Mutex);
+		return s_Data.Stats;
+	}
+
+}
@@ -2,20 +2,85 @@
 
 #include "LunariaCore/Renderer/Renderer.hpp"
 #include "LunariaCore/Renderer/Renderer2D.hpp"
+#include "LunariaCore/Renderer/MeshBatch.hpp"
+#include "LunariaCore/Renderer/GPUProfiler.hpp"
+#include "LunariaCore/Renderer/FrameSync.hpp"
 
 namespace Lunaria {
 
 	Scope<Renderer::SceneData> Renderer::s_SceneData = CreateScope<SceneData>();
 
+	struct BatchedMesh
+	{
+		std::weak_ptr<VertexArray> Source; // Detects a reused address of a destroyed vertex array
+		Ref<MeshBatch> Batch;
+		uint32_t Mesh = MeshBatch::InvalidMesh;
+	};
+
+	struct ShaderBatches
+	{
+		std::weak_ptr<Shader> BatchShader; // The batches don't keep the shader alive
+		std::vector<Ref<MeshBatch>> Batches; // One or more per vertex format
+		std::unordered_map<const VertexArray*, BatchedMesh> Meshes;
+	};
+
+	static std::unordered_map<const Shader*, ShaderBatches> s_ShaderBatches;
+
+	static void RemoveBatchedMesh(const BatchedMesh& mesh)
+	{
+		if (mesh.Mesh != MeshBatch::InvalidMesh)
+			mesh.Batch->RemoveMesh(mesh.Mesh);
+	}
+
+	// Frees the arena ranges of destroyed vertex arrays, then the batches and shaders left empty
+	static void SweepBatches()
+	{
+		for (auto it = s_ShaderBatches.begin(); it != s_ShaderBatches.end();)
+		{
+			ShaderBatches& shaderBatches = it->second;
+			if (shaderBatches.BatchShader.expired())
+			{
+				for (const auto& [vertexArray, mesh] : shaderBatches.Meshes)
+					RemoveBatchedMesh(mesh);
+				it = s_ShaderBatches.erase(it);
+				continue;
+			}
+
+			std::erase_if(shaderBatches.Meshes, [](const auto& entry)
+			{
+				if (!entry.second.Source.expired())
+					return false;
+
+				RemoveBatchedMesh(entry.second);
+				return true;
+			});
+			std::erase_if(shaderBatches.Batches, [](const Ref<MeshBatch>& batch) { return batch->GetMeshCount() == 0; });
+
+			it = shaderBatches.Meshes.empty() ? s_ShaderBatches.erase(it) : std::next(it);
+		}
+	}
+
+	static Scope<TextureStreamer> s_TextureStreamer;
+
 	void Renderer::Init()
 	{
 		RenderCommand::Init();
+		FrameSync::Init();
+		GPUProfiler::Init();
 		Renderer2D::Init();
+
+		s_TextureStreamer = TextureStreamer::Create();
 	}
 
 	void Renderer::Shutdown()
 	{
+		s_ShaderBatches.clear();
+		s_TextureStreamer.reset();
+
 		Renderer2D::Shutdown();
+		GPUProfiler::Shutdown();
+		FrameSync::Shutdown();
+		RenderCommand::Shutdown();
 	}
 
 	void Renderer::OnWindowResize(const uint32_t width, const uint32_t height)
@@ -23,13 +88,42 @@ namespace Lunaria {
 		RenderCommand::SetViewport(0, 0, width, height);
 	}
 
+	TextureStreamer& Renderer::GetTextureStreamer()
+	{
+		LU_CORE_ASSERT(s_TextureStreamer, "Renderer is not initialized!");
+		return *s_TextureStreamer;
+	}
+
 	void Renderer::BeginScene(OrthographicCamera& camera)
 	{
 		s_SceneData->ViewProjectionMatrix = camera.GetViewProjectionMatrix();
 	}
 
+	static void FlushBatch(const Ref<Shader>& shader, MeshBatch& batch, const glm::mat4& viewProjection, Renderer::Statistics& stats)
+	{
+		shader->Bind();
+		shader->SetMat4("u_ViewProjection", viewProjection);
+
+		batch.Flush();
+		stats.DrawCalls++;
+	}
+
 	void Renderer::EndScene()
 	{
+		for (auto& [key, shaderBatches] : s_ShaderBatches)
+		{
+			const Ref<Shader> shader = shaderBatches.BatchShader.lock();
+			if (!shader)
+				continue;
+
+			for (const auto& batch : shaderBatches.Batches)
+			{
+				if (batch->GetDrawCount() > 0)
+					FlushBatch(shader, *batch, s_SceneData->ViewProjectionMatrix, s_SceneData->Stats);
+			}
+		}
+
+		SweepBatches();
 	}
 
 	void Renderer::Submit(const Ref<Shader>& shader, 
@@ -41,6 +135,106 @@ namespace Lunaria {
 
 		vertexArray->Bind();
 		RenderCommand::DrawIndexed(vertexArray, vertexArray->GetIndexBuffer()->GetCount());
+
+		s_SceneData->Stats.DrawCalls++;
+		s_SceneData->Stats.MeshCount++;
+	}
+
+	static BatchedMesh* FindOrAddBatchedMesh(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray)
+	{
+		auto& shaderBatches = s_ShaderBatches[shader.get()];
+
+		// A destroyed shader whose address was reused, nothing of its batches applies
+		if (shaderBatches.BatchShader.lock() != shader)
+		{
+			for (const auto& [key, mesh] : shaderBatches.Meshes)
+				RemoveBatchedMesh(mesh);
+			shaderBatches = {};
+			shaderBatches.BatchShader = shader;
+		}
+
+		if (const auto it = shaderBatches.Meshes.find(vertexArray.get()); it != shaderBatches.Meshes.end())
+		{
+			if (!it->second.Source.expired())
+				return it->second.Mesh == MeshBatch::InvalidMesh ? nullptr : &it->second;
+
+			// Same address, different vertex array
+			RemoveBatchedMesh(it->second);
+		}
+
+		BatchedMesh entry;
+		entry.Source = vertexArray;
+
+		const auto& vertexBuffers = vertexArray->GetVertexBuffers();
+		if (vertexBuffers.size() == 1)
+		{
+			const BufferLayout& layout = vertexBuffers[0]->GetLayout();
+			for (const auto& batch : shaderBatches.Batches)
+			{
+				if (!(batch->GetSpecification().Layout == layout))
+					continue;
+
+				entry.Mesh = batch->AddMesh(vertexArray);
+				if (entry.Mesh != MeshBatch::InvalidMesh)
+				{
+					entry.Batch = batch;
+					break;
+				}
+			}
+
+			// No batch with this format has room left, open a new one
+			if (entry.Mesh == MeshBatch::InvalidMesh)
+			{
+				MeshBatchSpecification specification;
+				specification.Layout = layout;
+
+				// Backends without indirect draws have no batches
+				const Ref<MeshBatch> batch = MeshBatch::Create(specification);
+				entry.Mesh = batch ? batch->AddMesh(vertexArray) : MeshBatch::InvalidMesh;
+				if (entry.Mesh != MeshBatch::InvalidMesh)
+				{
+					entry.Batch = batch;
+					shaderBatches.Batches.push_back(batch);
+				}
+			}
+		}
+
+		// Unbatchable meshes are remembered too, so they go straight to the fallback next time
+		auto& stored = shaderBatches.Meshes[vertexArray.get()] = entry;
+		return stored.Mesh == MeshBatch::InvalidMesh ? nullptr : &stored;
+	}
+
+	void Renderer::SubmitBatched(const Ref<Shader>& shader, const Ref<Shader>& fallbackShader,
+		const Ref<VertexArray>& vertexArray, const glm::mat4& transform)
+	{
+		// The batch shader has no u_Transform, a single draw with it would read the storage buffer
+		BatchedMesh* mesh = FindOrAddBatchedMesh(shader, vertexArray);
+		if (!mesh)
+		{
+			Submit(fallbackShader, vertexArray, transform);
+			return;
+		}
+
+		if (!mesh->Batch->Submit(mesh->Mesh, transform))
+		{
+			// Full, the draws so far go out now and the batch starts over
+			FlushBatch(shader, *mesh->Batch, s_SceneData->ViewProjectionMatrix, s_SceneData->Stats);
+			[[maybe_unused]] const bool submitted = mesh->Batch->Submit(mesh->Mesh, transform);
+			LU_CORE_ASSERT(submitted, "Mesh batch is full right after a flush!");
+		}
+
+		s_SceneData->Stats.MeshCount++;
+		s_SceneData->Stats.BatchedMeshCount++;
+	}
+
+	void Renderer::ResetStats()
+	{
+		s_SceneData->Stats = {};
+	}
+
+	Renderer::Statistics Renderer::GetStats()
+	{
+		return s_SceneData->Stats;
 	}
 
 }
@@ -53,7 +53,7 @@ namespace Lunaria {
     void Renderer2D::Init()
     {
         s_Data.QuadVertexArray = VertexArray::Create();
-        s_Data.QuadVertexBuffer = VertexBuffer::Create(RendererData::MaxVertices * sizeof(QuadVertex));
+        s_Data.QuadVertexBuffer = VertexBuffer::Create(RendererData::MaxVertices * sizeof(QuadVertex), BufferUsage::Stream);
 
         s_Data.QuadVertexBuffer->SetLayout({
             {ShaderDataType::Float3, "a_Position"},
@@ -3,6 +3,9 @@
 #include "LunariaCore/Renderer/RendererAPI.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLRendererAPI.hpp"
+#include "LunariaCore/RHI/Null/NullRendererAPI.hpp"
+#include "LunariaCore/RHI/Software/SoftwareRendererAPI.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanRendererAPI.hpp"
 
 namespace Lunaria {
 
@@ -13,7 +16,13 @@ namespace Lunaria {
 		switch (s_RendererAPI)
 		{
 		case API::None:
-			LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			return CreateScope<NullRendererAPI>();
+
+		case API::Software:
+			return CreateScope<SoftwareRendererAPI>();
+
+		case API::Vulkan:
+			return CreateScope<VulkanRendererAPI>();
 			
 		case API::OpenGL:
 			return CreateScope<OpenGLRendererAPI>();
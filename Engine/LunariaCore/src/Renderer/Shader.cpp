@@ -4,6 +4,9 @@
 #include "LunariaCore/Renderer/Renderer.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLShader.hpp"
+#include "LunariaCore/RHI/Null/NullShader.hpp"
+#include "LunariaCore/RHI/Software/SoftwareShader.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanShader.hpp"
 
 namespace Lunaria {
 
@@ -12,11 +15,16 @@ namespace Lunaria {
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLShader>(filepath);
+			return RenderThread::CreateResource<OpenGLShader>(filepath);
 
-		case RendererAPI::API::None:    
-			LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!")
-			return nullptr;
+		case RendererAPI::API::None:
+			return CreateRef<NullShader>(filepath);
+
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareShader>(filepath);
+
+		case RendererAPI::API::Vulkan:
+			return CreateRef<VulkanShader>(filepath);
 		}
 
 		LU_CORE_ASSERT(false, "Unknown RendererAPI!")
@@ -28,11 +36,16 @@ namespace Lunaria {
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
+			return RenderThread::CreateResource<OpenGLShader>(name, vertexSrc, fragmentSrc);
+
+		case RendererAPI::API::None:
+			return CreateRef<NullShader>(name, vertexSrc, fragmentSrc);
+
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareShader>(name, vertexSrc, fragmentSrc);
 
-		case RendererAPI::API::None:    
-			LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!")
-			return nullptr;
+		case RendererAPI::API::Vulkan:
+			return CreateRef<VulkanShader>(name, vertexSrc, fragmentSrc);
 		}
 
 		LU_CORE_ASSERT(false, "Unknown RendererAPI!")
@@ -2,41 +2,60 @@
 
 #include "LunariaCore/Renderer/Texture.hpp"
 #include "LunariaCore/Renderer/Renderer.hpp"
+#include "LunariaCore/Renderer/TextureStreamer.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLTexure.hpp"
+#include "LunariaCore/RHI/Null/NullTexture.hpp"
+#include "LunariaCore/RHI/Software/SoftwareTexture.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanTexture.hpp"
 
 namespace Lunaria {
     
-    Ref<Texture2D> Texture2D::Create(const std::string& path)
+    Ref<Texture2D> Texture2D::Create(const std::string& path, const TextureSpecification& specification)
     {
         switch (Renderer::GetAPI())
         {
         case RendererAPI::API::OpenGL:
-            return CreateRef<OpenGLTexture2D>(path);
+            return RenderThread::CreateResource<OpenGLTexture2D>(path, specification);
 
-        case RendererAPI::API::None:    
-            LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
-            return nullptr;
+        case RendererAPI::API::None:
+            return CreateRef<NullTexture2D>(path, specification);
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareTexture2D>(path, specification);
+
+        case RendererAPI::API::Vulkan:
+            return CreateRef<VulkanTexture2D>(path, specification);
         }
 
         LU_CORE_ASSERT(false, "Unknown RendererAPI!");
         return nullptr;
     }
 
-    Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height)
+    Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height, const TextureSpecification& specification)
     {
         switch (Renderer::GetAPI())
         {
         case RendererAPI::API::OpenGL:
-            return CreateRef<OpenGLTexture2D>(width, height);
+            return RenderThread::CreateResource<OpenGLTexture2D>(width, height, specification);
+
+        case RendererAPI::API::None:
+            return CreateRef<NullTexture2D>(width, height, specification);
+
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareTexture2D>(width, height, specification);
 
-        case RendererAPI::API::None:    
-            LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
-            return nullptr;
+        case RendererAPI::API::Vulkan:
+            return CreateRef<VulkanTexture2D>(width, height, specification);
         }
 
         LU_CORE_ASSERT(false, "Unknown RendererAPI!");
         return nullptr;
     }
 
+    Ref<Texture2D> Texture2D::CreateAsync(const std::string& path, const TextureSpecification& specification)
+    {
+        return Renderer::GetTextureStreamer().Load(path, specification);
+    }
+
 }
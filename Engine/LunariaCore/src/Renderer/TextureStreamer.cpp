@@ -0,0 +1,34 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/TextureStreamer.hpp"
+#include "LunariaCore/Renderer/Renderer.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLTextureStreamer.hpp"
+#include "LunariaCore/RHI/Null/NullTexture.hpp"
+#include "LunariaCore/RHI/Software/SoftwareTexture.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanTexture.hpp"
+
+namespace Lunaria {
+
+	Scope<TextureStreamer> TextureStreamer::Create(const TextureStreamerSpecification& specification)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+			return CreateScope<OpenGLTextureStreamer>(specification);
+
+		case RendererAPI::API::None:
+			return CreateScope<NullTextureStreamer>();
+
+		case RendererAPI::API::Software:
+			return CreateScope<SoftwareTextureStreamer>();
+
+		case RendererAPI::API::Vulkan:
+			return CreateScope<VulkanTextureStreamer>();
+		}
+
+		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,34 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Renderer/TimerQuery.hpp"
+#include "LunariaCore/Renderer/Renderer.hpp"
+
+#include "LunariaCore/RHI/OpenGL/OpenGLTimerQuery.hpp"
+#include "LunariaCore/RHI/Null/NullTimerQuery.hpp"
+#include "LunariaCore/RHI/Software/SoftwareTimerQuery.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanTimerQuery.hpp"
+
+namespace Lunaria {
+
+	Scope<TimerQueryPool> TimerQueryPool::Create(uint32_t count)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::OpenGL:
+			return CreateScope<OpenGLTimerQueryPool>(count);
+
+		case RendererAPI::API::None:
+			return CreateScope<NullTimerQueryPool>(count);
+
+		case RendererAPI::API::Software:
+			return CreateScope<SoftwareTimerQueryPool>(count);
+
+		case RendererAPI::API::Vulkan:
+			return CreateScope<VulkanTimerQueryPool>(count);
+		}
+
+		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -4,6 +4,9 @@
 #include "LunariaCore/Renderer/Renderer.hpp"
 
 #include "LunariaCore/RHI/OpenGL/OpenGLVertexArray.hpp"
+#include "LunariaCore/RHI/Null/NullVertexArray.hpp"
+#include "LunariaCore/RHI/Software/SoftwareVertexArray.hpp"
+#include "LunariaCore/RHI/Vulkan/VulkanVertexArray.hpp"
 
 namespace Lunaria {
 
@@ -12,11 +15,16 @@ namespace Lunaria {
 		switch (Renderer::GetAPI())
 		{
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLVertexArray>();
+			return RenderThread::CreateResource<OpenGLVertexArray>();
 
-		case RendererAPI::API::None:    
-			LU_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
-			return nullptr;
+		case RendererAPI::API::None:
+			return CreateRef<NullVertexArray>();
+
+		case RendererAPI::API::Software:
+			return CreateRef<SoftwareVertexArray>();
+
+		case RendererAPI::API::Vulkan:
+			return CreateRef<VulkanVertexArray>();
 		}
 
 		LU_CORE_ASSERT(false, "Unknown RendererAPI!");
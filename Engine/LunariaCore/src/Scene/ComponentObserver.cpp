@@ -0,0 +1,40 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Scene/ComponentObserver.hpp"
+
+namespace Lunaria {
+
+	void ComponentObserver::Clear()
+	{
+		for (const entt::entity entity : m_Entities)
+			m_Positions[entt::to_entity(entity)] = 0;
+
+		m_Entities.clear();
+		m_Reset = false;
+	}
+
+	void ComponentObserver::Reset()
+	{
+		Clear();
+		m_Reset = true;
+	}
+
+	void ComponentObserver::OnChange(entt::registry& /*registry*/, const entt::entity entity)
+	{
+		if (m_Reset)
+			return;
+
+		const uint32_t index = entt::to_entity(entity);
+		if (index >= m_Positions.size())
+			m_Positions.resize(index + 1);
+
+		// A recycled id is listed next to the destroyed one, both have changed
+		const uint32_t position = m_Positions[index];
+		if (position && m_Entities[position - 1] == entity)
+			return;
+
+		m_Entities.push_back(entity);
+		m_Positions[index] = static_cast<uint32_t>(m_Entities.size());
+	}
+
+}
@@ -10,4 +10,14 @@ namespace Lunaria {
 	{
 	}
 
+	void Entity::SetParent(const Entity parent)
+	{
+		m_Scene->SetParent(*this, parent);
+	}
+
+	Entity Entity::GetParent() const
+	{
+		return m_Scene->GetParent(*this);
+	}
+
 }
\ No newline at end of file
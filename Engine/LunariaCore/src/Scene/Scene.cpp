@@ -5,92 +5,897 @@
 #include "LunariaCore/Scene/Entity.hpp"
 #include "LunariaCore/Scene/Components.hpp"
 
+#include "LunariaCore/Core/ThreadPool.hpp"
 #include "LunariaCore/Renderer/Renderer2D.hpp"
 
 #include <assert.h>
 
 namespace Lunaria {
 
+	static constexpr uint32_t s_NoParent = 0xffffffff;
+
+	// Levels narrower than this propagate on the calling thread, waking workers costs more
+	static constexpr uint32_t s_ParallelLevelSize = 16384;
+	static constexpr uint32_t s_PropagationChunkSize = 4096;
+
+	static StringID GetEntityTag(const std::string_view name)
+	{
+		static const StringID s_UnnamedTag("Unnamed entity");
+		return name.empty() ? s_UnnamedTag : StringID(name);
+	}
+
+	// World space bounds of the unit quad a sprite is drawn as
+	static void GetSpriteBounds(const glm::mat4& transform, glm::vec2& outMin, glm::vec2& outMax)
+	{
+		const glm::vec2 center = transform[3];
+		const glm::vec2 extent = 0.5f * (glm::abs(glm::vec2(transform[0])) + glm::abs(glm::vec2(transform[1])));
+		outMin = center - extent;
+		outMax = center + extent;
+	}
+
+	// Everything a copy or snapshot of a scene holds
+	template<typename... Component>
+	struct ComponentList {};
+	using AllComponents = ComponentList<TagComponent, TransformComponent, WorldTransformComponent, RelationshipComponent,
+		SpriteRendererComponent, CameraComponent, NativeScriptComponent, Rigidbody2DComponent, BoxCollider2DComponent, CircleCollider2DComponent>;
+
+	static void CopyEntities(const entt::registry& source, entt::registry& destination)
+	{
+		const auto& from = *source.storage<entt::entity>();
+		auto& to = destination.storage<entt::entity>();
+
+		// Released ids too, with their versions, so both registries hand out the same ids next
+		to.reserve(from.size());
+		for (size_t i = 0; i < from.size(); i++)
+			to.emplace(from.data()[i]);
+		to.in_use(from.in_use());
+	}
+
+	template<typename... Component>
+	static void CopyComponents(const entt::registry& source, entt::registry& destination, ComponentList<Component...>)
+	{
+		([&]()
+		{
+			const auto* from = source.storage<Component>();
+			if (!from || from->empty())
+				return;
+
+			// Packed order is kept, the transform storages stay sorted by hierarchy
+			const entt::sparse_set& entities = *from;
+			auto& to = destination.storage<Component>();
+			to.reserve(from->size());
+			to.insert(entities.rbegin(), entities.rend(), from->rbegin());
+		}(), ...);
+	}
+
+	// The destination's signals have to be disconnected, nothing is constructed or destroyed one by one
+	static void CopyRegistry(const entt::registry& source, entt::registry& destination)
+	{
+		destination.clear();
+		destination.storage<entt::entity>().clear();
+
+		CopyEntities(source, destination);
+		CopyComponents(source, destination, AllComponents{});
+
+		// Instances belong to the scene that created them
+		for (auto& script : destination.storage<NativeScriptComponent>())
+			script.Instance = nullptr;
+	}
+
 	Scene::Scene()
 	{
+		ConnectSignals();
+		m_CameraChanges = &Observe<CameraComponent>();
+
+		// Scripts can touch anything, so they get the frame to themselves
+		SystemSpecification scripts;
+		scripts.Name = "Scripts";
+		scripts.MainThread = true;
+		scripts.Exclusive = true;
+		m_Scheduler.Add(scripts, [](Scene& scene, Timestep ts) { scene.UpdateScripts(ts); });
+
+		AddSystem("Physics2D", Reads<BoxCollider2DComponent, CircleCollider2DComponent>{}, Writes<TransformComponent, Rigidbody2DComponent>{}, [](Scene& scene, Timestep ts)
+		{
+			ThreadPool* workers = SystemScheduler::IsRunningConcurrently() ? nullptr : &scene.GetWorkers();
+			scene.m_PhysicsWorld.Update(scene.m_Registry, ts, workers);
+		});
 	}
 
 	Scene::~Scene()
 	{
+		OnSceneStop();
 	}
 
-	Entity Scene::CreateEntity(const std::string& name)
+	Ref<Scene> Scene::Copy(const Ref<Scene>& other)
+	{
+		Ref<Scene> scene = CreateRef<Scene>();
+		scene->m_ViewportWidth = other->m_ViewportWidth;
+		scene->m_ViewportHeight = other->m_ViewportHeight;
+		scene->m_Scheduler = other->m_Scheduler;
+
+		scene->DisconnectSignals();
+		CopyRegistry(other->m_Registry, scene->m_Registry);
+		scene->ConnectSignals();
+		// Observers of a new scene start reset anyway
+
+		scene->m_HierarchyDirty = other->m_HierarchyDirty;
+		scene->m_ParentIndices = other->m_ParentIndices;
+		scene->m_LevelOffsets = other->m_LevelOffsets;
+
+		// Same entity ids, the bodies, sleep states and cached impulses carry over as they are
+		scene->m_PhysicsWorld = other->m_PhysicsWorld;
+		return scene;
+	}
+
+	void Scene::TakeSnapshot(SceneSnapshot& snapshot) const
+	{
+		CopyRegistry(m_Registry, snapshot.m_Registry);
+
+		snapshot.m_HierarchyDirty = m_HierarchyDirty;
+		snapshot.m_ParentIndices = m_ParentIndices;
+		snapshot.m_LevelOffsets = m_LevelOffsets;
+		snapshot.m_Valid = true;
+	}
+
+	void Scene::RestoreSnapshot(const SceneSnapshot& snapshot)
+	{
+		LU_CORE_ASSERT(snapshot.IsValid(), "Restoring an empty snapshot!");
+		if (!snapshot.IsValid())
+			return;
+
+		// Instances without the same script on the exact same entity in the snapshot, a recreated
+		// entity doesn't get the old one. Destroyed while their entities are still here.
+		std::vector<entt::entity> leftovers;
+		for (const auto [entity, script] : m_Registry.storage<NativeScriptComponent>().each())
+		{
+			const auto* restored = snapshot.m_Registry.valid(entity) ? snapshot.m_Registry.try_get<NativeScriptComponent>(entity) : nullptr;
+			if (script.Instance && (!restored || restored->CreatePool != script.CreatePool))
+				leftovers.push_back(entity);
+		}
+
+		for (const entt::entity entity : leftovers)
+		{
+			// OnDestroy of an earlier one may have destroyed this one already
+			auto* script = m_Registry.valid(entity) ? m_Registry.try_get<NativeScriptComponent>(entity) : nullptr;
+			if (script && script->Instance)
+				DestroyScript(*script);
+		}
+
+		// The remaining instances keep running with the restored components
+		std::unordered_map<entt::entity, ScriptableEntity*> instances;
+		for (const auto [entity, script] : m_Registry.storage<NativeScriptComponent>().each())
+		{
+			if (script.Instance)
+				instances.emplace(entity, script.Instance);
+		}
+
+		m_PendingScripts.clear();
+		DisconnectSignals();
+		CopyRegistry(snapshot.m_Registry, m_Registry);
+		ConnectSignals();
+
+		for (const auto& observer : m_Observers)
+			observer->Reset();
+
+		for (auto [entity, script] : m_Registry.storage<NativeScriptComponent>().each())
+		{
+			const auto it = instances.find(entity);
+			if (it != instances.end())
+				script.Instance = it->second;
+			else if (m_Playing)
+				m_PendingScripts.push_back(entity);
+		}
+
+		m_HierarchyDirty = snapshot.m_HierarchyDirty;
+		m_ParentIndices = snapshot.m_ParentIndices;
+		m_LevelOffsets = snapshot.m_LevelOffsets;
+		m_SpatialIndex.Clear();
+		m_SpatialIndexDirty = true;
+
+		// Velocities and sleep states are in the components, only the cached impulses are lost
+		m_PhysicsWorld.Invalidate();
+	}
+
+	void Scene::ConnectSignals()
+	{
+		m_Registry.on_construct<TransformComponent>().connect<&Scene::OnTransformConstruct>(*this);
+		m_Registry.on_update<TransformComponent>().connect<&Scene::OnTransformUpdate>(*this);
+		m_Registry.on_destroy<TransformComponent>().connect<&Scene::OnTransformDestroy>(*this);
+		m_Registry.on_destroy<RelationshipComponent>().connect<&Scene::OnRelationshipDestroy>(*this);
+		m_Registry.on_construct<SpriteRendererComponent>().connect<&Scene::OnSpriteConstruct>(*this);
+		m_Registry.on_destroy<SpriteRendererComponent>().connect<&Scene::OnSpriteDestroy>(*this);
+		m_Registry.on_construct<Rigidbody2DComponent>().connect<&Scene::OnRigidbodyConstruct>(*this);
+		m_Registry.on_destroy<Rigidbody2DComponent>().connect<&Scene::OnRigidbodyDestroy>(*this);
+		m_Registry.on_construct<BoxCollider2DComponent>().connect<&Scene::OnColliderChange>(*this);
+		m_Registry.on_update<BoxCollider2DComponent>().connect<&Scene::OnColliderChange>(*this);
+		m_Registry.on_destroy<BoxCollider2DComponent>().connect<&Scene::OnColliderChange>(*this);
+		m_Registry.on_construct<CircleCollider2DComponent>().connect<&Scene::OnColliderChange>(*this);
+		m_Registry.on_update<CircleCollider2DComponent>().connect<&Scene::OnColliderChange>(*this);
+		m_Registry.on_destroy<CircleCollider2DComponent>().connect<&Scene::OnColliderChange>(*this);
+		m_Registry.on_construct<NativeScriptComponent>().connect<&Scene::OnScriptConstruct>(*this);
+		m_Registry.on_destroy<NativeScriptComponent>().connect<&Scene::OnScriptDestroy>(*this);
+
+		for (const auto& observer : m_Observers)
+			observer->m_Connector(*observer, m_Registry, true);
+	}
+
+	void Scene::DisconnectSignals()
+	{
+		m_Registry.on_construct<TransformComponent>().disconnect(this);
+		m_Registry.on_update<TransformComponent>().disconnect(this);
+		m_Registry.on_destroy<TransformComponent>().disconnect(this);
+		m_Registry.on_destroy<RelationshipComponent>().disconnect(this);
+		m_Registry.on_construct<SpriteRendererComponent>().disconnect(this);
+		m_Registry.on_destroy<SpriteRendererComponent>().disconnect(this);
+		m_Registry.on_construct<Rigidbody2DComponent>().disconnect(this);
+		m_Registry.on_destroy<Rigidbody2DComponent>().disconnect(this);
+		m_Registry.on_construct<BoxCollider2DComponent>().disconnect(this);
+		m_Registry.on_update<BoxCollider2DComponent>().disconnect(this);
+		m_Registry.on_destroy<BoxCollider2DComponent>().disconnect(this);
+		m_Registry.on_construct<CircleCollider2DComponent>().disconnect(this);
+		m_Registry.on_update<CircleCollider2DComponent>().disconnect(this);
+		m_Registry.on_destroy<CircleCollider2DComponent>().disconnect(this);
+		m_Registry.on_construct<NativeScriptComponent>().disconnect(this);
+		m_Registry.on_destroy<NativeScriptComponent>().disconnect(this);
+
+		for (const auto& observer : m_Observers)
+			observer->m_Connector(*observer, m_Registry, false);
+	}
+
+	Entity Scene::CreateEntity(const std::string_view name)
 	{
 		Entity entity = { m_Registry.create(), this };
 		entity.AddComponent<TransformComponent>();
-		auto& tag = entity.AddComponent<TagComponent>();
-		tag.Tag = name.empty() ? "Unnamed entity" : name;
+		entity.AddComponent<TagComponent>(GetEntityTag(name));
 		return entity;
 	}
 
+	void Scene::CreateEntities(const uint32_t count, std::vector<Entity>& outEntities, const std::string_view name)
+	{
+		if (count == 0)
+			return;
+
+		m_CreatedEntities.resize(count);
+		m_Registry.create(m_CreatedEntities.begin(), m_CreatedEntities.end());
+
+		// The transform construct signal adds the other two one by one, they must not grow either
+		auto& transforms = m_Registry.storage<TransformComponent>();
+		auto& worldTransforms = m_Registry.storage<WorldTransformComponent>();
+		auto& relationships = m_Registry.storage<RelationshipComponent>();
+		auto& tags = m_Registry.storage<TagComponent>();
+		transforms.reserve(transforms.size() + count);
+		worldTransforms.reserve(worldTransforms.size() + count);
+		relationships.reserve(relationships.size() + count);
+		tags.reserve(tags.size() + count);
+
+		m_Registry.insert<TransformComponent>(m_CreatedEntities.begin(), m_CreatedEntities.end());
+		m_Registry.insert<TagComponent>(m_CreatedEntities.begin(), m_CreatedEntities.end(), TagComponent(GetEntityTag(name)));
+
+		outEntities.reserve(outEntities.size() + count);
+		for (const entt::entity entity : m_CreatedEntities)
+			outEntities.emplace_back(entity, this);
+	}
+
 	void Scene::DestroyEntity(Entity entity)
 	{
-		m_Registry.destroy(entity);
+		std::vector<entt::entity> subtree = { entity };
+		for (size_t i = 0; i < subtree.size(); i++)
+		{
+			// Removing the transform removes the relationship too, its children became roots then
+			const auto* relationship = m_Registry.try_get<RelationshipComponent>(subtree[i]);
+			if (!relationship)
+				continue;
+
+			for (entt::entity child = relationship->FirstChild; child != entt::null;
+				child = m_Registry.get<RelationshipComponent>(child).NextSibling)
+				subtree.push_back(child);
+		}
+
+		// Leaves first, nobody has to be detached from a parent that goes away anyway
+		for (auto it = subtree.rbegin(); it != subtree.rend(); ++it)
+			m_Registry.destroy(*it);
+	}
+
+	void Scene::SetParent(Entity entity, Entity parent)
+	{
+		auto& relationship = m_Registry.get<RelationshipComponent>(entity);
+		const entt::entity parentHandle = parent ? static_cast<entt::entity>(parent) : entt::null;
+		if (relationship.Parent == parentHandle)
+			return;
+
+		for (entt::entity ancestor = parentHandle; ancestor != entt::null; ancestor = m_Registry.get<RelationshipComponent>(ancestor).Parent)
+		{
+			if (ancestor == static_cast<entt::entity>(entity))
+			{
+				LU_CORE_WARN("An entity can't be parented to itself or one of its children");
+				return;
+			}
+		}
+
+		DetachFromParent(entity);
+
+		uint32_t depth = 0;
+		if (parentHandle != entt::null)
+		{
+			// Prepended, keeping the links O(1)
+			auto& parentRelationship = m_Registry.get<RelationshipComponent>(parentHandle);
+			relationship.Parent = parentHandle;
+			relationship.NextSibling = parentRelationship.FirstChild;
+			if (parentRelationship.FirstChild != entt::null)
+				m_Registry.get<RelationshipComponent>(parentRelationship.FirstChild).PreviousSibling = entity;
+
+			parentRelationship.FirstChild = entity;
+			parentRelationship.Children++;
+			depth = parentRelationship.Depth + 1;
+		}
+
+		UpdateDepth(entity, depth);
+		m_Registry.get<TransformComponent>(entity).Dirty = true;
+		m_HierarchyDirty = true;
+	}
+
+	Entity Scene::GetParent(Entity entity)
+	{
+		const entt::entity parent = m_Registry.get<RelationshipComponent>(entity).Parent;
+		return parent != entt::null ? Entity{ parent, this } : Entity{};
+	}
+
+	void Scene::DetachFromParent(const entt::entity entity)
+	{
+		auto& relationship = m_Registry.get<RelationshipComponent>(entity);
+		if (relationship.Parent == entt::null)
+			return;
+
+		auto& parentRelationship = m_Registry.get<RelationshipComponent>(relationship.Parent);
+		if (parentRelationship.FirstChild == entity)
+			parentRelationship.FirstChild = relationship.NextSibling;
+		parentRelationship.Children--;
+
+		if (relationship.PreviousSibling != entt::null)
+			m_Registry.get<RelationshipComponent>(relationship.PreviousSibling).NextSibling = relationship.NextSibling;
+		if (relationship.NextSibling != entt::null)
+			m_Registry.get<RelationshipComponent>(relationship.NextSibling).PreviousSibling = relationship.PreviousSibling;
+
+		relationship.Parent = entt::null;
+		relationship.NextSibling = entt::null;
+		relationship.PreviousSibling = entt::null;
+	}
+
+	void Scene::UpdateDepth(const entt::entity entity, const uint32_t depth)
+	{
+		std::vector<entt::entity> stack = { entity };
+		m_Registry.get<RelationshipComponent>(entity).Depth = depth;
+
+		while (!stack.empty())
+		{
+			const auto& relationship = m_Registry.get<RelationshipComponent>(stack.back());
+			stack.pop_back();
+
+			for (entt::entity child = relationship.FirstChild; child != entt::null;)
+			{
+				auto& childRelationship = m_Registry.get<RelationshipComponent>(child);
+				childRelationship.Depth = relationship.Depth + 1;
+				stack.push_back(child);
+				child = childRelationship.NextSibling;
+			}
+		}
 	}
 
 	void Scene::OnUpdate(Timestep ts)
 	{
-		// Update scripts
+		m_Scheduler.Run(*this, ts, GetWorkers());
+
+		UpdateWorldTransforms();
+		UpdateSpatialIndex();
+		UpdateCameras();
+		RenderScene();
+	}
+
+	void Scene::OnScenePlay()
+	{
+		if (m_Playing)
+			return;
+
+		m_Playing = true;
+		m_PendingScripts.clear();
+		for (auto [entity, script] : m_Registry.storage<NativeScriptComponent>().each())
 		{
-			m_Registry.view<NativeScriptComponent>().each([=](auto entity, auto& nsc)
-				{
-					// TODO: Move to Scene::OnScenePlay
-					if (!nsc.Instance)
-					{
-						nsc.Instance = nsc.InstantiateScript();
-						nsc.Instance->m_Entity = Entity{ entity, this };
+			if (!script.Instance && script.CreatePool)
+				InstantiateScript(entity, script);
+		}
+	}
+
+	void Scene::OnSceneStop()
+	{
+		m_Playing = false;
+		m_PendingScripts.clear();
+		for (auto& script : m_Registry.storage<NativeScriptComponent>())
+		{
+			if (script.Instance)
+				DestroyScript(script);
+		}
+	}
 
-						nsc.Instance->OnCreate();
-					}
+	void Scene::UpdateScripts(Timestep ts)
+	{
+		if (!m_Playing)
+			return;
 
-					nsc.Instance->OnUpdate(ts);
-				});
+		// Components are bound after they are added, so new scripts wait for the next update.
+		// Scripts added by OnCreate are queued again.
+		std::vector<entt::entity> pending;
+		pending.swap(m_PendingScripts);
+		for (const entt::entity entity : pending)
+		{
+			auto* script = m_Registry.try_get<NativeScriptComponent>(entity);
+			if (script && !script->Instance && script->CreatePool)
+				InstantiateScript(entity, *script);
 		}
 
-		// Render 2D
-		Camera* mainCamera = nullptr;
-		glm::mat4 cameraTransform;
+		for (const auto& [factory, pool] : m_ScriptPools)
+			pool->Update(ts);
+	}
+
+	void Scene::InstantiateScript(const entt::entity entity, NativeScriptComponent& script)
+	{
+		script.Instance = GetScriptPool(script.CreatePool).Allocate();
+		script.Instance->m_Entity = Entity{ entity, this };
+		script.Instance->OnCreate();
+	}
+
+	void Scene::DestroyScript(NativeScriptComponent& script)
+	{
+		// Cleared first, a script destroying its own entity in OnDestroy isn't destroyed twice
+		ScriptableEntity* instance = script.Instance;
+		script.Instance = nullptr;
+
+		instance->OnDestroy();
+		instance->m_Pool->Free(instance);
+	}
+
+	ScriptPool& Scene::GetScriptPool(const ScriptPoolFactory factory)
+	{
+		// A handful of script types, a linear search is enough
+		for (const auto& [poolFactory, pool] : m_ScriptPools)
 		{
-			const auto view = m_Registry.view<TransformComponent, CameraComponent>();
-			for (const auto entity : view)
+			if (poolFactory == factory)
+				return *pool;
+		}
+
+		return *m_ScriptPools.emplace_back(factory, factory()).second;
+	}
+
+	void Scene::UpdateCameras()
+	{
+		ComponentObserver& changes = *m_CameraChanges;
+		auto& cameras = m_Registry.storage<CameraComponent>();
+		const bool sized = m_ViewportWidth > 0 && m_ViewportHeight > 0;
+
+		// Writes that skipped PatchComponent aren't observed, the cached primary is checked every frame still.
+		// Without one, a camera made primary directly is looked for, there's nothing to render otherwise
+		bool findPrimary = changes.IsReset() || !cameras.contains(m_PrimaryCamera) || !cameras.get(m_PrimaryCamera).Primary
+			|| !m_Registry.all_of<WorldTransformComponent>(m_PrimaryCamera);
+
+		if (!findPrimary && sized)
+		{
+			CameraComponent& primary = cameras.get(m_PrimaryCamera);
+			if (!primary.FixedAspectRatio && primary.Camera.GetAspectRatio() != static_cast<float>(m_ViewportWidth) / static_cast<float>(m_ViewportHeight))
+				primary.Camera.SetViewportSize(m_ViewportWidth, m_ViewportHeight);
+		}
+
+		if (changes.IsEmpty() && !findPrimary)
+			return;
+
+		// Cameras created after the last resize, or no longer fixed to their aspect ratio
+		const auto resize = [&](CameraComponent& camera)
+		{
+			if (sized && !camera.FixedAspectRatio)
+				camera.Camera.SetViewportSize(m_ViewportWidth, m_ViewportHeight);
+		};
+
+		if (changes.IsReset())
+		{
+			for (auto& camera : cameras)
+				resize(camera);
+		}
+		else
+		{
+			for (const entt::entity entity : changes.GetEntities())
 			{
-				auto transform = view.get<TransformComponent>(entity);
-				auto camera = view.get<CameraComponent>(entity);
+				if (!cameras.contains(entity))
+					continue;
+
+				CameraComponent& camera = cameras.get(entity);
+				resize(camera);
+				findPrimary |= camera.Primary && entity != m_PrimaryCamera;
+			}
+		}
+		changes.Clear();
 
-				if (camera.Primary)
+		// Another camera made primary may come first, like walking all of them every frame would
+		if (findPrimary)
+		{
+			m_PrimaryCamera = entt::null;
+			const auto view = m_Registry.view<WorldTransformComponent, CameraComponent>();
+			for (const auto entity : view)
+			{
+				if (view.get<CameraComponent>(entity).Primary)
 				{
-					mainCamera = &camera.Camera;
-					cameraTransform = transform.GetTransform();
+					m_PrimaryCamera = entity;
 					break;
 				}
 			}
 		}
+	}
+
+	void Scene::RenderScene()
+	{
+		if (m_PrimaryCamera == entt::null)
+			return;
+
+		const auto* world = m_Registry.try_get<WorldTransformComponent>(m_PrimaryCamera);
+		if (!world)
+			return;
+
+		const SceneCamera* mainCamera = &m_Registry.get<CameraComponent>(m_PrimaryCamera).Camera;
+		const glm::mat4& cameraTransform = world->Transform;
 
-		if (mainCamera)
+		Renderer2D::BeginScene(*mainCamera, cameraTransform);
+
+		const auto view = m_Registry.view<WorldTransformComponent, SpriteRendererComponent>();
+
+		// An orthographic camera sees a box, only the sprites inside it are submitted
+		if (mainCamera->GetProjectionType() == SceneCamera::ProjectionType::Orthographic)
 		{
-			Renderer2D::BeginScene(*mainCamera, cameraTransform);
+			const glm::mat4 clipToWorld = cameraTransform * glm::inverse(mainCamera->GetProjection());
 
-			const auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
-			for (const auto entity : group)
+			glm::vec2 min(std::numeric_limits<float>::max()), max(std::numeric_limits<float>::lowest());
+			for (const glm::vec2 corner : { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(-1.0f, 1.0f), glm::vec2(1.0f, 1.0f) })
 			{
-				auto transform = group.get<TransformComponent>(entity);
-				auto sprite = group.get<SpriteRendererComponent>(entity);
+				const glm::vec2 point = clipToWorld * glm::vec4(corner, 0.0f, 1.0f);
+				min = glm::min(min, point);
+				max = glm::max(max, point);
+			}
+
+			m_VisibleSprites.clear();
+			m_SpatialIndex.Query(min, max, m_VisibleSprites);
+
+			// Same order as walking the whole view, overlapping sprites keep blending the same way. The view
+			// walks whichever of its storages was smaller when it was made, backwards
+			const auto& leading = *view.handle();
+			std::sort(m_VisibleSprites.begin(), m_VisibleSprites.end(), [&leading](const entt::entity lhs, const entt::entity rhs) { return leading.index(lhs) > leading.index(rhs); });
 
-				Renderer2D::DrawQuad(transform.GetTransform(), sprite.Color);
+			for (const auto entity : m_VisibleSprites)
+			{
+				const auto& [transform, sprite] = view.get<WorldTransformComponent, SpriteRendererComponent>(entity);
+
+				Renderer2D::DrawQuad(transform.Transform, sprite.Color);
 			}
+		}
+		else
+		{
+			// Not a group, the transform storages are sorted by hierarchy depth
+			for (const auto entity : view)
+			{
+				const auto& [transform, sprite] = view.get<WorldTransformComponent, SpriteRendererComponent>(entity);
 
-			Renderer2D::EndScene();
+				Renderer2D::DrawQuad(transform.Transform, sprite.Color);
+			}
 		}
 
+		Renderer2D::EndScene();
+	}
+
+	void Scene::QueryAABB(const glm::vec2& min, const glm::vec2& max, std::vector<Entity>& outEntities)
+	{
+		std::vector<entt::entity> entities;
+		m_SpatialIndex.Query(min, max, entities);
+
+		for (const entt::entity entity : entities)
+			outEntities.emplace_back(entity, this);
+	}
+
+	void Scene::QueryRadius(const glm::vec2& center, const float radius, std::vector<Entity>& outEntities)
+	{
+		std::vector<entt::entity> entities;
+		m_SpatialIndex.QueryRadius(center, radius, entities);
+
+		for (const entt::entity entity : entities)
+			outEntities.emplace_back(entity, this);
+	}
+
+	Entity Scene::Raycast(const glm::vec2& origin, const glm::vec2& direction, const float maxDistance, float* outDistance)
+	{
+		const entt::entity entity = m_SpatialIndex.Raycast(origin, direction, maxDistance, outDistance);
+		return entity != entt::null ? Entity{ entity, this } : Entity{};
+	}
+
+	ThreadPool& Scene::GetWorkers()
+	{
+		if (!m_Workers)
+			m_Workers = CreateScope<ThreadPool>(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+
+		return *m_Workers;
+	}
+
+	void Scene::ParallelRange(const uint32_t count, const uint32_t chunkSize, const std::function<void(uint32_t, uint32_t)>& function)
+	{
+		LU_CORE_ASSERT(chunkSize > 0, "Chunk size can't be zero!");
+
+		// The pool runs one loop at a time, a system sharing its wave already runs inside one
+		if (count <= chunkSize || SystemScheduler::IsRunningConcurrently())
+		{
+			function(0, count);
+			return;
+		}
+
+		const uint32_t chunks = (count + chunkSize - 1) / chunkSize;
+		GetWorkers().ParallelFor(chunks, [&](const uint32_t chunk)
+		{
+			const uint32_t begin = chunk * chunkSize;
+			function(begin, std::min(begin + chunkSize, count));
+		});
+	}
+
+	void Scene::UpdateWorldTransforms()
+	{
+		if (m_HierarchyDirty)
+			SortHierarchy();
+
+		// Same order in both storages, parents always come before their children. Indexed from the
+		// back of the iteration order, that is by packed index
+		const auto transforms = m_Registry.storage<TransformComponent>().rbegin();
+		const auto worlds = m_Registry.storage<WorldTransformComponent>().rbegin();
+		const auto size = static_cast<uint32_t>(m_ParentIndices.size());
+
+		// Static entities cost a flag check, only changed ones and their children rebuild the matrix
+		const auto propagate = [&](const uint32_t position)
+		{
+			auto& transform = transforms[position];
+			auto& world = worlds[position];
+
+			const uint32_t parent = m_ParentIndices[position];
+			const WorldTransformComponent* parentWorld = parent != s_NoParent ? &worlds[parent] : nullptr;
+
+			world.Changed = transform.Dirty || (parentWorld && parentWorld->Changed);
+			if (!world.Changed)
+				return;
+
+			world.Transform = parentWorld ? parentWorld->Transform * transform.GetTransform() : transform.GetTransform();
+			transform.Dirty = false;
+		};
+
+		// Every entity of a level only reads the levels before it
+		for (size_t level = 0; level < m_LevelOffsets.size(); level++)
+		{
+			const uint32_t first = m_LevelOffsets[level];
+			const uint32_t count = (level == 0 ? size : m_LevelOffsets[level - 1]) - first;
+
+			if (count < s_ParallelLevelSize)
+			{
+				for (uint32_t position = first; position < first + count; position++)
+					propagate(position);
+				continue;
+			}
+
+			const uint32_t chunks = (count + s_PropagationChunkSize - 1) / s_PropagationChunkSize;
+			GetWorkers().ParallelFor(chunks, [&](const uint32_t chunk)
+			{
+				const uint32_t begin = first + chunk * s_PropagationChunkSize;
+				const uint32_t end = std::min(begin + s_PropagationChunkSize, first + count);
+				for (uint32_t position = begin; position < end; position++)
+					propagate(position);
+			});
+		}
+	}
+
+	void Scene::UpdateSpatialIndex()
+	{
+		glm::vec2 min, max;
+		const auto view = m_Registry.view<WorldTransformComponent, SpriteRendererComponent>();
+
+		if (m_SpatialIndexDirty)
+		{
+			m_SpatialIndex.Clear();
+			for (const auto entity : view)
+			{
+				GetSpriteBounds(view.get<WorldTransformComponent>(entity).Transform, min, max);
+				m_SpatialIndex.Update(entity, min, max);
+			}
+
+			m_SpatialPending.clear();
+			m_SpatialIndexDirty = false;
+			return;
+		}
+
+		// Changed is set by the propagation for moved entities and everything below them
+		for (const auto entity : view)
+		{
+			const auto& world = view.get<WorldTransformComponent>(entity);
+			if (!world.Changed)
+				continue;
+
+			GetSpriteBounds(world.Transform, min, max);
+			m_SpatialIndex.Update(entity, min, max);
+		}
+
+		// Sprites added to entities that didn't move
+		for (const entt::entity entity : m_SpatialPending)
+		{
+			if (!m_Registry.valid(entity) || !view.contains(entity))
+				continue;
+
+			GetSpriteBounds(view.get<WorldTransformComponent>(entity).Transform, min, max);
+			m_SpatialIndex.Update(entity, min, max);
+		}
+		m_SpatialPending.clear();
+	}
+
+	void Scene::SortHierarchy()
+	{
+		auto& relationships = m_Registry.storage<RelationshipComponent>();
+		LU_CORE_ASSERT(relationships.size() == m_Registry.storage<TransformComponent>().size()
+			&& relationships.size() == m_Registry.storage<WorldTransformComponent>().size(), "Transform storages are out of sync!");
+
+		const entt::sparse_set& entities = relationships;
+		uint32_t maxEntity = 0;
+		for (const auto entity : entities)
+			maxEntity = std::max(maxEntity, static_cast<uint32_t>(entt::to_entity(entity)));
+
+		// Breadth first order, siblings end up next to each other and every level follows the
+		// order of its parents, so the parent reads of a level walk forward through memory
+		std::vector<uint32_t> positions(static_cast<size_t>(maxEntity) + 1, s_NoParent);
+		std::vector<entt::entity> order;
+		order.reserve(entities.size());
+		for (const auto& [entity, relationship] : relationships.each())
+		{
+			if (relationship.Parent == entt::null)
+				order.push_back(entity);
+		}
+
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			positions[entt::to_entity(order[i])] = static_cast<uint32_t>(i);
+			for (entt::entity child = relationships.get(order[i]).FirstChild; child != entt::null; child = relationships.get(child).NextSibling)
+				order.push_back(child);
+		}
+
+		relationships.sort([&positions](const entt::entity lhs, const entt::entity rhs) { return positions[entt::to_entity(lhs)] < positions[entt::to_entity(rhs)]; });
+		m_Registry.sort<TransformComponent, RelationshipComponent>();
+		m_Registry.sort<WorldTransformComponent, RelationshipComponent>();
+
+		m_ParentIndices.clear();
+		m_LevelOffsets.clear();
+		m_ParentIndices.reserve(relationships.size());
+
+		// Packed indices run from the deepest entities up to the roots
+		const auto packed = relationships.rbegin();
+		const auto size = static_cast<uint32_t>(relationships.size());
+		for (uint32_t index = 0; index < size; index++)
+		{
+			// Depths only get shallower from here, the first index of a depth is its lowest
+			const RelationshipComponent& relationship = packed[index];
+			if (m_LevelOffsets.size() <= relationship.Depth)
+				m_LevelOffsets.resize(relationship.Depth + 1, s_NoParent);
+			if (m_LevelOffsets[relationship.Depth] == s_NoParent)
+				m_LevelOffsets[relationship.Depth] = index;
+
+			m_ParentIndices.push_back(relationship.Parent != entt::null ? size - 1 - positions[entt::to_entity(relationship.Parent)] : s_NoParent);
+		}
+
+#ifdef LU_ENABLE_ASSERTS
+		// Every parent has to be in the depth right before its children, or the propagation reads stale parents
+		for (uint32_t index = 0; index < size; index++)
+		{
+			const uint32_t depth = packed[index].Depth;
+			LU_CORE_ASSERT(m_LevelOffsets[depth] <= index && (depth == 0 || index < m_LevelOffsets[depth - 1]), "Hierarchy levels are out of order!");
+			LU_CORE_ASSERT(depth == 0 || (m_ParentIndices[index] >= m_LevelOffsets[depth - 1]
+				&& (depth == 1 || m_ParentIndices[index] < m_LevelOffsets[depth - 2])), "Parent is not in the level before its child!");
+		}
+#endif
+
+		m_HierarchyDirty = false;
+	}
+
+	void Scene::OnTransformConstruct(entt::registry& registry, const entt::entity entity)
+	{
+		registry.emplace_or_replace<WorldTransformComponent>(entity);
+		registry.emplace_or_replace<RelationshipComponent>(entity);
+
+		// A new entity is a root at the end of all three storages, the end of depth 0
+		if (m_HierarchyDirty)
+			return;
+
+		const auto index = static_cast<uint32_t>(m_ParentIndices.size());
+		if (registry.storage<RelationshipComponent>().index(entity) != index || registry.storage<WorldTransformComponent>().index(entity) != index)
+		{
+			m_HierarchyDirty = true;
+			return;
+		}
+
+		m_ParentIndices.push_back(s_NoParent);
+		if (m_LevelOffsets.empty())
+			m_LevelOffsets.push_back(index);
+	}
+
+	void Scene::OnTransformUpdate(entt::registry& registry, const entt::entity entity)
+	{
+		registry.get<TransformComponent>(entity).Dirty = true;
+	}
+
+	void Scene::OnTransformDestroy(entt::registry& registry, const entt::entity entity)
+	{
+		registry.remove<WorldTransformComponent>(entity);
+		registry.remove<RelationshipComponent>(entity);
+		m_HierarchyDirty = true;
+
+		if (registry.all_of<Rigidbody2DComponent>(entity))
+			m_PhysicsWorld.RemoveBody(entity);
+	}
+
+	void Scene::OnRelationshipDestroy(entt::registry& registry, const entt::entity entity)
+	{
+		DetachFromParent(entity);
+
+		// Orphans become roots
+		auto& relationship = registry.get<RelationshipComponent>(entity);
+		while (relationship.FirstChild != entt::null)
+		{
+			const entt::entity child = relationship.FirstChild;
+			DetachFromParent(child);
+			UpdateDepth(child, 0);
+			registry.get<TransformComponent>(child).Dirty = true;
+		}
+
+		m_HierarchyDirty = true;
+	}
+
+	void Scene::OnSpriteConstruct(entt::registry& /*registry*/, const entt::entity entity)
+	{
+		if (!m_SpatialIndexDirty)
+			m_SpatialPending.push_back(entity);
+	}
+
+	void Scene::OnSpriteDestroy(entt::registry& /*registry*/, const entt::entity entity)
+	{
+		m_SpatialIndex.Remove(entity);
+	}
+
+	void Scene::OnRigidbodyConstruct(entt::registry& /*registry*/, const entt::entity entity)
+	{
+		m_PhysicsWorld.AddBody(entity);
+	}
+
+	void Scene::OnRigidbodyDestroy(entt::registry& /*registry*/, const entt::entity entity)
+	{
+		m_PhysicsWorld.RemoveBody(entity);
+	}
+
+	void Scene::OnColliderChange(entt::registry& /*registry*/, const entt::entity entity)
+	{
+		// Destroy signals come before the component is gone, the body is rebuilt on the next update
+		m_PhysicsWorld.RefreshBody(entity);
+	}
+
+	void Scene::OnScriptConstruct(entt::registry& /*registry*/, const entt::entity entity)
+	{
+		if (m_Playing)
+			m_PendingScripts.push_back(entity);
+	}
+
+	void Scene::OnScriptDestroy(entt::registry& registry, const entt::entity entity)
+	{
+		NativeScriptComponent& script = registry.get<NativeScriptComponent>(entity);
+		if (script.Instance)
+			DestroyScript(script);
 	}
 
 	void Scene::OnViewportResize(uint32_t width, uint32_t height)
 	{
+		// Called every frame, cameras added since are sized by UpdateCameras
+		if (width == m_ViewportWidth && height == m_ViewportHeight)
+			return;
+
 		m_ViewportWidth = width;
 		m_ViewportHeight = height;
 
@@ -105,6 +910,18 @@ namespace Lunaria {
 
 	}
 
+	void Scene::StopObserving(ComponentObserver& observer)
+	{
+		LU_CORE_ASSERT(&observer != m_CameraChanges, "The scene's own observers can't be removed!");
+
+		const auto it = std::find_if(m_Observers.begin(), m_Observers.end(), [&observer](const Scope<ComponentObserver>& entry) { return entry.get() == &observer; });
+		if (it == m_Observers.end())
+			return;
+
+		observer.m_Connector(observer, m_Registry, false);
+		m_Observers.erase(it);
+	}
+
 	template<typename T>
 	void Scene::OnComponentAdded(Entity entity, T& component)
 	{
@@ -0,0 +1,559 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Scene/SceneSerializer.hpp"
+
+#include "LunariaCore/Scene/Components.hpp"
+#include "LunariaCore/Core/MappedFile.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace Lunaria {
+
+	namespace Utils {
+
+		static constexpr uint32_t s_SceneMagic = 0x4353554c; // "LUSC"
+		static constexpr uint32_t s_SceneVersion = 1;
+		// Every block and column starts aligned, mapped columns are read in place
+		static constexpr uint64_t s_SceneAlignment = 16;
+		static constexpr uint32_t s_InvalidIndex = 0xffffffff;
+
+		enum class SceneBlockType : uint32_t
+		{
+			Tag = 1,
+			Transform = 2,
+			Relationship = 3,
+			SpriteRenderer = 4,
+			Camera = 5,
+			Rigidbody2D = 6,
+			BoxCollider2D = 7,
+			CircleCollider2D = 8
+		};
+
+		struct SceneFileHeader
+		{
+			uint32_t Magic = s_SceneMagic;
+			uint32_t Version = s_SceneVersion;
+			uint32_t EntityCount = 0;
+			uint32_t BlockCount = 0;
+		};
+
+		struct SceneBlockHeader
+		{
+			SceneBlockType Type = SceneBlockType::Tag;
+			uint32_t Count = 0; // Entities in the block
+			uint32_t ElementSize = 0; // Zero for the string table
+			uint32_t Reserved = 0;
+			uint64_t DataOffset = 0; // Components, after the entity indices
+			uint64_t Size = 0; // Everything following the header
+		};
+
+		// SceneCamera has a vtable and derived matrices, only its settings are stored
+		struct SceneCameraData
+		{
+			uint32_t ProjectionType;
+			float PerspectiveFOV, PerspectiveNear, PerspectiveFar;
+			float OrthographicSize, OrthographicNear, OrthographicFar;
+			uint8_t Primary, FixedAspectRatio;
+			uint8_t Padding[2] = {};
+		};
+
+		struct SceneBlockView
+		{
+			const SceneBlockHeader* Header = nullptr;
+			const uint32_t* Entities = nullptr;
+			const uint8_t* Data = nullptr;
+			uint64_t DataSize = 0;
+
+			const entt::entity* EntitiesBegin() const { return reinterpret_cast<const entt::entity*>(Entities); }
+			const entt::entity* EntitiesEnd() const { return EntitiesBegin() + Header->Count; }
+		};
+
+		static_assert(sizeof(SceneFileHeader) % s_SceneAlignment == 0 && sizeof(SceneBlockHeader) % s_SceneAlignment == 0);
+		static_assert(sizeof(entt::entity) == sizeof(uint32_t), "Entity index columns are read as entity ids!");
+		static_assert(std::is_trivially_copyable_v<TransformComponent> && std::is_trivially_copyable_v<RelationshipComponent>
+			&& std::is_trivially_copyable_v<SpriteRendererComponent> && std::is_trivially_copyable_v<Rigidbody2DComponent>
+			&& std::is_trivially_copyable_v<BoxCollider2DComponent> && std::is_trivially_copyable_v<CircleCollider2DComponent>, "Raw blocks need trivially copyable components!");
+
+		static uint64_t Align(const uint64_t size)
+		{
+			return (size + s_SceneAlignment - 1) / s_SceneAlignment * s_SceneAlignment;
+		}
+
+		class SceneFileWriter
+		{
+		public:
+			SceneFileWriter(const std::string& path)
+				: m_Out(path, std::ios::out | std::ios::binary | std::ios::trunc)
+			{
+				// Patched by Finish once the block count is known
+				const SceneFileHeader header;
+				m_Out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			}
+
+			bool IsOpen() const { return m_Out.is_open(); }
+
+			void WriteBlock(const SceneBlockType type, const std::vector<uint32_t>& entities, const uint32_t elementSize, const void* data, const uint64_t dataSize)
+			{
+				if (entities.empty())
+					return;
+
+				SceneBlockHeader header;
+				header.Type = type;
+				header.Count = static_cast<uint32_t>(entities.size());
+				header.ElementSize = elementSize;
+				header.DataOffset = Align(entities.size() * sizeof(uint32_t));
+				header.Size = header.DataOffset + Align(dataSize);
+
+				m_Out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				WritePadded(entities.data(), entities.size() * sizeof(uint32_t));
+				WritePadded(data, dataSize);
+				m_BlockCount++;
+			}
+
+			bool Finish(const uint32_t entityCount)
+			{
+				SceneFileHeader header;
+				header.EntityCount = entityCount;
+				header.BlockCount = m_BlockCount;
+
+				m_Out.seekp(0);
+				m_Out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				m_Out.close();
+				return !m_Out.fail();
+			}
+		private:
+			void WritePadded(const void* data, const uint64_t size)
+			{
+				static constexpr char padding[s_SceneAlignment] = {};
+
+				m_Out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+				m_Out.write(padding, static_cast<std::streamsize>(Align(size) - size));
+			}
+		private:
+			std::ofstream m_Out;
+			uint32_t m_BlockCount = 0;
+		};
+
+		// Walks a storage in packed order, loading inserts the components in that same order
+		template<typename Component, typename Func>
+		static void GatherBlock(entt::registry& registry, const std::vector<uint32_t>& indices, std::vector<uint32_t>& outEntities, Func func)
+		{
+			auto& storage = registry.storage<Component>();
+			const entt::sparse_set& entities = storage;
+
+			outEntities.clear();
+			outEntities.reserve(entities.size());
+
+			auto component = storage.rbegin();
+			for (auto entity = entities.rbegin(); entity != entities.rend(); ++entity, ++component)
+			{
+				outEntities.push_back(indices[entt::to_entity(*entity)]);
+				func(*component);
+			}
+		}
+
+		template<typename Component, typename Func>
+		static void WriteRawBlock(SceneFileWriter& writer, const SceneBlockType type, entt::registry& registry, const std::vector<uint32_t>& indices, Func patch)
+		{
+			std::vector<uint32_t> entities;
+			std::vector<Component> components;
+			components.reserve(registry.storage<Component>().size());
+
+			GatherBlock<Component>(registry, indices, entities, [&](const Component& component)
+			{
+				patch(components.emplace_back(component));
+			});
+
+			writer.WriteBlock(type, entities, sizeof(Component), components.data(), components.size() * sizeof(Component));
+		}
+
+		static bool ReadBlock(const MappedFile& file, uint64_t& offset, const uint32_t entityCount, std::vector<uint8_t>& seen, SceneBlockView& outBlock)
+		{
+			if (file.GetSize() - offset < sizeof(SceneBlockHeader))
+				return false;
+
+			const auto* header = reinterpret_cast<const SceneBlockHeader*>(file.GetData() + offset);
+			offset += sizeof(SceneBlockHeader);
+
+			if (header->Size > file.GetSize() - offset || header->Size % s_SceneAlignment != 0
+				|| header->DataOffset > header->Size || header->DataOffset % s_SceneAlignment != 0
+				|| header->DataOffset < static_cast<uint64_t>(header->Count) * sizeof(uint32_t))
+				return false;
+
+			outBlock.Header = header;
+			outBlock.Entities = reinterpret_cast<const uint32_t*>(file.GetData() + offset);
+			outBlock.Data = file.GetData() + offset + header->DataOffset;
+			outBlock.DataSize = header->Size - header->DataOffset;
+			offset += header->Size;
+
+			if (header->ElementSize != 0 && outBlock.DataSize < static_cast<uint64_t>(header->Count) * header->ElementSize)
+				return false;
+
+			// An entity can appear once per block
+			std::fill(seen.begin(), seen.end(), uint8_t(0));
+			for (uint32_t i = 0; i < header->Count; i++)
+			{
+				const uint32_t entity = outBlock.Entities[i];
+				if (entity >= entityCount || seen[entity])
+					return false;
+				seen[entity] = 1;
+			}
+
+			return true;
+		}
+
+		static bool ValidateTags(const SceneBlockView& block)
+		{
+			const uint32_t count = block.Header->Count;
+			if (block.DataSize < (static_cast<uint64_t>(count) + 1) * sizeof(uint32_t))
+				return false;
+
+			const auto* offsets = reinterpret_cast<const uint32_t*>(block.Data);
+			const uint64_t characters = block.DataSize - (static_cast<uint64_t>(count) + 1) * sizeof(uint32_t);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (offsets[i] > offsets[i + 1])
+					return false;
+			}
+
+			return offsets[count] <= characters;
+		}
+
+		static bool ValidateCameras(const SceneBlockView& block)
+		{
+			const auto* cameras = reinterpret_cast<const SceneCameraData*>(block.Data);
+			for (uint32_t i = 0; i < block.Header->Count; i++)
+			{
+				if (cameras[i].ProjectionType > static_cast<uint32_t>(SceneCamera::ProjectionType::Orthographic))
+					return false;
+			}
+
+			return true;
+		}
+
+		static bool ValidateRigidbodies(const SceneBlockView& block)
+		{
+			const auto* rigidbodies = reinterpret_cast<const Rigidbody2DComponent*>(block.Data);
+			for (uint32_t i = 0; i < block.Header->Count; i++)
+			{
+				const auto type = static_cast<uint32_t>(rigidbodies[i].Type);
+				if (type > static_cast<uint32_t>(Rigidbody2DComponent::BodyType::Kinematic))
+					return false;
+			}
+
+			return true;
+		}
+
+		// Relationships are loaded as they are, a broken link or cycle would hang the transform propagation
+		static bool ValidateHierarchy(const SceneBlockView& relationships, const SceneBlockView* transforms, const uint32_t entityCount)
+		{
+			const uint32_t count = relationships.Header->Count;
+			if (!transforms || transforms->Header->Count != count)
+				return false;
+
+			std::vector<uint32_t> slots(entityCount, s_InvalidIndex);
+			for (uint32_t i = 0; i < count; i++)
+				slots[relationships.Entities[i]] = i;
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (slots[transforms->Entities[i]] == s_InvalidIndex)
+					return false;
+			}
+
+			const auto* links = reinterpret_cast<const RelationshipComponent*>(relationships.Data);
+			const auto slotOf = [&](const entt::entity entity)
+			{
+				const uint32_t index = entt::to_integral(entity);
+				return index < entityCount ? slots[index] : s_InvalidIndex;
+			};
+			const auto isValid = [&](const entt::entity entity) { return entity == entt::null || slotOf(entity) != s_InvalidIndex; };
+
+			std::vector<uint8_t> visited(count, 0);
+			std::vector<uint32_t> queue;
+			queue.reserve(count);
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const RelationshipComponent& link = links[i];
+				if (!isValid(link.Parent) || !isValid(link.FirstChild) || !isValid(link.NextSibling) || !isValid(link.PreviousSibling))
+					return false;
+
+				if (link.Parent == entt::null)
+				{
+					if (link.Depth != 0)
+						return false;
+
+					visited[i] = 1;
+					queue.push_back(i);
+				}
+			}
+
+			// Every entity has to be reached from a root exactly once, through consistent links
+			for (size_t i = 0; i < queue.size(); i++)
+			{
+				const RelationshipComponent& parent = links[queue[i]];
+				const entt::entity parentEntity = static_cast<entt::entity>(relationships.Entities[queue[i]]);
+
+				uint32_t children = 0;
+				for (entt::entity child = parent.FirstChild; child != entt::null; child = links[slotOf(child)].NextSibling)
+				{
+					const uint32_t slot = slotOf(child);
+					if (visited[slot] || links[slot].Parent != parentEntity || links[slot].Depth != parent.Depth + 1)
+						return false;
+
+					visited[slot] = 1;
+					queue.push_back(slot);
+					children++;
+				}
+
+				if (children != parent.Children)
+					return false;
+			}
+
+			return queue.size() == count;
+		}
+
+	}
+
+	SceneSerializer::SceneSerializer(const Ref<Scene>& scene)
+		: m_Scene(scene)
+	{
+	}
+
+	bool SceneSerializer::Serialize(const std::string& path)
+	{
+		entt::registry& registry = m_Scene->m_Registry;
+
+		Utils::SceneFileWriter writer(path);
+		if (!writer.IsOpen())
+		{
+			LU_CORE_ERROR("Could not open file '{0}'", path);
+			return false;
+		}
+
+		// Entities are renumbered densely, a loaded scene gets these indices as its ids
+		auto& entityStorage = registry.storage<entt::entity>();
+		std::vector<uint32_t> indices(entityStorage.size(), Utils::s_InvalidIndex);
+		uint32_t entityCount = 0;
+		for (const auto [entity] : entityStorage.each())
+			indices[entt::to_entity(entity)] = entityCount++;
+
+		const auto remap = [&indices](const entt::entity entity)
+		{
+			return entity == entt::null ? entity : static_cast<entt::entity>(indices[entt::to_entity(entity)]);
+		};
+
+		// The loaded scene has no world transforms yet, every transform has to rebuild its matrix
+		Utils::WriteRawBlock<TransformComponent>(writer, Utils::SceneBlockType::Transform, registry, indices,
+			[](TransformComponent& transform) { transform.Dirty = true; });
+
+		Utils::WriteRawBlock<RelationshipComponent>(writer, Utils::SceneBlockType::Relationship, registry, indices, [&remap](RelationshipComponent& relationship)
+		{
+			relationship.Parent = remap(relationship.Parent);
+			relationship.FirstChild = remap(relationship.FirstChild);
+			relationship.NextSibling = remap(relationship.NextSibling);
+			relationship.PreviousSibling = remap(relationship.PreviousSibling);
+		});
+
+		Utils::WriteRawBlock<SpriteRendererComponent>(writer, Utils::SceneBlockType::SpriteRenderer, registry, indices, [](SpriteRendererComponent&) {});
+		Utils::WriteRawBlock<Rigidbody2DComponent>(writer, Utils::SceneBlockType::Rigidbody2D, registry, indices, [](Rigidbody2DComponent&) {});
+		Utils::WriteRawBlock<BoxCollider2DComponent>(writer, Utils::SceneBlockType::BoxCollider2D, registry, indices, [](BoxCollider2DComponent&) {});
+		Utils::WriteRawBlock<CircleCollider2DComponent>(writer, Utils::SceneBlockType::CircleCollider2D, registry, indices, [](CircleCollider2DComponent&) {});
+
+		std::vector<uint32_t> entities;
+
+		// String table, tag i spans [offsets[i], offsets[i + 1]) of the characters after the offsets
+		{
+			std::vector<uint32_t> offsets = { 0 };
+			std::string characters;
+			Utils::GatherBlock<TagComponent>(registry, indices, entities, [&](const TagComponent& tag)
+			{
+				characters += tag.Tag.GetString();
+				offsets.push_back(static_cast<uint32_t>(characters.size()));
+			});
+
+			std::vector<uint8_t> table(offsets.size() * sizeof(uint32_t) + characters.size());
+			std::memcpy(table.data(), offsets.data(), offsets.size() * sizeof(uint32_t));
+			std::memcpy(table.data() + offsets.size() * sizeof(uint32_t), characters.data(), characters.size());
+			writer.WriteBlock(Utils::SceneBlockType::Tag, entities, 0, table.data(), table.size());
+		}
+
+		{
+			std::vector<Utils::SceneCameraData> cameras;
+			Utils::GatherBlock<CameraComponent>(registry, indices, entities, [&](const CameraComponent& component)
+			{
+				const SceneCamera& camera = component.Camera;
+				cameras.push_back({
+					static_cast<uint32_t>(camera.GetProjectionType()),
+					camera.GetPerspectiveVerticalFOV(), camera.GetPerspectiveNearClip(), camera.GetPerspectiveFarClip(),
+					camera.GetOrthographicSize(), camera.GetOrthographicNearClip(), camera.GetOrthographicFarClip(),
+					component.Primary, component.FixedAspectRatio
+				});
+			});
+
+			writer.WriteBlock(Utils::SceneBlockType::Camera, entities, sizeof(Utils::SceneCameraData), cameras.data(), cameras.size() * sizeof(Utils::SceneCameraData));
+		}
+
+		if (!writer.Finish(entityCount))
+		{
+			LU_CORE_ERROR("Failed to write scene '{0}'!", path);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool SceneSerializer::Deserialize(const std::string& path)
+	{
+		entt::registry& registry = m_Scene->m_Registry;
+		if (!registry.storage<entt::entity>().empty())
+		{
+			LU_CORE_ERROR("Scene '{0}' can only be loaded into a new scene!", path);
+			return false;
+		}
+
+		MappedFile file(path);
+		if (!file.IsOpen())
+		{
+			LU_CORE_ERROR("Could not open file '{0}'", path);
+			return false;
+		}
+
+		if (file.GetSize() < sizeof(Utils::SceneFileHeader))
+		{
+			LU_CORE_ERROR("'{0}' is not a scene file!", path);
+			return false;
+		}
+
+		const auto& header = *reinterpret_cast<const Utils::SceneFileHeader*>(file.GetData());
+		if (header.Magic != Utils::s_SceneMagic)
+		{
+			LU_CORE_ERROR("'{0}' is not a scene file!", path);
+			return false;
+		}
+
+		if (header.Version != Utils::s_SceneVersion)
+		{
+			LU_CORE_ERROR("Unsupported scene version {0} in '{1}'!", header.Version, path);
+			return false;
+		}
+
+		// Everything is checked before the scene is touched, a broken file leaves it empty
+		Utils::SceneBlockView tags, transforms, relationships, sprites, cameras, rigidbodies, boxColliders, circleColliders;
+		{
+			std::vector<uint8_t> seen(header.EntityCount);
+			uint64_t offset = sizeof(Utils::SceneFileHeader);
+			bool valid = true;
+
+			for (uint32_t i = 0; i < header.BlockCount && valid; i++)
+			{
+				Utils::SceneBlockView block;
+				if (!Utils::ReadBlock(file, offset, header.EntityCount, seen, block))
+				{
+					valid = false;
+					break;
+				}
+
+				// Blocks of newer versions are skipped
+				Utils::SceneBlockView* target = nullptr;
+				uint32_t elementSize = 0;
+				switch (block.Header->Type)
+				{
+					case Utils::SceneBlockType::Tag:              target = &tags; break;
+					case Utils::SceneBlockType::Transform:        target = &transforms; elementSize = sizeof(TransformComponent); break;
+					case Utils::SceneBlockType::Relationship:     target = &relationships; elementSize = sizeof(RelationshipComponent); break;
+					case Utils::SceneBlockType::SpriteRenderer:   target = &sprites; elementSize = sizeof(SpriteRendererComponent); break;
+					case Utils::SceneBlockType::Camera:           target = &cameras; elementSize = sizeof(Utils::SceneCameraData); break;
+					case Utils::SceneBlockType::Rigidbody2D:      target = &rigidbodies; elementSize = sizeof(Rigidbody2DComponent); break;
+					case Utils::SceneBlockType::BoxCollider2D:    target = &boxColliders; elementSize = sizeof(BoxCollider2DComponent); break;
+					case Utils::SceneBlockType::CircleCollider2D: target = &circleColliders; elementSize = sizeof(CircleCollider2DComponent); break;
+				}
+
+				if (!target)
+					continue;
+
+				valid = !target->Header && block.Header->ElementSize == elementSize;
+				*target = block;
+			}
+
+			valid = valid
+				&& (!tags.Header || Utils::ValidateTags(tags))
+				&& (!cameras.Header || Utils::ValidateCameras(cameras))
+				&& (!rigidbodies.Header || Utils::ValidateRigidbodies(rigidbodies))
+				&& (!relationships.Header || Utils::ValidateHierarchy(relationships, transforms.Header ? &transforms : nullptr, header.EntityCount));
+
+			if (!valid)
+			{
+				LU_CORE_ERROR("Scene file '{0}' is corrupted!", path);
+				return false;
+			}
+		}
+
+		// Ids of a new registry are handed out in order, so they match the stored indices
+		std::vector<entt::entity> entities(header.EntityCount);
+		registry.create(entities.begin(), entities.end());
+		LU_CORE_ASSERT(entities.empty() || entt::to_integral(entities.back()) == header.EntityCount - 1, "Loaded entities don't match their stored indices!");
+
+		if (transforms.Header)
+		{
+			// The dependent components come in bulk below instead of one by one from the signal
+			registry.on_construct<TransformComponent>().disconnect<&Scene::OnTransformConstruct>(*m_Scene);
+
+			registry.insert<TransformComponent>(transforms.EntitiesBegin(), transforms.EntitiesEnd(), reinterpret_cast<const TransformComponent*>(transforms.Data));
+			registry.insert<WorldTransformComponent>(transforms.EntitiesBegin(), transforms.EntitiesEnd());
+
+			if (relationships.Header)
+				registry.insert<RelationshipComponent>(relationships.EntitiesBegin(), relationships.EntitiesEnd(), reinterpret_cast<const RelationshipComponent*>(relationships.Data));
+			else
+				registry.insert<RelationshipComponent>(transforms.EntitiesBegin(), transforms.EntitiesEnd());
+
+			registry.on_construct<TransformComponent>().connect<&Scene::OnTransformConstruct>(*m_Scene);
+			m_Scene->m_HierarchyDirty = true;
+		}
+
+		if (sprites.Header)
+			registry.insert<SpriteRendererComponent>(sprites.EntitiesBegin(), sprites.EntitiesEnd(), reinterpret_cast<const SpriteRendererComponent*>(sprites.Data));
+
+		if (rigidbodies.Header)
+			registry.insert<Rigidbody2DComponent>(rigidbodies.EntitiesBegin(), rigidbodies.EntitiesEnd(), reinterpret_cast<const Rigidbody2DComponent*>(rigidbodies.Data));
+		if (boxColliders.Header)
+			registry.insert<BoxCollider2DComponent>(boxColliders.EntitiesBegin(), boxColliders.EntitiesEnd(), reinterpret_cast<const BoxCollider2DComponent*>(boxColliders.Data));
+		if (circleColliders.Header)
+			registry.insert<CircleCollider2DComponent>(circleColliders.EntitiesBegin(), circleColliders.EntitiesEnd(), reinterpret_cast<const CircleCollider2DComponent*>(circleColliders.Data));
+
+		if (tags.Header)
+		{
+			const auto* offsets = reinterpret_cast<const uint32_t*>(tags.Data);
+			const char* characters = reinterpret_cast<const char*>(offsets + tags.Header->Count + 1);
+
+			auto& storage = registry.storage<TagComponent>();
+			storage.reserve(tags.Header->Count);
+			for (uint32_t i = 0; i < tags.Header->Count; i++)
+				storage.emplace(entities[tags.Entities[i]], std::string_view(characters + offsets[i], offsets[i + 1] - offsets[i]));
+		}
+
+		if (cameras.Header)
+		{
+			const auto* data = reinterpret_cast<const Utils::SceneCameraData*>(cameras.Data);
+			for (uint32_t i = 0; i < cameras.Header->Count; i++)
+			{
+				auto& component = registry.emplace<CameraComponent>(entities[cameras.Entities[i]]);
+				component.Primary = data[i].Primary;
+				component.FixedAspectRatio = data[i].FixedAspectRatio;
+
+				SceneCamera& camera = component.Camera;
+				camera.SetPerspective(data[i].PerspectiveFOV, data[i].PerspectiveNear, data[i].PerspectiveFar);
+				camera.SetOrthographic(data[i].OrthographicSize, data[i].OrthographicNear, data[i].OrthographicFar);
+				camera.SetProjectionType(static_cast<SceneCamera::ProjectionType>(data[i].ProjectionType));
+
+				if (m_Scene->m_ViewportWidth > 0 && m_Scene->m_ViewportHeight > 0)
+					camera.SetViewportSize(m_Scene->m_ViewportWidth, m_Scene->m_ViewportHeight);
+			}
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,70 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Scene/SceneSnapshot.hpp"
+
+#include "LunariaCore/Scene/Scene.hpp"
+
+namespace Lunaria {
+
+	SceneSnapshotRing::SceneSnapshotRing(const uint32_t capacity)
+		: m_Snapshots(std::max(capacity, 1u))
+	{
+		LU_CORE_ASSERT(capacity > 0, "Snapshot ring needs room for at least one snapshot!");
+	}
+
+	const SceneSnapshot& SceneSnapshotRing::Capture(const Scene& scene, const uint64_t frame)
+	{
+		LU_CORE_ASSERT(m_Size == 0 || At(0).m_Frame < frame, "Snapshots have to be captured in frame order!");
+
+		SceneSnapshot& snapshot = m_Snapshots[m_Next];
+		scene.TakeSnapshot(snapshot);
+		snapshot.m_Frame = frame;
+
+		m_Next = (m_Next + 1) % GetCapacity();
+		m_Size = std::min(m_Size + 1, GetCapacity());
+		return snapshot;
+	}
+
+	const SceneSnapshot* SceneSnapshotRing::Find(const uint64_t frame) const
+	{
+		for (uint32_t age = 0; age < m_Size; age++)
+		{
+			const SceneSnapshot& snapshot = At(age);
+			if (snapshot.m_Frame <= frame)
+				return &snapshot;
+		}
+
+		return nullptr;
+	}
+
+	const SceneSnapshot* SceneSnapshotRing::GetLatest() const
+	{
+		return m_Size > 0 ? &At(0) : nullptr;
+	}
+
+	void SceneSnapshotRing::DiscardAfter(const uint64_t frame)
+	{
+		// The registries stay allocated for the captures that replace them
+		while (m_Size > 0 && At(0).m_Frame > frame)
+		{
+			m_Next = (m_Next + GetCapacity() - 1) % GetCapacity();
+			m_Snapshots[m_Next].m_Valid = false;
+			m_Size--;
+		}
+	}
+
+	void SceneSnapshotRing::Clear()
+	{
+		for (SceneSnapshot& snapshot : m_Snapshots)
+			snapshot.m_Valid = false;
+
+		m_Next = 0;
+		m_Size = 0;
+	}
+
+	const SceneSnapshot& SceneSnapshotRing::At(const uint32_t age) const
+	{
+		return m_Snapshots[(m_Next + GetCapacity() - 1 - age) % GetCapacity()];
+	}
+
+}
@@ -0,0 +1,342 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Scene/SpatialGrid.hpp"
+
+namespace Lunaria {
+
+	static constexpr uint32_t s_NoItem = 0xffffffff;
+	// Boxes covering more cells than this go to the oversized list
+	static constexpr int64_t s_MaxItemCells = 64;
+	// Keeps far away coordinates from overflowing the cell indices
+	static constexpr float s_MaxCellIndex = 1.0e9f;
+
+	namespace Utils {
+
+		static bool Overlaps(const glm::vec2& minA, const glm::vec2& maxA, const glm::vec2& minB, const glm::vec2& maxB)
+		{
+			return minA.x <= maxB.x && maxA.x >= minB.x && minA.y <= maxB.y && maxA.y >= minB.y;
+		}
+
+		// Slab test, returns the distance the ray enters the box at
+		static bool IntersectRay(const glm::vec2& origin, const glm::vec2& direction, const glm::vec2& min, const glm::vec2& max, float& outDistance)
+		{
+			float enter = 0.0f;
+			float exit = std::numeric_limits<float>::max();
+
+			for (int axis = 0; axis < 2; axis++)
+			{
+				if (direction[axis] == 0.0f)
+				{
+					if (origin[axis] < min[axis] || origin[axis] > max[axis])
+						return false;
+					continue;
+				}
+
+				const float inverse = 1.0f / direction[axis];
+				float near = (min[axis] - origin[axis]) * inverse;
+				float far = (max[axis] - origin[axis]) * inverse;
+				if (near > far)
+					std::swap(near, far);
+
+				enter = std::max(enter, near);
+				exit = std::min(exit, far);
+				if (enter > exit)
+					return false;
+			}
+
+			outDistance = enter;
+			return true;
+		}
+
+	}
+
+	SpatialGrid::SpatialGrid(const float cellSize)
+		: m_CellSize(cellSize), m_InverseCellSize(1.0f / cellSize)
+	{
+		LU_CORE_ASSERT(cellSize > 0.0f, "Spatial grid cells need a size!");
+	}
+
+	void SpatialGrid::Update(const entt::entity entity, const glm::vec2& min, const glm::vec2& max)
+	{
+		const uint32_t index = entt::to_entity(entity);
+		if (index >= m_ItemIndices.size())
+			m_ItemIndices.resize(static_cast<size_t>(index) + 1, s_NoItem);
+
+		const glm::ivec2 firstCell = GetCell(min);
+		const glm::ivec2 lastCell = GetCell(max);
+
+		uint32_t slot = m_ItemIndices[index];
+		if (slot != s_NoItem)
+		{
+			Item& item = m_Items[slot];
+			item.Entity = entity;
+			item.Min = min;
+			item.Max = max;
+
+			// Moving inside the same cells is the common case and needs nothing else
+			if (item.FirstCell == firstCell && item.LastCell == lastCell)
+				return;
+
+			Unlink(slot);
+		}
+		else
+		{
+			if (!m_FreeItems.empty())
+			{
+				slot = m_FreeItems.back();
+				m_FreeItems.pop_back();
+			}
+			else
+			{
+				slot = static_cast<uint32_t>(m_Items.size());
+				m_Items.emplace_back();
+			}
+
+			m_Items[slot] = { min, max, firstCell, lastCell, entity };
+			m_ItemIndices[index] = slot;
+			m_Count++;
+		}
+
+		m_Items[slot].FirstCell = firstCell;
+		m_Items[slot].LastCell = lastCell;
+		Link(slot);
+	}
+
+	void SpatialGrid::Remove(const entt::entity entity)
+	{
+		if (!Contains(entity))
+			return;
+
+		const uint32_t index = entt::to_entity(entity);
+		const uint32_t slot = m_ItemIndices[index];
+		Unlink(slot);
+
+		m_Items[slot].Entity = entt::null;
+		m_FreeItems.push_back(slot);
+		m_ItemIndices[index] = s_NoItem;
+		m_Count--;
+	}
+
+	void SpatialGrid::Clear()
+	{
+		m_Items.clear();
+		m_FreeItems.clear();
+		m_ItemIndices.clear();
+		m_Cells.clear();
+		m_Oversized.clear();
+		m_Count = 0;
+	}
+
+	bool SpatialGrid::Contains(const entt::entity entity) const
+	{
+		const uint32_t index = entt::to_entity(entity);
+		return index < m_ItemIndices.size() && m_ItemIndices[index] != s_NoItem && m_Items[m_ItemIndices[index]].Entity == entity;
+	}
+
+	void SpatialGrid::Query(const glm::vec2& min, const glm::vec2& max, std::vector<entt::entity>& outEntities) const
+	{
+		const glm::ivec2 firstCell = GetCell(min);
+		const glm::ivec2 lastCell = GetCell(max);
+
+		const auto visit = [&](const int32_t x, const int32_t y, const std::vector<uint32_t>& cell)
+		{
+			for (const uint32_t slot : cell)
+			{
+				const Item& item = m_Items[slot];
+				if (!Utils::Overlaps(item.Min, item.Max, min, max))
+					continue;
+
+				// Listed in several cells, reported only from the first one the query shares with it
+				if (x != std::max(item.FirstCell.x, firstCell.x) || y != std::max(item.FirstCell.y, firstCell.y))
+					continue;
+
+				outEntities.push_back(item.Entity);
+			}
+		};
+
+		// A query larger than the occupied part of the grid walks the occupied cells instead
+		const int64_t cellCount = (static_cast<int64_t>(lastCell.x) - firstCell.x + 1) * (static_cast<int64_t>(lastCell.y) - firstCell.y + 1);
+		if (cellCount <= static_cast<int64_t>(m_Cells.size()))
+		{
+			for (int32_t y = firstCell.y; y <= lastCell.y; y++)
+			{
+				for (int32_t x = firstCell.x; x <= lastCell.x; x++)
+				{
+					const auto it = m_Cells.find(GetKey(x, y));
+					if (it != m_Cells.end())
+						visit(x, y, it->second);
+				}
+			}
+		}
+		else
+		{
+			for (const auto& [key, cell] : m_Cells)
+			{
+				const int32_t x = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+				const int32_t y = static_cast<int32_t>(static_cast<uint32_t>(key));
+				if (x >= firstCell.x && x <= lastCell.x && y >= firstCell.y && y <= lastCell.y)
+					visit(x, y, cell);
+			}
+		}
+
+		for (const uint32_t slot : m_Oversized)
+		{
+			const Item& item = m_Items[slot];
+			if (Utils::Overlaps(item.Min, item.Max, min, max))
+				outEntities.push_back(item.Entity);
+		}
+	}
+
+	void SpatialGrid::QueryRadius(const glm::vec2& center, const float radius, std::vector<entt::entity>& outEntities) const
+	{
+		const size_t first = outEntities.size();
+		Query(center - glm::vec2(radius), center + glm::vec2(radius), outEntities);
+
+		// The box query also finds bounds that only overlap the corners around the circle
+		const float radiusSquared = radius * radius;
+		const auto outside = [&](const entt::entity entity)
+		{
+			const Item& item = m_Items[m_ItemIndices[entt::to_entity(entity)]];
+			const glm::vec2 offset = glm::clamp(center, item.Min, item.Max) - center;
+			return glm::dot(offset, offset) > radiusSquared;
+		};
+
+		outEntities.erase(std::remove_if(outEntities.begin() + first, outEntities.end(), outside), outEntities.end());
+	}
+
+	entt::entity SpatialGrid::Raycast(const glm::vec2& origin, const glm::vec2& direction, const float maxDistance, float* outDistance) const
+	{
+		LU_CORE_ASSERT(std::isfinite(maxDistance) && maxDistance >= 0.0f, "Rays need a finite length!");
+
+		float closest = maxDistance;
+		entt::entity hit = entt::null;
+
+		const auto test = [&](const Item& item)
+		{
+			float distance;
+			if (Utils::IntersectRay(origin, direction, item.Min, item.Max, distance) && distance <= closest)
+			{
+				closest = distance;
+				hit = item.Entity;
+			}
+		};
+
+		for (const uint32_t slot : m_Oversized)
+			test(m_Items[slot]);
+
+		glm::ivec2 cell = GetCell(origin);
+		const glm::ivec2 endCell = GetCell(origin + direction * maxDistance);
+		const int64_t steps = std::abs(static_cast<int64_t>(endCell.x) - cell.x) + std::abs(static_cast<int64_t>(endCell.y) - cell.y) + 1;
+
+		// A ray crossing more cells than are occupied tests every item instead
+		if (steps > static_cast<int64_t>(m_Cells.size()))
+		{
+			for (const Item& item : m_Items)
+			{
+				if (item.Entity != entt::null && !item.Oversized)
+					test(item);
+			}
+		}
+		else
+		{
+			// Walks the cells along the ray in order, see Amanatides and Woo
+			const glm::ivec2 step = { direction.x > 0.0f ? 1 : -1, direction.y > 0.0f ? 1 : -1 };
+			glm::vec2 nextBoundary, boundaryStep;
+			for (int axis = 0; axis < 2; axis++)
+			{
+				if (direction[axis] == 0.0f)
+				{
+					nextBoundary[axis] = std::numeric_limits<float>::max();
+					boundaryStep[axis] = std::numeric_limits<float>::max();
+					continue;
+				}
+
+				const float boundary = static_cast<float>(cell[axis] + (step[axis] > 0 ? 1 : 0)) * m_CellSize;
+				nextBoundary[axis] = (boundary - origin[axis]) / direction[axis];
+				boundaryStep[axis] = m_CellSize / std::abs(direction[axis]);
+			}
+
+			for (int64_t i = 0; i < steps; i++)
+			{
+				const auto it = m_Cells.find(GetKey(cell.x, cell.y));
+				if (it != m_Cells.end())
+				{
+					for (const uint32_t slot : it->second)
+						test(m_Items[slot]);
+				}
+
+				// Anything in the cells further along is entered later than this hit
+				const int axis = nextBoundary.x < nextBoundary.y ? 0 : 1;
+				if (closest <= nextBoundary[axis] || cell == endCell)
+					break;
+
+				cell[axis] += step[axis];
+				nextBoundary[axis] += boundaryStep[axis];
+			}
+		}
+
+		if (outDistance && hit != entt::null)
+			*outDistance = closest;
+
+		return hit;
+	}
+
+	SpatialGrid::CellKey SpatialGrid::GetKey(const int32_t x, const int32_t y)
+	{
+		return (static_cast<CellKey>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+	}
+
+	glm::ivec2 SpatialGrid::GetCell(const glm::vec2& point) const
+	{
+		const glm::vec2 cell = glm::clamp(glm::floor(point * m_InverseCellSize), glm::vec2(-s_MaxCellIndex), glm::vec2(s_MaxCellIndex));
+		return glm::ivec2(cell);
+	}
+
+	void SpatialGrid::Link(const uint32_t slot)
+	{
+		Item& item = m_Items[slot];
+		const int64_t cellCount = (static_cast<int64_t>(item.LastCell.x) - item.FirstCell.x + 1) * (static_cast<int64_t>(item.LastCell.y) - item.FirstCell.y + 1);
+
+		item.Oversized = cellCount > s_MaxItemCells;
+		if (item.Oversized)
+		{
+			m_Oversized.push_back(slot);
+			return;
+		}
+
+		for (int32_t y = item.FirstCell.y; y <= item.LastCell.y; y++)
+		{
+			for (int32_t x = item.FirstCell.x; x <= item.LastCell.x; x++)
+				m_Cells[GetKey(x, y)].push_back(slot);
+		}
+	}
+
+	void SpatialGrid::Unlink(const uint32_t slot)
+	{
+		const Item& item = m_Items[slot];
+		const auto erase = [slot](std::vector<uint32_t>& slots)
+		{
+			const auto it = std::find(slots.begin(), slots.end(), slot);
+			*it = slots.back();
+			slots.pop_back();
+		};
+
+		if (item.Oversized)
+		{
+			erase(m_Oversized);
+			return;
+		}
+
+		for (int32_t y = item.FirstCell.y; y <= item.LastCell.y; y++)
+		{
+			for (int32_t x = item.FirstCell.x; x <= item.LastCell.x; x++)
+			{
+				const auto it = m_Cells.find(GetKey(x, y));
+				erase(it->second);
+				if (it->second.empty())
+					m_Cells.erase(it);
+			}
+		}
+	}
+
+}
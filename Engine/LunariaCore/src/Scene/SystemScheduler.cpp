@@ -0,0 +1,132 @@
+#include "lepch.hpp"
+
+#include "LunariaCore/Scene/SystemScheduler.hpp"
+
+#include "LunariaCore/Core/ThreadPool.hpp"
+
+namespace Lunaria {
+
+	static thread_local bool s_RunningConcurrently = false;
+
+	static bool Contains(const std::vector<entt::id_type>& components, const entt::id_type component)
+	{
+		return std::find(components.begin(), components.end(), component) != components.end();
+	}
+
+	static bool Conflicts(const SystemSpecification& first, const SystemSpecification& second)
+	{
+		if (first.Exclusive || second.Exclusive)
+			return true;
+
+		for (const entt::id_type component : first.Writes)
+		{
+			if (Contains(second.Reads, component) || Contains(second.Writes, component))
+				return true;
+		}
+
+		for (const entt::id_type component : second.Writes)
+		{
+			if (Contains(first.Reads, component))
+				return true;
+		}
+
+		return false;
+	}
+
+	uint32_t SystemScheduler::Add(const SystemSpecification& specification, SystemFunction function)
+	{
+		LU_CORE_ASSERT(function, "A system needs a function!");
+
+		const uint32_t id = m_NextID++;
+		m_Systems.push_back({ id, specification, std::move(function) });
+		m_WavesDirty = true;
+		return id;
+	}
+
+	void SystemScheduler::Remove(const uint32_t id)
+	{
+		const auto it = std::find_if(m_Systems.begin(), m_Systems.end(), [id](const System& system) { return system.ID == id; });
+		if (it == m_Systems.end())
+			return;
+
+		m_Systems.erase(it);
+		m_WavesDirty = true;
+	}
+
+	void SystemScheduler::Run(Scene& scene, const Timestep timestep, ThreadPool& workers)
+	{
+		LU_CORE_ASSERT(!s_RunningConcurrently, "Systems can't run a scheduler!");
+
+		if (m_WavesDirty)
+			BuildWaves();
+
+		std::vector<uint32_t> concurrent;
+		for (const auto& wave : m_Waves)
+		{
+			concurrent.clear();
+			for (const uint32_t index : wave)
+			{
+				if (!m_Systems[index].Specification.MainThread)
+					concurrent.push_back(index);
+			}
+
+			// A lone system keeps the calling thread and can split its own loops over the workers
+			if (concurrent.size() == 1)
+			{
+				m_Systems[concurrent.front()].Function(scene, timestep);
+			}
+			else if (concurrent.size() > 1)
+			{
+				workers.ParallelFor(static_cast<uint32_t>(concurrent.size()), [&](const uint32_t i)
+				{
+					s_RunningConcurrently = true;
+					m_Systems[concurrent[i]].Function(scene, timestep);
+					s_RunningConcurrently = false;
+				});
+			}
+
+			// Nothing in the wave conflicts with them, running them last keeps the order intact
+			for (const uint32_t index : wave)
+			{
+				if (m_Systems[index].Specification.MainThread)
+					m_Systems[index].Function(scene, timestep);
+			}
+		}
+	}
+
+	uint32_t SystemScheduler::GetWaveCount()
+	{
+		if (m_WavesDirty)
+			BuildWaves();
+
+		return static_cast<uint32_t>(m_Waves.size());
+	}
+
+	bool SystemScheduler::IsRunningConcurrently()
+	{
+		return s_RunningConcurrently;
+	}
+
+	void SystemScheduler::BuildWaves()
+	{
+		// Longest path through the conflict graph, edges go from earlier to later registered systems
+		std::vector<uint32_t> levels(m_Systems.size(), 0);
+		m_Waves.clear();
+
+		for (size_t i = 0; i < m_Systems.size(); i++)
+		{
+			for (size_t j = 0; j < i; j++)
+			{
+				if (levels[j] + 1 > levels[i] && Conflicts(m_Systems[j].Specification, m_Systems[i].Specification))
+					levels[i] = levels[j] + 1;
+			}
+
+			if (m_Waves.size() <= levels[i])
+				m_Waves.resize(levels[i] + 1);
+			m_Waves[levels[i]].push_back(static_cast<uint32_t>(i));
+		}
+
+		m_WavesDirty = false;
+	}
+
+}
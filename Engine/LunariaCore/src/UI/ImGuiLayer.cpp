@@ -4,6 +4,7 @@
 
 #include "LunariaCore/UI/ImGuiLayer.hpp"
 #include "LunariaCore/UI/ImGuiTheme.hpp"
+#include "LunariaCore/Renderer/RenderThread.hpp"
 
 #include <imgui/imgui.h>
 #include <imgui/imgui_internal.h>
@@ -30,6 +31,10 @@ namespace Lunaria {
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;		// Enable Docking
 		io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;		// Enable Multi-Viewport / Platform Windows
 
+		// Platform windows create and switch GL contexts on the main thread, the render thread owns ours
+		if (RenderThread::IsEnabled())
+			io.ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+
 		// Setup custom moonlight theme
 		UI::SetEditorTheme();
 
@@ -65,9 +70,28 @@ namespace Lunaria {
 		}
 	}
 
+	// Draw lists are rebuilt by the next NewFrame, the render thread gets its own copy
+	static ImDrawData* CloneDrawData(const ImDrawData* drawData)
+	{
+		auto* clone = new ImDrawData(*drawData);
+		for (ImDrawList*& list : clone->CmdLists)
+			list = list->CloneOutput();
+
+		return clone;
+	}
+
+	static void DestroyDrawData(ImDrawData* drawData)
+	{
+		for (ImDrawList* list : drawData->CmdLists)
+			IM_DELETE(list);
+
+		delete drawData;
+	}
+
 	void ImGuiLayer::Begin()
 	{
-		ImGui_ImplOpenGL3_NewFrame();
+		// Creates the backend's GL objects on first use
+		RenderThread::Submit([] { ImGui_ImplOpenGL3_NewFrame(); });
 		ImGui_ImplSDL2_NewFrame();
 		ImGui::NewFrame();
 	}
@@ -82,7 +106,20 @@ namespace Lunaria {
 		// Rendering
 		{
 			ImGui::Render();
-			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+			if (RenderThread::IsRunning())
+			{
+				ImDrawData* drawData = CloneDrawData(ImGui::GetDrawData());
+				RenderThread::Submit([drawData]
+				{
+					ImGui_ImplOpenGL3_RenderDrawData(drawData);
+					DestroyDrawData(drawData);
+				});
+			}
+			else
+			{
+				ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			}
 		}
 
 		// Update and Render additional Platform Windows (Platform functions may change the current OpenGL context, so we save/restore it to make it easier to paste this code elsewhere.
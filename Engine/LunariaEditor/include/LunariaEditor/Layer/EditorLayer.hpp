@@ -23,10 +23,25 @@ namespace Lunaria {
 
         void OnAttach() override;
         void OnDetach() override;
+    private:
+        bool OnKeyPressed(KeyPressedEvent& event);
+
+        void NewScene();
+        void OpenScene();
+        void OpenScene(const std::string& path);
+        void SaveScene();
+        void SaveSceneAs();
+        void DrawScenePathPopup();
     private:
         OrthographicCameraController m_CameraController;
 
     	Ref<Scene> m_ActiveScene;
+        std::string m_ScenePath; // Empty until the scene is saved or opened
+
+        // No native file dialog, Open and Save As ask for the path in a popup
+        enum class ScenePathRequest { None, Open, SaveAs };
+        ScenePathRequest m_ScenePathRequest = ScenePathRequest::None;
+        std::array<char, 256> m_ScenePathBuffer = {};
         Entity m_SquareEntity;
 
         Entity m_CameraEntity;
@@ -15,6 +15,7 @@ namespace Lunaria {
 		void OnImGuiRender();
 	private:
 		void DrawEntityNode(Entity entity);
+		bool IsDescendant(Entity entity, Entity ancestor) const;
 		void DrawComponents(Entity entity);
 	private:
 		Ref<Scene> m_Context;
@@ -4,15 +4,27 @@
 
 namespace Lunaria {
 
+	struct MenubarCallbacks
+	{
+		std::function<void()> NewScene;
+		std::function<void()> OpenScene;
+		std::function<void()> SaveScene;
+		std::function<void()> SaveSceneAs;
+	};
+
 	class MenubarWidget 
 	{
 	public:
 		MenubarWidget();
 
 		void Draw();
+
+		void SetCallbacks(const MenubarCallbacks& callbacks) { m_Callbacks = callbacks; }
 	private:
 		bool BeginMenubar(const ImRect& barRectangle);
 		void EndMenubar();
+	private:
+		MenubarCallbacks m_Callbacks;
 	};
 
 }
\ No newline at end of file
@@ -12,6 +12,8 @@ namespace Lunaria {
 
 		// Window custom theme
 		void DrawUITitlebar();
+
+		MenubarWidget& GetMenubar() { return m_MenubarWidget; }
 	private:
 		bool m_TitleBarHovered = false;
 
@@ -11,8 +11,11 @@ namespace Lunaria {
 
 		void Init();
 		void Draw();
+		void DrawResolutionSettings();
 
 		void ResizeFrameBuffer();
+		// Picks this frame's render size from the GPU time of the "Viewport" pass
+		void UpdateResolution();
 		void BindFrameBuffer();
 		void UnbindFrameBuffer();
 
@@ -22,6 +25,7 @@ namespace Lunaria {
 		bool IsHovered() const { return m_ViewportHovered; }
 	private:
 		Ref<FrameBuffer> m_FrameBuffer;
+		DynamicResolution m_DynamicResolution;
 
 		bool m_ViewportFocused = false;
 		bool m_ViewportHovered = false;
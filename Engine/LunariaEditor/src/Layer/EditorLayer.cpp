@@ -7,6 +7,8 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <filesystem>
+
 namespace Lunaria {
 
     EditorLayer::EditorLayer() :
@@ -33,7 +35,7 @@ namespace Lunaria {
 
         auto redSquare = m_ActiveScene->CreateEntity("Red Square");
         redSquare.AddComponent<SpriteRendererComponent>(glm::vec4{ 1.0f, 0.0f, 0.0f, 1.0f });
-        redSquare.GetComponent<TransformComponent>().Translation.x = 2.0f;
+        redSquare.GetComponent<TransformComponent>().SetTranslation({ 2.0f, 0.0f, 0.0f });
 
         m_CameraEntity = m_ActiveScene->CreateEntity("Camera A");
         m_CameraEntity.AddComponent<CameraComponent>();
@@ -47,8 +49,9 @@ namespace Lunaria {
         public:
             virtual void OnCreate() override
             {
-                auto& translation = GetComponent<TransformComponent>().Translation;
-                translation.x = rand() % 10 - 5.0f;
+                m_Transform = GetComponentRef<TransformComponent>();
+                m_Transform->Translation.x = rand() % 10 - 5.0f;
+                m_Transform->MarkDirty();
             }
 
             virtual void OnDestroy() override
@@ -57,7 +60,8 @@ namespace Lunaria {
 
             virtual void OnUpdate(Timestep ts) override
             {
-                auto& translation = GetComponent<TransformComponent>().Translation;
+                TransformComponent& transform = *m_Transform;
+                glm::vec3 translation = transform.Translation;
 
                 float speed = 5.0f;
 
@@ -69,14 +73,27 @@ namespace Lunaria {
                     translation.y += speed * ts;
                 if (Input::IsKeyPressed(Key::S))
                     translation.y -= speed * ts;
+
+                if (translation != transform.Translation)
+                    transform.SetTranslation(translation);
             }
+        private:
+            ComponentRef<TransformComponent> m_Transform;
         };
 
         m_CameraEntity.AddComponent<NativeScriptComponent>().Bind<CameraController>();
 
         m_SecondCamera.AddComponent<NativeScriptComponent>().Bind<CameraController>();
 
+        m_ActiveScene->OnScenePlay();
         m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+
+        MenubarCallbacks callbacks;
+        callbacks.NewScene = [this]() { NewScene(); };
+        callbacks.OpenScene = [this]() { OpenScene(); };
+        callbacks.SaveScene = [this]() { SaveScene(); };
+        callbacks.SaveSceneAs = [this]() { SaveSceneAs(); };
+        m_TitlebarWidget.GetMenubar().SetCallbacks(callbacks);
     }
 
     void EditorLayer::OnDetach()
@@ -93,6 +110,8 @@ namespace Lunaria {
             
             m_ActiveScene->OnViewportResize(static_cast<uint32_t>(m_ViewportWidget.GetSize().x),
                 static_cast<uint32_t>((m_ViewportWidget.GetSize().y)));
+
+            m_ViewportWidget.UpdateResolution();
         }
 
         // Update
@@ -100,20 +119,30 @@ namespace Lunaria {
             m_CameraController.OnUpdate(timestep);
 
         // Render
+        Renderer::ResetStats();
         Renderer2D::ResetStats();
+        RenderCommand::ResetStateStats();
+
+        LU_GPU_SCOPE("Viewport");
 
         // Bind framebuffer, set color
         m_ViewportWidget.BindFrameBuffer();
-        RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
-        RenderCommand::Clear();
+        {
+            LU_GPU_SCOPE("Clear");
+            RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+            RenderCommand::Clear();
+        }
 
         // Draw quads
-        Renderer2D::BeginScene(m_CameraController.GetCamera());
+        {
+            LU_GPU_SCOPE("Scene");
+            Renderer2D::BeginScene(m_CameraController.GetCamera());
 
-        // Update scene
-    	m_ActiveScene->OnUpdate(timestep);
+            // Update scene
+            m_ActiveScene->OnUpdate(timestep);
 
-    	Renderer2D::EndScene();
+            Renderer2D::EndScene();
+        }
 
         m_ViewportWidget.UnbindFrameBuffer();
     }
@@ -121,6 +150,127 @@ namespace Lunaria {
     void EditorLayer::OnEvent(Event& event)
     {
         m_CameraController.OnEvent(event);
+
+        EventDispatcher dispatcher(event);
+        dispatcher.Dispatch<KeyPressedEvent>(LU_BIND_EVENT_FN(EditorLayer::OnKeyPressed));
+    }
+
+    bool EditorLayer::OnKeyPressed(KeyPressedEvent& event)
+    {
+        if (event.GetRepeatCount() > 0)
+            return false;
+
+        const bool control = Input::IsKeyPressed(Key::LeftControl) || Input::IsKeyPressed(Key::RightControl);
+        const bool shift = Input::IsKeyPressed(Key::LeftShift) || Input::IsKeyPressed(Key::RightShift);
+        if (!control)
+            return false;
+
+        switch (event.GetKeyCode())
+        {
+            case Key::N: NewScene(); return true;
+            case Key::O: OpenScene(); return true;
+            case Key::S: shift ? SaveSceneAs() : SaveScene(); return true;
+            default: return false;
+        }
+    }
+
+    void EditorLayer::NewScene()
+    {
+        m_ActiveScene = CreateRef<Scene>();
+        m_ActiveScene->OnViewportResize(static_cast<uint32_t>(m_ViewportWidget.GetSize().x),
+            static_cast<uint32_t>(m_ViewportWidget.GetSize().y));
+        m_ActiveScene->OnScenePlay();
+
+        m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+        m_ScenePath.clear();
+    }
+
+    void EditorLayer::OpenScene()
+    {
+        m_ScenePathRequest = ScenePathRequest::Open;
+    }
+
+    void EditorLayer::OpenScene(const std::string& path)
+    {
+        // Loaded aside, a file that fails to load leaves the open scene alone
+        Ref<Scene> scene = CreateRef<Scene>();
+        scene->OnViewportResize(static_cast<uint32_t>(m_ViewportWidget.GetSize().x),
+            static_cast<uint32_t>(m_ViewportWidget.GetSize().y));
+
+        if (!SceneSerializer(scene).Deserialize(path))
+            return;
+
+        scene->OnScenePlay();
+        m_ActiveScene = scene;
+        m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+        m_ScenePath = path;
+    }
+
+    void EditorLayer::SaveScene()
+    {
+        if (m_ScenePath.empty())
+        {
+            SaveSceneAs();
+            return;
+        }
+
+        SceneSerializer(m_ActiveScene).Serialize(m_ScenePath);
+    }
+
+    void EditorLayer::SaveSceneAs()
+    {
+        m_ScenePathRequest = ScenePathRequest::SaveAs;
+    }
+
+    void EditorLayer::DrawScenePathPopup()
+    {
+        if (m_ScenePathRequest == ScenePathRequest::None)
+            return;
+
+        if (!ImGui::IsPopupOpen("Scene Path"))
+        {
+            const std::string path = m_ScenePath.empty() ? "Scenes/Untitled.lscene" : m_ScenePath;
+            m_ScenePathBuffer = {};
+            path.copy(m_ScenePathBuffer.data(), m_ScenePathBuffer.size() - 1);
+            ImGui::OpenPopup("Scene Path");
+        }
+
+        if (ImGui::BeginPopupModal("Scene Path", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+        {
+            ImGui::InputText("##Path", m_ScenePathBuffer.data(), m_ScenePathBuffer.size());
+
+            const bool open = m_ScenePathRequest == ScenePathRequest::Open;
+            if (ImGui::Button(open ? "Open" : "Save"))
+            {
+                const std::string path = m_ScenePathBuffer.data();
+                if (open)
+                {
+                    OpenScene(path);
+                }
+                else
+                {
+                    const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+                    std::error_code error;
+                    if (!directory.empty())
+                        std::filesystem::create_directories(directory, error);
+
+                    if (SceneSerializer(m_ActiveScene).Serialize(path))
+                        m_ScenePath = path;
+                }
+
+                m_ScenePathRequest = ScenePathRequest::None;
+                ImGui::CloseCurrentPopup();
+            }
+
+            ImGui::SameLine();
+            if (ImGui::Button("Cancel"))
+            {
+                m_ScenePathRequest = ScenePathRequest::None;
+                ImGui::CloseCurrentPopup();
+            }
+
+            ImGui::EndPopup();
+        }
     }
 
     void EditorLayer::OnImGuiRender()
@@ -201,6 +351,8 @@ namespace Lunaria {
 
     	ImGui::PopStyleVar();
 
+        m_ViewportWidget.DrawResolutionSettings();
+
         ImGui::End();
 
         // Render titlebar
@@ -213,6 +365,8 @@ namespace Lunaria {
             ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoDocking);
         m_TitlebarWidget.DrawUITitlebar();
         ImGui::End();
+
+        DrawScenePathPopup();
     }
 
 }
@@ -16,16 +16,19 @@ namespace Lunaria {
 	void SceneHierarchyPanel::SetContext(const Ref<Scene>& context)
 	{
 		m_Context = context;
+		m_SelectionContext = {};
 	}
 
 	void SceneHierarchyPanel::OnImGuiRender()
 	{
 		ImGui::Begin("Scene Hierarchy");
 
+		// Children are drawn inside their parent's node
 		m_Context->m_Registry.each([&](auto entityID)
 			{
 				Entity entity{ entityID , m_Context.get() };
-				DrawEntityNode(entity);
+				if (!entity.GetParent())
+					DrawEntityNode(entity);
 			});
 
 		if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered())
@@ -50,21 +53,60 @@ namespace Lunaria {
 		ImGui::End();
 	}
 
+	bool SceneHierarchyPanel::IsDescendant(Entity entity, Entity ancestor) const
+	{
+		for (Entity parent = entity.GetParent(); parent; parent = parent.GetParent())
+		{
+			if (parent == ancestor)
+				return true;
+		}
+
+		return false;
+	}
+
 	void SceneHierarchyPanel::DrawEntityNode(Entity entity)
 	{
 		auto& tag = entity.GetComponent<TagComponent>().Tag;
+		const auto& relationship = entity.GetComponent<RelationshipComponent>();
 
 		ImGuiTreeNodeFlags flags = ((m_SelectionContext == entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow;
 		flags |= ImGuiTreeNodeFlags_SpanAvailWidth;
-		bool opened = ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<uint64_t>(static_cast<uint32_t>(entity))), flags, tag.c_str());
+		if (relationship.FirstChild == entt::null)
+			flags |= ImGuiTreeNodeFlags_Leaf;
+		bool opened = ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<uint64_t>(static_cast<uint32_t>(entity))), flags, tag.CStr());
 		if (ImGui::IsItemClicked())
 		{
 			m_SelectionContext = entity;
 		}
 
+		// Drag an entity onto another one to parent it
+		if (ImGui::BeginDragDropSource())
+		{
+			const entt::entity handle = entity;
+			ImGui::SetDragDropPayload("SCENE_ENTITY", &handle, sizeof(handle));
+			ImGui::Text("%s", tag.CStr());
+			ImGui::EndDragDropSource();
+		}
+
+		if (ImGui::BeginDragDropTarget())
+		{
+			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SCENE_ENTITY"))
+			{
+				Entity child{ *static_cast<const entt::entity*>(payload->Data), m_Context.get() };
+				child.SetParent(entity);
+			}
+			ImGui::EndDragDropTarget();
+		}
+
 		bool entityDeleted = false;
 		if (ImGui::BeginPopupContextItem())
 		{
+			if (ImGui::MenuItem("Create Child Entity"))
+				m_Context->CreateEntity("Empty Entity").SetParent(entity);
+
+			if (relationship.Parent != entt::null && ImGui::MenuItem("Unparent Entity"))
+				entity.SetParent({});
+
 			if (ImGui::MenuItem("Delete Entity"))
 				entityDeleted = true;
 
@@ -73,18 +115,22 @@ namespace Lunaria {
 
 		if (opened)
 		{
-			ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
-			bool opened = ImGui::TreeNodeEx((void*)9817239, flags, tag.c_str());
-			if (opened)
-				ImGui::TreePop();
+			for (entt::entity child = relationship.FirstChild; child != entt::null;)
+			{
+				// Read the link first, the child may be deleted or moved while drawn
+				const entt::entity next = m_Context->m_Registry.get<RelationshipComponent>(child).NextSibling;
+				DrawEntityNode({ child, m_Context.get() });
+				child = next;
+			}
 			ImGui::TreePop();
 		}
 
 		if (entityDeleted)
 		{
-			m_Context->DestroyEntity(entity);
-			if (m_SelectionContext == entity)
+			// The children go with it
+			if (m_SelectionContext && (m_SelectionContext == entity || IsDescendant(m_SelectionContext, entity)))
 				m_SelectionContext = {};
+			m_Context->DestroyEntity(entity);
 		}
 
 	}
@@ -210,17 +256,17 @@ namespace Lunaria {
 			char buffer[256];
 			memset(buffer, 0, sizeof(buffer));
 	#ifdef LU_PLATFORM_WINDOWS
-			strcpy_s(buffer, sizeof(buffer), tag.c_str());
+			strcpy_s(buffer, sizeof(buffer), tag.CStr());
 	#else
 			// Using strncpy with manual null-termination
 			// Ensure buffer is large enough to accommodate the copied string and null-terminator
 			#include <cstring>
-			strncpy(buffer, tag.c_str(), sizeof(buffer) - 1); // Use sizeof(buffer) - 1 to leave space for the null-terminator
+			strncpy(buffer, tag.CStr(), sizeof(buffer) - 1); // Use sizeof(buffer) - 1 to leave space for the null-terminator
 			buffer[sizeof(buffer) - 1] = '\0'; // Null-terminate the string manually
 	#endif
 			if (ImGui::InputText("##Tag", buffer, sizeof(buffer)))
 			{
-				tag = std::string(buffer);
+				tag = StringID(buffer);
 			}
 		}
 
@@ -244,6 +290,24 @@ namespace Lunaria {
 				ImGui::CloseCurrentPopup();
 			}
 
+			if (ImGui::MenuItem("Rigidbody 2D"))
+			{
+				m_SelectionContext.AddComponent<Rigidbody2DComponent>();
+				ImGui::CloseCurrentPopup();
+			}
+
+			if (ImGui::MenuItem("Box Collider 2D"))
+			{
+				m_SelectionContext.AddComponent<BoxCollider2DComponent>();
+				ImGui::CloseCurrentPopup();
+			}
+
+			if (ImGui::MenuItem("Circle Collider 2D"))
+			{
+				m_SelectionContext.AddComponent<CircleCollider2DComponent>();
+				ImGui::CloseCurrentPopup();
+			}
+
 			ImGui::EndPopup();
 		}
 
@@ -256,13 +320,17 @@ namespace Lunaria {
 			DrawVec3Control("Rotation", rotation);
 			component.Rotation = glm::radians(rotation);
 			DrawVec3Control("Scale", component.Scale, 1.0f);
+
+			// Only the selected entity is drawn, rebuilding its matrix every frame is free
+			component.MarkDirty();
 		});
 
-		DrawComponent<CameraComponent>("Camera", entity, [](auto& component)
+		// Patched when the selection or the sizing of the cameras changes, the scene only looks again then
+		DrawComponent<CameraComponent>("Camera", entity, [entity](auto& component) mutable
 		{
 			auto& camera = component.Camera;
 
-			ImGui::Checkbox("Primary", &component.Primary);
+			bool changed = ImGui::Checkbox("Primary", &component.Primary);
 
 			const char* projectionTypeStrings[] = { "Perspective", "Orthographic" };
 			const char* currentProjectionTypeString = projectionTypeStrings[(int)camera.GetProjectionType()];
@@ -313,8 +381,11 @@ namespace Lunaria {
 				if (ImGui::DragFloat("Far", &orthoFar))
 					camera.SetOrthographicFarClip(orthoFar);
 
-				ImGui::Checkbox("Fixed Aspect Ratio", &component.FixedAspectRatio);
+				changed |= ImGui::Checkbox("Fixed Aspect Ratio", &component.FixedAspectRatio);
 			}
+
+			if (changed)
+				entity.PatchComponent<CameraComponent>();
 		});
 
 		DrawComponent<SpriteRendererComponent>("Sprite Renderer", entity, [](auto& component)
@@ -322,5 +393,56 @@ namespace Lunaria {
 			ImGui::ColorEdit4("Color", glm::value_ptr(component.Color));
 		});
 
+		DrawComponent<Rigidbody2DComponent>("Rigidbody 2D", entity, [](auto& component)
+		{
+			const char* bodyTypeStrings[] = { "Static", "Dynamic", "Kinematic" };
+			const char* currentBodyTypeString = bodyTypeStrings[(int)component.Type];
+			if (ImGui::BeginCombo("Body Type", currentBodyTypeString))
+			{
+				for (int i = 0; i < 3; i++)
+				{
+					bool isSelected = currentBodyTypeString == bodyTypeStrings[i];
+					if (ImGui::Selectable(bodyTypeStrings[i], isSelected))
+					{
+						currentBodyTypeString = bodyTypeStrings[i];
+						component.Type = (Rigidbody2DComponent::BodyType)i;
+					}
+
+					if (isSelected)
+						ImGui::SetItemDefaultFocus();
+				}
+
+				ImGui::EndCombo();
+			}
+
+			ImGui::Checkbox("Fixed Rotation", &component.FixedRotation);
+			ImGui::DragFloat("Gravity Scale", &component.GravityScale, 0.1f);
+		});
+
+		// Patched, so the physics world rebuilds the body with the new collider
+		DrawComponent<BoxCollider2DComponent>("Box Collider 2D", entity, [entity](auto& component) mutable
+		{
+			bool changed = ImGui::DragFloat2("Offset", glm::value_ptr(component.Offset), 0.1f);
+			changed |= ImGui::DragFloat2("Size", glm::value_ptr(component.Size), 0.1f, 0.01f, 1000.0f);
+			changed |= ImGui::DragFloat("Density", &component.Density, 0.01f, 0.0f, 1000.0f);
+			changed |= ImGui::DragFloat("Friction", &component.Friction, 0.01f, 0.0f, 1.0f);
+			changed |= ImGui::DragFloat("Restitution", &component.Restitution, 0.01f, 0.0f, 1.0f);
+
+			if (changed)
+				entity.PatchComponent<BoxCollider2DComponent>();
+		});
+
+		DrawComponent<CircleCollider2DComponent>("Circle Collider 2D", entity, [entity](auto& component) mutable
+		{
+			bool changed = ImGui::DragFloat2("Offset", glm::value_ptr(component.Offset), 0.1f);
+			changed |= ImGui::DragFloat("Radius", &component.Radius, 0.1f, 0.01f, 1000.0f);
+			changed |= ImGui::DragFloat("Density", &component.Density, 0.01f, 0.0f, 1000.0f);
+			changed |= ImGui::DragFloat("Friction", &component.Friction, 0.01f, 0.0f, 1.0f);
+			changed |= ImGui::DragFloat("Restitution", &component.Restitution, 0.01f, 0.0f, 1.0f);
+
+			if (changed)
+				entity.PatchComponent<CircleCollider2DComponent>();
+		});
+
 	}
 }
\ No newline at end of file
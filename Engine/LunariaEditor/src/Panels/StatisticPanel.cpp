@@ -18,6 +18,78 @@ namespace Lunaria {
         ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
         ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
 
+        const auto rendererStats = Renderer::GetStats();
+
+        ImGui::Separator();
+        ImGui::Text("Renderer Stats:");
+        ImGui::Text("Draw Calls: %d", rendererStats.DrawCalls);
+        ImGui::Text("Meshes: %d", rendererStats.MeshCount);
+        ImGui::Text("Batched Meshes: %d", rendererStats.BatchedMeshCount);
+
+        const auto stateStats = RenderCommand::GetStateStats();
+
+        ImGui::Separator();
+        ImGui::Text("State Cache Stats:");
+        ImGui::Text("Issued Calls: %d", stateStats.IssuedCalls);
+        ImGui::Text("Skipped Calls: %d", stateStats.SkippedCalls);
+
+        const auto streamingStats = Renderer::GetTextureStreamer().GetStats();
+
+        ImGui::Separator();
+        ImGui::Text("Texture Streaming Stats:");
+        ImGui::Text("Pending Decodes: %d", streamingStats.PendingDecodes);
+        ImGui::Text("Pending Uploads: %d", streamingStats.PendingUploads);
+        ImGui::Text("Uploaded: %.2f MB", static_cast<float>(streamingStats.UploadedBytes) / (1024.0f * 1024.0f));
+        ImGui::Text("Loaded Textures: %d", streamingStats.LoadedTextures);
+        ImGui::Text("Failed Textures: %d", streamingStats.FailedTextures);
+
+        const auto syncStats = FrameSync::GetStats();
+
+        ImGui::Separator();
+        ImGui::Text("Frame Sync Stats:");
+        ImGui::Text("Frames In Flight: %d", FrameSync::GetFramesInFlight());
+        ImGui::Text("Frames Ahead: %d", syncStats.FramesAhead);
+        ImGui::Text("Fence Wait: %.3f ms (max %.3f ms)", syncStats.WaitMilliseconds, syncStats.MaxWaitMilliseconds);
+        ImGui::Text("Stalls: %d", syncStats.Stalls);
+
+        if (RenderThread::IsRunning())
+        {
+            const auto threadStats = RenderThread::GetStats();
+
+            ImGui::Separator();
+            ImGui::Text("Render Thread Stats:");
+            ImGui::Text("Recorded Commands: %d", threadStats.RecordedCommands);
+            ImGui::Text("Flushes: %d", threadStats.Flushes);
+            ImGui::Text("Main Thread Wait: %.3f ms", threadStats.WaitMilliseconds);
+            ImGui::Text("Execute: %.3f ms", threadStats.ExecuteMilliseconds);
+        }
+
+        // Timings lag a few frames behind, the GPU is never waited on
+        ImGui::Separator();
+        ImGui::Text("GPU Timings:");
+        ImGui::Text("CPU Frame: %.3f ms", ImGui::GetIO().DeltaTime * 1000.0f);
+        ImGui::Text("Dropped Frames: %d", GPUProfiler::GetDroppedFrames());
+
+        for (const auto& pass : GPUProfiler::GetPassTimings())
+        {
+            ImGui::PushID(&pass);
+
+            // Indent(0) would use the default spacing
+            const float indent = static_cast<float>(pass.Depth) * ImGui::GetStyle().IndentSpacing;
+            if (indent > 0.0f)
+                ImGui::Indent(indent);
+
+            char overlay[64];
+            snprintf(overlay, sizeof(overlay), "%s: %.3f ms", pass.Name.c_str(), pass.Milliseconds);
+            ImGui::PlotLines("##History", pass.History.data(), static_cast<int>(pass.History.size()),
+                static_cast<int>(pass.HistoryOffset), overlay, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+
+            if (indent > 0.0f)
+                ImGui::Unindent(indent);
+
+            ImGui::PopID();
+        }
+
         ImGui::End();
 	}
 }
@@ -15,10 +15,10 @@ namespace Lunaria {
 		{
 			if (ImGui::BeginMenu("File"))
 			{
-				if (ImGui::MenuItem("New", "Ctrl+N")) {}
-				if (ImGui::MenuItem("Open...", "Ctrl+O")) {}
-				if (ImGui::MenuItem("Save", "Ctrl+S")) {}
-				if (ImGui::MenuItem("Save As...", "Ctrl+Shift+S")) {}
+				if (ImGui::MenuItem("New", "Ctrl+N") && m_Callbacks.NewScene) { m_Callbacks.NewScene(); }
+				if (ImGui::MenuItem("Open...", "Ctrl+O") && m_Callbacks.OpenScene) { m_Callbacks.OpenScene(); }
+				if (ImGui::MenuItem("Save", "Ctrl+S") && m_Callbacks.SaveScene) { m_Callbacks.SaveScene(); }
+				if (ImGui::MenuItem("Save As...", "Ctrl+Shift+S") && m_Callbacks.SaveSceneAs) { m_Callbacks.SaveSceneAs(); }
 				ImGui::Separator();
 				if (ImGui::MenuItem("Exit")) { Application::Get().Shutdown(); }
 				ImGui::EndMenu();
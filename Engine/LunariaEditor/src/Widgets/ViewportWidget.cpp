@@ -26,8 +26,23 @@ namespace Lunaria {
 		ImVec2 viewportPanelSize = ImGui::GetContentRegionAvail();
 		m_ViewportSize = { viewportPanelSize.x, viewportPanelSize.y };
 
+		// Only the rendered part is shown, stretched over the panel with bilinear filtering
+		const auto& specification = m_FrameBuffer->GetSpecification();
+		const glm::uvec2 renderSize = m_FrameBuffer->GetRenderSize();
+		// The far edges are pulled in by half a texel when the attachment is larger than the rendered part,
+		// bilinear filtering would blend in the stale texels past it otherwise. The near edges are clamped
+		const auto edge = [](const uint32_t rendered, const uint32_t size)
+		{
+			if (size == 0)
+				return 1.0f;
+
+			return (rendered < size ? static_cast<float>(rendered) - 0.5f : static_cast<float>(rendered)) / static_cast<float>(size);
+		};
+		const float u = edge(renderSize.x, specification.Width);
+		const float v = edge(renderSize.y, specification.Height);
+
 		uint64_t textureID = m_FrameBuffer->GetColorAttachmentRendererID();
-		ImGui::Image(reinterpret_cast<void*>(textureID), ImVec2{ m_ViewportSize.x, m_ViewportSize.y }, ImVec2{ 0.0f, 1.0f }, ImVec2{ 1.0f, 0.0f });
+		ImGui::Image(reinterpret_cast<void*>(textureID), ImVec2{ m_ViewportSize.x, m_ViewportSize.y }, ImVec2{ 0.0f, v }, ImVec2{ u, 0.0f });
 		ImGui::End();
 	}
 
@@ -46,4 +61,38 @@ namespace Lunaria {
 		m_FrameBuffer->Resize(m_ViewportSize.x, m_ViewportSize.y);
 	}
 
+	void ViewportWidget::UpdateResolution()
+	{
+		m_DynamicResolution.Update(GPUProfiler::GetPassMilliseconds("Viewport"));
+
+		const auto& specification = m_FrameBuffer->GetSpecification();
+		const glm::uvec2 size = m_DynamicResolution.GetScaledSize(specification.Width, specification.Height);
+		m_FrameBuffer->SetRenderSize(size.x, size.y);
+	}
+
+	void ViewportWidget::DrawResolutionSettings()
+	{
+		ImGui::Begin("Dynamic Resolution");
+
+		bool enabled = m_DynamicResolution.IsEnabled();
+		if (ImGui::Checkbox("Enabled", &enabled))
+			m_DynamicResolution.SetEnabled(enabled);
+
+		DynamicResolutionSpecification specification = m_DynamicResolution.GetSpecification();
+		bool changed = false;
+		changed |= ImGui::DragFloat("Target (ms)", &specification.TargetMilliseconds, 0.1f, 1.0f, 100.0f);
+		changed |= ImGui::SliderFloat("Min Scale", &specification.MinScale, 0.25f, specification.MaxScale);
+		changed |= ImGui::SliderFloat("Max Scale", &specification.MaxScale, specification.MinScale, 1.0f);
+		changed |= ImGui::SliderFloat("Hysteresis", &specification.Hysteresis, 0.0f, 0.5f);
+		if (changed)
+			m_DynamicResolution.SetSpecification(specification);
+
+		const glm::uvec2 renderSize = m_FrameBuffer->GetRenderSize();
+		ImGui::Text("Scale: %.2f", m_DynamicResolution.GetScale());
+		ImGui::Text("Render Size: %d x %d", renderSize.x, renderSize.y);
+		ImGui::Text("Viewport GPU: %.3f ms", GPUProfiler::GetPassMilliseconds("Viewport"));
+
+		ImGui::End();
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,18 @@
+// Flat Color Shader, Vulkan version of FlatColor.lusf
+// glslc FlatColor.frag -o FlatColor.frag.spv
+
+#version 450
+
+layout(location = 0) out vec4 color;
+
+layout(set = 0, binding = 0) uniform Uniforms
+{
+	mat4 u_ViewProjection;
+	mat4 u_Transform;
+	vec4 u_Color;
+};
+
+void main()
+{
+	color = u_Color;
+}
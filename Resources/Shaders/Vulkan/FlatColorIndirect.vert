@@ -0,0 +1,23 @@
+// Flat Color Shader for Renderer::SubmitBatched, Vulkan version of FlatColorIndirect.lusf
+// glslc FlatColorIndirect.vert -o FlatColorIndirect.vert.spv
+
+// There is no MeshBatch on Vulkan, SubmitBatched draws through Submit with u_Transform
+
+#version 450
+
+layout(location = 0) in vec3 a_Position;
+
+layout(set = 0, binding = 0) uniform Uniforms
+{
+	mat4 u_ViewProjection;
+	mat4 u_Transform;
+	vec4 u_Color;
+};
+
+void main()
+{
+	gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+
+	// GL clip space depth [-w, w] to Vulkan's [0, w]
+	gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;
+}
@@ -0,0 +1,32 @@
+// Basic Texture Shader, Vulkan version of Texture.lusf
+// glslc Texture.vert -o Texture.vert.spv
+
+#version 450
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+layout(location = 4) in float a_TilingFactor;
+
+layout(set = 0, binding = 0) uniform Uniforms
+{
+	mat4 u_ViewProjection;
+};
+
+layout(location = 0) out vec4 v_Color;
+layout(location = 1) out vec2 v_TexCoord;
+layout(location = 2) flat out float v_TexIndex;
+layout(location = 3) out float v_TilingFactor;
+
+void main()
+{
+	v_Color = a_Color;
+	v_TexCoord = a_TexCoord;
+	v_TexIndex = a_TexIndex;
+	v_TilingFactor = a_TilingFactor;
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+
+	// GL clip space depth [-w, w] to Vulkan's [0, w]
+	gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;
+}